@@ -154,3 +154,39 @@ function(ulib_populate_sample_target target_name)
     )
 
 endfunction()
+
+#Build benchmark
+function(ulib_populate_bench_target target_name)
+
+    #Include the benchmark and thread helpers
+    target_sources(${target_name}
+        PRIVATE
+            ${PROJECT_SOURCE_DIR}/tests/src/az_ulib_test_bench.c
+            ${PROJECT_SOURCE_DIR}/tests/src/${ULIB_PAL_OS_DIRECTORY}/az_ulib_test_bench.c
+            ${PROJECT_SOURCE_DIR}/tests/src/${ULIB_PAL_OS_DIRECTORY}/az_ulib_test_thread.c
+    )
+
+    target_include_directories(${target_name}
+        PRIVATE
+            ${PROJECT_SOURCE_DIR}/inc
+            ${PROJECT_SOURCE_DIR}/config
+            ${PROJECT_SOURCE_DIR}/tests/inc
+            ${PROJECT_SOURCE_DIR}/pal/${ULIB_PAL_DIRECTORY}
+            ${PROJECT_SOURCE_DIR}/pal/os/inc
+            ${PROJECT_SOURCE_DIR}/pal/os/inc/${ULIB_PAL_OS_DIRECTORY}
+    )
+
+    target_link_libraries(${target_name}
+        PRIVATE
+            azure_ulib_c
+            azure_macro_utils_c
+            umock_c
+            $<$<STREQUAL:"${ULIB_PAL_OS_DIRECTORY}","linux">:pthread>
+    )
+
+    set_target_properties(${target_name}
+        PROPERTIES
+            FOLDER "uLib Benchmarks"
+    )
+
+endfunction()
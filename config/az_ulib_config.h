@@ -64,13 +64,172 @@ extern "C" {
  */
 #define AZ_ULIB_CONFIG_MAX_IPC_INSTANCES 20
 
+/**
+ * @brief   Number of buckets in the IPC name index.
+ *
+ * Defines the number of buckets in the hash table that the IPC uses to find the published interfaces
+ * by name. Interfaces with the same name share one entry in the table, with the list of their
+ * versions. Increasing this number will reduce the collisions between names, at the cost of one
+ * pointer per bucket in the IPC control block. For best results, use a number close to the number
+ * of distinct interface names in the system.
+ */
+#define AZ_ULIB_CONFIG_IPC_NAME_INDEX_SIZE 8
+
+/**
+ * @brief   Number of interfaces in the first segment of the growable IPC.
+ *
+ * Defines the number of interfaces in the first segment allocated by the IPC when
+ * `AZ_ULIB_CONFIG_IPC_GROWABLE` is defined. Each new segment has twice the size of the previous
+ * one, so the IPC can store up to `AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE * (2^AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS - 1)`
+ * interfaces. This value shall fit in 32 bits.
+ */
+#define AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE 16
+
+/**
+ * @brief   Maximum number of segments in the growable IPC.
+ *
+ * Defines the size of the table of segments in the IPC control block when
+ * `AZ_ULIB_CONFIG_IPC_GROWABLE` is defined. Each entry costs one pointer, the segments are only
+ * allocated when the IPC needs them.
+ */
+#define AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS 16
+
+/**
+ * @brief   Number of running counters in each IPC interface.
+ *
+ * Defines the number of shards of the counter that the IPC uses to track the calls in execution on
+ * each interface when `AZ_ULIB_CONFIG_IPC_UNPUBLISH` is defined. Each thread counts its calls in one
+ * of the shards, so threads on different cores calling the same interface don't write in the same
+ * cache line. Each shard uses #AZ_ULIB_CONFIG_CACHE_LINE_SIZE bytes per interface, so for multicore
+ * systems, use the number of cores. The value 1 keeps a single counter, without padding, which is
+ * the best option for single core MCUs. Values bigger than 1 require a port with
+ * `AZ_ULIB_PORT_THREAD_LOCAL`.
+ */
+#define AZ_ULIB_CONFIG_IPC_CALL_SHARDS 1
+
+/**
+ * @brief   Size of the cache line of the processor.
+ *
+ * Defines the number of bytes that the ulib uses to keep data written by different cores in
+ * different cache lines.
+ */
+#define AZ_ULIB_CONFIG_CACHE_LINE_SIZE 64
+
+/**
+ * @brief   Maximum number of windows in a memory-mapped file ustream.
+ *
+ * Defines the size of the table of windows in the `az_ulib_ustream_mmap_data_cb`. The file is divided in up to
+ * this number of windows, so increasing this number will reduce the size of each window, at the cost of more
+ * memory reserved to each memory-mapped file ustream.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS 64
+
+/**
+ * @brief   Minimum size of the window in a memory-mapped file ustream.
+ *
+ * Defines the minimum number of bytes mapped at once by the memory-mapped file ustream. Files smaller than this
+ * size are mapped in a single window. This value shall be a multiple of the system memory page size.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE (1024 * 1024)
+
+/**
+ * @brief   Maximum queue depth of the io_uring file ustream.
+ *
+ * Defines the number of chunk buffers in the `az_ulib_ustream_uring_data_cb`, which is also the maximum
+ * number of reads that the io_uring file ustream can keep in flight. Increasing this number will increase
+ * the size of each `az_ulib_ustream_uring_data_cb` by #AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE bytes.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH 8
+
+/**
+ * @brief   Size of the chunk in the io_uring file ustream.
+ *
+ * Defines the number of bytes read from the file on each request submitted by the io_uring file ustream.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE (64 * 1024)
+
+/**
+ * @brief   Size of the chunk in the ustream builder.
+ *
+ * Defines the number of bytes in each `az_ulib_ustream_builder_chunk`. The builder appends the content in chunks
+ * of this size, so bigger chunks waste more memory in the last chunk of each ustream, and smaller chunks make the
+ * ustream walk more chunks to find a position.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_BUILDER_CHUNK_SIZE 1024
+
+/**
+ * @brief   Size of the local buffer used by the ustream find.
+ *
+ * Defines the number of bytes in the stack buffer that az_ulib_ustream_find() uses to search ustreams that
+ * cannot expose their content without a copy. Ustreams that support az_ulib_ustream_peek() do not use it.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_FIND_BUFFER_SIZE 256
+
+/**
+ * @brief   Size of the local buffer used to checksum ustreams.
+ *
+ * Defines the number of bytes in the stack buffer that az_ulib_ustream_crc32c() and az_ulib_ustream_crc32() use
+ * to read ustreams that cannot expose their content without a copy. Ustreams that support az_ulib_ustream_peek()
+ * do not use it.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_CHECKSUM_BUFFER_SIZE 256
+
+/**
+ * @brief   Size of the local buffer used by the base64 ustreams.
+ *
+ * Defines the number of bytes in the stack buffer that the base64 encode and decode ustreams use to read the
+ * source ustream on each step of a read. This value shall be a multiple of 12, so the buffer holds complete
+ * blocks of both the binary (3 bytes) and the base64 (4 characters) content.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_BASE64_BUFFER_SIZE 192
+
+/**
+ * @brief   Size of the chunk in the LZ compression ustreams.
+ *
+ * Defines the maximum number of bytes of the original content compressed in each chunk by the LZ compress ustream,
+ * and the maximum chunk that the LZ decompress ustream accepts. Each `az_ulib_ustream_lz_data_cb` keeps 2 buffers of
+ * this size, so bigger chunks compress better, at the cost of more memory and more work per read. This value cannot
+ * be bigger than 65535.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE 4096
+
+/**
+ * @brief   Number of entries in the chunk index of the LZ ustreams.
+ *
+ * Defines the number of chunks whose positions each `az_ulib_ustream_lz_data_cb` records, so a read out of the
+ * loaded chunk starts from the closest recorded chunk instead of the beginning of the content. Contents with more
+ * chunks than entries record one chunk out of a power of 2, so the work of this read grows with the size of the
+ * content divided by this value. This value shall be an even number.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE 64
+
+#ifndef AZ_ULIB_CONFIG_REMOVE_SIMD
+/**
+ * @brief   Enable SIMD on the ustream helpers.
+ *
+ * @note    Comment this line will:
+ *            - Reduce the code size.
+ *            - Remove the dependency on the compiler support for the SIMD instructions.
+ *
+ * Some ustream helpers, like az_ulib_ustream_find() and az_ulib_ustream_crc32c(), have versions that use
+ * the SIMD instructions of the processor, selected in runtime when the processor supports them. If the
+ * system doesn't need the performance, or the compiler doesn't support these instructions, the helpers can
+ * use only the portable implementation.
+ *
+ * @note  **To avoid conflicts in the linker, instead of comment this line, define
+ *        AZ_ULIB_CONFIG_REMOVE_SIMD as part of the make file that will build the project.
+ *        For cmake, use the option -Dremove_ulib_simd.**
+ */
+#define AZ_ULIB_CONFIG_SIMD
+#endif /*AZ_ULIB_CONFIG_REMOVE_SIMD*/
+
 #ifndef AZ_ULIB_CONFIG_REMOVE_UNPUBLISH
 /**
  * @brief   Enable unpublish on IPC.
  *
  * @note    Comment this line will:
  *            - Improve performance.
- *            - Reduce memory by 2 longs per IPC interface.
+ *            - Reduce memory by the running counters of each IPC interface.
  *            - Remove the API az_ulib_ipc_unpublish.
  *
  * To allow users to unpublish interfaces in the IPC, it is necessary to add a flag to avoid an
@@ -85,6 +244,26 @@ extern "C" {
 #define AZ_ULIB_CONFIG_IPC_UNPUBLISH
 #endif /*AZ_ULIB_CONFIG_REMOVE_UNPUBLISH*/
 
+/**
+ * @brief   Enable the growable IPC registry.
+ *
+ * @note    Uncomment this line will:
+ *            - Add a dependency on the `malloc` and `free` of the standard library.
+ *            - Remove the #AZ_ULIB_CONFIG_MAX_IPC_INTERFACE limit on the number of interfaces.
+ *            - Remove the #AZ_ULIB_CONFIG_MAX_IPC_INSTANCES limit on the number of instances.
+ *
+ * By default, the IPC reserves memory for #AZ_ULIB_CONFIG_MAX_IPC_INTERFACE interfaces in its
+ * control block, which is the best option for MCUs. Systems with many interfaces, like gateways,
+ * can use the growable registry, that allocates the interfaces in segments that never move, so
+ * the handles stay valid while the registry grows. The name index also grows with the number of
+ * interface names.
+ *
+ * @note  **To avoid conflicts in the linker, instead of uncomment this line, define
+ *        AZ_ULIB_CONFIG_IPC_GROWABLE as part of the make file that will build the project.
+ *        For cmake, use the option -Duse_ipc_growable.**
+ */
+// #define AZ_ULIB_CONFIG_IPC_GROWABLE
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
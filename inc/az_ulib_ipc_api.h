@@ -60,6 +60,8 @@ typedef _az_ulib_ipc_interface_handle az_ulib_ipc_interface_handle;
  *  @retval #AZ_ULIB_SUCCESS                    If the IPC initialize with success.
  *  @retval #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the arguments is invalid.
  *  @retval #AZ_ULIB_ALREADY_INITIALIZED_ERROR  If the IPC is already initialized.
+ *  @retval #AZ_ULIB_OUT_OF_MEMORY_ERROR        If the IPC is growable, and there is no memory to
+ *                                              allocate its name index.
  */
 static inline az_ulib_result az_ulib_ipc_init(az_ulib_ipc* ipc_handle) {
 #ifdef AZ_ULIB_CONFIG_IPC_VALIDATE_CONTRACT
@@ -144,6 +146,13 @@ static inline az_ulib_result az_ulib_ipc_publish(
 /**
  * @brief   Unpublish an interface from the IPC.
  *
+ * Before returning #AZ_ULIB_SUCCESS, this API waits for the az_ulib_ipc_try_get_interface() calls
+ * that may be using the descriptor, so the caller may release the descriptor after this call.
+ *
+ * If methods of the interface are running, this API waits for them without blocking the other IPC
+ * APIs, and returns as soon as the last one ends. While it waits, the interface cannot be found,
+ * and a new publish with the same name and version returns #AZ_ULIB_ELEMENT_DUPLICATE_ERROR.
+ *
  * @note    You may remove this API defining a global key `AZ_ULIB_CONFIG_REMOVE_UNPUBLISH` on your
  * compilation enviroment. See more at #AZ_ULIB_CONFIG_IPC_UNPUBLISH.
  *
@@ -186,6 +195,10 @@ static inline az_ulib_result az_ulib_ipc_unpublish(
  * that the IPC will know how many components is using this interface. When a component does not
  * need this interface anymore, it shall release it by calling az_ulib_ipc_release_interface().
  *
+ * This API does not take the IPC lock, so it does not wait for other threads that are getting or
+ * releasing interfaces. An interface published or unpublished while this API runs may or may not be
+ * found by it.
+ *
  * @note    **Do not release an interface will cause memory leak.**
  *
  * @param[in]   name              The `const char* const` with the interface name. It shall be a
@@ -230,6 +243,8 @@ static inline az_ulib_result az_ulib_ipc_try_get_interface(
  * that the IPC will know how many components is using this interface. When a component does not
  * need this interface anymore, it shall release it by calling az_ulib_ipc_release_interface().
  *
+ * This API does not take the IPC lock.
+ *
  * @note    **Do not release an interface will cause memory leak.**
  *
  * @param[in]   original_interface_handle The #az_ulib_ipc_interface_handle with the original
@@ -264,7 +279,7 @@ static inline az_ulib_result az_ulib_ipc_get_interface(
  * This API releases an interface got by the az_ulib_ipc_try_get_interface() and
  * az_ulib_ipc_get_interface(). Release an interface is necessary to decrease the reference counter.
  * IPC will only free any memory related to the interface when all components that got this
- * interface releases it.
+ * interface releases it. This API does not take the IPC lock.
  *
  * The interface shall be released in two situations:
  *  * When it is not necessary anymore.
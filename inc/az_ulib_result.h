@@ -44,7 +44,8 @@ typedef enum az_ulib_result_tag {
     AZ_ULIB_DISABLED_ERROR             = (AZ_ULIB_ERROR_FLAG | 9),    /**<Disabled error */
     AZ_ULIB_INCOMPATIBLE_VERSION_ERROR = (AZ_ULIB_ERROR_FLAG | 10),   /**<Required version is not available error */
     AZ_ULIB_NOT_INITIALIZED_ERROR      = (AZ_ULIB_ERROR_FLAG | 11),   /**<Use a component that was not properly initialized */
-    AZ_ULIB_ALREADY_INITIALIZED_ERROR  = (AZ_ULIB_ERROR_FLAG | 12)    /**<A singleton component is already initialized */
+    AZ_ULIB_ALREADY_INITIALIZED_ERROR  = (AZ_ULIB_ERROR_FLAG | 12),   /**<A singleton component is already initialized */
+    AZ_ULIB_NOT_SUPPORTED_ERROR        = (AZ_ULIB_ERROR_FLAG | 13)    /**<The operation is not supported by the implementation */
 } az_ulib_result;
 
 #ifdef __cplusplus
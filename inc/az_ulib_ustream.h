@@ -101,6 +101,40 @@ MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_concat,
         az_ulib_ustream_multi_data_cb*, multi_data,
         az_ulib_release_callback, multi_data_release);
 
+/**
+  * @brief   Concatenate N ustreams to the existing ustream in a flat table.
+  *
+  *  The concat N appends the <tt>ustream_count</tt> ustreams in <tt>ustreams_to_concat</tt>, in order, at the end of the
+  *     passed <tt>ustream_instance</tt>, with the same ownership rules of the az_ulib_ustream_concat(). The difference is
+  *     that the ustreams are placed in one flat table of segments, instead of a chain of #az_ulib_ustream_multi_data_cb
+  *     where each read walks all the previous concatenations. Finding the segment of a position costs O(log N), and the
+  *     memory is one table for all the segments, instead of one control block for each ustream.
+  *
+  * @param[in,out]      ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[in]          ustreams_to_concat      The #az_ulib_ustream* pointing to the array of ustreams to concat to
+  *                                             <tt>ustream_instance</tt>. It cannot be <tt>NULL</tt>, and all the ustreams
+  *                                             shall be valid.
+  * @param[in]          ustream_count           The <tt>size_t</tt> with the number of ustreams in <tt>ustreams_to_concat</tt>.
+  *                                             It cannot be zero.
+  * @param[in]          flat_data               The #az_ulib_ustream_flat_data_cb* pointing to the allocated flat data control
+  *                                             block, with at least <tt>AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(ustream_count + 1)</tt>
+  *                                             bytes. It must be allocated in a way that it remains a valid address until the
+  *                                             passed <tt>flat_data_release</tt> is invoked some time in the future.
+  * @param[in]          flat_data_release       The #az_ulib_release_callback callback which will be called once
+  *                                             the number of references to the control block reaches zero. It may be <tt>NULL</tt> if no
+  *                                             future cleanup is needed.
+  * @return The #az_ulib_result with the result of the <tt>concat</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the az_ulib_ustream is concatenated with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_concat_n,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream*, ustreams_to_concat,
+        size_t, ustream_count,
+        az_ulib_ustream_flat_data_cb*, flat_data,
+        az_ulib_release_callback, flat_data_release);
+
 /**
   * @brief   Split a ustream at a given position.
   *
@@ -131,6 +165,226 @@ MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_split,
         az_ulib_ustream*, ustream_instance_split,
         offset_t, split_pos);
 
+/**
+  * @brief   Create a bounded view over part of a ustream.
+  *
+  *  The slice initializes <tt>ustream_instance_slice</tt> as a new ustream that shares the control block of the
+  *     <tt>ustream_instance</tt>, and exposes only the <tt>length</tt> bytes that starts at the position
+  *     <tt>offset</tt> of the <tt>ustream_instance</tt>. The slice keeps the positions that its bytes have in the
+  *     <tt>ustream_instance</tt>, so its current position starts at <tt>offset</tt>, and it cannot be moved out of
+  *     the view.
+  *
+  *  Different from the az_ulib_ustream_split(), the slice does not change the <tt>ustream_instance</tt>, not even
+  *     temporarily, and does not depend on its current position. So, it is safe to slice a ustream that is read by
+  *     another thread at the same time.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  *                                             It is not changed by this function.
+  * @param[in]          offset                  The <tt>offset_t</tt> with the position of the first byte of the slice in
+  *                                             the <tt>ustream_instance</tt>. It cannot be before the first valid position
+  *                                             of the <tt>ustream_instance</tt>.
+  * @param[in]          length                  The <tt>size_t</tt> with the number of bytes in the slice. The slice cannot
+  *                                             go after the end of the <tt>ustream_instance</tt>.
+  * @param[out]         ustream_instance_slice  The pointer to the allocated #az_ulib_ustream struct that will receive the
+  *                                             slice. It cannot be <tt>NULL</tt>.
+  *
+  * @return The #az_ulib_result with the result of the <tt>slice</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the slice is created with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  *          @retval    #AZ_ULIB_NO_SUCH_ELEMENT_ERROR  If the slice is out of the valid content of the
+  *                                                     <tt>ustream_instance</tt>.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_slice,
+        az_ulib_ustream*, ustream_instance,
+        offset_t, offset,
+        size_t, length,
+        az_ulib_ustream*, ustream_instance_slice);
+
+/**
+  * @brief   Cut a ustream in fixed-size chunks.
+  *
+  *  The chunk fills the <tt>chunks</tt> array with independent ustreams, each one exposing <tt>chunk_size</tt> bytes
+  *     of the <tt>ustream_instance</tt>, starting at its current position. The last chunk may be smaller, with the
+  *     remaining bytes. Each chunk is an az_ulib_ustream_slice() of the <tt>ustream_instance</tt>, so no content is
+  *     copied, and each chunk keeps the positions that its bytes have in the <tt>ustream_instance</tt>. Different from a chain
+  *     of az_ulib_ustream_split(), the <tt>ustream_instance</tt> is not changed, and the cost is linear on the number
+  *     of chunks.
+  *
+  *  The chunks are independent instances, so they can be read in parallel, and disposed in any order. If there
+  *     are more chunks than <tt>max_chunks</tt>, only the first <tt>max_chunks</tt> chunks are created, and the caller
+  *     may call the chunk again over the remaining content.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  *                                             It is not changed by this function.
+  * @param[in]          chunk_size              The <tt>size_t</tt> with the number of bytes in each chunk. It cannot be zero.
+  * @param[out]         chunks                  The pointer to the array of allocated #az_ulib_ustream structs that will
+  *                                             receive the chunks. It cannot be <tt>NULL</tt>.
+  * @param[in]          max_chunks              The <tt>size_t</tt> with the number of structs in <tt>chunks</tt>. It cannot
+  *                                             be zero.
+  * @param[out]         chunk_count             The <tt>size_t* const</tt> that will receive the number of created chunks.
+  *                                             It cannot be <tt>NULL</tt>.
+  *
+  * @return The #az_ulib_result with the result of the <tt>chunk</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the chunks are created with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  *          @retval    #AZ_ULIB_EOF                    If there are no remaining bytes in the <tt>ustream_instance</tt>.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_chunk,
+        az_ulib_ustream*, ustream_instance,
+        size_t, chunk_size,
+        az_ulib_ustream*, chunks,
+        size_t, max_chunks,
+        size_t* const, chunk_count);
+
+/**
+  * @brief   Move the current position of a ustream forward.
+  *
+  *  The advance moves the current position of the <tt>ustream_instance</tt> <tt>size</tt> bytes forward. It is the
+  *     companion of the az_ulib_ustream_peek() and az_ulib_ustream_get_span(), which expose the content of the
+  *     ustream without changing its current position. After consuming the returned span, the consumer calls the
+  *     advance to move past the consumed bytes.
+  *
+  * @param[in,out]      ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[in]          size                    The <tt>size_t</tt> with the number of bytes to move forward. It cannot
+  *                                             move the current position after the end of the ustream.
+  *
+  * @return The #az_ulib_result with the result of the <tt>advance</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the current position was moved with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  *          @retval    #AZ_ULIB_NO_SUCH_ELEMENT_ERROR  If the new position is after the end of the ustream.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_advance,
+        az_ulib_ustream*, ustream_instance,
+        size_t, size);
+
+/**
+  * @brief   Get a span with the next portion of any ustream.
+  *
+  *  The get span exposes the next portion of the ustream without changing its current position. For ustreams that
+  *     support az_ulib_ustream_peek(), the span points directly to the ustream content, and no copy is made. For the
+  *     ones that return #AZ_ULIB_NOT_SUPPORTED_ERROR, the get span falls back to a copy of the next portion of the
+  *     ustream to the provided <tt>local_buffer</tt>, and returns a span over it. In both cases, the consumer calls
+  *     az_ulib_ustream_advance() to move past the consumed bytes.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[out]         local_buffer            The <tt>uint8_t* const</tt> that points to the local buffer used if the
+  *                                             ustream cannot expose its content without a copy. It can be <tt>NULL</tt>, in
+  *                                             which case the get span only succeeds over ustreams that support the peek.
+  * @param[in]          local_buffer_length     The <tt>size_t</tt> with the size of the local buffer.
+  * @param[out]         span                    The <tt>const uint8_t** const</tt> that points to the place where the get span
+  *                                             shall store the pointer to the span. It cannot be <tt>NULL</tt>.
+  * @param[out]         size                    The <tt>size_t* const</tt> that points to the place where the get span shall
+  *                                             store the number of valid <tt>uint8_t</tt> values in the span. It cannot be <tt>NULL</tt>.
+  *
+  * @return The #az_ulib_result with the result of the <tt>get_span</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the span was returned with success.
+  *          @retval    #AZ_ULIB_EOF                    If there are no more <tt>uint8_t</tt> values in the ustream.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  *          @retval    #AZ_ULIB_NOT_SUPPORTED_ERROR    If the ustream cannot expose its content without a copy, and
+  *                                                     no local buffer was provided.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_get_span,
+        az_ulib_ustream*, ustream_instance,
+        uint8_t* const, local_buffer,
+        size_t, local_buffer_length,
+        const uint8_t** const, span,
+        size_t* const, size);
+
+/**
+  * @brief   Find the next occurrence of a pattern in any ustream.
+  *
+  *  The find searches the content of the ustream, from the current position up to the end of the ustream, for the
+  *     first occurrence of the <tt>pattern</tt>. The search runs directly over the spans exposed by
+  *     az_ulib_ustream_get_span(), so ustreams that support az_ulib_ustream_peek() are searched without any copy. The
+  *     pattern may cross the boundaries between spans, like the ones between the ustreams of a concatenation.
+  *
+  *  On processors that support it, the find scans each span with SIMD instructions (SSE2 or AVX2), selected in
+  *     runtime. See #AZ_ULIB_CONFIG_SIMD.
+  *
+  *  The current position of the ustream is not changed by the find. To consume the content up to the match, use
+  *     az_ulib_ustream_set_position() with the returned position. To find the next occurrence, set the current
+  *     position to the byte after the returned position, and call the find again.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[in]          pattern                 The <tt>const uint8_t* const</tt> with the sequence of bytes to find. It
+  *                                             cannot be <tt>NULL</tt>.
+  * @param[in]          pattern_length          The <tt>size_t</tt> with the number of bytes in the <tt>pattern</tt>. It
+  *                                             cannot be zero.
+  * @param[out]         position                The <tt>offset_t* const</tt> that points to the place where the find shall
+  *                                             store the logical position of the first byte of the match. It cannot be
+  *                                             <tt>NULL</tt>.
+  *
+  * @return The #az_ulib_result with the result of the <tt>find</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the pattern was found.
+  *          @retval    #AZ_ULIB_EOF                    If the pattern does not occur between the current position and
+  *                                                     the end of the ustream.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_find,
+        az_ulib_ustream*, ustream_instance,
+        const uint8_t* const, pattern,
+        size_t, pattern_length,
+        offset_t* const, position);
+
+/**
+  * @brief   Calculate the CRC32C of the content of any ustream.
+  *
+  *  The CRC32C uses the Castagnoli polynomial (iSCSI, 0x1EDC6F41) over the content of the ustream, from the current
+  *     position up to the end of the ustream. The content of the ustreams that support az_ulib_ustream_peek(),
+  *     including each ustream in a concatenation, is used in place, without any copy.
+  *
+  *  On processors that support it, the CRC32C uses the SSE4.2 <tt>crc32</tt> instruction, selected in runtime.
+  *     See #AZ_ULIB_CONFIG_SIMD.
+  *
+  *  The current position of the ustream is not changed, so the same ustream can be consumed after the checksum.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[in,out]      crc                     The <tt>uint32_t* const</tt> with the initial CRC, that receives the CRC
+  *                                             updated with the content of the ustream. It cannot be <tt>NULL</tt>. Use
+  *                                             <tt>0</tt> to start a new CRC, or the result of a previous call to continue
+  *                                             the CRC with the content of another ustream.
+  *
+  * @return The #az_ulib_result with the result of the <tt>crc32c</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the CRC was calculated with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_crc32c,
+        az_ulib_ustream*, ustream_instance,
+        uint32_t* const, crc);
+
+/**
+  * @brief   Calculate the CRC32 of the content of any ustream.
+  *
+  *  The CRC32 uses the IEEE 802.3 polynomial (0x04C11DB7), the same as zlib, over the content of the ustream, from
+  *     the current position up to the end of the ustream. The content of the ustreams that support
+  *     az_ulib_ustream_peek(), including each ustream in a concatenation, is used in place, without any copy.
+  *
+  *  On processors that support it, the CRC32 folds the content with the PCLMULQDQ instruction, selected in runtime.
+  *     See #AZ_ULIB_CONFIG_SIMD.
+  *
+  *  The current position of the ustream is not changed, so the same ustream can be consumed after the checksum.
+  *
+  * @param[in]          ustream_instance        The #az_ulib_ustream* with the interface of
+  *                                             the ustream. It cannot be <tt>NULL</tt>, and it shall be a valid ustream.
+  * @param[in,out]      crc                     The <tt>uint32_t* const</tt> with the initial CRC, that receives the CRC
+  *                                             updated with the content of the ustream. It cannot be <tt>NULL</tt>. Use
+  *                                             <tt>0</tt> to start a new CRC, or the result of a previous call to continue
+  *                                             the CRC with the content of another ustream.
+  *
+  * @return The #az_ulib_result with the result of the <tt>crc32</tt> operation.
+  *          @retval    #AZ_ULIB_SUCCESS                If the CRC was calculated with success.
+  *          @retval    #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+  */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_crc32,
+        az_ulib_ustream*, ustream_instance,
+        uint32_t* const, crc);
+
 
 #ifdef __cplusplus
 }
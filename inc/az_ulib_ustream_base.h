@@ -19,8 +19,9 @@
  *      - <b>Consumer</b> - is the module of code that will use the data exposed by the provider.
  *
  *  The ustream shall have a clear separation between the internal content (provider domain)
- *      and what it exposes as external content (consumer domain). The ustream shall never expose 
- *      the internal content (ex: providing a pointer to a internal memory position). All 
+ *      and what it exposes as external content (consumer domain). The ustream shall never expose
+ *      the internal content for writing (ex: providing a pointer to a internal memory position that the
+ *      consumer can change). Besides the read-only span returned by az_ulib_ustream_peek(), all
  *      exposed content shall be copied from the internal data source to some given external memory. To do
  *      that in a clear way, the ustream shall always work with the concept of two buffers, the 
  *      <tt>data source</tt> and the <tt>local buffer</tt>, adhering to the following definition:
@@ -333,11 +334,48 @@ extern "C" {
  */
 typedef size_t offset_t;
 
+/**
+ * @brief   Maximum value of an #offset_t.
+ *
+ *  Positions are not limited to 32 bits, a ustream can expose any size that fits in an #offset_t. The logical
+ *      position of the last byte in a ustream, including the offset of a clone, cannot exceed this value.
+ */
+#define AZ_ULIB_OFFSET_MAX SIZE_MAX
+
 /**
  * @brief   Forward declaration of az_ulib_ustream. See #az_ulib_ustream_tag for struct members.
  */
 typedef struct az_ulib_ustream_tag az_ulib_ustream;
 
+/**
+ * @brief   One local buffer in a scatter read.
+ *
+ *  Array of this struct describes the list of local buffers that az_ulib_ustream_readv() shall fill, in order.
+ */
+typedef struct az_ulib_ustream_iovec_tag
+{
+    uint8_t* buffer;                            /**<The <tt>uint8_t*</tt> that points to the local buffer */
+    size_t buffer_length;                       /**<The <tt>size_t</tt> with the size of the local buffer */
+} az_ulib_ustream_iovec;
+
+/**
+ * @brief   Access pattern that the consumer expects for a range of the ustream.
+ *
+ *  The hints are advisory, see az_ulib_ustream_hint().
+ */
+typedef enum az_ulib_ustream_hint_type_tag
+{
+    AZ_ULIB_USTREAM_HINT_SEQUENTIAL = 0,        /**<The range will be read in order, the ustream may read ahead aggressively */
+    AZ_ULIB_USTREAM_HINT_RANDOM = 1,            /**<The range will be read in random order, the ustream shall not read ahead */
+    AZ_ULIB_USTREAM_HINT_WILL_NEED = 2,         /**<The range will be read soon, the ustream may start to bring it to memory */
+    AZ_ULIB_USTREAM_HINT_DONE = 3               /**<The range will not be read again, the ustream may drop its cached content */
+} az_ulib_ustream_hint_type;
+
+/**
+ * @brief   Check if a hint is one of the values in #az_ulib_ustream_hint_type.
+ */
+#define AZ_ULIB_USTREAM_HINT_IS_VALID(hint)     ((unsigned int)(hint) <= (unsigned int)AZ_ULIB_USTREAM_HINT_DONE)
+
 /**
  * @brief   vTable with the ustream APIs.
  *
@@ -358,6 +396,14 @@ typedef struct az_ulib_ustream_interface_tag
     az_ulib_result(*clone)(az_ulib_ustream* ustream_instance_clone, 
                                             az_ulib_ustream* ustream_instance, offset_t offset); /**<concrete <tt>clone</tt> implementation*/
     az_ulib_result(*dispose)(az_ulib_ustream* ustream_instance);                                 /**<concrete <tt>dispose</tt> implementation*/
+    az_ulib_result(*peek)(az_ulib_ustream* ustream_instance, const uint8_t** const buffer,
+                                            size_t* const size);                                 /**<concrete <tt>peek</tt> implementation*/
+    az_ulib_result(*readv)(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov,
+                                            size_t iov_count, size_t* const size);               /**<concrete <tt>readv</tt> implementation*/
+    az_ulib_result(*read_at)(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer,
+                                            size_t buffer_length, size_t* const size);           /**<concrete <tt>read_at</tt> implementation*/
+    az_ulib_result(*hint)(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint,
+                                            offset_t position, size_t size);                     /**<concrete <tt>hint</tt> implementation*/
 } az_ulib_ustream_interface;
 
 /**
@@ -451,6 +497,83 @@ typedef struct az_ulib_ustream_multi_data_cb_tag
     az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section of the read from the multi ustream */
 } az_ulib_ustream_multi_data_cb;
 
+/**
+ * @brief   Structure of one segment in a flat concatenation.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_flat_segment_tag
+{
+    az_ulib_ustream ustream;                        /**<The #az_ulib_ustream with the segment instance */
+    offset_t end;                                   /**<The #offset_t with the inner position right after the end of the segment */
+} az_ulib_ustream_flat_segment;
+
+/**
+ * @brief   Structure to keep track of ustreams concatenated in a flat table.
+ *
+ * When concatenating N ustreams at once, the instances are placed in a table of segments with the cumulative position of
+ *      the end of each segment. The first segment receives a copy of the base ustream, and the other segments receive clones
+ *      of the ustreams to concatenate, like the <tt>ustream_one</tt> and <tt>ustream_two</tt> in the #az_ulib_ustream_multi_data_cb.
+ *      Any position is found by a binary search in the table, instead of walking a chain of #az_ulib_ustream_multi_data_cb.
+ *
+ * The table of segments is placed in the memory right after this structure, so the memory for the flat data shall be
+ *      allocated with the size returned by #AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_flat_data_cb_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the flat data structure*/
+    az_ulib_ustream_flat_segment* segments;         /**<The #az_ulib_ustream_flat_segment* with the table of segments */
+    size_t segment_count;                           /**<The <tt>size_t</tt> with the number of segments in the table */
+    az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section of the read from the segments */
+} az_ulib_ustream_flat_data_cb;
+
+/**
+ * @brief   Size of the memory for a #az_ulib_ustream_flat_data_cb with the table for <tt>segment_count</tt> segments.
+ */
+#define AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(segment_count) \
+    (sizeof(az_ulib_ustream_flat_data_cb) + ((segment_count) * sizeof(az_ulib_ustream_flat_segment)))
+
+/**
+ * @brief   Structure of one node in a rope of ustreams.
+ *
+ * A rope is a balanced binary tree where the leaves contain clones of the ustreams to compose, and the branches
+ *      contain the two subtrees with the content of the left one followed by the content of the right one. The nodes
+ *      are immutable and reference counted, so the ropes created by a concat, split or slice share all the nodes that
+ *      did not change, and each operation only creates the O(log n) nodes in the path from the root to the position.
+ *
+ * Each node is also the control block of the rope ustream that has it as the root, so a rope ustream instance is
+ *      just a reference to its root node.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_rope_node_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the node, its <tt>ref_count</tt>
+                                                            counts the ustream instances and the parent nodes */
+    size_t length;                                  /**<The <tt>size_t</tt> with the number of bytes in the node */
+    uint32_t height;                                /**<The <tt>uint32_t</tt> with the height of the node, zero for leaves */
+    union
+    {
+        struct
+        {
+            struct az_ulib_ustream_rope_node_tag* left;     /**<The left subtree of a branch */
+            struct az_ulib_ustream_rope_node_tag* right;    /**<The right subtree of a branch */
+        } branch;                                   /**<The subtrees of a node with <tt>height</tt> bigger than zero */
+        struct
+        {
+            az_ulib_ustream ustream;                /**<The #az_ulib_ustream with the clone of the leaf content, starting
+                                                            at the position zero */
+            az_ulib_pal_os_lock lock;               /**<The #az_ulib_pal_os_lock with controls the critical section of the
+                                                            read from ustreams that do not support read_at */
+        } leaf;                                     /**<The content of a node with <tt>height</tt> equal to zero */
+    } content;                                      /**<The content of the node */
+} az_ulib_ustream_rope_node;
+
 /**
  * @brief   Check if a handle is the same type of the API.
  *
@@ -869,6 +992,221 @@ static inline az_ulib_result az_ulib_ustream_dispose(az_ulib_ustream* ustream_in
     return ustream_instance->control_block->api->dispose(ustream_instance);
 }
 
+/**
+ * @brief   Gets a read-only span with the next contiguous portion of the ustream.
+ *
+ *  The <tt>az_ulib_ustream_peek</tt> API exposes, without copying it, the next contiguous portion of the
+ *      <tt>Data Source</tt> starting at the current position. It is the zero-copy counterpart of the
+ *      az_ulib_ustream_read(): instead of filling a local buffer, it returns a pointer to the memory where
+ *      the data already lives. The peek does not change the current position, so the consumer shall call
+ *      az_ulib_ustream_advance() to move past the bytes that it consumed from the span.
+ *
+ *  A ustream that stores its data in multiple places (ex: a concatenated ustream) returns one contiguous
+ *      region at a time, so the consumer may need multiple peeks to go over the full content. A ustream that
+ *      cannot expose its content as memory (ex: data in a file or that needs conversion) shall return
+ *      #AZ_ULIB_NOT_SUPPORTED_ERROR; consumers that want a single code path for every ustream can use
+ *      az_ulib_ustream_get_span(), which falls back to a copy in this case.
+ *
+ *  The span belongs to the ustream: it is valid only while the instance is not disposed, and the
+ *      consumer shall never change its content.
+ *
+ *  The <tt>az_ulib_ustream_peek</tt> API shall follow the following minimum requirements:
+ *      - The peek shall return in <tt>buffer</tt> a pointer to the content of the <tt>Data Source</tt> at the
+ *          current position.
+ *      - The peek shall return in <tt>size</tt> the number of contiguous <tt>uint8_t</tt> values available in the
+ *          returned span, which shall be bigger than 0 and not exceed the remaining size.
+ *      - The peek shall not change the current position of the ustream.
+ *      - If there is no more content to return, the peek shall return #AZ_ULIB_EOF, and size shall be set to 0.
+ *      - If the ustream cannot expose the content of the <tt>Data Source</tt> without a copy, the peek shall
+ *          return #AZ_ULIB_NOT_SUPPORTED_ERROR.
+ *      - If the provided interface is <tt>NULL</tt>, the peek shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided interface is not the implemented ustream type, the peek shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided buffer or size pointer is <tt>NULL</tt>, the peek shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the interface of the ustream. It
+ *                                          cannot be <tt>NULL</tt>, and it shall be a valid ustream that is the
+ *                                          implemented ustream type.
+ * @param[out]      buffer                  The <tt>const uint8_t** const</tt> that points to the place where the peek
+ *                                          shall store the pointer to the span. It cannot be <tt>NULL</tt>.
+ * @param[out]      size                    The <tt>size_t* const</tt> that points to the place where the peek shall store
+ *                                          the number of valid <tt>uint8_t</tt> values in the span. It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the peek operation.
+ *          @retval     #AZ_ULIB_SUCCESS                If the ustream returned a span with success.
+ *          @retval     #AZ_ULIB_BUSY_ERROR             If the resource necessary to peek the ustream content is busy.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_EOF                    If there are no more <tt>uint8_t</tt> values in the <tt>Data Source</tt> to peek.
+ *          @retval     #AZ_ULIB_NOT_SUPPORTED_ERROR    If the ustream cannot expose its content without a copy.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR           If the peek operation failed on the system level.
+ */
+static inline az_ulib_result az_ulib_ustream_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size)
+{
+    return ustream_instance->control_block->api->peek(ustream_instance, buffer, size);
+}
+
+/**
+ * @brief   Gets the next portion of the ustream, starting at the current position, scattered in multiple local buffers.
+ *
+ *  The <tt>az_ulib_ustream_readv</tt> API behaves as a sequence of az_ulib_ustream_read() calls, one for each
+ *      local buffer in the <tt>iov</tt> array, but in a single call. It fills each local buffer completely
+ *      before moving to the next one, and stops when all local buffers are full or when it reaches the end
+ *      of the <tt>Data Source</tt>. Assembling a datagram from multiple local buffers (ex: header, body, and
+ *      trailer) with a single readv avoids the cost of one call, and the correspondent internal controls, for
+ *      each buffer.
+ *
+ *  The <tt>az_ulib_ustream_readv</tt> API shall follow the following minimum requirements:
+ *      - The readv shall copy the contents of the <tt>Data Source</tt> to the provided local buffers, in order.
+ *      - The readv shall only start to copy to a local buffer when all the previous ones are full.
+ *      - The readv shall skip the local buffers with <tt>buffer_length</tt> equal to zero.
+ *      - The readv shall return the total number of valid <tt>uint8_t</tt> values copied to the local buffers in
+ *          the provided <tt>size</tt>.
+ *      - If there is no more content to return, the readv shall return #AZ_ULIB_EOF, size shall be set to 0, and
+ *          will not change the contents of the local buffers.
+ *      - If the provided interface is <tt>NULL</tt>, the readv shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided interface is not the implemented ustream type, the readv shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided <tt>iov</tt> is <tt>NULL</tt>, or <tt>iov_count</tt> is zero, the readv shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If one of the local buffers in the <tt>iov</tt> is <tt>NULL</tt> with a <tt>buffer_length</tt> bigger than
+ *          zero, the readv shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR and will not change the current position
+ *          of the buffer.
+ *      - If the provided return size pointer is <tt>NULL</tt>, the readv shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR and will not change the local buffers contents or the
+ *          current position of the buffer.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the interface of the ustream. It
+ *                                          cannot be <tt>NULL</tt>, and it shall be a valid ustream that is the
+ *                                          implemented ustream type.
+ * @param[in]       iov                     The <tt>const #az_ulib_ustream_iovec* const</tt> that points to the array
+ *                                          of local buffers. It cannot be <tt>NULL</tt>.
+ * @param[in]       iov_count               The <tt>size_t</tt> with the number of local buffers in the <tt>iov</tt>.
+ *                                          It shall be bigger than 0.
+ * @param[out]      size                    The <tt>size_t* const</tt> that points to the place where the readv shall store
+ *                                          the total number of valid <tt>uint8_t</tt> values returned in the local buffers.
+ *                                          It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the readv operation.
+ *          @retval     #AZ_ULIB_SUCCESS                If the ustream copied the content of the <tt>Data Source</tt> to the local
+ *                                                        buffers with success.
+ *          @retval     #AZ_ULIB_BUSY_ERROR             If the resource necessary to read the ustream content is busy.
+ *          @retval     #AZ_ULIB_CANCELLED_ERROR        If the read of the content was cancelled.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_EOF                    If there are no more <tt>uint8_t</tt> values in the <tt>Data Source</tt> to read.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR    If there is not enough memory to execute the readv.
+ *          @retval     #AZ_ULIB_SECURITY_ERROR         If the readv was denied for security reasons.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR           If the readv operation failed on the system level.
+ */
+static inline az_ulib_result az_ulib_ustream_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size)
+{
+    return ustream_instance->control_block->api->readv(ustream_instance, iov, iov_count, size);
+}
+
+/**
+ * @brief   Gets a portion of the ustream starting at the provided position, without changing the current position.
+ *
+ *  The <tt>az_ulib_ustream_read_at</tt> API copies the content of the <tt>Data Source</tt> starting at the provided
+ *      logical <tt>position</tt> to the local buffer, in the same way as an az_ulib_ustream_set_position() followed by
+ *      an az_ulib_ustream_read(), but it does not change the current position or any other state of the ustream.
+ *      Because of that, multiple threads can read_at the same ustream instance, or clones of it, at the same time,
+ *      and composed ustreams, like the concatenation, can read their inner ustreams without a lock.
+ *
+ *  The ustreams that cannot read without moving an internal position (ex: a ustream over a sequential source, like
+ *      a socket) return #AZ_ULIB_NOT_SUPPORTED_ERROR; consumers shall fall back to the
+ *      az_ulib_ustream_set_position() and az_ulib_ustream_read(), serialized by the consumer itself.
+ *
+ *  The <tt>az_ulib_ustream_read_at</tt> API shall follow the following minimum requirements:
+ *      - The read_at shall copy the contents of the <tt>Data Source</tt> starting at the provided <tt>position</tt>
+ *          to the local buffer, up to the <tt>buffer_length</tt> or the end of the <tt>Data Source</tt>.
+ *      - The read_at shall return the number of valid <tt>uint8_t</tt> values in the local buffer in
+ *          the provided <tt>size</tt>.
+ *      - The read_at shall not change the current position, or the first valid position, of the ustream.
+ *      - If the <tt>position</tt> is the end of the <tt>Data Source</tt>, the read_at shall return #AZ_ULIB_EOF, and
+ *          size shall be set to 0.
+ *      - If the <tt>position</tt> is after the end of the <tt>Data Source</tt>, or before the first valid position,
+ *          the read_at shall return #AZ_ULIB_NO_SUCH_ELEMENT_ERROR.
+ *      - If the ustream cannot read without changing its internal state, the read_at shall return
+ *          #AZ_ULIB_NOT_SUPPORTED_ERROR.
+ *      - If the provided interface is <tt>NULL</tt>, the read_at shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided interface is not the implemented ustream type, the read_at shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided local buffer is <tt>NULL</tt>, the read_at shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided buffer_length is zero, the read_at shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided return size pointer is <tt>NULL</tt>, the read_at shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR and will not change the local buffer contents.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the interface of the ustream. It
+ *                                          cannot be <tt>NULL</tt>, and it shall be a valid ustream that is the
+ *                                          implemented ustream type.
+ * @param[in]       position                The <tt>offset_t</tt> with the logical position of the first
+ *                                          <tt>uint8_t</tt> to copy, in the same base as az_ulib_ustream_get_position().
+ * @param[out]      buffer                  The <tt>uint8_t* const</tt> that points to the local buffer. It cannot be <tt>NULL</tt>.
+ * @param[in]       buffer_length           The <tt>size_t</tt> with the size of the local buffer. It shall be
+ *                                          bigger than 0.
+ * @param[out]      size                    The <tt>size_t* const</tt> that points to the place where the read_at shall store
+ *                                          the number of valid <tt>uint8_t</tt> values returned in the local buffer.
+ *                                          It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the read_at operation.
+ *          @retval     #AZ_ULIB_SUCCESS                If the ustream copied the content of the <tt>Data Source</tt> to the local
+ *                                                        buffer with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_NO_SUCH_ELEMENT_ERROR  If the position is out of the valid range of the ustream.
+ *          @retval     #AZ_ULIB_EOF                    If there are no more <tt>uint8_t</tt> values in the <tt>Data Source</tt> to read.
+ *          @retval     #AZ_ULIB_NOT_SUPPORTED_ERROR    If the ustream cannot read without changing its internal state.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR           If the read_at operation failed on the system level.
+ */
+static inline az_ulib_result az_ulib_ustream_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size)
+{
+    return ustream_instance->control_block->api->read_at(ustream_instance, position, buffer, buffer_length, size);
+}
+
+/**
+ * @brief   Advise the ustream about how the consumer will access a range of its content.
+ *
+ *  The <tt>az_ulib_ustream_hint</tt> API tells the ustream how the consumer expects to read the <tt>size</tt> bytes
+ *      starting at the logical <tt>position</tt>, so the ustream can prepare its <tt>Data Source</tt> (ex: a file
+ *      ustream can read ahead, or drop the cached pages of the range). The hint is only advisory, it never changes
+ *      the content, the current position, or the first valid position of the ustream, and a ustream that has no
+ *      use for the hint just returns #AZ_ULIB_SUCCESS.
+ *
+ *  The hints #AZ_ULIB_USTREAM_HINT_SEQUENTIAL and #AZ_ULIB_USTREAM_HINT_RANDOM describe an access pattern, so the
+ *      ustreams that cannot restrict it to a range may apply it to the whole <tt>Data Source</tt>, including the
+ *      other instances that share it. Composed ustreams, like the concatenation, forward the hint to the inner
+ *      ustreams that contain the range.
+ *
+ *  The <tt>az_ulib_ustream_hint</tt> API shall follow the following minimum requirements:
+ *      - The hint shall not change the content, the current position, or the first valid position of the ustream.
+ *      - The hint shall consider only the part of the range before the end of the <tt>Data Source</tt>.
+ *      - If the ustream has no use for the provided hint, the hint shall return #AZ_ULIB_SUCCESS.
+ *      - If the <tt>position</tt> is after the end of the <tt>Data Source</tt>, or before the first valid position,
+ *          the hint shall return #AZ_ULIB_NO_SUCH_ELEMENT_ERROR.
+ *      - If the provided interface is <tt>NULL</tt>, the hint shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided interface is not the implemented ustream type, the hint shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided hint is not a valid #az_ulib_ustream_hint_type, the hint shall return
+ *          #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *      - If the provided size is zero, the hint shall return #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the interface of the ustream. It
+ *                                          cannot be <tt>NULL</tt>, and it shall be a valid ustream that is the
+ *                                          implemented ustream type.
+ * @param[in]       hint                    The #az_ulib_ustream_hint_type with the expected access to the range.
+ * @param[in]       position                The <tt>offset_t</tt> with the logical position of the first
+ *                                          <tt>uint8_t</tt> in the range, in the same base as az_ulib_ustream_get_position().
+ * @param[in]       size                    The <tt>size_t</tt> with the number of <tt>uint8_t</tt> in the range. It shall be
+ *                                          bigger than 0, and it may exceed the end of the <tt>Data Source</tt>.
+ *
+ * @return The #az_ulib_result with the result of the hint operation.
+ *          @retval     #AZ_ULIB_SUCCESS                If the ustream accepted the hint.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_NO_SUCH_ELEMENT_ERROR  If the position is out of the valid range of the ustream.
+ */
+static inline az_ulib_result az_ulib_ustream_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size)
+{
+    return ustream_instance->control_block->api->hint(ustream_instance, hint, position, size);
+}
+
 
 #ifdef __cplusplus
 }
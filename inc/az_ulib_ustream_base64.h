@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_base64.h
+ *
+ * @brief ustream implementation for base64 encode and decode of other ustreams
+ *
+ *  These ustreams wrap a source ustream and expose its content encoded to, or decoded from, base64 (RFC 4648,
+ *      standard alphabet, with padding, without line breaks). The transformation is lazy, each read only takes
+ *      from the source the blocks needed to fill the consumer buffer, so a message is never materialized a
+ *      second time in memory.
+ *
+ *  Base64 maps each block of 3 bytes to a block of 4 characters, so any position of the transformed content
+ *      maps to one block of the source. Because of that, az_ulib_ustream_set_position() and
+ *      az_ulib_ustream_read_at() are O(1), without decoding the content before the position.
+ *
+ *  On processors that support it, the blocks are encoded and decoded with SSSE3 or AVX2 instructions, selected in
+ *      runtime. See #AZ_ULIB_CONFIG_SIMD.
+ *
+ *  The transformed content is produced in the consumer buffer, so these ustreams cannot expose their content
+ *      without a copy, and the az_ulib_ustream_peek() returns #AZ_ULIB_NOT_SUPPORTED_ERROR.
+ */
+
+#ifndef AZ_ULIB_USTREAM_BASE64_H
+#define AZ_ULIB_USTREAM_BASE64_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Structure to keep track of a base64 transformation of a ustream.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_base64_data_cb_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the base64 data structure */
+    az_ulib_ustream source;                         /**<The #az_ulib_ustream with the clone of the source, starting at the
+                                                            position zero */
+    size_t source_length;                           /**<The <tt>size_t</tt> with the number of bytes in the source */
+    bool decode;                                    /**<The <tt>bool</tt> that is <tt>true</tt> if the ustream decodes the
+                                                            source, or <tt>false</tt> if it encodes the source */
+    az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section of the
+                                                            read from sources that do not support read_at */
+} az_ulib_ustream_base64_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream with the base64 encode of another ustream.
+ *
+ *  The new ustream exposes 4 characters for each 3 bytes of <tt>ustream_to_encode</tt>, from its current position
+ *      up to its end, with the padding in the last block. The <tt>ustream_to_encode</tt> is cloned, so it is not
+ *      changed, and it may be disposed right after this call.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_base64_encode() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       base64_data             The #az_ulib_ustream_base64_data_cb* pointing to the allocated base64 data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>base64_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       base64_data_release     The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the clone of the
+ *                                          source is disposed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       ustream_to_encode       The #az_ulib_ustream* with the content to encode. It cannot be <tt>NULL</tt>, it shall be
+ *                                          a valid ustream, and its remaining size cannot be zero.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, or the
+ *                                                              <tt>ustream_to_encode</tt> is empty.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_base64_encode,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_base64_data_cb*, base64_data,
+        az_ulib_release_callback, base64_data_release,
+        az_ulib_ustream*, ustream_to_encode);
+
+/**
+ * @brief   Factory to initialize a new ustream with the base64 decode of another ustream.
+ *
+ *  The new ustream exposes 3 bytes for each 4 characters of <tt>ustream_to_decode</tt>, from its current position
+ *      up to its end. The factory reads the last block of <tt>ustream_to_decode</tt> to find the padding, and with
+ *      it, the size of the decoded content. The other blocks are only validated when they are read, so the
+ *      read that reaches an invalid character returns #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. The <tt>ustream_to_decode</tt>
+ *      is cloned, so it is not changed, and it may be disposed right after this call.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_base64_decode() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       base64_data             The #az_ulib_ustream_base64_data_cb* pointing to the allocated base64 data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>base64_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       base64_data_release     The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the clone of the
+ *                                          source is disposed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       ustream_to_decode       The #az_ulib_ustream* with the base64 content to decode. It cannot be <tt>NULL</tt>, it
+ *                                          shall be a valid ustream, and its remaining size shall be a multiple of 4 bigger than zero.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, the size of the
+ *                                                              <tt>ustream_to_decode</tt> is not valid, or its last block is
+ *                                                              not valid base64.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_base64_decode,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_base64_data_cb*, base64_data,
+        az_ulib_release_callback, base64_data_release,
+        az_ulib_ustream*, ustream_to_decode);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_BASE64_H */
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_builder.h
+ *
+ * @brief Append-only builder of ustreams over chunks taken from a pool
+ *
+ *  A producer that does not know the size of its payload in advance usually assembles it in a growable buffer,
+ *      which costs a <tt>realloc</tt> each time the buffer grows, and then wraps the buffer in a ustream. The
+ *      builder appends the content in chunks of #AZ_ULIB_CONFIG_USTREAM_BUILDER_CHUNK_SIZE bytes taken from an
+ *      #az_ulib_ustream_builder_pool, so the content that was already appended never moves.
+ *
+ *  When the content is complete, the az_ulib_ustream_builder_freeze() creates a regular ustream over the
+ *      chunks, without copying them. The chunks belong to the ustream from then on, and they return to the pool
+ *      when the last instance of the ustream is disposed. The pool hands out and gets back the chunks without
+ *      locks, so the ustreams can be disposed in any thread.
+ */
+
+#ifndef AZ_ULIB_USTREAM_BUILDER_H
+#define AZ_ULIB_USTREAM_BUILDER_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_config.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Maximum number of chunks in one pool.
+ *
+ *  The free list is kept in a single 32 bits word, in the same way as the #az_ulib_ustream_pool.
+ */
+#define AZ_ULIB_USTREAM_BUILDER_POOL_MAX_CHUNKS     0xFFFF
+
+typedef struct az_ulib_ustream_builder_pool_tag az_ulib_ustream_builder_pool;
+
+/**
+ * @brief   Structure of one chunk of content.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the builder. Users should therefore
+ *       not act on it directly and only allocate the memory necessary for it to be passed to the pool.
+ */
+typedef struct az_ulib_ustream_builder_chunk_tag
+{
+    uint8_t data[AZ_ULIB_CONFIG_USTREAM_BUILDER_CHUNK_SIZE];  /**<The content in this chunk */
+    struct az_ulib_ustream_builder_chunk_tag* next;         /**<The #az_ulib_ustream_builder_chunk* with the next chunk
+                                                                    of content, or <tt>NULL</tt> if it is the last one */
+    struct az_ulib_ustream_builder_chunk_tag* prev;         /**<The #az_ulib_ustream_builder_chunk* with the previous
+                                                                    chunk of content, or <tt>NULL</tt> if it is the first one */
+    struct az_ulib_ustream_builder_chunk_tag* jump;         /**<The #az_ulib_ustream_builder_chunk* with a previous chunk
+                                                                    of content, used to find a chunk by its index */
+    uint32_t index;                                         /**<The <tt>uint32_t</tt> with the index of the chunk in the
+                                                                    content */
+    az_ulib_ustream_builder_pool* pool;                     /**<The #az_ulib_ustream_builder_pool that owns the chunk */
+    volatile uint32_t next_free;                            /**<The <tt>uint32_t</tt> with the index + 1 of the next
+                                                                    free chunk, or zero if it is the last one */
+} az_ulib_ustream_builder_chunk;
+
+/**
+ * @brief   Structure to keep track of a pool of chunks.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the builder. Users should therefore
+ *       not act on it directly and only allocate the memory necessary for it to be passed to the pool.
+ */
+struct az_ulib_ustream_builder_pool_tag
+{
+    volatile uint32_t free_list;                    /**<The <tt>uint32_t</tt> with the tag and the index + 1 of the first
+                                                            free chunk */
+    az_ulib_ustream_builder_chunk* chunks;          /**<The #az_ulib_ustream_builder_chunk* with the chunks in the pool */
+    size_t chunk_count;                             /**<The <tt>size_t</tt> with the number of chunks in the pool */
+};
+
+/**
+ * @brief   Structure to keep track of the content appended to a builder.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the builder. Users should therefore
+ *       not act on it directly and only allocate the memory necessary for it to be passed to the builder.
+ */
+typedef struct az_ulib_ustream_builder_tag
+{
+    az_ulib_ustream_builder_pool* pool;             /**<The #az_ulib_ustream_builder_pool to take the chunks from */
+    az_ulib_ustream_builder_chunk* first_chunk;     /**<The #az_ulib_ustream_builder_chunk* with the first chunk, or
+                                                            <tt>NULL</tt> if the builder is empty */
+    az_ulib_ustream_builder_chunk* last_chunk;      /**<The #az_ulib_ustream_builder_chunk* with the chunk that receives
+                                                            the next append */
+    size_t length;                                  /**<The <tt>size_t</tt> with the number of bytes appended */
+} az_ulib_ustream_builder;
+
+/**
+ * @brief   Initialize a pool of chunks.
+ *
+ *  All the chunks in the pool start free. The pool does not allocate any memory, and it does not need to be
+ *      deinitialized. The memory of the pool and of the chunks can be reused after all the chunks are released.
+ *
+ * @param[out]      pool            The #az_ulib_ustream_builder_pool* to initialize. It cannot be <tt>NULL</tt>, and it
+ *                                  must remain valid while there is a chunk from this pool in use.
+ * @param[in]       chunks          The #az_ulib_ustream_builder_chunk* pointing to the array of chunks that the pool will
+ *                                  hand out. It cannot be <tt>NULL</tt>, and it must remain valid while there is a chunk
+ *                                  from this pool in use.
+ * @param[in]       chunk_count     The <tt>size_t</tt> with the number of chunks in <tt>chunks</tt>. It shall be bigger
+ *                                  than zero and not bigger than #AZ_ULIB_USTREAM_BUILDER_POOL_MAX_CHUNKS.
+ *
+ * @return The #az_ulib_result with the result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the pool is initialized with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_builder_pool_init,
+        az_ulib_ustream_builder_pool*, pool,
+        az_ulib_ustream_builder_chunk*, chunks,
+        size_t, chunk_count);
+
+/**
+ * @brief   Initialize an empty builder.
+ *
+ * @param[out]      builder         The #az_ulib_ustream_builder* to initialize. It cannot be <tt>NULL</tt>.
+ * @param[in]       pool            The #az_ulib_ustream_builder_pool* to take the chunks from. It cannot be
+ *                                  <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the builder is initialized with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_builder_init,
+        az_ulib_ustream_builder*, builder,
+        az_ulib_ustream_builder_pool*, pool);
+
+/**
+ * @brief   Append content to the end of a builder.
+ *
+ *  The content is copied to the free space in the last chunk, and to new chunks taken from the pool when the
+ *      last chunk is full. The append is all or nothing, if the pool does not have enough chunks for the whole
+ *      <tt>buffer</tt>, the chunks taken by this append return to the pool and the builder is not changed.
+ *
+ * @param[in, out]  builder         The #az_ulib_ustream_builder* to append the content. It cannot be <tt>NULL</tt>.
+ * @param[in]       buffer          The <tt>const uint8_t* const</tt> with the content to append. It cannot be
+ *                                  <tt>NULL</tt>.
+ * @param[in]       size            The <tt>size_t</tt> with the number of bytes in <tt>buffer</tt>. It cannot be zero.
+ *
+ * @return The #az_ulib_result with the result of the append.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the content is appended with success.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there are not enough free chunks in the pool.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_builder_append,
+        az_ulib_ustream_builder*, builder,
+        const uint8_t* const, buffer,
+        size_t, size);
+
+/**
+ * @brief   Create a ustream with the content of a builder, without copying it.
+ *
+ *  The chunks are moved from the builder to the new ustream, and the builder is left empty, ready to build the
+ *      next content. The chunks return to their pool when the last instance of the ustream is disposed. The
+ *      ustream supports az_ulib_ustream_peek(), which exposes the content of one chunk at a time. The chunk of a
+ *      position is found in O(log n) steps on the number of chunks, so there is no penalty to read big contents.
+ *
+ * @param[in, out]  builder                 The #az_ulib_ustream_builder* with the content. It cannot be <tt>NULL</tt>.
+ * @param[in]       control_block           The #az_ulib_ustream_data_cb* pointing to the allocated control block. It
+ *                                          must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>control_block_release</tt> is invoked some time in the future. It cannot
+ *                                          be <tt>NULL</tt>.
+ * @param[in]       control_block_release   The #az_ulib_release_callback callback which will be called once the number
+ *                                          of references to the control block reaches zero, after the chunks return to
+ *                                          the pool. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid
+ *                                          from the time az_ulib_ustream_builder_freeze() is called through
+ *                                          az_ulib_ustream_dispose(). It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the freeze.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the ustream is created with success.
+ *          @retval     #AZ_ULIB_EOF                        If the builder is empty.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_builder_freeze,
+        az_ulib_ustream_builder*, builder,
+        az_ulib_ustream_data_cb*, control_block,
+        az_ulib_release_callback, control_block_release,
+        az_ulib_ustream*, ustream_instance);
+
+/**
+ * @brief   Discard the content of a builder.
+ *
+ *  The chunks of the builder return to the pool, and the builder is left empty.
+ *
+ * @param[in, out]  builder         The #az_ulib_ustream_builder* to discard. It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the content is discarded with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If the provided builder is <tt>NULL</tt>.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_builder_deinit,
+        az_ulib_ustream_builder*, builder);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_BUILDER_H */
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_lz.h
+ *
+ * @brief ustream implementation for LZ compression and decompression of other ustreams
+ *
+ *  These ustreams wrap a source ustream and expose its content compressed, or decompressed, with a fast LZ
+ *      codec implemented in the ulib, without external dependencies. The content is compressed in independent
+ *      chunks of up to #AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE bytes, so each sequential read transforms at most one
+ *      chunk, and the work per read does not depend on the size of the content.
+ *
+ *  The compressed content is a sequence of chunks. Each chunk starts with a header of
+ *      #AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE bytes, with the number of bytes of the original content in the chunk,
+ *      followed by the number of bytes of the chunk payload, both as 16 bits little endian. If both sizes are equal,
+ *      the payload is the original content, because it could not be compressed. Otherwise, the payload is the
+ *      original content compressed in the LZ4 block format.
+ *
+ *  The factories walk all the chunks to find the size of the content, and record the position of the chunks, in
+ *      the transformed content and in the source, in an index of #AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE entries. A read
+ *      out of the loaded chunk, after an az_ulib_ustream_set_position(), an az_ulib_ustream_read_at(), or a read of
+ *      another clone, starts from the closest indexed chunk, or from the loaded chunk if it is closer. The decompress
+ *      ustream only reads the headers of the chunks up to the position, and decompresses the chunk with the position.
+ *      The compress ustream cannot know where a chunk ends without compressing it, so it compresses the chunks up to
+ *      the position. Contents with up to #AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE chunks have all chunks in the index, so
+ *      these reads transform a single chunk. Bigger contents have one chunk out of a power of 2 in the index, with
+ *      less than 2 * chunks / #AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE chunks between the indexed ones. Sequential reads
+ *      never compress or decompress a chunk more than once.
+ *
+ *  The size of the compressed content is only known after the compression, so the factory of the compress ustream
+ *      compresses the source once to find it. For contents that fit in a single chunk, which is the case of most
+ *      telemetry messages, this compressed chunk is kept and used by the first read.
+ *
+ *  The transformed content is produced in a chunk shared by all the clones, so these ustreams cannot expose their
+ *      content without a copy, and the az_ulib_ustream_peek() returns #AZ_ULIB_NOT_SUPPORTED_ERROR.
+ */
+
+#ifndef AZ_ULIB_USTREAM_LZ_H
+#define AZ_ULIB_USTREAM_LZ_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_config.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Number of bytes in the header of each chunk of the compressed content.
+ */
+#define AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE 4
+
+/**
+ * @brief   Number of bits of the hash used by the compressor to find matches.
+ */
+#define AZ_ULIB_USTREAM_LZ_HASH_LOG 12
+
+/**
+ * @brief   Structure with the position of a chunk in the index of an LZ transformation of a ustream.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream.
+ */
+typedef struct az_ulib_ustream_lz_index_entry_tag
+{
+    offset_t position;                              /**<The #offset_t with the position of the chunk in the transformed
+                                                            content */
+    offset_t source_position;                       /**<The #offset_t with the position of the chunk in the source */
+} az_ulib_ustream_lz_index_entry;
+
+/**
+ * @brief   Structure to keep track of an LZ transformation of a ustream.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_lz_data_cb_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the LZ data structure */
+    az_ulib_ustream source;                         /**<The #az_ulib_ustream with the clone of the source, starting at the
+                                                            position zero */
+    size_t source_length;                           /**<The <tt>size_t</tt> with the number of bytes in the source */
+    bool decompress;                                /**<The <tt>bool</tt> that is <tt>true</tt> if the ustream decompresses
+                                                            the source, or <tt>false</tt> if it compresses the source */
+    az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section of the
+                                                            chunk shared by the instances */
+    az_ulib_pal_os_lock source_lock;                /**<The #az_ulib_pal_os_lock with controls the critical section of the
+                                                            read from sources that do not support read_at */
+    offset_t chunk_position;                        /**<The #offset_t with the position of the chunk in the transformed
+                                                            content */
+    size_t chunk_size;                              /**<The <tt>size_t</tt> with the number of bytes of transformed content in
+                                                            the chunk, or zero if the chunk is empty */
+    offset_t chunk_source_position;                 /**<The #offset_t with the position of the chunk in the source */
+    size_t chunk_source_size;                       /**<The <tt>size_t</tt> with the number of bytes of the source in the
+                                                            chunk */
+    uint8_t chunk[AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE + AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE];
+                                                    /**<The <tt>uint8_t</tt> buffer with the transformed content of the
+                                                            chunk */
+    uint8_t work[AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE];
+                                                    /**<The <tt>uint8_t</tt> buffer with the content of the chunk read from
+                                                            the source */
+    az_ulib_ustream_lz_index_entry index[AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE];
+                                                    /**<The #az_ulib_ustream_lz_index_entry table with the positions of the
+                                                            indexed chunks, in the order of the content */
+    size_t index_count;                             /**<The <tt>size_t</tt> with the number of entries in the index */
+    size_t index_stride;                            /**<The <tt>size_t</tt> with the number of chunks between the indexed
+                                                            chunks, always a power of 2 */
+    uint16_t hash_table[1 << AZ_ULIB_USTREAM_LZ_HASH_LOG];
+                                                    /**<The <tt>uint16_t</tt> table with the last position of each hash in
+                                                            the chunk, used by the compressor */
+} az_ulib_ustream_lz_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream with the LZ compression of another ustream.
+ *
+ *  The new ustream exposes the compressed content of <tt>ustream_to_compress</tt>, from its current position up to
+ *      its end. The <tt>ustream_to_compress</tt> is cloned, so it is not changed, and it may be disposed right
+ *      after this call. To find the size of the compressed content, this factory compresses the full content once.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_lz_compress() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       lz_data                 The #az_ulib_ustream_lz_data_cb* pointing to the allocated LZ data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>lz_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       lz_data_release         The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the clone of the
+ *                                          source is disposed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       ustream_to_compress     The #az_ulib_ustream* with the content to compress. It cannot be <tt>NULL</tt>, it shall
+ *                                          be a valid ustream, and its remaining size cannot be zero.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, or the
+ *                                                              <tt>ustream_to_compress</tt> is empty.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the read of the <tt>ustream_to_compress</tt> failed.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_lz_compress,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_lz_data_cb*, lz_data,
+        az_ulib_release_callback, lz_data_release,
+        az_ulib_ustream*, ustream_to_compress);
+
+/**
+ * @brief   Factory to initialize a new ustream with the LZ decompression of another ustream.
+ *
+ *  The new ustream exposes the decompressed content of <tt>ustream_to_decompress</tt>, from its current position up
+ *      to its end. The factory reads the headers of all chunks of <tt>ustream_to_decompress</tt> to find the size of
+ *      the decompressed content. The payloads are only validated when they are read, so the read that reaches an
+ *      invalid chunk returns #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. The <tt>ustream_to_decompress</tt> is cloned, so it is
+ *      not changed, and it may be disposed right after this call.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_lz_decompress() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       lz_data                 The #az_ulib_ustream_lz_data_cb* pointing to the allocated LZ data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>lz_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       lz_data_release         The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the clone of the
+ *                                          source is disposed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       ustream_to_decompress   The #az_ulib_ustream* with the compressed content. It cannot be <tt>NULL</tt>, it shall
+ *                                          be a valid ustream, and its remaining size cannot be zero.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, the
+ *                                                              <tt>ustream_to_decompress</tt> is empty, or one of its chunk
+ *                                                              headers is not valid, including chunks bigger than
+ *                                                              #AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the read of the <tt>ustream_to_decompress</tt> failed.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_lz_decompress,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_lz_data_cb*, lz_data,
+        az_ulib_release_callback, lz_data_release,
+        az_ulib_ustream*, ustream_to_decompress);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_LZ_H */
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_mmap.h
+ *
+ * @brief ustream implementation for memory-mapped files
+ *
+ *  This ustream exposes the content of a file without copying it to the HEAP. The file is mapped in
+ *      the address space of the process in windows, and each window is only mapped when some instance
+ *      of the ustream touches it for the first time. In this way, the ustream can handle files bigger
+ *      than the RAM, and the startup cost does not depend on the size of the file.
+ *
+ *  Released data is returned to the system by az_ulib_ustream_release(), which advises the system that
+ *      the pages before the first valid position are not needed anymore.
+ *
+ *  The az_ulib_ustream_hint() is passed to the system as <tt>madvise</tt> on the windows of the range. The
+ *      hints that prepare the range map its windows first, and #AZ_ULIB_USTREAM_HINT_DONE returns the pages fully
+ *      inside the range to the system, like the release does.
+ *
+ *  This implementation is only available on systems that support <tt>mmap</tt>.
+ */
+
+#ifndef AZ_ULIB_USTREAM_MMAP_H
+#define AZ_ULIB_USTREAM_MMAP_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_config.h"
+#include "az_ulib_pal_os.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Structure to keep track of a memory-mapped file.
+ *
+ *  The file is divided in up to #AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS windows of <tt>window_size</tt> bytes. The
+ *      window size is at least #AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE, and grows with the file, so all the windows
+ *      fit in the <tt>windows</tt> table. A mapped window stays mapped until all the instances of the ustream are
+ *      disposed, so the spans returned by az_ulib_ustream_peek() are valid during the entire life of the instance.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream.
+ */
+typedef struct az_ulib_ustream_mmap_data_cb_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the mmap data structure */
+    int file_descriptor;                            /**<The <tt>int</tt> with the descriptor of the mapped file */
+    size_t file_size;                               /**<The <tt>size_t</tt> with the size of the mapped file */
+    size_t window_size;                             /**<The <tt>size_t</tt> with the size of each window */
+    size_t page_size;                               /**<The <tt>size_t</tt> with the size of the system memory page */
+    uint8_t* volatile windows[AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS]; /**<The table with the address of each mapped
+                                                                            window, or <tt>NULL</tt> if not mapped yet */
+    az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section
+                                                            to map a new window */
+} az_ulib_ustream_mmap_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream with the content of a file.
+ *
+ *  This factory opens the file <tt>file_name</tt> for read, and initializes a ustream that exposes its
+ *      content using memory-mapped windows. No window is mapped during the initialization. The file shall not
+ *      be changed while there is an instance of the ustream.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_mmap_init() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       mmap_data               The #az_ulib_ustream_mmap_data_cb* pointing to the allocated mmap data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>mmap_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       mmap_data_release       The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the windows are
+ *                                          unmapped and the file is closed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       file_name               The <tt>const char* const</tt> with the name of the file to expose. It cannot be
+ *                                          <tt>NULL</tt>, and the file shall not be empty. The file may be
+ *                                          bigger than 4GB, up to #AZ_ULIB_OFFSET_MAX bytes.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, or the file is empty
+ *                                                              or bigger than #AZ_ULIB_OFFSET_MAX.
+ *          @retval     #AZ_ULIB_NO_SUCH_ELEMENT_ERROR      If the file cannot be opened.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the system failed to get the information about the file.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_mmap_init,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_mmap_data_cb*, mmap_data,
+        az_ulib_release_callback, mmap_data_release,
+        const char* const, file_name);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_MMAP_H */
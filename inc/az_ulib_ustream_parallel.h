@@ -0,0 +1,189 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_parallel.h
+ *
+ * @brief Parallel processing of a ustream over a pool of worker threads
+ *
+ *  CPU-heavy work over a large ustream (hashing, compression, encoding) can use more than one core if the
+ *      content is cut in slices that are processed at the same time. The az_ulib_ustream_parallel_run() cuts the
+ *      ustream in slices with az_ulib_ustream_slice(), so each slice is an independent clone that shares the
+ *      content of the original ustream, hands the slices to the threads of an #az_ulib_ustream_worker_pool, and
+ *      then joins the results in the order of the slices, in the thread that called the run.
+ *
+ *  The worker threads are created by the PAL in the az_ulib_ustream_worker_pool_init(), and wait for work
+ *      between runs, so a run does not pay the cost to create threads. The pool does not allocate memory, the
+ *      caller provides the memory for the threads and for the slices.
+ */
+
+#ifndef AZ_ULIB_USTREAM_PARALLEL_H
+#define AZ_ULIB_USTREAM_PARALLEL_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_result.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_pal_os_api.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Signature of the work that runs in the worker threads, once for each slice.
+ *
+ *  The work may run at the same time in different threads, for different slices, so any state shared by the
+ *      <tt>context</tt> shall be protected by the work. The slice is disposed by the run after the work returns.
+ *
+ * @param[in]       slice           The #az_ulib_ustream* with the slice to process.
+ * @param[in]       index           The <tt>size_t</tt> with the index of the slice in the ustream, starting at 0.
+ * @param[in]       context         The <tt>void*</tt> provided in the az_ulib_ustream_parallel_run().
+ *
+ * @return The #az_ulib_result with the result of the work.
+ */
+typedef az_ulib_result (*az_ulib_ustream_parallel_work)(az_ulib_ustream* slice, size_t index, void* context);
+
+/**
+ * @brief   Signature of the join that runs in the thread that called the run, once for each slice, in order.
+ *
+ * @param[in]       index           The <tt>size_t</tt> with the index of the slice in the ustream, starting at 0.
+ * @param[in]       context         The <tt>void*</tt> provided in the az_ulib_ustream_parallel_run().
+ *
+ * @return The #az_ulib_result with the result of the join.
+ */
+typedef az_ulib_result (*az_ulib_ustream_parallel_join)(size_t index, void* context);
+
+/**
+ * @brief   Structure of one slice in a parallel run.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the run. Users should therefore
+ *       not act on it directly and only allocate the memory necessary for it to be passed to the run.
+ */
+typedef struct az_ulib_ustream_parallel_task_tag
+{
+    az_ulib_ustream slice;
+    az_ulib_result result;
+} az_ulib_ustream_parallel_task;
+
+/**
+ * @brief   Structure of a pool of worker threads.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the pool. Users should therefore
+ *       not act on it directly and only allocate the memory necessary for it to be passed to the pool.
+ */
+typedef struct az_ulib_ustream_worker_pool_tag
+{
+    az_ulib_pal_os_lock lock;
+    az_ulib_pal_os_condition work_ready;
+    az_ulib_pal_os_condition work_done;
+    az_ulib_pal_os_thread* threads;
+    size_t thread_count;
+    az_ulib_ustream_parallel_task* tasks;
+    size_t task_count;
+    size_t next_task;
+    size_t pending_tasks;
+    size_t first_index;
+    az_ulib_ustream_parallel_work work;
+    void* context;
+    bool running;
+    bool stop;
+} az_ulib_ustream_worker_pool;
+
+/**
+ * @brief   Initialize a pool and start its worker threads.
+ *
+ * @param[out]      pool            The #az_ulib_ustream_worker_pool* to initialize. It cannot be <tt>NULL</tt>.
+ * @param[in]       threads         The pointer to the array of #az_ulib_pal_os_thread with the memory for the
+ *                                  threads. It cannot be <tt>NULL</tt>, and it shall remain valid until the
+ *                                  az_ulib_ustream_worker_pool_deinit() returns.
+ * @param[in]       thread_count    The <tt>size_t</tt> with the number of threads in <tt>threads</tt>. It cannot be
+ *                                  zero.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If all the worker threads are running.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the PAL failed to create a thread. No thread is left
+ *                                                              running.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_worker_pool_init,
+        az_ulib_ustream_worker_pool*, pool,
+        az_ulib_pal_os_thread*, threads,
+        size_t, thread_count);
+
+/**
+ * @brief   Stop the worker threads of a pool, and wait for them to end.
+ *
+ *  There shall be no run in progress in the pool.
+ *
+ * @param[in]       pool            The #az_ulib_ustream_worker_pool* to deinitialize. It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with result of the deinitialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If all the worker threads ended.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If the provided pool is <tt>NULL</tt>.
+ *          @retval     #AZ_ULIB_BUSY_ERROR                 If there is a run in progress.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_worker_pool_deinit,
+        az_ulib_ustream_worker_pool*, pool);
+
+/**
+ * @brief   Process a ustream in parallel, one slice of <tt>chunk_size</tt> bytes in each work.
+ *
+ *  The run cuts the content of the <tt>ustream_instance</tt>, from its current position to its end, in slices of
+ *      <tt>chunk_size</tt> bytes, the last one may be smaller. The slices are processed in rounds of up to
+ *      <tt>max_tasks</tt> slices. In each round, the worker threads call the <tt>work</tt> for the slices, and,
+ *      when all of them are done, the calling thread calls the <tt>join</tt> for each slice, in order.
+ *
+ *  The run stops in the first slice, in order, that fails in the <tt>work</tt> or in the <tt>join</tt>, and returns
+ *      its result. The slices after it in the same round may have been processed by the <tt>work</tt>, but they are
+ *      not joined. The <tt>ustream_instance</tt> is not changed.
+ *
+ *  The run returns only after all the slices are disposed. A pool can only execute one run at a time.
+ *
+ * @param[in]       pool                The #az_ulib_ustream_worker_pool* with the worker threads. It cannot be
+ *                                      <tt>NULL</tt>.
+ * @param[in]       ustream_instance    The #az_ulib_ustream* with the content to process. It cannot be <tt>NULL</tt>,
+ *                                      and it shall be a valid ustream. It is not changed by this function.
+ * @param[in]       chunk_size          The <tt>size_t</tt> with the number of bytes in each slice. It cannot be zero.
+ * @param[in]       tasks               The pointer to the array of #az_ulib_ustream_parallel_task with the memory
+ *                                      for the slices of one round. It cannot be <tt>NULL</tt>.
+ * @param[in]       max_tasks           The <tt>size_t</tt> with the number of tasks in <tt>tasks</tt>. It cannot be
+ *                                      zero.
+ * @param[in]       work                The #az_ulib_ustream_parallel_work to call for each slice in the worker threads.
+ *                                      It cannot be <tt>NULL</tt>.
+ * @param[in]       join                The #az_ulib_ustream_parallel_join to call for each slice in the calling thread.
+ *                                      It may be <tt>NULL</tt> if no join is needed.
+ * @param[in]       context             The <tt>void*</tt> that will be passed to the <tt>work</tt> and the
+ *                                      <tt>join</tt>.
+ *
+ * @return The #az_ulib_result with result of the run.
+ *          @retval     #AZ_ULIB_SUCCESS                    If all slices were processed and joined with success.
+ *          @retval     #AZ_ULIB_EOF                        If there are no remaining bytes in the
+ *                                                              <tt>ustream_instance</tt>.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_BUSY_ERROR                 If there is another run in progress in the pool.
+ *          @retval     other                               The result of the first slice that failed.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_parallel_run,
+        az_ulib_ustream_worker_pool*, pool,
+        az_ulib_ustream*, ustream_instance,
+        size_t, chunk_size,
+        az_ulib_ustream_parallel_task*, tasks,
+        size_t, max_tasks,
+        az_ulib_ustream_parallel_work, work,
+        az_ulib_ustream_parallel_join, join,
+        void*, context);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_PARALLEL_H */
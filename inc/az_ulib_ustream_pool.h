@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_pool.h
+ *
+ * @brief Lock-free pool of ustream control blocks
+ *
+ *  Every ustream needs an #az_ulib_ustream_data_cb, every concatenation needs an #az_ulib_ustream_multi_data_cb,
+ *      and every rope needs an #az_ulib_ustream_rope_node for each node in its tree. When these control blocks come
+ *      from the HEAP, each new ustream costs a <tt>malloc</tt> and a <tt>free</tt>, which is expensive and not
+ *      deterministic in a hot path.
+ *
+ *  This pool manages a fixed number of blocks, provided by the caller in the az_ulib_ustream_pool_init(). Each
+ *      block can hold any of the control blocks, and the pool hands them out and gets them back without locks,
+ *      so the pool can be shared between threads. The az_ulib_ustream_pool_release() can be used directly as the
+ *      <tt>control_block_release</tt> in the az_ulib_ustream_init(), and as the <tt>multi_data_release</tt> in the
+ *      az_ulib_ustream_concat(), returning the block to its pool when the ustream does not need it anymore.
+ */
+
+#ifndef AZ_ULIB_USTREAM_POOL_H
+#define AZ_ULIB_USTREAM_POOL_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Maximum number of blocks in one pool.
+ *
+ *  The free list is kept in a single 32 bits word, with the index of the first free block in the 16 less
+ *      significant bits, and a tag to protect the list against the ABA problem in the 16 most significant bits.
+ */
+#define AZ_ULIB_USTREAM_POOL_MAX_BLOCKS     0xFFFF
+
+typedef struct az_ulib_ustream_pool_tag az_ulib_ustream_pool;
+
+/**
+ * @brief   Structure of one block in the pool.
+ *
+ *  The control block is the first field in the structure, so the pointer to the control block is also
+ *      the pointer to the block.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the pool. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the pool.
+ */
+typedef struct az_ulib_ustream_pool_block_tag
+{
+    union
+    {
+        az_ulib_ustream_data_cb data_cb;            /**<The #az_ulib_ustream_data_cb handed out by the pool */
+        az_ulib_ustream_multi_data_cb multi_data_cb;/**<The #az_ulib_ustream_multi_data_cb handed out by the pool */
+        az_ulib_ustream_rope_node rope_node;        /**<The #az_ulib_ustream_rope_node handed out by the pool */
+    } control_block;                                /**<The control block handed out by the pool */
+    az_ulib_ustream_pool* pool;                     /**<The #az_ulib_ustream_pool that owns the block */
+    volatile uint32_t next;                         /**<The <tt>uint32_t</tt> with the index + 1 of the next free block,
+                                                            or zero if it is the last one */
+} az_ulib_ustream_pool_block;
+
+/**
+ * @brief   Structure to keep track of a pool of control blocks.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the pool. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the pool.
+ */
+struct az_ulib_ustream_pool_tag
+{
+    volatile uint32_t free_list;                    /**<The <tt>uint32_t</tt> with the tag and the index + 1 of the first
+                                                            free block */
+    az_ulib_ustream_pool_block* blocks;             /**<The #az_ulib_ustream_pool_block* with the blocks in the pool */
+    size_t block_count;                             /**<The <tt>size_t</tt> with the number of blocks in the pool */
+};
+
+/**
+ * @brief   Initialize a pool of control blocks.
+ *
+ *  All the blocks in the pool start free. The pool does not allocate any memory, and it does not need to be
+ *      deinitialized. The memory of the pool and of the blocks can be reused after all the blocks are released.
+ *
+ * @param[out]      pool            The #az_ulib_ustream_pool* to initialize. It cannot be <tt>NULL</tt>, and it must
+ *                                  remain valid while there is a block from this pool in use.
+ * @param[in]       blocks          The #az_ulib_ustream_pool_block* pointing to the array of blocks that the pool will
+ *                                  hand out. It cannot be <tt>NULL</tt>, and it must remain valid while there is a block
+ *                                  from this pool in use.
+ * @param[in]       block_count     The <tt>size_t</tt> with the number of blocks in <tt>blocks</tt>. It shall be bigger
+ *                                  than zero and not bigger than #AZ_ULIB_USTREAM_POOL_MAX_BLOCKS.
+ *
+ * @return The #az_ulib_result with the result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the pool is initialized with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_pool_init,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream_pool_block*, blocks,
+        size_t, block_count);
+
+/**
+ * @brief   Get a #az_ulib_ustream_data_cb from the pool.
+ *
+ *  The block shall be returned to the pool by az_ulib_ustream_pool_release(), usually as the
+ *      <tt>control_block_release</tt> in the az_ulib_ustream_init().
+ *
+ * @param[in]       pool            The #az_ulib_ustream_pool* with the pool. It cannot be <tt>NULL</tt>.
+ * @param[out]      data_cb         The #az_ulib_ustream_data_cb** that will receive the control block. It cannot be
+ *                                  <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the control block is taken from the pool with success.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there is no free block in the pool.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_pool_get_data_cb,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream_data_cb**, data_cb);
+
+/**
+ * @brief   Get a #az_ulib_ustream_multi_data_cb from the pool.
+ *
+ *  The block shall be returned to the pool by az_ulib_ustream_pool_release(), usually as the
+ *      <tt>multi_data_release</tt> in the az_ulib_ustream_concat().
+ *
+ * @param[in]       pool            The #az_ulib_ustream_pool* with the pool. It cannot be <tt>NULL</tt>.
+ * @param[out]      multi_data_cb   The #az_ulib_ustream_multi_data_cb** that will receive the control block. It cannot be
+ *                                  <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the control block is taken from the pool with success.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there is no free block in the pool.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_pool_get_multi_data_cb,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream_multi_data_cb**, multi_data_cb);
+
+/**
+ * @brief   Get a #az_ulib_ustream_rope_node from the pool.
+ *
+ *  The rope ustreams take their nodes from the pool provided in the az_ulib_ustream_rope_init(), and return them
+ *      by az_ulib_ustream_pool_release() when the last reference to the node is disposed.
+ *
+ * @param[in]       pool            The #az_ulib_ustream_pool* with the pool. It cannot be <tt>NULL</tt>.
+ * @param[out]      rope_node       The #az_ulib_ustream_rope_node** that will receive the node. It cannot be
+ *                                  <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the node is taken from the pool with success.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there is no free block in the pool.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_pool_get_rope_node,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream_rope_node**, rope_node);
+
+/**
+ * @brief   Return a control block to its pool.
+ *
+ *  This function follows the #az_ulib_release_callback signature, so it can be provided as the release callback
+ *      of the control blocks taken from a pool. The block is returned to the pool that handed it out.
+ *
+ * @param[in]       release_pointer     The <tt>void*</tt> with the #az_ulib_ustream_data_cb, the
+ *                                      #az_ulib_ustream_multi_data_cb, or the #az_ulib_ustream_rope_node taken from a pool. It cannot be <tt>NULL</tt>.
+ */
+MOCKABLE_FUNCTION(, void, az_ulib_ustream_pool_release,
+        void*, release_pointer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_POOL_H */
@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_rope.h
+ *
+ * @brief ustream implementation for balanced ropes of ustreams
+ *
+ *  The az_ulib_ustream_concat() chains one #az_ulib_ustream_multi_data_cb for each concatenation, and the
+ *      az_ulib_ustream_split() only reduces the <tt>length</tt> of the instance, so a message that is split and
+ *      concatenated over and over (segmentation, retries, insertion of headers) grows a chain that each read needs to
+ *      walk. The rope keeps the composed ustreams in a balanced binary tree instead, where concat, split, slice and
+ *      index cost O(log n) on the number of leaves, and do not depend on how the rope was built.
+ *
+ *  Any ustream can be a leaf. The rope operations accept any ustream as input, a rope or not, and always
+ *      create a new rope ustream, without changing the inputs. The content of each input is the one that a clone
+ *      of it would expose: from its current position to its end. The ropes are immutable and share their nodes,
+ *      so the inputs and the results may be read and disposed in any order.
+ *
+ *  The nodes of the tree are taken from an #az_ulib_ustream_pool, and are returned to it when the last rope that
+ *      uses them is disposed. Each operation takes O(log n) nodes from the pool.
+ */
+
+#ifndef AZ_ULIB_USTREAM_ROPE_H
+#define AZ_ULIB_USTREAM_ROPE_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Factory to initialize a new rope ustream with the content of an existing ustream.
+ *
+ *  If <tt>ustream_to_wrap</tt> is a rope, the new rope shares its nodes. Otherwise, the new rope has one leaf with
+ *      a clone of <tt>ustream_to_wrap</tt>.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct that will receive the
+ *                                          rope. It cannot be <tt>NULL</tt>.
+ * @param[in]       pool                    The #az_ulib_ustream_pool* with the pool that provides the nodes. It cannot
+ *                                          be <tt>NULL</tt>.
+ * @param[in]       ustream_to_wrap         The #az_ulib_ustream* with the ustream to wrap. It cannot be <tt>NULL</tt>,
+ *                                          it shall be a valid ustream, and its remaining size cannot be zero. It is not
+ *                                          changed by this function.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there are not enough free blocks in the pool.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_rope_init,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream*, ustream_to_wrap);
+
+/**
+ * @brief   Create a rope with the content of a ustream followed by the content of another ustream.
+ *
+ *  The new rope shares the nodes of the inputs that are ropes, and rebalances only the path where they are joined,
+ *      so the cost is O(log n) on the number of leaves.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct that will receive the
+ *                                          rope. It cannot be <tt>NULL</tt>.
+ * @param[in]       pool                    The #az_ulib_ustream_pool* with the pool that provides the nodes. It cannot
+ *                                          be <tt>NULL</tt>.
+ * @param[in]       ustream_left            The #az_ulib_ustream* with the first part of the content. It cannot be
+ *                                          <tt>NULL</tt>, and it shall be a valid ustream. It is not changed by this function.
+ * @param[in]       ustream_right           The #az_ulib_ustream* with the second part of the content. It cannot be
+ *                                          <tt>NULL</tt>, and it shall be a valid ustream. It is not changed by this function.
+ *
+ * @return The #az_ulib_result with result of the concatenation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the rope is successfully created.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, or if both
+ *                                                              ustreams are empty.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there are not enough free blocks in the pool.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_rope_concat,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream*, ustream_left,
+        az_ulib_ustream*, ustream_right);
+
+/**
+ * @brief   Create two ropes with the content of a ustream before and after an offset.
+ *
+ *  Different from the az_ulib_ustream_split(), the <tt>ustream_to_split</tt> is not changed, and the cost is
+ *      O(log n) on the number of leaves, no matter how many times the content was split before.
+ *
+ * @param[in]       ustream_to_split        The #az_ulib_ustream* with the content to split. It cannot be <tt>NULL</tt>,
+ *                                          and it shall be a valid ustream. It is not changed by this function.
+ * @param[in]       pool                    The #az_ulib_ustream_pool* with the pool that provides the nodes. It cannot
+ *                                          be <tt>NULL</tt>.
+ * @param[in]       split_offset            The <tt>size_t</tt> with the offset of the split from the current position of
+ *                                          <tt>ustream_to_split</tt>. It shall be bigger than zero and smaller than the
+ *                                          remaining size, so none of the ropes is empty.
+ * @param[out]      ustream_left            The pointer to the allocated #az_ulib_ustream struct that will receive the
+ *                                          rope with the content before <tt>split_offset</tt>. It cannot be <tt>NULL</tt>.
+ * @param[out]      ustream_right           The pointer to the allocated #az_ulib_ustream struct that will receive the
+ *                                          rope with the content from <tt>split_offset</tt>. It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with result of the split.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the ropes are successfully created.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there are not enough free blocks in the pool.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_rope_split,
+        az_ulib_ustream*, ustream_to_split,
+        az_ulib_ustream_pool*, pool,
+        size_t, split_offset,
+        az_ulib_ustream*, ustream_left,
+        az_ulib_ustream*, ustream_right);
+
+/**
+ * @brief   Create a rope with part of the content of a ustream.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct that will receive the
+ *                                          rope. It cannot be <tt>NULL</tt>.
+ * @param[in]       pool                    The #az_ulib_ustream_pool* with the pool that provides the nodes. It cannot
+ *                                          be <tt>NULL</tt>.
+ * @param[in]       ustream_to_slice        The #az_ulib_ustream* with the content to slice. It cannot be <tt>NULL</tt>,
+ *                                          and it shall be a valid ustream. It is not changed by this function.
+ * @param[in]       offset                  The <tt>size_t</tt> with the offset of the slice from the current position of
+ *                                          <tt>ustream_to_slice</tt>.
+ * @param[in]       length                  The <tt>size_t</tt> with the number of bytes in the slice. It shall be bigger
+ *                                          than zero, and the slice shall fit in the remaining size of
+ *                                          <tt>ustream_to_slice</tt>.
+ *
+ * @return The #az_ulib_result with result of the slice.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the rope is successfully created.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_OUT_OF_MEMORY_ERROR        If there are not enough free blocks in the pool.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_rope_slice,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_pool*, pool,
+        az_ulib_ustream*, ustream_to_slice,
+        size_t, offset,
+        size_t, length);
+
+/**
+ * @brief   Get one byte of a rope.
+ *
+ *  The byte is found by a descent from the root of the rope to the leaf that contains it, so the cost is
+ *      O(log n) on the number of leaves. The current position of the rope is not changed.
+ *
+ * @param[in]       ustream_instance        The #az_ulib_ustream* with the rope. It cannot be <tt>NULL</tt>, and it shall
+ *                                          be a rope ustream.
+ * @param[in]       offset                  The <tt>size_t</tt> with the offset of the byte from the current position of
+ *                                          <tt>ustream_instance</tt>.
+ * @param[out]      value                   The <tt>uint8_t* const</tt> that will receive the byte. It cannot be
+ *                                          <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with result of the index.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the byte is returned with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ *          @retval     #AZ_ULIB_NO_SUCH_ELEMENT_ERROR      If the offset is not smaller than the remaining size.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the leaf failed to read the byte.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_rope_index,
+        az_ulib_ustream*, ustream_instance,
+        size_t, offset,
+        uint8_t* const, value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_ROPE_H */
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_sha256.h
+ *
+ * @brief Incremental SHA-256 over buffers and ustreams
+ *
+ *  The SHA-256 digest is calculated incrementally. The az_ulib_sha256_init() starts a new digest, each
+ *      az_ulib_sha256_update() or az_ulib_ustream_sha256_update() adds more content to it, and the
+ *      az_ulib_sha256_final() returns the digest. The content of a ustream is hashed directly from the spans
+ *      exposed by az_ulib_ustream_peek(), so multi-segment ustreams are hashed without being flattened.
+ *
+ *  On processors that support it, the digest uses the x86 SHA extensions (SHA-NI), selected in runtime.
+ *      See #AZ_ULIB_CONFIG_SIMD.
+ */
+
+#ifndef AZ_ULIB_USTREAM_SHA256_H
+#define AZ_ULIB_USTREAM_SHA256_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_result.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Number of bytes in a SHA-256 digest.
+ */
+#define AZ_ULIB_SHA256_DIGEST_SIZE      32
+
+/**
+ * @brief   Number of bytes in a SHA-256 block.
+ */
+#define AZ_ULIB_SHA256_BLOCK_SIZE       64
+
+/**
+ * @brief   Signature of the function that adds complete blocks to the SHA-256 state.
+ */
+typedef void (*az_ulib_sha256_transform)(uint32_t* state, const uint8_t* blocks, size_t block_count);
+
+/**
+ * @brief   Structure to keep track of an incremental SHA-256 digest.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the SHA-256. Users should therefore not
+ *       act on it directly and only allocate the memory necessary for it to be passed to the SHA-256.
+ */
+typedef struct az_ulib_sha256_context_tag
+{
+    uint32_t state[8];                              /**<The <tt>uint32_t</tt> array with the hash state */
+    uint64_t length;                                /**<The <tt>uint64_t</tt> with the number of bytes added to the digest */
+    uint8_t buffer[AZ_ULIB_SHA256_BLOCK_SIZE];      /**<The <tt>uint8_t</tt> array with the content of an incomplete block */
+    size_t buffer_length;                           /**<The <tt>size_t</tt> with the number of bytes in the <tt>buffer</tt> */
+    az_ulib_sha256_transform transform;             /**<The #az_ulib_sha256_transform selected for the processor */
+} az_ulib_sha256_context;
+
+/**
+ * @brief   Start a new SHA-256 digest.
+ *
+ * @param[out]      context         The #az_ulib_sha256_context* to initialize. It cannot be <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the context is initialized with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_sha256_init,
+        az_ulib_sha256_context*, context);
+
+/**
+ * @brief   Add the content of a buffer to the SHA-256 digest.
+ *
+ * @param[in,out]   context         The #az_ulib_sha256_context* with the digest. It cannot be <tt>NULL</tt>, and it shall
+ *                                  be initialized by az_ulib_sha256_init().
+ * @param[in]       buffer          The <tt>const uint8_t* const</tt> with the content to add. It can be <tt>NULL</tt> only
+ *                                  if the <tt>size</tt> is zero.
+ * @param[in]       size            The <tt>size_t</tt> with the number of bytes in the <tt>buffer</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the content is added with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_sha256_update,
+        az_ulib_sha256_context*, context,
+        const uint8_t* const, buffer,
+        size_t, size);
+
+/**
+ * @brief   Add the content of a ustream to the SHA-256 digest.
+ *
+ *  The content of the ustream from the current position up to the end of the ustream is added to the digest. The
+ *      content of the ustreams that support az_ulib_ustream_peek(), including each ustream in a concatenation, is
+ *      hashed in place, without any copy. The other ones are read through a local buffer of
+ *      #AZ_ULIB_CONFIG_USTREAM_CHECKSUM_BUFFER_SIZE bytes.
+ *
+ *  The current position of the ustream is not changed, so the same ustream can be consumed after the digest.
+ *
+ * @param[in,out]   context             The #az_ulib_sha256_context* with the digest. It cannot be <tt>NULL</tt>, and it
+ *                                      shall be initialized by az_ulib_sha256_init().
+ * @param[in]       ustream_instance    The #az_ulib_ustream* with the interface of the ustream. It cannot be <tt>NULL</tt>,
+ *                                      and it shall be a valid ustream.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the content is added with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_sha256_update,
+        az_ulib_sha256_context*, context,
+        az_ulib_ustream*, ustream_instance);
+
+/**
+ * @brief   Finish the SHA-256 digest.
+ *
+ *  After the final, the context shall be initialized again by az_ulib_sha256_init() to start a new digest.
+ *
+ * @param[in,out]   context         The #az_ulib_sha256_context* with the digest. It cannot be <tt>NULL</tt>, and it shall
+ *                                  be initialized by az_ulib_sha256_init().
+ * @param[out]      digest          The <tt>uint8_t* const</tt> that points to the buffer with
+ *                                  #AZ_ULIB_SHA256_DIGEST_SIZE bytes that will receive the digest. It cannot be
+ *                                  <tt>NULL</tt>.
+ *
+ * @return The #az_ulib_result with the result of the operation.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the digest is returned with success.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_sha256_final,
+        az_ulib_sha256_context*, context,
+        uint8_t* const, digest);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_SHA256_H */
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_uring.h
+ *
+ * @brief ustream implementation for files read through io_uring
+ *
+ *  This ustream exposes the content of a file, reading it in chunks of #AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE
+ *      bytes submitted to the Linux io_uring. When the consumer reads a chunk, the ustream also submits the reads
+ *      for the next <tt>read_ahead</tt> chunks, so the I/O latency of the storage overlaps with the processing of
+ *      the current chunk instead of being serialized in the consumer loop.
+ *
+ *  The chunks live in a fixed set of buffers inside the #az_ulib_ustream_uring_data_cb, shared by all the instances
+ *      of the ustream. The az_ulib_ustream_release() uses the release watermark (the first valid position) to
+ *      drop the chunks that the consumer does not need anymore, making their buffers available for the next reads.
+ *      Because the buffers are recycled, this ustream cannot expose its content without a copy, and the
+ *      az_ulib_ustream_peek() returns #AZ_ULIB_NOT_SUPPORTED_ERROR.
+ *
+ *  The az_ulib_ustream_hint() adjusts the buffer management for all the instances: #AZ_ULIB_USTREAM_HINT_SEQUENTIAL
+ *      reads ahead as many chunks as the queue depth allows, #AZ_ULIB_USTREAM_HINT_RANDOM disables the read-ahead,
+ *      #AZ_ULIB_USTREAM_HINT_WILL_NEED submits the reads for the chunks of the range that fit in the free buffers,
+ *      and #AZ_ULIB_USTREAM_HINT_DONE drops the chunks fully inside the range. The hint is also passed to the system
+ *      as <tt>posix_fadvise</tt> on the file.
+ *
+ *  This implementation is only available on Linux. If the system does not support io_uring, the ustream falls
+ *      back to synchronous reads with the same buffer management.
+ */
+
+#ifndef AZ_ULIB_USTREAM_URING_H
+#define AZ_ULIB_USTREAM_URING_H
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_config.h"
+#include "az_ulib_pal_os.h"
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif /* __cplusplus */
+
+/**
+ * @brief   Structure to keep track of one chunk of the file.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream.
+ */
+typedef struct az_ulib_ustream_uring_chunk_tag
+{
+    offset_t position;                              /**<The #offset_t with the position of the chunk in the file */
+    size_t length;                                  /**<The <tt>size_t</tt> with the number of bytes in the chunk */
+    size_t filled;                                  /**<The <tt>size_t</tt> with the number of bytes already read */
+    int state;                                      /**<The <tt>int</tt> with the state of the chunk buffer */
+} az_ulib_ustream_uring_chunk;
+
+/**
+ * @brief   Structure with the io_uring mapped in the process.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream.
+ */
+typedef struct az_ulib_ustream_uring_ring_tag
+{
+    int ring_fd;                                    /**<The <tt>int</tt> with the io_uring descriptor, or <tt>-1</tt> if
+                                                            the ustream is using synchronous reads */
+    void* sq_ring;                                  /**<The <tt>void*</tt> with the mapped submission queue ring */
+    size_t sq_ring_size;                            /**<The <tt>size_t</tt> with the size of the submission queue ring */
+    void* cq_ring;                                  /**<The <tt>void*</tt> with the mapped completion queue ring */
+    size_t cq_ring_size;                            /**<The <tt>size_t</tt> with the size of the completion queue ring */
+    void* sqes;                                     /**<The <tt>void*</tt> with the mapped submission queue entries */
+    size_t sqes_size;                               /**<The <tt>size_t</tt> with the size of the submission queue entries */
+    unsigned* sq_tail;                              /**<The <tt>unsigned*</tt> with the tail of the submission queue */
+    unsigned* sq_mask;                              /**<The <tt>unsigned*</tt> with the mask of the submission queue */
+    unsigned* sq_array;                             /**<The <tt>unsigned*</tt> with the index array of the submission queue */
+    unsigned* cq_head;                              /**<The <tt>unsigned*</tt> with the head of the completion queue */
+    unsigned* cq_tail;                              /**<The <tt>unsigned*</tt> with the tail of the completion queue */
+    unsigned* cq_mask;                              /**<The <tt>unsigned*</tt> with the mask of the completion queue */
+    void* cqes;                                     /**<The <tt>void*</tt> with the completion queue entries */
+} az_ulib_ustream_uring_ring;
+
+/**
+ * @brief   Structure to keep track of a file read through io_uring.
+ *
+ * @note This structure should be viewed and used as internal to the implementation of the ustream. Users should therefore not act on
+ *       it directly and only allocate the memory necessary for it to be passed to the ustream. The structure contains
+ *       #AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH buffers of #AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE bytes, so it is
+ *       usually allocated in the HEAP.
+ */
+typedef struct az_ulib_ustream_uring_data_cb_tag
+{
+    az_ulib_ustream_data_cb control_block;          /**<The #az_ulib_ustream_data_cb to manage the uring data structure */
+    int file_descriptor;                            /**<The <tt>int</tt> with the descriptor of the file */
+    size_t file_size;                               /**<The <tt>size_t</tt> with the size of the file */
+    size_t queue_depth;                             /**<The <tt>size_t</tt> with the number of chunk buffers in use */
+    size_t read_ahead;                              /**<The <tt>size_t</tt> with the number of chunks to read ahead, changed
+                                                            by the access pattern hints */
+    az_ulib_ustream_uring_ring ring;                /**<The #az_ulib_ustream_uring_ring with the io_uring */
+    az_ulib_ustream_uring_chunk chunks[AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH]; /**<The table with the chunk
+                                                                                            in each buffer */
+    az_ulib_pal_os_lock lock;                       /**<The #az_ulib_pal_os_lock with controls the critical section
+                                                            of the io_uring and the chunk table */
+    uint8_t buffers[AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH][AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE]; /**<The chunk
+                                                                                            buffers */
+} az_ulib_ustream_uring_data_cb;
+
+/**
+ * @brief   Factory to initialize a new ustream with the content of a file read through io_uring.
+ *
+ *  This factory opens the file <tt>file_name</tt> for read, creates an io_uring with <tt>queue_depth</tt>
+ *      entries, and initializes a ustream that exposes the content of the file. No read is submitted during the
+ *      initialization. The file shall not be changed while there is an instance of the ustream.
+ *
+ * @param[out]      ustream_instance        The pointer to the allocated #az_ulib_ustream struct. This memory must be valid from
+ *                                          the time az_ulib_ustream_uring_init() is called through az_ulib_ustream_dispose(). The ustream will not
+ *                                          free this struct and it is the responsibility of the developer to make sure it is valid during
+ *                                          the time frame described above. It cannot be <tt>NULL</tt>.
+ * @param[in]       uring_data              The #az_ulib_ustream_uring_data_cb* pointing to the allocated uring data control block.
+ *                                          It must be allocated in a way that it remains a valid address until the passed
+ *                                          <tt>uring_data_release</tt> is invoked some time in the future. It cannot be <tt>NULL</tt>.
+ * @param[in]       uring_data_release      The #az_ulib_release_callback callback which will be called once
+ *                                          the number of references to the control block reaches zero, after the io_uring and
+ *                                          the file are closed. It may be <tt>NULL</tt> if no future cleanup is needed.
+ * @param[in]       file_name               The <tt>const char* const</tt> with the name of the file to expose. It cannot be
+ *                                          <tt>NULL</tt>, and the file shall not be empty. The file may be
+ *                                          bigger than 4GB, up to #AZ_ULIB_OFFSET_MAX bytes.
+ * @param[in]       queue_depth             The <tt>size_t</tt> with the number of chunk buffers, and maximum number of reads in
+ *                                          flight. It shall be bigger than zero and not bigger than
+ *                                          #AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH.
+ * @param[in]       read_ahead              The <tt>size_t</tt> with the number of chunks after the current one that the ustream
+ *                                          shall request from the file. It shall be smaller than <tt>queue_depth</tt>. Zero
+ *                                          disables the read-ahead.
+ *
+ * @return The #az_ulib_result with result of the initialization.
+ *          @retval     #AZ_ULIB_SUCCESS                    If the #az_ulib_ustream* is successfully initialized.
+ *          @retval     #AZ_ULIB_ILLEGAL_ARGUMENT_ERROR     If one of the provided parameters is invalid, or the file is empty
+ *                                                              or bigger than #AZ_ULIB_OFFSET_MAX.
+ *          @retval     #AZ_ULIB_NO_SUCH_ELEMENT_ERROR      If the file cannot be opened.
+ *          @retval     #AZ_ULIB_SYSTEM_ERROR               If the system failed to get the information about the file.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, az_ulib_ustream_uring_init,
+        az_ulib_ustream*, ustream_instance,
+        az_ulib_ustream_uring_data_cb*, uring_data,
+        az_ulib_release_callback, uring_data_release,
+        const char* const, file_name,
+        size_t, queue_depth,
+        size_t, read_ahead);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* AZ_ULIB_USTREAM_URING_H */
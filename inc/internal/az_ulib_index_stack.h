@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#ifndef INTERNAL_AZ_ULIB_INDEX_STACK_H
+#define INTERNAL_AZ_ULIB_INDEX_STACK_H
+
+#include "az_ulib_port.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+extern "C" {
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/*
+ * Lock-free stack (Treiber stack) of the elements of an array, used as the free list of the fixed-size pools.
+ *  Each element has a <tt>volatile uint32_t</tt> with the index + 1 of the next element in the stack, and
+ *  0 ends the stack. The head of the stack is a single 32 bits word with the index + 1 of the first element in
+ *  the 16 less significant bits, and a tag in the 16 most significant bits. Every change in the head increments
+ *  the tag, so a thread that read the head before another thread popped and pushed back the same element fails
+ *  the compare-and-swap instead of corrupting the stack (ABA problem). The index has 16 bits, so the array cannot
+ *  have more than 0xFFFF elements.
+ *
+ * The elements are identified by their index + 1, and the next of each one is found in the array by the size of
+ *  the elements and the offset of the next field in them, so any array of structs can be in a stack.
+ */
+#define _AZ_ULIB_INDEX_STACK_INDEX_MASK         ((uint32_t)0x0000FFFF)
+#define _AZ_ULIB_INDEX_STACK_TAG_MASK           ((uint32_t)0xFFFF0000)
+#define _AZ_ULIB_INDEX_STACK_TAG_INCREMENT      ((uint32_t)0x00010000)
+
+static inline volatile uint32_t* _az_ulib_index_stack_next(
+    void* elements,
+    size_t element_size,
+    size_t next_offset,
+    uint32_t index)
+{
+    return (volatile uint32_t*)((uint8_t*)elements + ((size_t)(index - 1) * element_size) + next_offset);
+}
+
+static inline uint32_t _az_ulib_index_stack_next_head(uint32_t head, uint32_t index)
+{
+    return ((head + _AZ_ULIB_INDEX_STACK_TAG_INCREMENT) & _AZ_ULIB_INDEX_STACK_TAG_MASK) | index;
+}
+
+/* Pop the first element of the stack. Returns its index + 1, or 0 if the stack is empty. */
+static inline uint32_t _az_ulib_index_stack_pop(
+    volatile uint32_t* head,
+    void* elements,
+    size_t element_size,
+    size_t next_offset)
+{
+    uint32_t current_head;
+    uint32_t index;
+
+    do
+    {
+        current_head = *head;
+        index = current_head & _AZ_ULIB_INDEX_STACK_INDEX_MASK;
+        if(index == 0)
+        {
+            return 0;
+        }
+        /* If another thread took this element in the meantime, the next may be garbage, but the tag changed. */
+    } while(AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(head, current_head,
+                _az_ulib_index_stack_next_head(current_head,
+                    *_az_ulib_index_stack_next(elements, element_size, next_offset, index))) != current_head);
+
+    return index;
+}
+
+/* Push the element with the provided index + 1 in the top of the stack. */
+static inline void _az_ulib_index_stack_push(
+    volatile uint32_t* head,
+    void* elements,
+    size_t element_size,
+    size_t next_offset,
+    uint32_t index)
+{
+    volatile uint32_t* next = _az_ulib_index_stack_next(elements, element_size, next_offset, index);
+    uint32_t current_head;
+
+    do
+    {
+        current_head = *head;
+        *next = current_head & _AZ_ULIB_INDEX_STACK_INDEX_MASK;
+    } while(AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(head, current_head,
+                _az_ulib_index_stack_next_head(current_head, index)) != current_head);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INTERNAL_AZ_ULIB_INDEX_STACK_H */
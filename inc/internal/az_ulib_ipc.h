@@ -26,18 +26,79 @@ extern "C" {
 
 typedef void* _az_ulib_ipc_interface_handle;
 
-typedef struct _az_ulib_ipc_interface_tag {
-  volatile const az_ulib_interface_descriptor* interface_descriptor;
-  volatile long ref_count;
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+/*
+ * The growable name index is replaced by a bigger one while readers may be walking it, so each
+ * interface has one link for the current index, and one to build the next one.
+ */
+#define _AZ_ULIB_IPC_NAME_INDEX_LINKS 2
+#define _AZ_ULIB_IPC_MAX_INSTANCES UINT32_MAX
+#else
+#define _AZ_ULIB_IPC_NAME_INDEX_LINKS 1
+#define _AZ_ULIB_IPC_MAX_INSTANCES AZ_ULIB_CONFIG_MAX_IPC_INSTANCES
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
+
+#if defined(AZ_ULIB_CONFIG_IPC_UNPUBLISH) || defined(AZ_ULIB_CONFIG_IPC_GROWABLE)
+#define _AZ_ULIB_IPC_READER_EPOCH
+#endif
+
 #ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+/*
+ * Each thread counts its calls in one shard. With more than one shard, each shard fills a cache
+ * line, so threads on different cores calling the same interface don't share the line.
+ */
+typedef struct _az_ulib_ipc_call_shard_tag {
   volatile long running_count;
   volatile long running_count_low_watermark;
+#if AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+  uint8_t padding[AZ_ULIB_CONFIG_CACHE_LINE_SIZE - (2 * sizeof(long))];
+#endif // AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+} _az_ulib_ipc_call_shard;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+typedef struct _az_ulib_ipc_interface_tag {
+  volatile const az_ulib_interface_descriptor* interface_descriptor;
+  volatile uint32_t ref_count;
+  const char* volatile name;
+  volatile uint32_t name_hash;
+  struct _az_ulib_ipc_interface_tag* volatile next_name[_AZ_ULIB_IPC_NAME_INDEX_LINKS];
+  struct _az_ulib_ipc_interface_tag* volatile next_version;
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  volatile const az_ulib_interface_descriptor* unpublishing_descriptor;
+#if AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+  uint8_t padding[AZ_ULIB_CONFIG_CACHE_LINE_SIZE];
+#endif // AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+  _az_ulib_ipc_call_shard call_shard[AZ_ULIB_CONFIG_IPC_CALL_SHARDS];
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
 } _az_ulib_ipc_interface;
 
+typedef struct _az_ulib_ipc_name_index_tag {
+  _az_ulib_ipc_interface* volatile* bucket;
+  uint32_t size;
+  uint32_t link;
+  uint32_t name_count;
+} _az_ulib_ipc_name_index;
+
 typedef struct _az_ulib_ipc_tag {
   az_ulib_pal_os_lock lock;
+  uint32_t interface_count;
+  uint32_t unpublished_count;
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+  _az_ulib_ipc_interface* segment_list[AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS];
+#else
   _az_ulib_ipc_interface interface_list[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
+  _az_ulib_ipc_name_index static_name_index;
+  _az_ulib_ipc_interface* volatile static_name_index_bucket[AZ_ULIB_CONFIG_IPC_NAME_INDEX_SIZE];
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
+  _az_ulib_ipc_name_index* volatile name_index;
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  az_ulib_pal_os_lock drain_lock;
+  az_ulib_pal_os_condition drain_condition;
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#ifdef _AZ_ULIB_IPC_READER_EPOCH
+  volatile uint32_t reader_epoch;
+  volatile uint32_t reader_count[2];
+#endif // _AZ_ULIB_IPC_READER_EPOCH
 } _az_ulib_ipc;
 
 MOCKABLE_FUNCTION(, az_ulib_result, _az_ulib_ipc_init_no_contract, _az_ulib_ipc*, ipc_handle);
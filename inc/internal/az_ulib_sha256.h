@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#ifndef INTERNAL_AZ_ULIB_SHA256_H
+#define INTERNAL_AZ_ULIB_SHA256_H
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#include "az_ulib_ustream_sha256.h"
+#include "az_ulib_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Start a new SHA-256 digest that only uses the portable transform, even if the processor supports the SHA
+ *  extensions. Used to compare both implementations.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, _az_ulib_sha256_init_portable, az_ulib_sha256_context*, context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INTERNAL_AZ_ULIB_SHA256_H */
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#ifndef INTERNAL_AZ_ULIB_USTREAM_AUX_H
+#define INTERNAL_AZ_ULIB_USTREAM_AUX_H
+
+#include "azure_macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_result.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/*
+ * Copy the content of an inner ustream of a composed ustream, starting at the provided logical position. The
+ *  read_at does not change the inner ustream, so the instances that share it do not need to be serialized.
+ *  Only the inner ustreams that do not support read_at fall back to the set_position and read, holding the
+ *  provided lock between them.
+ */
+MOCKABLE_FUNCTION(, az_ulib_result, _az_ulib_ustream_read_inner,
+        az_ulib_pal_os_lock*, lock,
+        az_ulib_ustream*, inner_ustream,
+        offset_t, position,
+        uint8_t* const, buffer,
+        size_t, buffer_length,
+        size_t* const, size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INTERNAL_AZ_ULIB_USTREAM_AUX_H */
@@ -86,6 +86,29 @@ __attribute__((always_inline)) static inline void* AZ_ULIB_PORT_ATOMIC_EXCHANGE_
   return result;
 }
 
+__attribute__((always_inline)) static inline uint32_t AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(
+    volatile uint32_t* addr,
+    uint32_t expected,
+    uint32_t val) {
+  register uint32_t prev;
+  register uint32_t result;
+
+  __asm volatile("1:     ldrex   %0, [%2]                \n"
+                 "       cmp     %0, %3                  \n"
+                 "       bne     2f                      \n"
+                 "       strex   %1, %4, [%2]            \n"
+                 "       cmp     %1, #0                  \n"
+                 "       bne     1b                      \n"
+                 "       b       3f                      \n"
+                 "2:     clrex                           \n"
+                 "3:                                     "
+                 : "=&r"(prev), "=&r"(result)
+                 : "r"(addr), "r"(expected), "r"(val)
+                 : "cc", "memory");
+
+  return prev;
+}
+
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
 #ifdef __cplusplus
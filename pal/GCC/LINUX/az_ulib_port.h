@@ -53,6 +53,16 @@ static inline uint32_t AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(volatile void** addr, vo
   *addr = val;
   return prev;
 }
+static inline uint32_t AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(
+    volatile uint32_t* addr,
+    uint32_t expected,
+    uint32_t val) {
+  uint32_t prev = *addr;
+  if (prev == expected) {
+    *addr = val;
+  }
+  return prev;
+}
 
 #elif defined(AZURE_ULIB_C_USE_STD_ATOMIC)
 #ifndef __cplusplus
@@ -68,6 +78,13 @@ static inline uint32_t AZ_ULIB_PORT_ATOMIC_DEC_W(volatile uint32_t* addr) {
 }
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(target, value) atomic_exchange((target), (value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) atomic_exchange((target), (value))
+static inline uint32_t AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(
+    volatile uint32_t* addr,
+    uint32_t expected,
+    uint32_t val) {
+  (void)atomic_compare_exchange_strong(addr, &expected, val);
+  return expected;
+}
 
 #elif defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)
 #define AZ_ULIB_PORT_ATOMIC_INC_W(count) __sync_add_and_fetch((count), 1)
@@ -76,9 +93,14 @@ static inline uint32_t AZ_ULIB_PORT_ATOMIC_DEC_W(volatile uint32_t* addr) {
   __sync_val_compare_and_swap((target), *(target), (value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
   __sync_val_compare_and_swap((target), *(target), (value))
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(target, expected, value) \
+  __sync_val_compare_and_swap((target), (expected), (value))
 
 #endif /*defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)*/
 
+/*storage class of the variables with one instance per thread*/
+#define AZ_ULIB_PORT_THREAD_LOCAL __thread
+
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
 #ifdef __cplusplus
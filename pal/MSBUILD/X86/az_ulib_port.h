@@ -13,6 +13,11 @@
   InterlockedExchange((volatile LONG*)(target), (LONG)(value))
 #define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
   InterlockedExchangePointer((volatile PVOID*)(target), (PVOID)(value))
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(target, expected, value) \
+  InterlockedCompareExchange((volatile LONG*)(target), (LONG)(value), (LONG)(expected))
+
+/*storage class of the variables with one instance per thread*/
+#define AZ_ULIB_PORT_THREAD_LOCAL __declspec(thread)
 
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
@@ -15,6 +15,7 @@
 #include "az_ulib_pal_os.h"
 
 #ifndef __cplusplus
+#include <stdbool.h>
 #include <stdint.h>
 #else
 #include <cstdint>
@@ -58,6 +59,89 @@ MOCKABLE_FUNCTION(, void, az_pal_os_lock_release, az_ulib_pal_os_lock*, lock);
  */
 MOCKABLE_FUNCTION(, void, az_pal_os_sleep, uint32_t, sleep_time_ms);
 
+/**
+ * @brief   Get the number of milliseconds since an arbitrary point in the past.
+ *
+ *  The time is monotonic, so it is not affected by changes in the wall clock. It wraps around after
+ *  `UINT32_MAX` milliseconds, so the elapsed time between two calls is the difference between them in
+ *  `uint32_t`.
+ *
+ * @return The `uint32_t` with the current time in milliseconds.
+ */
+MOCKABLE_FUNCTION(, uint32_t, az_pal_os_get_time_ms);
+
+/**
+ * @brief   This API initialize a condition variable.
+ *
+ * @param[in,out]   condition   The #az_ulib_pal_os_condition* that points to the condition variable.
+ */
+MOCKABLE_FUNCTION(, void, az_pal_os_condition_init, az_ulib_pal_os_condition*, condition);
+
+/**
+ * @brief   The condition variable is destroyed.
+ *
+ * @param[in]       condition   The #az_ulib_pal_os_condition* that points to a valid condition variable.
+ */
+MOCKABLE_FUNCTION(, void, az_pal_os_condition_deinit, az_ulib_pal_os_condition*, condition);
+
+/**
+ * @brief   Atomically releases the lock and blocks the caller until the condition variable is notified, then
+ *          acquires the lock again before returning.
+ *
+ *  The caller shall hold the lock. The wait may return without a notification, so the caller shall check its
+ *      predicate again in a loop.
+ *
+ * @param[in]       condition   The #az_ulib_pal_os_condition* that points to a valid condition variable.
+ * @param[in]       lock        The #az_ulib_pal_os_lock* that points to the lock held by the caller.
+ */
+MOCKABLE_FUNCTION(, void, az_pal_os_condition_wait, az_ulib_pal_os_condition*, condition, az_ulib_pal_os_lock*, lock);
+
+/**
+ * @brief   Same as az_pal_os_condition_wait(), but gives up the wait after some milliseconds.
+ *
+ *  The caller shall hold the lock, and it holds the lock again when this API returns, even if the time expired.
+ *
+ * @param[in]       condition       The #az_ulib_pal_os_condition* that points to a valid condition variable.
+ * @param[in]       lock            The #az_ulib_pal_os_lock* that points to the lock held by the caller.
+ * @param[in]       wait_time_ms    The `uint32_t` with the maximum number of milliseconds to wait.
+ *
+ * @return `false` if the time expired without a notification, or `true` otherwise.
+ */
+MOCKABLE_FUNCTION(, bool, az_pal_os_condition_timed_wait, az_ulib_pal_os_condition*, condition, az_ulib_pal_os_lock*, lock, uint32_t, wait_time_ms);
+
+/**
+ * @brief   Wakes up all the threads waiting on the condition variable.
+ *
+ * @param[in]       condition   The #az_ulib_pal_os_condition* that points to a valid condition variable.
+ */
+MOCKABLE_FUNCTION(, void, az_pal_os_condition_notify_all, az_ulib_pal_os_condition*, condition);
+
+/**
+ * @brief   Signature of the function that runs in a thread created by az_pal_os_thread_create().
+ *
+ * @param[in]       arg         The `void*` provided in the az_pal_os_thread_create().
+ */
+typedef void (*az_ulib_pal_os_thread_function)(void* arg);
+
+/**
+ * @brief   Creates a new thread that runs the provided function.
+ *
+ * @param[out]      thread      The #az_ulib_pal_os_thread* that points to the thread handle. It shall remain valid
+ *                              until the az_pal_os_thread_join() returns.
+ * @param[in]       function    The #az_ulib_pal_os_thread_function that the new thread will run.
+ * @param[in]       arg         The `void*` that will be passed to the <tt>function</tt>.
+ *
+ * @return `true` if the thread was created, `false` otherwise.
+ */
+MOCKABLE_FUNCTION(, bool, az_pal_os_thread_create, az_ulib_pal_os_thread*, thread, az_ulib_pal_os_thread_function, function, void*, arg);
+
+/**
+ * @brief   Waits for the end of a thread, and release its resources.
+ *
+ * @param[in]       thread      The #az_ulib_pal_os_thread* that points to the thread handle.
+ */
+MOCKABLE_FUNCTION(, void, az_pal_os_thread_join, az_ulib_pal_os_thread*, thread);
+
 #ifdef __cplusplus
 }
 #endif
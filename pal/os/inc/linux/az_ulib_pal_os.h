@@ -18,6 +18,25 @@ extern "C" {
  */
 typedef pthread_mutex_t az_ulib_pal_os_lock;
 
+/*
+ *  @struct az_ulib_pal_os_condition
+ *
+ *  @brief  platform specific struct for a condition variable implementation
+ */
+typedef pthread_cond_t az_ulib_pal_os_condition;
+
+/*
+ *  @struct az_ulib_pal_os_thread
+ *
+ *  @brief  platform specific struct for a thread implementation
+ */
+typedef struct az_ulib_pal_os_thread_tag
+{
+    pthread_t handle;
+    void (*function)(void*);
+    void* arg;
+} az_ulib_pal_os_thread;
+
 #ifdef __cplusplus
 }
 #endif
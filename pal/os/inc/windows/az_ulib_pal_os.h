@@ -18,6 +18,25 @@ extern "C" {
  */
 typedef SRWLOCK az_ulib_pal_os_lock;
 
+/*
+ *  @struct az_ulib_pal_os_condition
+ *
+ *  @brief  platform specific struct for a condition variable implementation
+ */
+typedef CONDITION_VARIABLE az_ulib_pal_os_condition;
+
+/*
+ *  @struct az_ulib_pal_os_thread
+ *
+ *  @brief  platform specific struct for a thread implementation
+ */
+typedef struct az_ulib_pal_os_thread_tag
+{
+    HANDLE handle;
+    void (*function)(void*);
+    void* arg;
+} az_ulib_pal_os_thread;
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,10 +2,12 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+#include <errno.h>
 #include <pthread.h>
 #include <time.h>
 
 #ifdef TI_RTOS
+#include <ti/sysbios/knl/Clock.h>
 #include <ti/sysbios/knl/Task.h>
 #else
 #include <unistd.h>
@@ -32,3 +34,69 @@ void az_pal_os_sleep(uint32_t sleep_time_ms) {
   (void)nanosleep(&time_to_sleep, NULL);
 #endif
 }
+
+uint32_t az_pal_os_get_time_ms(void) {
+#ifdef TI_RTOS
+  /* Clock_tickPeriod is the tick period in microseconds. */
+  return (uint32_t)(((uint64_t)Clock_getTicks() * Clock_tickPeriod) / 1000);
+#else
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)(((uint64_t)now.tv_sec * 1000) + ((uint64_t)now.tv_nsec / 1000000));
+#endif
+}
+
+void az_pal_os_condition_init(az_ulib_pal_os_condition* condition) {
+#ifdef __APPLE__
+  /* There is no pthread_condattr_setclock in macOS, the timed wait uses a relative timeout instead. */
+  pthread_cond_init((pthread_cond_t*)condition, NULL);
+#else
+  /* The timed wait measures the timeout in the monotonic clock, so changes in the wall clock do not change it. */
+  pthread_condattr_t attr;
+  (void)pthread_condattr_init(&attr);
+  (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init((pthread_cond_t*)condition, &attr);
+  (void)pthread_condattr_destroy(&attr);
+#endif
+}
+
+void az_pal_os_condition_deinit(az_ulib_pal_os_condition* condition) { pthread_cond_destroy((pthread_cond_t*)condition); }
+
+void az_pal_os_condition_wait(az_ulib_pal_os_condition* condition, az_ulib_pal_os_lock* lock) {
+  pthread_cond_wait((pthread_cond_t*)condition, (pthread_mutex_t*)lock);
+}
+
+bool az_pal_os_condition_timed_wait(az_ulib_pal_os_condition* condition, az_ulib_pal_os_lock* lock, uint32_t wait_time_ms) {
+#ifdef __APPLE__
+  struct timespec timeout = { (time_t)(wait_time_ms / 1000), (long)(wait_time_ms % 1000) * 1000000L };
+  return (pthread_cond_timedwait_relative_np((pthread_cond_t*)condition, (pthread_mutex_t*)lock, &timeout) != ETIMEDOUT);
+#else
+  struct timespec deadline;
+  (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += (time_t)(wait_time_ms / 1000);
+  deadline.tv_nsec += (long)(wait_time_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return (pthread_cond_timedwait((pthread_cond_t*)condition, (pthread_mutex_t*)lock, &deadline) != ETIMEDOUT);
+#endif
+}
+
+void az_pal_os_condition_notify_all(az_ulib_pal_os_condition* condition) {
+  pthread_cond_broadcast((pthread_cond_t*)condition);
+}
+
+static void* thread_wrapper(void* arg) {
+  az_ulib_pal_os_thread* thread = (az_ulib_pal_os_thread*)arg;
+  thread->function(thread->arg);
+  return NULL;
+}
+
+bool az_pal_os_thread_create(az_ulib_pal_os_thread* thread, az_ulib_pal_os_thread_function function, void* arg) {
+  thread->function = function;
+  thread->arg = arg;
+  return (pthread_create(&(thread->handle), NULL, thread_wrapper, thread) == 0);
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread) { (void)pthread_join(thread->handle, NULL); }
@@ -16,3 +16,39 @@ void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock) { AcquireSRWLockExclusive
 void az_pal_os_lock_release(az_ulib_pal_os_lock* lock) { ReleaseSRWLockExclusive((SRWLOCK*)lock); }
 
 void az_pal_os_sleep(uint32_t sleep_time_ms) { Sleep(sleep_time_ms); }
+
+uint32_t az_pal_os_get_time_ms(void) { return (uint32_t)GetTickCount(); }
+
+void az_pal_os_condition_init(az_ulib_pal_os_condition* condition) { InitializeConditionVariable((CONDITION_VARIABLE*)condition); }
+
+void az_pal_os_condition_deinit(az_ulib_pal_os_condition* condition) { (void)condition; }
+
+void az_pal_os_condition_wait(az_ulib_pal_os_condition* condition, az_ulib_pal_os_lock* lock) {
+  (void)SleepConditionVariableSRW((CONDITION_VARIABLE*)condition, (SRWLOCK*)lock, INFINITE, 0);
+}
+
+bool az_pal_os_condition_timed_wait(az_ulib_pal_os_condition* condition, az_ulib_pal_os_lock* lock, uint32_t wait_time_ms) {
+  return (SleepConditionVariableSRW((CONDITION_VARIABLE*)condition, (SRWLOCK*)lock, (DWORD)wait_time_ms, 0) != 0);
+}
+
+void az_pal_os_condition_notify_all(az_ulib_pal_os_condition* condition) {
+  WakeAllConditionVariable((CONDITION_VARIABLE*)condition);
+}
+
+static DWORD WINAPI thread_wrapper(LPVOID arg) {
+  az_ulib_pal_os_thread* thread = (az_ulib_pal_os_thread*)arg;
+  thread->function(thread->arg);
+  return 0;
+}
+
+bool az_pal_os_thread_create(az_ulib_pal_os_thread* thread, az_ulib_pal_os_thread_function function, void* arg) {
+  thread->function = function;
+  thread->arg = arg;
+  thread->handle = CreateThread(NULL, 0, thread_wrapper, thread, 0, NULL);
+  return (thread->handle != NULL);
+}
+
+void az_pal_os_thread_join(az_ulib_pal_os_thread* thread) {
+  (void)WaitForSingleObject(thread->handle, INFINITE);
+  (void)CloseHandle(thread->handle);
+}
@@ -2,7 +2,9 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 #include "azure_macro_utils/macro_utils.h"
 #include "umock_c/umock_c_prod.h"
@@ -24,18 +26,246 @@
  */
 static _az_ulib_ipc* ipc = NULL;
 
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#if AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+#ifndef AZ_ULIB_PORT_THREAD_LOCAL
+#error "AZ_ULIB_CONFIG_IPC_CALL_SHARDS bigger than 1 requires AZ_ULIB_PORT_THREAD_LOCAL in the port."
+#endif // AZ_ULIB_PORT_THREAD_LOCAL
+/*
+ * Each thread takes the next shard the first time it calls an interface. The thread keeps the shard
+ * plus one, so zero means that the thread has no shard yet.
+ */
+static volatile uint32_t next_call_shard = 0;
+static AZ_ULIB_PORT_THREAD_LOCAL uint32_t thread_call_shard = 0;
+
+static inline uint32_t get_call_shard(void) {
+  if (thread_call_shard == 0) {
+    thread_call_shard
+        = (AZ_ULIB_PORT_ATOMIC_INC_W(&next_call_shard) % AZ_ULIB_CONFIG_IPC_CALL_SHARDS) + 1;
+  }
+  return thread_call_shard - 1;
+}
+#else
+#define get_call_shard() 0
+#endif // AZ_ULIB_CONFIG_IPC_CALL_SHARDS > 1
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+static uint32_t hash_name(const char* name) {
+  // FNV-1a, good enough to spread the interface names over the buckets.
+  uint32_t hash = 2166136261u;
+  while (*name != '\0') {
+    hash ^= (uint8_t)(*name);
+    hash *= 16777619u;
+    name++;
+  }
+  return hash;
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+/*
+ * The growable registry stores the interfaces in segments that never move, so the handles stay
+ * valid while it grows. Each segment is twice the size of the previous one.
+ */
+static _az_ulib_ipc_interface** get_segment(uint32_t index, uint32_t* offset) {
+  uint32_t segment = 0;
+  while (index >= ((uint32_t)AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE << segment)) {
+    index -= ((uint32_t)AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE << segment);
+    segment++;
+  }
+  *offset = index;
+  return &(ipc->segment_list[segment]);
+}
+
+static _az_ulib_ipc_interface* get_slot(uint32_t index) {
+  uint32_t offset;
+  return &((*get_segment(index, &offset))[offset]);
+}
+
+static _az_ulib_ipc_interface* get_new_slot(void) {
+  _az_ulib_ipc_interface* result = NULL;
+  uint32_t offset;
+  _az_ulib_ipc_interface** segment = get_segment(ipc->interface_count, &offset);
+  uint32_t segment_index = (uint32_t)(segment - ipc->segment_list);
+
+  if (segment_index < AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS) {
+    if (*segment == NULL) {
+      *segment = (_az_ulib_ipc_interface*)malloc(
+          sizeof(_az_ulib_ipc_interface) * ((size_t)AZ_ULIB_CONFIG_IPC_SEGMENT_SIZE << segment_index));
+    }
+    if (*segment != NULL) {
+      result = &((*segment)[offset]);
+      ipc->interface_count++;
+    }
+  }
+
+  return result;
+}
+
+static _az_ulib_ipc_name_index* create_name_index(uint32_t size, uint32_t link) {
+  _az_ulib_ipc_name_index* name_index = (_az_ulib_ipc_name_index*)malloc(
+      sizeof(_az_ulib_ipc_name_index) + (sizeof(_az_ulib_ipc_interface*) * size));
+
+  if (name_index != NULL) {
+    name_index->bucket = (_az_ulib_ipc_interface* volatile*)(name_index + 1);
+    name_index->size = size;
+    name_index->link = link;
+    name_index->name_count = 0;
+    for (uint32_t i = 0; i < size; i++) {
+      name_index->bucket[i] = NULL;
+    }
+  }
+
+  return name_index;
+}
+#else
+static _az_ulib_ipc_interface* get_slot(uint32_t index) { return &(ipc->interface_list[index]); }
+
+static _az_ulib_ipc_interface* get_new_slot(void) {
+  _az_ulib_ipc_interface* result;
+
+  if (ipc->interface_count < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE) {
+    result = &(ipc->interface_list[ipc->interface_count]);
+    ipc->interface_count++;
+  } else {
+    result = NULL;
+  }
+
+  return result;
+}
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
+
+/*
+ * Returns the link in the name index that points to the first version of the interface with the
+ * provided name, or the `NULL` link at the end of the bucket if there is no interface with this name.
+ *
+ * A writer may change the links while a reader walks them, so each link is read only once.
+ */
+static _az_ulib_ipc_interface* volatile* get_name_entry(
+    _az_ulib_ipc_name_index* name_index,
+    const char* const name,
+    uint32_t name_hash) {
+  _az_ulib_ipc_interface* volatile* entry = &(name_index->bucket[name_hash % name_index->size]);
+  _az_ulib_ipc_interface* ipc_interface;
+
+  while (((ipc_interface = *entry) != NULL)
+         && ((ipc_interface->name_hash != name_hash) || (strcmp(ipc_interface->name, name) != 0))) {
+    entry = &(ipc_interface->next_name[name_index->link]);
+  }
+
+  return entry;
+}
+
+static _az_ulib_ipc_interface* get_version(
+    _az_ulib_ipc_interface* first_version,
+    az_ulib_version version,
+    az_ulib_version_match_criteria match_criteria) {
+  _az_ulib_ipc_interface* result = first_version;
+
+  while (result != NULL) {
+    const az_ulib_interface_descriptor* descriptor
+        = (const az_ulib_interface_descriptor*)result->interface_descriptor;
+    if ((descriptor != NULL) && az_ulib_version_match(descriptor->version, version, match_criteria)) {
+      break;
+    }
+    result = result->next_version;
+  }
+
+  return result;
+}
+
+/*
+ * The name index is changed only under the IPC lock, but it is read without it, so each change
+ * shall keep the lists consistent for a reader that walks them at the same time.
+ */
+static void add_to_name_index(
+    _az_ulib_ipc_name_index* name_index,
+    _az_ulib_ipc_interface* volatile* entry,
+    _az_ulib_ipc_interface* ipc_interface) {
+  ipc_interface->next_name[name_index->link] = NULL;
+  ipc_interface->next_version = NULL;
+
+  if (*entry == NULL) {
+    // First version of this name, it will be the entry in the bucket.
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(entry, ipc_interface);
+    name_index->name_count++;
+  } else {
+    // Keep the versions in the publish order.
+    _az_ulib_ipc_interface* last_version = *entry;
+    while (last_version->next_version != NULL) {
+      last_version = last_version->next_version;
+    }
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(&(last_version->next_version), ipc_interface);
+  }
+}
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
 static _az_ulib_ipc_interface* get_interface(
     const char* const name,
     az_ulib_version version,
     az_ulib_version_match_criteria match_criteria) {
-  _az_ulib_ipc_interface* result = NULL;
+  return get_version(
+      *get_name_entry(ipc->name_index, name, hash_name(name)), version, match_criteria);
+}
+
+/*
+ * The removed interface keeps its links, so a reader that is on it can continue its walk. It can
+ * only be reused after wait_for_readers().
+ */
+static void remove_from_name_index(_az_ulib_ipc_interface* ipc_interface) {
+  _az_ulib_ipc_name_index* name_index = ipc->name_index;
+  uint32_t link = name_index->link;
+  _az_ulib_ipc_interface* volatile* entry
+      = get_name_entry(name_index, ipc_interface->name, ipc_interface->name_hash);
+
+  if (*entry == ipc_interface) {
+    if (ipc_interface->next_version != NULL) {
+      // The next version takes the place of the removed one in the bucket.
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+          &(ipc_interface->next_version->next_name[link]), ipc_interface->next_name[link]);
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(entry, ipc_interface->next_version);
+    } else {
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(entry, ipc_interface->next_name[link]);
+      name_index->name_count--;
+    }
+  } else {
+    _az_ulib_ipc_interface* previous_version = *entry;
+    while (previous_version->next_version != ipc_interface) {
+      previous_version = previous_version->next_version;
+    }
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
+        &(previous_version->next_version), ipc_interface->next_version);
+  }
+}
+
+
+/*
+ * After the unpublish blocks the descriptor, no new call can reach the methods of the interface. So,
+ * a shard is free as soon as its running_count reaches zero once, seen by the az_ulib_ipc_call in
+ * the low watermark, or by the unpublish itself. The interface is free when all shards are.
+ */
+static bool is_running(_az_ulib_ipc_interface* ipc_interface) {
+  bool result = false;
+
+  for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CALL_SHARDS; i++) {
+    _az_ulib_ipc_call_shard* shard = &(ipc_interface->call_shard[i]);
+    if (shard->running_count_low_watermark != 0) {
+      if (shard->running_count == 0) {
+        (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(shard->running_count_low_watermark), 0);
+      } else {
+        result = true;
+      }
+    }
+  }
+
+  return result;
+}
+
+static bool has_running_count(_az_ulib_ipc_interface* ipc_interface) {
+  bool result = false;
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
-    if ((ipc->interface_list[i].interface_descriptor != NULL)
-        && (strcmp(ipc->interface_list[i].interface_descriptor->name, name) == 0)
-        && az_ulib_version_match(
-            ipc->interface_list[i].interface_descriptor->version, version, match_criteria)) {
-      result = &(ipc->interface_list[i]);
+  for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CALL_SHARDS; i++) {
+    if (ipc_interface->call_shard[i].running_count != 0) {
+      result = true;
       break;
     }
   }
@@ -43,47 +273,242 @@ static _az_ulib_ipc_interface* get_interface(
   return result;
 }
 
-static _az_ulib_ipc_interface* get_first_free() {
+static bool is_unpublishing(
+    _az_ulib_ipc_interface* first_version,
+    az_ulib_version version) {
+  bool result = false;
+
+  for (_az_ulib_ipc_interface* ipc_interface = first_version; ipc_interface != NULL;
+       ipc_interface = ipc_interface->next_version) {
+    const az_ulib_interface_descriptor* descriptor
+        = (const az_ulib_interface_descriptor*)ipc_interface->unpublishing_descriptor;
+    if ((descriptor != NULL) && (descriptor->version == version)) {
+      result = true;
+      break;
+    }
+  }
+
+  return result;
+}
+
+/*
+ * Wait, without the IPC lock, until the calls in execution on the interface end. The
+ * az_ulib_ipc_call notifies the drain condition when the running_count of a shard, that the
+ * unpublish is waiting for, reaches zero. The drain condition is shared by all interfaces, and the
+ * wait may wake up without a notification, so each wait only gets the time that remains up to the
+ * end of the wait_option_ms.
+ */
+static void wait_for_calls(_az_ulib_ipc_interface* ipc_interface, uint32_t wait_option_ms) {
+  uint32_t start_time_ms = az_pal_os_get_time_ms();
+
+  az_pal_os_lock_acquire(&(ipc->drain_lock));
+  while (is_running(ipc_interface)) {
+    if (wait_option_ms == AZ_ULIB_WAIT_FOREVER) {
+      az_pal_os_condition_wait(&(ipc->drain_condition), &(ipc->drain_lock));
+    } else {
+      uint32_t elapsed_time_ms = az_pal_os_get_time_ms() - start_time_ms;
+      if ((elapsed_time_ms >= wait_option_ms)
+          || !az_pal_os_condition_timed_wait(
+              &(ipc->drain_condition), &(ipc->drain_lock), wait_option_ms - elapsed_time_ms)) {
+        break;
+      }
+    }
+  }
+  az_pal_os_lock_release(&(ipc->drain_lock));
+}
+
+static void notify_calls_drained(void) {
+  az_pal_os_lock_acquire(&(ipc->drain_lock));
+  az_pal_os_condition_notify_all(&(ipc->drain_condition));
+  az_pal_os_lock_release(&(ipc->drain_lock));
+}
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+
+#ifdef _AZ_ULIB_IPC_READER_EPOCH
+/*
+ * The readers of the name index don't take the IPC lock, so a reader may be comparing the name of
+ * an interface that is being unpublished, or walking a name index that is being replaced. Each
+ * reader registers itself in the counter of the current epoch, and after removing an interface, or
+ * the old name index, the IPC moves to the next epoch and waits for the readers in the previous
+ * one. New readers cannot reach the removed memory, so after this point it may be released.
+ */
+static uint32_t enter_reader(void) {
+  uint32_t epoch;
+  bool registered;
+
+  do {
+    epoch = ipc->reader_epoch;
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc->reader_count[epoch & 1]));
+    registered = (epoch == ipc->reader_epoch);
+    if (!registered) {
+      // The unpublish may have checked this counter before the increment, try in the new epoch.
+      (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc->reader_count[epoch & 1]));
+    }
+  } while (!registered);
+
+  return epoch;
+}
+
+static void exit_reader(uint32_t epoch) {
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc->reader_count[epoch & 1]));
+}
+
+static void wait_for_readers(void) {
+  uint32_t epoch = ipc->reader_epoch;
+
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(ipc->reader_epoch), epoch + 1);
+
+  // Readers stay registered only for the time to walk one bucket, so just yield while they finish.
+  while (ipc->reader_count[epoch & 1] != 0) {
+    az_pal_os_sleep(0);
+  }
+}
+#endif // _AZ_ULIB_IPC_READER_EPOCH
+
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+/*
+ * Replace the name index by one with twice the number of buckets. The new index is built with the
+ * other link of each interface, so readers of the old index are not affected.
+ */
+static void grow_name_index(void) {
+  _az_ulib_ipc_name_index* old_index = ipc->name_index;
+  _az_ulib_ipc_name_index* new_index = create_name_index(old_index->size << 1, old_index->link ^ 1);
+
+  // If there is no memory for a bigger index, keep using the old one.
+  if (new_index != NULL) {
+    for (uint32_t i = 0; i < old_index->size; i++) {
+      for (_az_ulib_ipc_interface* first_version = old_index->bucket[i]; first_version != NULL;
+           first_version = first_version->next_name[old_index->link]) {
+        _az_ulib_ipc_interface* volatile* entry
+            = &(new_index->bucket[first_version->name_hash % new_index->size]);
+        first_version->next_name[new_index->link] = *entry;
+        *entry = first_version;
+      }
+    }
+    new_index->name_count = old_index->name_count;
+
+    (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(&(ipc->name_index), new_index);
+    wait_for_readers();
+    free(old_index);
+  }
+}
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
+
+static _az_ulib_ipc_interface* get_first_free(void) {
   _az_ulib_ipc_interface* result = NULL;
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
-    if ((ipc->interface_list[i].interface_descriptor == NULL)
-        && (ipc->interface_list[i].ref_count == 0)) {
-      result = &(ipc->interface_list[i]);
-      break;
+  // Reuse an unpublished interface, if one of them has no references anymore.
+  if (ipc->unpublished_count != 0) {
+    for (uint32_t i = 0; i < ipc->interface_count; i++) {
+      _az_ulib_ipc_interface* ipc_interface = get_slot(i);
+      if ((ipc_interface->interface_descriptor == NULL) && (ipc_interface->ref_count == 0)
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+          && (ipc_interface->unpublishing_descriptor == NULL)
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      ) {
+        ipc->unpublished_count--;
+        result = ipc_interface;
+        break;
+      }
     }
   }
 
+  if ((result == NULL) && ((result = get_new_slot()) != NULL)) {
+    result->interface_descriptor = NULL;
+    result->ref_count = 0;
+  }
+
   return result;
 }
 
-static az_ulib_result get_instance(_az_ulib_ipc_interface* ipc_interface) {
-  az_ulib_result result;
-  if (ipc_interface->ref_count >= AZ_ULIB_CONFIG_MAX_IPC_INSTANCES) {
-    result = AZ_ULIB_BUSY_ERROR;
-  } else {
-    result = AZ_ULIB_SUCCESS;
-    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->ref_count));
+/*
+ * Create a new reference to the interface published with the provided descriptor, without the IPC
+ * lock.
+ */
+static az_ulib_result get_instance(
+    _az_ulib_ipc_interface* ipc_interface,
+    const az_ulib_interface_descriptor* descriptor) {
+  az_ulib_result result = AZ_ULIB_SUCCESS;
+  uint32_t ref_count;
+
+  do {
+    ref_count = ipc_interface->ref_count;
+    if (ref_count >= _AZ_ULIB_IPC_MAX_INSTANCES) {
+      result = AZ_ULIB_BUSY_ERROR;
+    }
+  } while ((result == AZ_ULIB_SUCCESS)
+           && (AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(
+                   &(ipc_interface->ref_count), ref_count, ref_count + 1)
+               != ref_count));
+
+  // The interface may be unpublished while the reference is created. In this case, the new
+  // reference is not valid anymore.
+  if ((result == AZ_ULIB_SUCCESS) && (ipc_interface->interface_descriptor != descriptor)) {
+    (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->ref_count));
+    result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
   }
+
   return result;
 }
 
-az_ulib_result _az_ulib_ipc_init_no_contract(_az_ulib_ipc* handle) {
-  /*az_ulib_ipc_init_succeed*/
-  ipc = handle;
+static az_ulib_result release_instance(_az_ulib_ipc_interface* ipc_interface) {
+  az_ulib_result result = AZ_ULIB_SUCCESS;
+  uint32_t ref_count;
+
+  do {
+    ref_count = ipc_interface->ref_count;
+    if (ref_count == 0) {
+      result = AZ_ULIB_PRECONDITION_ERROR;
+    }
+  } while ((result == AZ_ULIB_SUCCESS)
+           && (AZ_ULIB_PORT_ATOMIC_COMPARE_AND_SWAP_W(
+                   &(ipc_interface->ref_count), ref_count, ref_count - 1)
+               != ref_count));
+
+  return result;
+}
 
-  az_pal_os_lock_init(&(ipc->lock));
+az_ulib_result _az_ulib_ipc_init_no_contract(_az_ulib_ipc* handle) {
+  az_ulib_result result = AZ_ULIB_SUCCESS;
+
+  handle->interface_count = 0;
+  handle->unpublished_count = 0;
+#ifdef _AZ_ULIB_IPC_READER_EPOCH
+  handle->reader_epoch = 0;
+  handle->reader_count[0] = 0;
+  handle->reader_count[1] = 0;
+#endif // _AZ_ULIB_IPC_READER_EPOCH
+
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS; i++) {
+    handle->segment_list[i] = NULL;
+  }
+  if ((handle->name_index = create_name_index(AZ_ULIB_CONFIG_IPC_NAME_INDEX_SIZE, 0)) == NULL) {
+    /*az_ulib_ipc_init_out_of_memory_failed*/
+    result = AZ_ULIB_OUT_OF_MEMORY_ERROR;
+  }
+#else
+  handle->static_name_index.bucket = handle->static_name_index_bucket;
+  handle->static_name_index.size = AZ_ULIB_CONFIG_IPC_NAME_INDEX_SIZE;
+  handle->static_name_index.link = 0;
+  handle->static_name_index.name_count = 0;
+  for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_NAME_INDEX_SIZE; i++) {
+    handle->static_name_index_bucket[i] = NULL;
+  }
+  handle->name_index = &(handle->static_name_index);
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
 
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
-    ipc->interface_list[i].ref_count = 0;
+  if (result == AZ_ULIB_SUCCESS) {
+    /*az_ulib_ipc_init_succeed*/
 #ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    ipc->interface_list[i].running_count = 0;
-    ipc->interface_list[i].running_count_low_watermark = 0;
+    az_pal_os_lock_init(&(handle->drain_lock));
+    az_pal_os_condition_init(&(handle->drain_condition));
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
-    ipc->interface_list[i].interface_descriptor = NULL;
+    az_pal_os_lock_init(&(handle->lock));
+    ipc = handle;
   }
 
-  return AZ_ULIB_SUCCESS;
+  return result;
 }
 
 az_ulib_result _az_ulib_ipc_init(_az_ulib_ipc* handle) {
@@ -99,11 +524,11 @@ az_ulib_result _az_ulib_ipc_deinit_no_contract(void) {
   az_ulib_result result;
 
   result = AZ_ULIB_SUCCESS;
-  for (size_t i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
-    if ((ipc->interface_list[i].interface_descriptor != NULL)
-        || (ipc->interface_list[i].ref_count != 0)
+  for (uint32_t i = 0; i < ipc->interface_count; i++) {
+    _az_ulib_ipc_interface* ipc_interface = get_slot(i);
+    if ((ipc_interface->interface_descriptor != NULL) || (ipc_interface->ref_count != 0)
 #ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-        || (ipc->interface_list[i].running_count != 0)
+        || has_running_count(ipc_interface) || (ipc_interface->unpublishing_descriptor != NULL)
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
     ) {
       /*az_ulib_ipc_deinit_with_published_interface_failed*/
@@ -115,6 +540,16 @@ az_ulib_result _az_ulib_ipc_deinit_no_contract(void) {
 
   if (result == AZ_ULIB_SUCCESS) {
     /*az_ulib_ipc_deinit_succeed*/
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    az_pal_os_condition_deinit(&(ipc->drain_condition));
+    az_pal_os_lock_deinit(&(ipc->drain_lock));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+    for (size_t i = 0; i < AZ_ULIB_CONFIG_IPC_MAX_SEGMENTS; i++) {
+      free(ipc->segment_list[i]);
+    }
+    free(ipc->name_index);
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
     az_pal_os_lock_deinit(&(ipc->lock));
     ipc = NULL;
   }
@@ -134,12 +569,17 @@ az_ulib_result _az_ulib_ipc_publish_no_contract(
     _az_ulib_ipc_interface_handle* interface_handle) {
   az_ulib_result result;
   _az_ulib_ipc_interface* new_interface;
+  uint32_t name_hash = hash_name(interface_descriptor->name);
 
   az_pal_os_lock_acquire(&(ipc->lock));
   {
-    if (get_interface(
-            interface_descriptor->name, interface_descriptor->version, AZ_ULIB_VERSION_EQUALS_TO)
-        != NULL) {
+    _az_ulib_ipc_interface* volatile* entry
+        = get_name_entry(ipc->name_index, interface_descriptor->name, name_hash);
+    if ((get_version(*entry, interface_descriptor->version, AZ_ULIB_VERSION_EQUALS_TO) != NULL)
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+        || is_unpublishing(*entry, interface_descriptor->version)
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    ) {
       /*az_ulib_ipc_publish_with__descriptor_with_same_name_and_version_failed*/
       result = AZ_ULIB_ELEMENT_DUPLICATE_ERROR;
     } else if ((new_interface = get_first_free()) == NULL) {
@@ -147,13 +587,24 @@ az_ulib_result _az_ulib_ipc_publish_no_contract(
       result = AZ_ULIB_OUT_OF_MEMORY_ERROR;
     } else {
       /*az_ulib_ipc_publish_succeed*/
+      // A free interface has no references, and no reader can reach it in the name index.
       (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
           &(new_interface->interface_descriptor), interface_descriptor);
-      new_interface->ref_count = 0;
 #ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
-      new_interface->running_count = 0;
-      new_interface->running_count_low_watermark = 0;
+      new_interface->unpublishing_descriptor = NULL;
+      for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CALL_SHARDS; i++) {
+        new_interface->call_shard[i].running_count = 0;
+        new_interface->call_shard[i].running_count_low_watermark = 0;
+      }
 #endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
+      new_interface->name = interface_descriptor->name;
+      new_interface->name_hash = name_hash;
+      add_to_name_index(ipc->name_index, entry, new_interface);
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+      if (ipc->name_index->name_count > (ipc->name_index->size << 1)) {
+        grow_name_index();
+      }
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
       if (interface_handle != NULL) {
         /*az_ulib_ipc_publish_return_handle_succeed*/
         *interface_handle = new_interface;
@@ -195,63 +646,57 @@ az_ulib_result _az_ulib_ipc_unpublish_no_contract(
       // The order of the code here, including the ones that looks not necessary, are associated to
       // the interlock between this function and the az_ulib_ipc_call.
 
-      // Prepare to recover in case it was not possible to unpublish the interface.
-      const az_ulib_interface_descriptor* recover_interface_descriptor
-          = (const az_ulib_interface_descriptor*)release_interface->interface_descriptor;
+      // Prepare to recover in case it was not possible to unpublish the interface. While the
+      // unpublish waits, this descriptor also keeps the interface out of the free ones, and avoids
+      // a new publish of the same name and version.
+      release_interface->unpublishing_descriptor = release_interface->interface_descriptor;
 
       // Block access to this interface. After this point, any new call to az_ulib_ipc_call that
       // didn't get the interface pointer yet will return AZ_ULIB_NO_SUCH_ELEMENT_ERROR.
       (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(&(release_interface->interface_descriptor), NULL);
 
-      // If the running_count is `0` is because no other process is inside of any of the functions
-      // methods, and they may be removed from the memory. There will be the case that the other
-      // process is already in the az_ulib_ipc_call, in the direction to call a method in this
-      // interface, but the call will just return AZ_ULIB_NO_SUCH_ELEMENT_ERROR from there.
+      // If the running_count of all shards is `0` is because no other process is inside of any of
+      // the functions methods, and they may be removed from the memory. There will be the case that
+      // the other process is already in the az_ulib_ipc_call, in the direction to call a method in
+      // this interface, but the call will just return AZ_ULIB_NO_SUCH_ELEMENT_ERROR from there.
       /*az_ulib_ipc_unpublish_succeed*/
-      uint32_t retry_interval;
-      if (wait_option_ms == AZ_ULIB_WAIT_FOREVER) {
-        retry_interval = 100;
-      } else {
-        retry_interval = wait_option_ms >> 3;
-        if (retry_interval == 0) {
-          retry_interval = 1;
-        }
+      for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CALL_SHARDS; i++) {
+        _az_ulib_ipc_call_shard* shard = &(release_interface->call_shard[i]);
+        (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
+            &(shard->running_count_low_watermark), shard->running_count);
       }
 
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-          &(release_interface->running_count_low_watermark), release_interface->running_count);
-      uint32_t retry_total_time = 0;
-
-      // A semaphore here would be more efficient, but it would force a synchronization between
-      // az_ulib_ipc_call and az_ulib_ipc_unpublish that would add extra code on az_ulib_ipc_call,
-      // making it heavier. On the other hand, there is no expectations about heavy usage of the
-      // function az_ulib_ipc_unpublish, in many applications, it will not be used at all. So, we
-      // decided to open an exception here and use a busy loop on the az_ulib_ipc_unpublish
-      // instead of a semaphore.
+      // Waiting for the calls with the IPC lock would block all other publish and unpublish, so
+      // release it while the calls drain.
       /*az_ulib_ipc_unpublish_with_method_running_with_small_timeout_failed*/
-      while ((retry_total_time < wait_option_ms)
-             && (release_interface->running_count_low_watermark != 0)) {
-
-        az_pal_os_sleep(retry_interval);
-
-        if (wait_option_ms != AZ_ULIB_WAIT_FOREVER) {
-          retry_total_time += retry_interval;
-        }
+      if (is_running(release_interface) && (wait_option_ms != AZ_ULIB_NO_WAIT)) {
+        az_pal_os_lock_release(&(ipc->lock));
+        wait_for_calls(release_interface, wait_option_ms);
+        az_pal_os_lock_acquire(&(ipc->lock));
       }
 
-      if (release_interface->running_count_low_watermark == 0) {
+      if (!is_running(release_interface)) {
         /*az_ulib_ipc_unpublish_random_order_succeed*/
         /*az_ulib_ipc_unpublish_release_resource_succeed*/
         /*az_ulib_ipc_unpublish_with_valid_interface_instance_succeed*/
+        remove_from_name_index(release_interface);
+        wait_for_readers();
+        ipc->unpublished_count++;
         result = AZ_ULIB_SUCCESS;
       } else {
         /*az_ulib_ipc_unpublish_with_method_running_failed*/
         // If caller doesn't want to wait anymore, recover the interface and return
-        // AZ_ULIB_BUSY_ERROR.
+        // AZ_ULIB_BUSY_ERROR. The running calls don't need to notify the end anymore.
+        for (uint32_t i = 0; i < AZ_ULIB_CONFIG_IPC_CALL_SHARDS; i++) {
+          (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
+              &(release_interface->call_shard[i].running_count_low_watermark), 0);
+        }
         (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
-            &(release_interface->interface_descriptor), recover_interface_descriptor);
+            &(release_interface->interface_descriptor),
+            release_interface->unpublishing_descriptor);
         result = AZ_ULIB_BUSY_ERROR;
       }
+      release_interface->unpublishing_descriptor = NULL;
     }
   }
   az_pal_os_lock_release(&(ipc->lock));
@@ -276,22 +721,33 @@ az_ulib_result _az_ulib_ipc_try_get_interface_no_contract(
     az_ulib_version version,
     az_ulib_version_match_criteria match_criteria,
     _az_ulib_ipc_interface_handle* interface_handle) {
-  az_ulib_result result;
+  az_ulib_result result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
   _az_ulib_ipc_interface* ipc_interface;
 
-  az_pal_os_lock_acquire(&(ipc->lock));
-  {
-    if ((ipc_interface = get_interface(name, version, match_criteria)) == NULL) {
-      /*az_ulib_ipc_try_get_interface_with_unknown_name_failed*/
-      /*az_ulib_ipc_try_get_interface_with_unknown_version_failed*/
-      result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+#ifdef _AZ_ULIB_IPC_READER_EPOCH
+  uint32_t epoch = enter_reader();
+#endif // _AZ_ULIB_IPC_READER_EPOCH
+  for (ipc_interface = *get_name_entry(ipc->name_index, name, hash_name(name));
+       ipc_interface != NULL;
+       ipc_interface = ipc_interface->next_version) {
+    const az_ulib_interface_descriptor* descriptor
+        = (const az_ulib_interface_descriptor*)ipc_interface->interface_descriptor;
+    if ((descriptor != NULL) && az_ulib_version_match(descriptor->version, version, match_criteria)
+        && ((result = get_instance(ipc_interface, descriptor)) != AZ_ULIB_NO_SUCH_ELEMENT_ERROR)) {
       /*az_ulib_ipc_try_get_interface_with_max_interface_instances_failed*/
-    } else if ((result = get_instance(ipc_interface)) == AZ_ULIB_SUCCESS) {
-      /*az_ulib_ipc_try_get_interface_succeed*/
-      *interface_handle = ipc_interface;
+      break;
     }
   }
-  az_pal_os_lock_release(&(ipc->lock));
+#ifdef _AZ_ULIB_IPC_READER_EPOCH
+  exit_reader(epoch);
+#endif // _AZ_ULIB_IPC_READER_EPOCH
+
+  if (result == AZ_ULIB_SUCCESS) {
+    /*az_ulib_ipc_try_get_interface_succeed*/
+    *interface_handle = ipc_interface;
+  }
+  /*az_ulib_ipc_try_get_interface_with_unknown_name_failed*/
+  /*az_ulib_ipc_try_get_interface_with_unknown_version_failed*/
 
   return result;
 }
@@ -316,20 +772,18 @@ az_ulib_result _az_ulib_ipc_get_interface_no_contract(
     _az_ulib_ipc_interface_handle original_interface_handle,
     _az_ulib_ipc_interface_handle* interface_handle) {
   az_ulib_result result;
+  _az_ulib_ipc_interface* ipc_interface = original_interface_handle;
+  const az_ulib_interface_descriptor* descriptor
+      = (const az_ulib_interface_descriptor*)ipc_interface->interface_descriptor;
 
-  az_pal_os_lock_acquire(&(ipc->lock));
-  {
-    _az_ulib_ipc_interface* ipc_interface = original_interface_handle;
-    if (ipc_interface->interface_descriptor == NULL) {
-      /*az_ulib_ipc_get_interface_with_unpublished_interface_failed*/
-      result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
-      /*az_ulib_ipc_get_interface_with_max_interface_instances_failed*/
-    } else if ((result = get_instance(ipc_interface)) == AZ_ULIB_SUCCESS) {
-      /*az_ulib_ipc_get_interface_succeed*/
-      *interface_handle = ipc_interface;
-    }
+  if (descriptor == NULL) {
+    /*az_ulib_ipc_get_interface_with_unpublished_interface_failed*/
+    result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    /*az_ulib_ipc_get_interface_with_max_interface_instances_failed*/
+  } else if ((result = get_instance(ipc_interface, descriptor)) == AZ_ULIB_SUCCESS) {
+    /*az_ulib_ipc_get_interface_succeed*/
+    *interface_handle = ipc_interface;
   }
-  az_pal_os_lock_release(&(ipc->lock));
 
   return result;
 }
@@ -349,23 +803,9 @@ az_ulib_result _az_ulib_ipc_get_interface(
 
 az_ulib_result _az_ulib_ipc_release_interface_no_contract(
     _az_ulib_ipc_interface_handle interface_handle) {
-  _az_ulib_ipc_interface* ipc_interface = (_az_ulib_ipc_interface*)interface_handle;
-  az_ulib_result result;
-
-  az_pal_os_lock_acquire(&(ipc->lock));
-  {
-    if (ipc_interface->ref_count == 0) {
-      /*az_ulib_ipc_release_interface_double_release_failed*/
-      result = AZ_ULIB_PRECONDITION_ERROR;
-    } else {
-      /*az_ulib_ipc_release_interface_succeed*/
-      result = AZ_ULIB_SUCCESS;
-      ipc_interface->ref_count--;
-    }
-  }
-  az_pal_os_lock_release(&(ipc->lock));
-
-  return result;
+  /*az_ulib_ipc_release_interface_double_release_failed*/
+  /*az_ulib_ipc_release_interface_succeed*/
+  return release_instance((_az_ulib_ipc_interface*)interface_handle);
 }
 
 az_ulib_result _az_ulib_ipc_release_interface(_az_ulib_ipc_interface_handle interface_handle) {
@@ -390,7 +830,8 @@ az_ulib_result _az_ulib_ipc_call_no_contract(
   // and az_ulib_ipc_unpublish. It will allow a interface to be unpublished even if it has a high
   // volume of calls.
   if (ipc_interface->interface_descriptor != NULL) {
-    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(ipc_interface->running_count));
+    _az_ulib_ipc_call_shard* shard = &(ipc_interface->call_shard[get_call_shard()]);
+    (void)AZ_ULIB_PORT_ATOMIC_INC_W(&(shard->running_count));
     register const az_ulib_interface_descriptor* descriptor
         = (const az_ulib_interface_descriptor*)ipc_interface->interface_descriptor;
 
@@ -401,10 +842,13 @@ az_ulib_result _az_ulib_ipc_call_no_contract(
       /*az_ulib_ipc_call_calls_the_method_succeed*/
       result = descriptor->action_list[method_index].action_ptr_1.method(model_in, model_out);
     }
-    long new_running_count = AZ_ULIB_PORT_ATOMIC_DEC_W(&(ipc_interface->running_count));
-    if (new_running_count < ipc_interface->running_count_low_watermark) {
-      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-          &(ipc_interface->running_count_low_watermark), new_running_count);
+    long new_running_count = AZ_ULIB_PORT_ATOMIC_DEC_W(&(shard->running_count));
+    if (new_running_count < shard->running_count_low_watermark) {
+      // Only happens while an unpublish is waiting for this interface.
+      (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&(shard->running_count_low_watermark), new_running_count);
+      if (new_running_count == 0) {
+        notify_calls_drained();
+      }
     }
   } else {
     result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
@@ -20,6 +20,10 @@ static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, o
 static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
 static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
 static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
 static const az_ulib_ustream_interface api =
 {
         concrete_set_position,
@@ -29,7 +33,11 @@ static const az_ulib_ustream_interface api =
         concrete_get_position,
         concrete_release,
         concrete_clone,
-        concrete_dispose
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
 };
 
 static void init_instance(
@@ -234,7 +242,7 @@ static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az
     AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
                                             AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
                     AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
-                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (UINT32_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
     /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
     /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
     /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
@@ -269,6 +277,195 @@ static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
     return AZ_ULIB_SUCCESS;
 }
 
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                    AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+        *buffer = (const uint8_t*)ustream_instance->control_block->ptr + ustream_instance->inner_current_position;
+        *size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                    AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        if(ustream_instance->inner_current_position >= ustream_instance->length)
+        {
+            /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+            *size = 0;
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+            const uint8_t* data = (const uint8_t*)ustream_instance->control_block->ptr;
+            size_t remain_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+            *size = 0;
+            for(size_t i = 0; (i < iov_count) && (*size < remain_size); i++)
+            {
+                if(iov[i].buffer_length != 0)
+                {
+                    size_t copy_size = remain_size - *size;
+                    if(iov[i].buffer_length < copy_size)
+                    {
+                        copy_size = iov[i].buffer_length;
+                    }
+                    (void)memcpy(iov[i].buffer, data + ustream_instance->inner_current_position + *size, copy_size);
+                    *size += copy_size;
+                }
+            }
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                    AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(inner_position == ustream_instance->length)
+    {
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        *size = (buffer_length < remain_size) ? buffer_length : remain_size;
+        (void)memcpy(buffer, (const uint8_t*)ustream_instance->control_block->ptr + inner_position, *size);
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                    AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /* The content is already in memory, there is nothing to prepare. */
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
 az_ulib_result az_ulib_ustream_init(
     az_ulib_ustream* ustream_instance,
     az_ulib_ustream_data_cb* ustream_control_block,
@@ -11,6 +11,7 @@
 #include "az_ulib_pal_os.h"
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_ulog.h"
+#include "internal/az_ulib_ustream_aux.h"
 
 static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
 static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
@@ -20,6 +21,10 @@ static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, o
 static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
 static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
 static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
 static const az_ulib_ustream_interface api =
 {
         concrete_set_position,
@@ -29,7 +34,11 @@ static const az_ulib_ustream_interface api =
         concrete_get_position,
         concrete_release,
         concrete_clone,
-        concrete_dispose
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
 };
 
 static void destroy_instance(az_ulib_ustream* ustream_instance)
@@ -97,6 +106,110 @@ static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
     return AZ_ULIB_SUCCESS;
 }
 
+az_ulib_result _az_ulib_ustream_read_inner(
+        az_ulib_pal_os_lock* lock,
+        az_ulib_ustream* inner_ustream,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    az_ulib_result result = az_ulib_ustream_read_at(inner_ustream, position, buffer, buffer_length, size);
+
+    if(result == AZ_ULIB_NOT_SUPPORTED_ERROR)
+    {
+        /*[az_ulib_ustream_multi_read_inner_read_at_not_supported_succeed]*/
+        //Critical section to make sure another instance doesn't set_position before this one reads
+        az_pal_os_lock_acquire(lock);
+        if((result = az_ulib_ustream_set_position(inner_ustream, position)) == AZ_ULIB_SUCCESS)
+        {
+            result = az_ulib_ustream_read(inner_ustream, buffer, buffer_length, size);
+        }
+        az_pal_os_lock_release(lock);
+    }
+
+    return result;
+}
+
+/* Copy the content from the inner position to the local buffers, in order, crossing from the first
+ * to the second ustream when needed. The instance is not changed, the caller shall move its current
+ * position when it is the case. */
+static az_ulib_result multi_read_iov(
+        az_ulib_ustream* ustream_instance,
+        offset_t inner_position,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+    size_t remain_size = (inner_position < ustream_instance->length) ?
+                            (ustream_instance->length - (size_t)inner_position) : 0;
+    size_t iov_index = 0;
+    size_t iov_offset = 0;
+
+    *size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (iov_index < iov_count) && (*size < remain_size))
+    {
+        if(iov_offset >= iov[iov_index].buffer_length)
+        {
+            iov_index++;
+            iov_offset = 0;
+        }
+        else
+        {
+            az_ulib_ustream* current_ustream;
+            offset_t current_position;
+            size_t copied_size;
+            size_t copy_size = iov[iov_index].buffer_length - iov_offset;
+            if(copy_size > (remain_size - *size))
+            {
+                copy_size = remain_size - *size;
+            }
+
+            /* The first ustream shares the inner positions with the multi instance, the second was cloned
+             * with its logical position starting at the end of the first one. */
+            if(inner_position < multi_data->ustream_one.length)
+            {
+                current_ustream = &multi_data->ustream_one;
+                current_position = inner_position + multi_data->ustream_one.offset_diff;
+            }
+            else
+            {
+                current_ustream = &multi_data->ustream_two;
+                current_position = inner_position;
+            }
+
+            /*[az_ulib_ustream_multi_read_clone_and_original_in_parallel_succeed]*/
+            if((result = _az_ulib_ustream_read_inner(&multi_data->lock, current_ustream, current_position,
+                            &(iov[iov_index].buffer[iov_offset]), copy_size, &copied_size)) == AZ_ULIB_SUCCESS)
+            {
+                *size += copied_size;
+                inner_position += copied_size;
+                iov_offset += copied_size;
+                if(copied_size == 0)
+                {
+                    result = AZ_ULIB_EOF;
+                }
+            }
+            /*[az_ulib_ustream_multi_read_control_block_failed_in_read_with_some_valid_content_succeed]*/
+        }
+    }
+
+    if(*size != 0)
+    {
+        /*[az_ulib_ustream_concat_read_from_multiple_buffers_succeed]*/
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(remain_size == 0)
+    {
+        result = AZ_ULIB_EOF;
+    }
+    /*[az_ulib_ustream_multi_read_control_block_failed_in_read_failed]*/
+
+    return result;
+}
+
 static az_ulib_result concrete_read(
         az_ulib_ustream* ustream_instance,
         uint8_t* const buffer,
@@ -116,9 +229,7 @@ static az_ulib_result concrete_read(
 
     az_ulib_result result;
 
-    az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
-    az_ulib_ustream* current_ustream = (ustream_instance->inner_current_position < multi_data->ustream_one.length) ?
-                                                                &multi_data->ustream_one : &multi_data->ustream_two;
+    az_ulib_ustream_iovec iov = { buffer, buffer_length };
 
     /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
     /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
@@ -127,56 +238,9 @@ static az_ulib_result concrete_read(
     /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
     /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
     /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
-    *size = 0;
-    az_ulib_result intermediate_result = AZ_ULIB_SUCCESS;
-    while((intermediate_result == AZ_ULIB_SUCCESS) &&
-            (*size < buffer_length) &&
-            (current_ustream != NULL))
-    {
-        size_t copied_size;
-        size_t remain_size = buffer_length - *size;
-
-        //Critical section to make sure another instance doesn't set_position before this one reads
-        az_pal_os_lock_acquire(&multi_data->lock);
-        /*[az_ulib_ustream_multi_read_clone_and_original_in_parallel_succeed]*/
-        az_ulib_ustream_set_position(current_ustream, ustream_instance->inner_current_position + *size);
-        intermediate_result = az_ulib_ustream_read(current_ustream, &buffer[*size], remain_size, &copied_size);
-        az_pal_os_lock_release(&multi_data->lock);
-
-        switch(intermediate_result)
-        {
-        case AZ_ULIB_SUCCESS:
-            *size += copied_size;
-        case AZ_ULIB_EOF:
-            if(*size < buffer_length)
-            {
-                if(current_ustream == &multi_data->ustream_one)
-                {
-                    current_ustream = &multi_data->ustream_two;
-                    intermediate_result = AZ_ULIB_SUCCESS;
-                }
-                else
-                {
-                    current_ustream = NULL;
-                }
-            }
-            break;
-        default:
-            /*[az_ulib_ustream_multi_read_control_block_failed_in_read_with_some_valid_content_succeed]*/
-            break;
-        }
-    }
-
-    if(*size != 0)
+    if((result = multi_read_iov(ustream_instance, ustream_instance->inner_current_position, &iov, 1, size)) == AZ_ULIB_SUCCESS)
     {
-        /*[az_ulib_ustream_concat_read_from_multiple_buffers_succeed]*/
         ustream_instance->inner_current_position += *size;
-        result = AZ_ULIB_SUCCESS;
-    }
-    else
-    {
-        /*[az_ulib_ustream_multi_read_control_block_failed_in_read_failed]*/
-        result = intermediate_result;
     }
 
     return result;
@@ -257,7 +321,7 @@ static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az
     AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
                                             AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
                     AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
-                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (UINT32_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
 
     /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
     /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
@@ -314,6 +378,216 @@ static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
     return AZ_ULIB_SUCCESS;
 }
 
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+        az_ulib_ustream* current_ustream;
+        offset_t current_position;
+
+        /* The first ustream shares the inner positions with the multi instance, the second was cloned
+         * with its logical position starting at the end of the first one. */
+        if(ustream_instance->inner_current_position < multi_data->ustream_one.length)
+        {
+            current_ustream = &multi_data->ustream_one;
+            current_position = ustream_instance->inner_current_position + multi_data->ustream_one.offset_diff;
+        }
+        else
+        {
+            current_ustream = &multi_data->ustream_two;
+            current_position = ustream_instance->inner_current_position;
+        }
+
+        //Critical section to make sure another instance doesn't set_position before this one peeks
+        az_pal_os_lock_acquire(&multi_data->lock);
+        /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+        /*[az_ulib_ustream_multi_peek_not_supported_inner_ustream_failed]*/
+        if((result = az_ulib_ustream_set_position(current_ustream, current_position)) == AZ_ULIB_SUCCESS)
+        {
+            result = az_ulib_ustream_peek(current_ustream, buffer, size);
+        }
+        az_pal_os_lock_release(&multi_data->lock);
+
+        /* A split multi instance may end before the end of its inner ustreams. */
+        if((result == AZ_ULIB_SUCCESS) && (*size > (ustream_instance->length - ustream_instance->inner_current_position)))
+        {
+            *size = ustream_instance->length - ustream_instance->inner_current_position;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+        /*[az_ulib_ustream_multi_readv_with_failed_inner_read_succeed]*/
+        /*[az_ulib_ustream_multi_readv_with_failed_inner_read_failed]*/
+        if((result = multi_read_iov(ustream_instance, ustream_instance->inner_current_position, iov, iov_count, size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        az_ulib_ustream_iovec iov = { buffer, buffer_length };
+        result = multi_read_iov(ustream_instance, inner_position, &iov, 1, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_multi_hint_forward_to_both_ustreams_succeed]*/
+        /*[az_ulib_ustream_multi_hint_forward_failed]*/
+        az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+
+        /* The hint does not change the inner ustreams, so it is forwarded without the lock. The first ustream
+         * shares the inner positions with the multi instance, the second starts at the end of the first one. */
+        result = AZ_ULIB_SUCCESS;
+        if((inner_position < inner_end) && (inner_position < multi_data->ustream_one.length))
+        {
+            offset_t one_end = (inner_end < multi_data->ustream_one.length) ? inner_end : multi_data->ustream_one.length;
+            result = az_ulib_ustream_hint(&multi_data->ustream_one, hint,
+                            inner_position + multi_data->ustream_one.offset_diff, (size_t)(one_end - inner_position));
+        }
+        if((result == AZ_ULIB_SUCCESS) && (inner_position < inner_end) && (inner_end > multi_data->ustream_one.length))
+        {
+            offset_t two_position = (inner_position > multi_data->ustream_one.length) ?
+                                        inner_position : multi_data->ustream_one.length;
+            result = az_ulib_ustream_hint(&multi_data->ustream_two, hint, two_position, (size_t)(inner_end - two_position));
+        }
+    }
+
+    return result;
+}
+
 static void ustream_multi_init(az_ulib_ustream* ustream_instance, az_ulib_ustream_data_cb* control_block,
                                     az_ulib_ustream_multi_data_cb* multi_data, az_ulib_release_callback multi_data_release)
 {
@@ -443,3 +717,181 @@ az_ulib_result az_ulib_ustream_split(
 
     return result;
 }
+
+az_ulib_result az_ulib_ustream_slice(
+    az_ulib_ustream* ustream_instance,
+    offset_t offset,
+    size_t length,
+    az_ulib_ustream* ustream_instance_slice)
+{
+    /*[az_ulib_ustream_slice_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_slice_compliance_null_buffer_slice_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_slice, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    az_ulib_ustream view;
+
+    /*
+     * The slice only reads the offset_diff, the first valid position and the length of the ustream_instance, and
+     * does not use its current position, so another thread may read the ustream_instance at the same time. The
+     * clone copies the current position of the ustream that it receives, so the slice clones a local view of the
+     * ustream_instance that is already at the offset, instead of the ustream_instance itself.
+     */
+    offset_t inner_position = offset - ustream_instance->offset_diff;
+    if((inner_position < ustream_instance->inner_first_valid_position) ||
+        (inner_position > ustream_instance->length) ||
+        (length > (ustream_instance->length - inner_position)))
+    {
+        /*[az_ulib_ustream_slice_compliance_before_first_valid_position_failed]*/
+        /*[az_ulib_ustream_slice_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_slice_compliance_length_out_of_the_buffer_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        view.control_block = ustream_instance->control_block;
+        view.offset_diff = ustream_instance->offset_diff;
+        view.inner_current_position = inner_position;
+        view.inner_first_valid_position = ustream_instance->inner_first_valid_position;
+        view.length = ustream_instance->length;
+
+        /*[az_ulib_ustream_slice_clone_failed]*/
+        if((result = az_ulib_ustream_clone(ustream_instance_slice, &view, offset)) == AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_slice_compliance_succeed]*/
+            /*[az_ulib_ustream_slice_compliance_does_not_change_position_succeed]*/
+            /*[az_ulib_ustream_slice_compliance_cloned_buffer_succeed]*/
+            /*[az_ulib_ustream_slice_compliance_slice_of_slice_succeed]*/
+            /*[az_ulib_ustream_slice_compliance_empty_slice_succeed]*/
+            ustream_instance_slice->offset_diff = ustream_instance->offset_diff;
+            ustream_instance_slice->inner_current_position = inner_position;
+            ustream_instance_slice->inner_first_valid_position = inner_position;
+            ustream_instance_slice->length = inner_position + length;
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_chunk(
+    az_ulib_ustream* ustream_instance,
+    size_t chunk_size,
+    az_ulib_ustream* chunks,
+    size_t max_chunks,
+    size_t* const chunk_count)
+{
+    /*[az_ulib_ustream_chunk_null_instance_failed]*/
+    /*[az_ulib_ustream_chunk_zero_chunk_size_failed]*/
+    /*[az_ulib_ustream_chunk_null_chunks_failed]*/
+    /*[az_ulib_ustream_chunk_zero_max_chunks_failed]*/
+    /*[az_ulib_ustream_chunk_null_chunk_count_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(chunk_size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(chunks, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(max_chunks, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(chunk_count, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    offset_t position;
+    size_t remaining_size;
+
+    *chunk_count = 0;
+
+    /*[az_ulib_ustream_chunk_get_position_failed]*/
+    /*[az_ulib_ustream_chunk_get_remaining_size_failed]*/
+    if(((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_ULIB_SUCCESS) &&
+        ((result = az_ulib_ustream_get_remaining_size(ustream_instance, &remaining_size)) == AZ_ULIB_SUCCESS))
+    {
+        if(remaining_size == 0)
+        {
+            /*[az_ulib_ustream_chunk_empty_ustream_failed]*/
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            while((result == AZ_ULIB_SUCCESS) && (remaining_size != 0) && (*chunk_count < max_chunks))
+            {
+                size_t size = (remaining_size < chunk_size) ? remaining_size : chunk_size;
+
+                /*[az_ulib_ustream_chunk_clone_failed]*/
+                /*[az_ulib_ustream_chunk_success]*/
+                /*[az_ulib_ustream_chunk_last_chunk_smaller_success]*/
+                /*[az_ulib_ustream_chunk_from_current_position_success]*/
+                if((result = az_ulib_ustream_slice(ustream_instance, position, size, &(chunks[*chunk_count]))) ==
+                    AZ_ULIB_SUCCESS)
+                {
+                    position += size;
+                    remaining_size -= size;
+                    (*chunk_count)++;
+                }
+            }
+
+            if(result != AZ_ULIB_SUCCESS)
+            {
+                while(*chunk_count > 0)
+                {
+                    (*chunk_count)--;
+                    az_ulib_ustream_dispose(&(chunks[*chunk_count]));
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_advance(
+    az_ulib_ustream* ustream_instance,
+    size_t size)
+{
+    /*[az_ulib_ustream_advance_null_instance_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t position;
+    if((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_advance_succeed]*/
+        /*[az_ulib_ustream_advance_after_the_end_failed]*/
+        result = az_ulib_ustream_set_position(ustream_instance, position + size);
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_get_span(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const local_buffer,
+    size_t local_buffer_length,
+    const uint8_t** const span,
+    size_t* const size)
+{
+    /*[az_ulib_ustream_get_span_null_instance_failed]*/
+    /*[az_ulib_ustream_get_span_null_span_failed]*/
+    /*[az_ulib_ustream_get_span_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(span, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_span_zero_copy_succeed]*/
+    az_ulib_result result = az_ulib_ustream_peek(ustream_instance, span, size);
+
+    if((result == AZ_ULIB_NOT_SUPPORTED_ERROR) && (local_buffer != NULL) && (local_buffer_length != 0))
+    {
+        /*[az_ulib_ustream_get_span_copy_fallback_succeed]*/
+        /*[az_ulib_ustream_get_span_copy_fallback_does_not_change_position_succeed]*/
+        offset_t position;
+        if((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_ULIB_SUCCESS)
+        {
+            if((result = az_ulib_ustream_read(ustream_instance, local_buffer, local_buffer_length, size)) == AZ_ULIB_SUCCESS)
+            {
+                *span = local_buffer;
+                result = az_ulib_ustream_set_position(ustream_instance, position);
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,1168 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_base64.h"
+#include "az_ulib_config.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_ustream_aux.h"
+
+#if defined(AZ_ULIB_CONFIG_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define USTREAM_BASE64_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#define BINARY_BLOCK_SIZE   3
+#define BASE64_BLOCK_SIZE   4
+#define BASE64_PADDING      '='
+#define INVALID_VALUE       0xFF
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+/*
+ * Block codecs. Each encode function converts block_count blocks of 3 bytes in blocks of 4 characters, and each
+ *  decode function does the opposite, returning false if any character is not in the base64 alphabet. The
+ *  padding is not handled here, the last block of the content is converted by encode_last_block() and
+ *  decode_last_block().
+ */
+typedef void (*encode_function)(const uint8_t* source, size_t block_count, uint8_t* destination);
+typedef bool (*decode_function)(const uint8_t* source, size_t block_count, uint8_t* destination);
+
+static const uint8_t encode_table[64] =
+{
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+static const uint8_t decode_table[256] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static void encode_scalar(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    for(size_t i = 0; i < block_count; i++)
+    {
+        uint32_t value = ((uint32_t)source[0] << 16) | ((uint32_t)source[1] << 8) | (uint32_t)source[2];
+        destination[0] = encode_table[value >> 18];
+        destination[1] = encode_table[(value >> 12) & 0x3F];
+        destination[2] = encode_table[(value >> 6) & 0x3F];
+        destination[3] = encode_table[value & 0x3F];
+        source += BINARY_BLOCK_SIZE;
+        destination += BASE64_BLOCK_SIZE;
+    }
+}
+
+static bool decode_scalar(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    for(size_t i = 0; i < block_count; i++)
+    {
+        uint8_t a = decode_table[source[0]];
+        uint8_t b = decode_table[source[1]];
+        uint8_t c = decode_table[source[2]];
+        uint8_t d = decode_table[source[3]];
+        if((a | b | c | d) == INVALID_VALUE)
+        {
+            return false;
+        }
+        uint32_t value = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | (uint32_t)d;
+        destination[0] = (uint8_t)(value >> 16);
+        destination[1] = (uint8_t)(value >> 8);
+        destination[2] = (uint8_t)value;
+        source += BASE64_BLOCK_SIZE;
+        destination += BINARY_BLOCK_SIZE;
+    }
+
+    return true;
+}
+
+#ifdef USTREAM_BASE64_X86_SIMD
+/*
+ * The SIMD codecs follow the algorithms of Wojciech Muła. The encode shuffles each 3 bytes to a 32 bits lane,
+ *  splits the lane in 4 indexes of 6 bits with multiplications, and translates the indexes to characters with
+ *  a table of offsets indexed by pshufb. The decode classifies each character by its two nibbles to detect the
+ *  invalid ones, translates the valid ones to their values with a table of offsets, and packs the 4 values of
+ *  each lane back in 3 bytes.
+ */
+__attribute__((target("ssse3")))
+static __m128i encode_block_ssse3(__m128i input)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    __m128i lanes = _mm_shuffle_epi8(input, shuffle);
+    __m128i indexes = _mm_or_si128(
+        _mm_mulhi_epu16(_mm_and_si128(lanes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040)),
+        _mm_mullo_epi16(_mm_and_si128(lanes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010)));
+
+    /* Reduce each index to the position of its offset: 0 for 'a'-'z', 1-10 for '0'-'9', 11 for '+', 12 for
+     * '/', and 13 for 'A'-'Z'. */
+    __m128i reduced = _mm_subs_epu8(indexes, _mm_set1_epi8(51));
+    reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indexes), _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(indexes, _mm_shuffle_epi8(offsets, reduced));
+}
+
+__attribute__((target("ssse3")))
+static void encode_ssse3(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    size_t i = 0;
+
+    /* Each step consumes 4 blocks, but loads 16 bytes. */
+    for(; (block_count - i) >= 6; i += 4)
+    {
+        _mm_storeu_si128((__m128i*)&destination[i * BASE64_BLOCK_SIZE],
+            encode_block_ssse3(_mm_loadu_si128((const __m128i*)&source[i * BINARY_BLOCK_SIZE])));
+    }
+
+    encode_scalar(&source[i * BINARY_BLOCK_SIZE], block_count - i, &destination[i * BASE64_BLOCK_SIZE]);
+}
+
+__attribute__((target("avx2")))
+static void encode_avx2(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    const __m256i shuffle = _mm256_broadcastsi128_si256(
+        _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m256i offsets = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+    size_t i = 0;
+
+    /* Each step consumes 8 blocks, with 12 bytes in each 128 bits lane, but loads 28 bytes. */
+    for(; (block_count - i) >= 10; i += 8)
+    {
+        const uint8_t* block = &source[i * BINARY_BLOCK_SIZE];
+        __m256i input = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)block)),
+            _mm_loadu_si128((const __m128i*)&block[12]), 1);
+
+        __m256i lanes = _mm256_shuffle_epi8(input, shuffle);
+        __m256i indexes = _mm256_or_si256(
+            _mm256_mulhi_epu16(_mm256_and_si256(lanes, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040)),
+            _mm256_mullo_epi16(_mm256_and_si256(lanes, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010)));
+
+        __m256i reduced = _mm256_subs_epu8(indexes, _mm256_set1_epi8(51));
+        reduced = _mm256_or_si256(reduced,
+            _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indexes), _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256((__m256i*)&destination[i * BASE64_BLOCK_SIZE],
+            _mm256_add_epi8(indexes, _mm256_shuffle_epi8(offsets, reduced)));
+    }
+
+    encode_ssse3(&source[i * BINARY_BLOCK_SIZE], block_count - i, &destination[i * BASE64_BLOCK_SIZE]);
+}
+
+__attribute__((target("ssse3")))
+static bool decode_ssse3(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    const __m128i lut_low = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_high = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for(; (block_count - i) >= 4; i += 4)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i*)&source[i * BASE64_BLOCK_SIZE]);
+        __m128i high_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), nibble);
+        __m128i classes = _mm_and_si128(_mm_shuffle_epi8(lut_low, _mm_and_si128(input, nibble)),
+                                        _mm_shuffle_epi8(lut_high, high_nibbles));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(classes, _mm_setzero_si128())) != 0xFFFF)
+        {
+            return false;
+        }
+
+        /* '/' shares the high nibble with '+', so it uses the offset right before the one of its nibble. */
+        __m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(lut_offsets,
+                            _mm_add_epi8(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')), high_nibbles)));
+        __m128i packed = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+                                        _mm_set1_epi32(0x00011000));
+        packed = _mm_shuffle_epi8(packed, pack);
+
+        uint8_t* block = &destination[i * BINARY_BLOCK_SIZE];
+        uint32_t tail = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+        _mm_storel_epi64((__m128i*)block, packed);
+        (void)memcpy(&block[8], &tail, sizeof(tail));
+    }
+
+    return decode_scalar(&source[i * BASE64_BLOCK_SIZE], block_count - i, &destination[i * BINARY_BLOCK_SIZE]);
+}
+
+__attribute__((target("avx2")))
+static bool decode_avx2(const uint8_t* source, size_t block_count, uint8_t* destination)
+{
+    const __m256i lut_low = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+    const __m256i lut_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+    const __m256i lut_offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                                                            0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                                    -1, -1, -1, -1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for(; (block_count - i) >= 8; i += 8)
+    {
+        __m256i input = _mm256_loadu_si256((const __m256i*)&source[i * BASE64_BLOCK_SIZE]);
+        __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble);
+        __m256i classes = _mm256_and_si256(_mm256_shuffle_epi8(lut_low, _mm256_and_si256(input, nibble)),
+                                            _mm256_shuffle_epi8(lut_high, high_nibbles));
+        if((unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(classes, _mm256_setzero_si256())) != 0xFFFFFFFFu)
+        {
+            return false;
+        }
+
+        __m256i values = _mm256_add_epi8(input, _mm256_shuffle_epi8(lut_offsets,
+                            _mm256_add_epi8(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')), high_nibbles)));
+        __m256i packed = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+                                            _mm256_set1_epi32(0x00011000));
+
+        /* Each 128 bits lane has 12 bytes, move them together in the first 24 bytes. */
+        packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(packed, pack),
+                                                _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+        uint8_t* block = &destination[i * BINARY_BLOCK_SIZE];
+        _mm_storeu_si128((__m128i*)block, _mm256_castsi256_si128(packed));
+        _mm_storel_epi64((__m128i*)&block[16], _mm256_extracti128_si256(packed, 1));
+    }
+
+    return decode_ssse3(&source[i * BASE64_BLOCK_SIZE], block_count - i, &destination[i * BINARY_BLOCK_SIZE]);
+}
+#endif /* USTREAM_BASE64_X86_SIMD */
+
+static encode_function resolve_encode_function(void)
+{
+#ifdef USTREAM_BASE64_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return encode_avx2;
+    }
+    if(__builtin_cpu_supports("ssse3"))
+    {
+        return encode_ssse3;
+    }
+#endif /* USTREAM_BASE64_X86_SIMD */
+    return encode_scalar;
+}
+
+static decode_function resolve_decode_function(void)
+{
+#ifdef USTREAM_BASE64_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return decode_avx2;
+    }
+    if(__builtin_cpu_supports("ssse3"))
+    {
+        return decode_ssse3;
+    }
+#endif /* USTREAM_BASE64_X86_SIMD */
+    return decode_scalar;
+}
+
+static encode_function get_encode_function(void)
+{
+    /*
+     * The read calls it for every chunk, so the dispatch is resolved in the first call and cached. Threads that
+     *  race in the first call resolve and store the same function.
+     */
+    static volatile encode_function encode_cache = NULL;
+    encode_function function = encode_cache;
+
+    if(function == NULL)
+    {
+        function = resolve_encode_function();
+        encode_cache = function;
+    }
+
+    return function;
+}
+
+static decode_function get_decode_function(void)
+{
+    /* Resolved once, like the encode function. */
+    static volatile decode_function decode_cache = NULL;
+    decode_function function = decode_cache;
+
+    if(function == NULL)
+    {
+        function = resolve_decode_function();
+        decode_cache = function;
+    }
+
+    return function;
+}
+
+/* Encode the last 1, 2 or 3 bytes of the content, with padding. */
+static void encode_last_block(const uint8_t* source, size_t size, uint8_t* destination)
+{
+    uint8_t block[BINARY_BLOCK_SIZE] = { 0, 0, 0 };
+
+    (void)memcpy(block, source, size);
+    encode_scalar(block, 1, destination);
+    if(size < 3)
+    {
+        destination[3] = BASE64_PADDING;
+        if(size < 2)
+        {
+            destination[2] = BASE64_PADDING;
+        }
+    }
+}
+
+/* Decode the last block of the content, that may have padding, returning the number of decoded bytes, or zero if
+ * the block is not valid. */
+static size_t decode_last_block(const uint8_t* source, uint8_t* destination)
+{
+    uint8_t block[BASE64_BLOCK_SIZE];
+    size_t size = BINARY_BLOCK_SIZE;
+
+    (void)memcpy(block, source, BASE64_BLOCK_SIZE);
+    if(block[3] == BASE64_PADDING)
+    {
+        block[3] = 'A';
+        size--;
+        if(block[2] == BASE64_PADDING)
+        {
+            block[2] = 'A';
+            size--;
+        }
+    }
+
+    return decode_scalar(block, 1, destination) ? size : 0;
+}
+
+/* Read the source from the position up to the size, crossing the boundaries of composed sources. The source
+ * is shared by all the instances, so it is read with read_at, or under the lock if it does not support it. */
+static az_ulib_result read_source(
+    az_ulib_ustream_base64_data_cb* base64_data,
+    offset_t position,
+    uint8_t* buffer,
+    size_t size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t read_size = 0;
+
+    while((result == AZ_ULIB_SUCCESS) && (read_size < size))
+    {
+        size_t copied_size;
+        if((result = _az_ulib_ustream_read_inner(&base64_data->lock, &base64_data->source, position + read_size,
+                        &buffer[read_size], size - read_size, &copied_size)) == AZ_ULIB_SUCCESS)
+        {
+            read_size += copied_size;
+        }
+    }
+
+    return result;
+}
+
+/* Copy the encoded content from the position. The complete blocks are encoded directly in the buffer, and the
+ * blocks that are partially copied go through a local block. */
+static az_ulib_result encode_copy(
+    az_ulib_ustream_base64_data_cb* base64_data,
+    offset_t position,
+    uint8_t* buffer,
+    size_t buffer_length,
+    size_t* size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    encode_function encode = get_encode_function();
+    uint8_t source_buffer[AZ_ULIB_CONFIG_USTREAM_BASE64_BUFFER_SIZE];
+
+    *size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (*size < buffer_length))
+    {
+        offset_t source_position = (position / BASE64_BLOCK_SIZE) * BINARY_BLOCK_SIZE;
+        size_t skip = position % BASE64_BLOCK_SIZE;
+        size_t source_remain = base64_data->source_length - source_position;
+        size_t space = buffer_length - *size;
+        size_t encoded_size;
+
+        if((skip != 0) || (space < BASE64_BLOCK_SIZE))
+        {
+            uint8_t block[BASE64_BLOCK_SIZE];
+            size_t read_size = (source_remain < BINARY_BLOCK_SIZE) ? source_remain : BINARY_BLOCK_SIZE;
+            if((result = read_source(base64_data, source_position, source_buffer, read_size)) == AZ_ULIB_SUCCESS)
+            {
+                encode_last_block(source_buffer, read_size, block);
+                encoded_size = BASE64_BLOCK_SIZE - skip;
+                if(encoded_size > space)
+                {
+                    encoded_size = space;
+                }
+                (void)memcpy(&buffer[*size], &block[skip], encoded_size);
+            }
+        }
+        else
+        {
+            size_t block_count = space / BASE64_BLOCK_SIZE;
+            if(block_count > (sizeof(source_buffer) / BINARY_BLOCK_SIZE))
+            {
+                block_count = sizeof(source_buffer) / BINARY_BLOCK_SIZE;
+            }
+            size_t read_size = block_count * BINARY_BLOCK_SIZE;
+            if(read_size > source_remain)
+            {
+                read_size = source_remain;
+            }
+            if((result = read_source(base64_data, source_position, source_buffer, read_size)) == AZ_ULIB_SUCCESS)
+            {
+                size_t full_blocks = read_size / BINARY_BLOCK_SIZE;
+                encode(source_buffer, full_blocks, &buffer[*size]);
+                encoded_size = full_blocks * BASE64_BLOCK_SIZE;
+                if((read_size % BINARY_BLOCK_SIZE) != 0)
+                {
+                    encode_last_block(&source_buffer[read_size - (read_size % BINARY_BLOCK_SIZE)],
+                        read_size % BINARY_BLOCK_SIZE, &buffer[*size + encoded_size]);
+                    encoded_size += BASE64_BLOCK_SIZE;
+                }
+            }
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            *size += encoded_size;
+            position += encoded_size;
+        }
+    }
+
+    return result;
+}
+
+/* Copy the decoded content from the position. The complete blocks are decoded directly in the buffer, and the
+ * last block, that may have padding, and the blocks that are partially copied go through a local block. */
+static az_ulib_result decode_copy(
+    az_ulib_ustream_base64_data_cb* base64_data,
+    offset_t position,
+    uint8_t* buffer,
+    size_t buffer_length,
+    size_t* size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    decode_function decode = get_decode_function();
+    uint8_t source_buffer[AZ_ULIB_CONFIG_USTREAM_BASE64_BUFFER_SIZE];
+    offset_t last_block = (base64_data->source_length / BASE64_BLOCK_SIZE) - 1;
+
+    *size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (*size < buffer_length))
+    {
+        offset_t block_index = position / BINARY_BLOCK_SIZE;
+        size_t skip = position % BINARY_BLOCK_SIZE;
+        size_t space = buffer_length - *size;
+        size_t decoded_size;
+
+        if((skip != 0) || (space < BINARY_BLOCK_SIZE) || (block_index == last_block))
+        {
+            uint8_t block[BINARY_BLOCK_SIZE];
+            if((result = read_source(base64_data, block_index * BASE64_BLOCK_SIZE, source_buffer,
+                            BASE64_BLOCK_SIZE)) == AZ_ULIB_SUCCESS)
+            {
+                if(block_index == last_block)
+                {
+                    decoded_size = decode_last_block(source_buffer, block);
+                }
+                else
+                {
+                    decoded_size = decode_scalar(source_buffer, 1, block) ? BINARY_BLOCK_SIZE : 0;
+                }
+
+                if(decoded_size <= skip)
+                {
+                    /*[az_ulib_ustream_base64_decode_invalid_character_failed]*/
+                    result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+                }
+                else
+                {
+                    decoded_size -= skip;
+                    if(decoded_size > space)
+                    {
+                        decoded_size = space;
+                    }
+                    (void)memcpy(&buffer[*size], &block[skip], decoded_size);
+                }
+            }
+        }
+        else
+        {
+            size_t block_count = space / BINARY_BLOCK_SIZE;
+            if(block_count > (sizeof(source_buffer) / BASE64_BLOCK_SIZE))
+            {
+                block_count = sizeof(source_buffer) / BASE64_BLOCK_SIZE;
+            }
+            if(block_count > (last_block - block_index))
+            {
+                block_count = last_block - block_index;
+            }
+            if((result = read_source(base64_data, block_index * BASE64_BLOCK_SIZE, source_buffer,
+                            block_count * BASE64_BLOCK_SIZE)) == AZ_ULIB_SUCCESS)
+            {
+                if(decode(source_buffer, block_count, &buffer[*size]))
+                {
+                    decoded_size = block_count * BINARY_BLOCK_SIZE;
+                }
+                else
+                {
+                    /*[az_ulib_ustream_base64_decode_invalid_character_failed]*/
+                    result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+                }
+            }
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            *size += decoded_size;
+            position += decoded_size;
+        }
+    }
+
+    return result;
+}
+
+/* Copy the transformed content from the position, up to the end of the content. */
+static az_ulib_result transform_copy(
+    az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    uint8_t* buffer,
+    size_t buffer_length,
+    size_t* size)
+{
+    az_ulib_result result;
+    az_ulib_ustream_base64_data_cb* base64_data = (az_ulib_ustream_base64_data_cb*)ustream_instance->control_block->ptr;
+    size_t remain_size = ustream_instance->length - (size_t)inner_position;
+
+    if(buffer_length > remain_size)
+    {
+        buffer_length = remain_size;
+    }
+
+    if(base64_data->decode)
+    {
+        result = decode_copy(base64_data, inner_position, buffer, buffer_length, size);
+    }
+    else
+    {
+        result = encode_copy(base64_data, inner_position, buffer, buffer_length, size);
+    }
+
+    /* The content copied before a failure is returned, the next read will report the failure. */
+    if(*size != 0)
+    {
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+    ustream_instance->inner_current_position = inner_current_position;
+    ustream_instance->inner_first_valid_position = inner_current_position;
+    ustream_instance->offset_diff = offset - inner_current_position;
+    ustream_instance->control_block = control_block;
+    ustream_instance->length = data_buffer_length;
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+static void destroy_instance(az_ulib_ustream* ustream_instance)
+{
+    az_ulib_ustream_base64_data_cb* base64_data = (az_ulib_ustream_base64_data_cb*)ustream_instance->control_block->ptr;
+
+    (void)az_ulib_ustream_dispose(&base64_data->source);
+    az_pal_os_lock_deinit(&base64_data->lock);
+
+    if(ustream_instance->control_block->data_release != NULL)
+    {
+        ustream_instance->control_block->data_release(ustream_instance->control_block->ptr);
+    }
+}
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_base64_encode_set_position_in_the_middle_of_a_block_succeed]*/
+        /*[az_ulib_ustream_base64_decode_set_position_in_the_middle_of_a_block_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+        /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_base64_encode_succeed]*/
+        /*[az_ulib_ustream_base64_decode_succeed]*/
+        if((result = transform_copy(ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length,
+                        size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+        /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    init_instance(ustream_instance_clone, ustream_instance->control_block, ustream_instance->inner_current_position, offset,
+                                                            ustream_instance->length);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    /*[az_ulib_ustream_base64_dispose_source_succeed]*/
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        destroy_instance(ustream_instance);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_peek_compliance_not_supported_failed]*/
+    /* The transformed content only exists in the consumer buffer. */
+    return AZ_ULIB_NOT_SUPPORTED_ERROR;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        if(ustream_instance->inner_current_position >= ustream_instance->length)
+        {
+            /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+            *size = 0;
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+            offset_t inner_position = ustream_instance->inner_current_position;
+            *size = 0;
+
+            for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < iov_count) && (inner_position < ustream_instance->length); i++)
+            {
+                if(iov[i].buffer_length != 0)
+                {
+                    size_t copied_size;
+                    if((result = transform_copy(ustream_instance, inner_position, iov[i].buffer, iov[i].buffer_length,
+                                    &copied_size)) == AZ_ULIB_SUCCESS)
+                    {
+                        *size += copied_size;
+                        inner_position += copied_size;
+                    }
+                }
+            }
+
+            if(*size != 0)
+            {
+                ustream_instance->inner_current_position += *size;
+                result = AZ_ULIB_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(inner_position == ustream_instance->length)
+    {
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        result = transform_copy(ustream_instance, inner_position, buffer, buffer_length, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_base64_hint_forward_to_source_succeed]*/
+        az_ulib_ustream_base64_data_cb* base64_data = (az_ulib_ustream_base64_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+        size_t transformed_block = base64_data->decode ? BINARY_BLOCK_SIZE : BASE64_BLOCK_SIZE;
+        size_t source_block = base64_data->decode ? BASE64_BLOCK_SIZE : BINARY_BLOCK_SIZE;
+
+        /* Forward the hint to the source blocks that produce the range. */
+        offset_t source_position = (inner_position / transformed_block) * source_block;
+        offset_t source_end = ((inner_end + transformed_block - 1) / transformed_block) * source_block;
+        if(source_end > base64_data->source_length)
+        {
+            source_end = base64_data->source_length;
+        }
+        result = (source_position < source_end) ?
+                    az_ulib_ustream_hint(&base64_data->source, hint, source_position, (size_t)(source_end - source_position)) :
+                    AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+/* Clone the source and initialize the control block, without the instance. */
+static az_ulib_result base64_data_init(
+    az_ulib_ustream_base64_data_cb* base64_data,
+    az_ulib_release_callback base64_data_release,
+    az_ulib_ustream* ustream_to_transform,
+    bool decode)
+{
+    az_ulib_result result;
+
+    if((result = az_ulib_ustream_get_remaining_size(ustream_to_transform, &base64_data->source_length)) == AZ_ULIB_SUCCESS)
+    {
+        if(base64_data->source_length == 0)
+        {
+            /*[az_ulib_ustream_base64_encode_empty_source_failed]*/
+            /*[az_ulib_ustream_base64_decode_empty_source_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else if((result = az_ulib_ustream_clone(&base64_data->source, ustream_to_transform, 0)) == AZ_ULIB_SUCCESS)
+        {
+            az_pal_os_lock_init(&base64_data->lock);
+            base64_data->decode = decode;
+
+            base64_data->control_block.api = &api;
+            base64_data->control_block.ptr = (void*)base64_data;
+            base64_data->control_block.ref_count = 0;
+            base64_data->control_block.data_release = base64_data_release;
+            base64_data->control_block.control_block_release = NULL;
+        }
+    }
+
+    return result;
+}
+
+static void base64_data_deinit(az_ulib_ustream_base64_data_cb* base64_data)
+{
+    (void)az_ulib_ustream_dispose(&base64_data->source);
+    az_pal_os_lock_deinit(&base64_data->lock);
+}
+
+az_ulib_result az_ulib_ustream_base64_encode(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_base64_data_cb* base64_data,
+    az_ulib_release_callback base64_data_release,
+    az_ulib_ustream* ustream_to_encode)
+{
+    /*[az_ulib_ustream_base64_encode_null_instance_failed]*/
+    /*[az_ulib_ustream_base64_encode_null_base64_data_failed]*/
+    /*[az_ulib_ustream_base64_encode_null_ustream_to_encode_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(base64_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_encode, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if((result = base64_data_init(base64_data, base64_data_release, ustream_to_encode, false)) == AZ_ULIB_SUCCESS)
+    {
+        size_t source_length = base64_data->source_length;
+
+        if(source_length > ((AZ_ULIB_OFFSET_MAX / BASE64_BLOCK_SIZE) * BINARY_BLOCK_SIZE))
+        {
+            /* The encoded content would not fit in the positions of a ustream. */
+            base64_data_deinit(base64_data);
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else
+        {
+            /*[az_ulib_ustream_base64_encode_succeed]*/
+            init_instance(ustream_instance, &base64_data->control_block, 0, 0,
+                ((source_length / BINARY_BLOCK_SIZE) + (((source_length % BINARY_BLOCK_SIZE) != 0) ? 1 : 0)) * BASE64_BLOCK_SIZE);
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_base64_decode(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_base64_data_cb* base64_data,
+    az_ulib_release_callback base64_data_release,
+    az_ulib_ustream* ustream_to_decode)
+{
+    /*[az_ulib_ustream_base64_decode_null_instance_failed]*/
+    /*[az_ulib_ustream_base64_decode_null_base64_data_failed]*/
+    /*[az_ulib_ustream_base64_decode_null_ustream_to_decode_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(base64_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_decode, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if((result = base64_data_init(base64_data, base64_data_release, ustream_to_decode, true)) == AZ_ULIB_SUCCESS)
+    {
+        size_t source_length = base64_data->source_length;
+        uint8_t last_block[BASE64_BLOCK_SIZE];
+        uint8_t decoded_block[BINARY_BLOCK_SIZE];
+        size_t last_block_size = 0;
+
+        if((source_length % BASE64_BLOCK_SIZE) != 0)
+        {
+            /*[az_ulib_ustream_base64_decode_invalid_size_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else if(((result = read_source(base64_data, source_length - BASE64_BLOCK_SIZE, last_block,
+                        BASE64_BLOCK_SIZE)) == AZ_ULIB_SUCCESS) &&
+                ((last_block_size = decode_last_block(last_block, decoded_block)) == 0))
+        {
+            /*[az_ulib_ustream_base64_decode_invalid_last_block_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_base64_decode_succeed]*/
+            init_instance(ustream_instance, &base64_data->control_block, 0, 0,
+                (((source_length / BASE64_BLOCK_SIZE) - 1) * BINARY_BLOCK_SIZE) + last_block_size);
+        }
+        else
+        {
+            base64_data_deinit(base64_data);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,760 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_builder.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_index_stack.h"
+
+#define CHUNK_SIZE          AZ_ULIB_CONFIG_USTREAM_BUILDER_CHUNK_SIZE
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+/* The free list of chunks is a lock-free stack, see internal/az_ulib_index_stack.h. */
+static az_ulib_ustream_builder_chunk* pop_chunk(az_ulib_ustream_builder_pool* pool)
+{
+    uint32_t index = _az_ulib_index_stack_pop(&pool->free_list, pool->chunks,
+                        sizeof(az_ulib_ustream_builder_chunk), offsetof(az_ulib_ustream_builder_chunk, next_free));
+
+    if(index == 0)
+    {
+        return NULL;
+    }
+
+    pool->chunks[index - 1].next = NULL;
+    return &pool->chunks[index - 1];
+}
+
+static void push_chunk(az_ulib_ustream_builder_chunk* chunk)
+{
+    az_ulib_ustream_builder_pool* pool = chunk->pool;
+
+    _az_ulib_index_stack_push(&pool->free_list, pool->chunks,
+        sizeof(az_ulib_ustream_builder_chunk), offsetof(az_ulib_ustream_builder_chunk, next_free),
+        (uint32_t)(chunk - pool->chunks) + 1);
+}
+
+/* Return a chain of chunks, from the first one, to their pool. */
+static void release_chunks(az_ulib_ustream_builder_chunk* chunk)
+{
+    while(chunk != NULL)
+    {
+        az_ulib_ustream_builder_chunk* next = chunk->next;
+        push_chunk(chunk);
+        chunk = next;
+    }
+}
+
+/* Return the chunks of a frozen ustream to their pool. The control block points to the last chunk, so it walks the
+ * chain backward. It follows the az_ulib_release_callback signature, so it is the data_release of the frozen
+ * ustreams. */
+static void release_frozen_chunks(void* release_pointer)
+{
+    az_ulib_ustream_builder_chunk* chunk = (az_ulib_ustream_builder_chunk*)release_pointer;
+
+    while(chunk != NULL)
+    {
+        az_ulib_ustream_builder_chunk* prev = chunk->prev;
+        push_chunk(chunk);
+        chunk = prev;
+    }
+}
+
+/*
+ * Link the chunk in the end of the content, after the last chunk, or as the first chunk if last is NULL. Besides
+ *  the previous chunk, each chunk keeps a jump to a previous chunk, chosen in the skew-binary scheme of Myers (An
+ *  applicative random-access stack, 1983), so find_chunk reaches any chunk from the last one in O(log n) steps.
+ *  The jumps only depend on the previous chunks, so they are set once, and the frozen ustreams only read them.
+ */
+static void link_chunk(az_ulib_ustream_builder_chunk* chunk, az_ulib_ustream_builder_chunk* last)
+{
+    chunk->prev = last;
+    if(last == NULL)
+    {
+        chunk->index = 0;
+        chunk->jump = chunk;
+    }
+    else
+    {
+        az_ulib_ustream_builder_chunk* jump = last->jump;
+
+        chunk->index = last->index + 1;
+        chunk->jump = ((last->index - jump->index) == (jump->index - jump->jump->index)) ? jump->jump : last;
+    }
+}
+
+/* Find the chunk with the inner position, starting from the last chunk. All chunks but the last one are full, so
+ * the chunk is the one with index inner_position / CHUNK_SIZE. The inner position shall be before the end of the
+ * content. */
+static const az_ulib_ustream_builder_chunk* find_chunk(const az_ulib_ustream* ustream_instance, offset_t inner_position)
+{
+    const az_ulib_ustream_builder_chunk* chunk =
+        (const az_ulib_ustream_builder_chunk*)ustream_instance->control_block->ptr;
+    uint32_t index = (uint32_t)(inner_position / CHUNK_SIZE);
+
+    while(chunk->index > index)
+    {
+        chunk = (chunk->jump->index >= index) ? chunk->jump : chunk->prev;
+    }
+
+    return chunk;
+}
+
+/* Copy the content from the inner position to the local buffers, in order, crossing the chunks when needed.
+ * The instance is not changed, the caller shall move its current position when it is the case. */
+static az_ulib_result builder_read_iov(
+        az_ulib_ustream* ustream_instance,
+        offset_t inner_position,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t remain_size = (inner_position < ustream_instance->length) ?
+                            (ustream_instance->length - (size_t)inner_position) : 0;
+
+    *size = 0;
+    if(remain_size == 0)
+    {
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        const az_ulib_ustream_builder_chunk* chunk = find_chunk(ustream_instance, inner_position);
+        size_t chunk_offset = (size_t)(inner_position % CHUNK_SIZE);
+
+        for(size_t iov_index = 0; (iov_index < iov_count) && (*size < remain_size); iov_index++)
+        {
+            size_t iov_offset = 0;
+            while((iov_offset < iov[iov_index].buffer_length) && (*size < remain_size))
+            {
+                if(chunk_offset == CHUNK_SIZE)
+                {
+                    chunk = chunk->next;
+                    chunk_offset = 0;
+                }
+
+                size_t copy_size = iov[iov_index].buffer_length - iov_offset;
+                if(copy_size > (CHUNK_SIZE - chunk_offset))
+                {
+                    copy_size = CHUNK_SIZE - chunk_offset;
+                }
+                if(copy_size > (remain_size - *size))
+                {
+                    copy_size = remain_size - *size;
+                }
+
+                (void)memcpy(&(iov[iov_index].buffer[iov_offset]), &(chunk->data[chunk_offset]), copy_size);
+                *size += copy_size;
+                iov_offset += copy_size;
+                chunk_offset += copy_size;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_set_position(
+        az_ulib_ustream* ustream_instance,
+        offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+       (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    az_ulib_ustream_iovec iov = { buffer, buffer_length };
+
+    /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+    /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_builder_read_across_chunks_succeed]*/
+    if((result = builder_read_iov(ustream_instance, ustream_instance->inner_current_position, &iov, 1, size)) == AZ_ULIB_SUCCESS)
+    {
+        ustream_instance->inner_current_position += *size;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+    /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_no_memory_to_create_instance_failed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    ustream_instance_clone->inner_current_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->inner_first_valid_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->offset_diff = offset - ustream_instance->inner_current_position;
+    ustream_instance_clone->control_block = ustream_instance->control_block;
+    ustream_instance_clone->length = ustream_instance->length;
+
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        /*[az_ulib_ustream_builder_dispose_return_chunks_to_pool_succeed]*/
+        control_block->data_release(control_block->ptr);
+        if(control_block->control_block_release != NULL)
+        {
+            control_block->control_block_release(control_block);
+        }
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                    AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    offset_t inner_position = ustream_instance->inner_current_position;
+
+    if(inner_position >= ustream_instance->length)
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+        /*[az_ulib_ustream_builder_peek_up_to_the_end_of_the_chunk_succeed]*/
+        size_t chunk_offset = (size_t)(inner_position % CHUNK_SIZE);
+        *buffer = &(find_chunk(ustream_instance, inner_position)->data[chunk_offset]);
+        *size = CHUNK_SIZE - chunk_offset;
+        if(*size > (ustream_instance->length - (size_t)inner_position))
+        {
+            *size = ustream_instance->length - (size_t)inner_position;
+        }
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+        if((result = builder_read_iov(ustream_instance, ustream_instance->inner_current_position, iov, iov_count, size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        az_ulib_ustream_iovec iov = { buffer, buffer_length };
+        result = builder_read_iov(ustream_instance, inner_position, &iov, 1, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /* The chunks are already in memory, there is nothing to prepare. */
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_builder_pool_init(
+    az_ulib_ustream_builder_pool* pool,
+    az_ulib_ustream_builder_chunk* chunks,
+    size_t chunk_count)
+{
+    /*[az_ulib_ustream_builder_pool_init_null_pool_failed]*/
+    /*[az_ulib_ustream_builder_pool_init_null_chunks_failed]*/
+    /*[az_ulib_ustream_builder_pool_init_zero_chunk_count_failed]*/
+    /*[az_ulib_ustream_builder_pool_init_chunk_count_exceed_max_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(chunks, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(chunk_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE((chunk_count <= AZ_ULIB_USTREAM_BUILDER_POOL_MAX_CHUNKS), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_builder_pool_init_succeed]*/
+    for(size_t i = 0; i < chunk_count; i++)
+    {
+        chunks[i].pool = pool;
+        chunks[i].next = NULL;
+        chunks[i].next_free = (i + 1 < chunk_count) ? (uint32_t)(i + 2) : 0;
+    }
+    pool->chunks = chunks;
+    pool->chunk_count = chunk_count;
+    pool->free_list = 1;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_builder_init(
+    az_ulib_ustream_builder* builder,
+    az_ulib_ustream_builder_pool* pool)
+{
+    /*[az_ulib_ustream_builder_init_null_builder_failed]*/
+    /*[az_ulib_ustream_builder_init_null_pool_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(builder, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_builder_init_succeed]*/
+    builder->pool = pool;
+    builder->first_chunk = NULL;
+    builder->last_chunk = NULL;
+    builder->length = 0;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_builder_append(
+    az_ulib_ustream_builder* builder,
+    const uint8_t* const buffer,
+    size_t size)
+{
+    /*[az_ulib_ustream_builder_append_null_builder_failed]*/
+    /*[az_ulib_ustream_builder_append_null_buffer_failed]*/
+    /*[az_ulib_ustream_builder_append_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(builder, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t used_size = builder->length % CHUNK_SIZE;
+    size_t copy_size = 0;
+    az_ulib_ustream_builder_chunk* new_first_chunk = NULL;
+    az_ulib_ustream_builder_chunk* new_last_chunk = NULL;
+
+    /* Fill the free space in the last chunk first. It is beyond the length, so it is not visible if the append fails. */
+    if((builder->last_chunk != NULL) && (used_size != 0))
+    {
+        /*[az_ulib_ustream_builder_append_fill_last_chunk_succeed]*/
+        copy_size = CHUNK_SIZE - used_size;
+        if(copy_size > size)
+        {
+            copy_size = size;
+        }
+        (void)memcpy(&(builder->last_chunk->data[used_size]), buffer, copy_size);
+    }
+
+    /*[az_ulib_ustream_builder_append_multiple_chunks_succeed]*/
+    for(size_t offset = copy_size; (result == AZ_ULIB_SUCCESS) && (offset < size); offset += copy_size)
+    {
+        az_ulib_ustream_builder_chunk* chunk = pop_chunk(builder->pool);
+        if(chunk == NULL)
+        {
+            /*[az_ulib_ustream_builder_append_out_of_chunks_failed]*/
+            release_chunks(new_first_chunk);
+            result = AZ_ULIB_OUT_OF_MEMORY_ERROR;
+        }
+        else
+        {
+            copy_size = ((size - offset) < CHUNK_SIZE) ? (size - offset) : CHUNK_SIZE;
+            (void)memcpy(chunk->data, &(buffer[offset]), copy_size);
+            if(new_last_chunk == NULL)
+            {
+                new_first_chunk = chunk;
+            }
+            else
+            {
+                new_last_chunk->next = chunk;
+            }
+            new_last_chunk = chunk;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_builder_append_succeed]*/
+        if(new_first_chunk != NULL)
+        {
+            if(builder->last_chunk == NULL)
+            {
+                builder->first_chunk = new_first_chunk;
+            }
+            else
+            {
+                builder->last_chunk->next = new_first_chunk;
+            }
+            for(az_ulib_ustream_builder_chunk* chunk = new_first_chunk; chunk != NULL; chunk = chunk->next)
+            {
+                link_chunk(chunk, builder->last_chunk);
+                builder->last_chunk = chunk;
+            }
+        }
+        builder->length += size;
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_builder_freeze(
+    az_ulib_ustream_builder* builder,
+    az_ulib_ustream_data_cb* control_block,
+    az_ulib_release_callback control_block_release,
+    az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_builder_freeze_null_builder_failed]*/
+    /*[az_ulib_ustream_builder_freeze_null_control_block_failed]*/
+    /*[az_ulib_ustream_builder_freeze_null_instance_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(builder, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(control_block, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(builder->length == 0)
+    {
+        /*[az_ulib_ustream_builder_freeze_empty_builder_failed]*/
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_builder_freeze_succeed]*/
+        control_block->api = &api;
+        control_block->ptr = (void*)builder->last_chunk;
+        control_block->ref_count = 1;
+        control_block->data_release = release_frozen_chunks;
+        control_block->control_block_release = control_block_release;
+
+        ustream_instance->control_block = control_block;
+        ustream_instance->offset_diff = 0;
+        ustream_instance->inner_current_position = 0;
+        ustream_instance->inner_first_valid_position = 0;
+        ustream_instance->length = builder->length;
+
+        /*[az_ulib_ustream_builder_freeze_builder_reuse_succeed]*/
+        builder->first_chunk = NULL;
+        builder->last_chunk = NULL;
+        builder->length = 0;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_builder_deinit(az_ulib_ustream_builder* builder)
+{
+    /*[az_ulib_ustream_builder_deinit_null_builder_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(builder, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_builder_deinit_succeed]*/
+    release_chunks(builder->first_chunk);
+    builder->first_chunk = NULL;
+    builder->last_chunk = NULL;
+    builder->length = 0;
+
+    return AZ_ULIB_SUCCESS;
+}
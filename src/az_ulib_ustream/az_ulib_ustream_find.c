@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_config.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ulog.h"
+
+#if defined(AZ_ULIB_CONFIG_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define USTREAM_FIND_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/*
+ * Each scan function returns the index of the first match of the pattern that fits entirely in the span, or
+ *  the size of the span if there is none. The SIMD versions compare the first and the last byte of the pattern
+ *  with 16 or 32 positions of the span at once, and only compare the full pattern in the positions where both
+ *  bytes match.
+ */
+typedef size_t (*scan_function)(const uint8_t* span, size_t size, const uint8_t* pattern, size_t pattern_length);
+
+static size_t scan_scalar_from(const uint8_t* span, size_t size, const uint8_t* pattern, size_t pattern_length, size_t start)
+{
+    if(size >= pattern_length)
+    {
+        size_t last = size - pattern_length;
+        while(start <= last)
+        {
+            const uint8_t* candidate = (const uint8_t*)memchr(&span[start], pattern[0], last - start + 1);
+            if(candidate == NULL)
+            {
+                break;
+            }
+            start = (size_t)(candidate - span);
+            if(memcmp(candidate, pattern, pattern_length) == 0)
+            {
+                return start;
+            }
+            start++;
+        }
+    }
+
+    return size;
+}
+
+static size_t scan_scalar(const uint8_t* span, size_t size, const uint8_t* pattern, size_t pattern_length)
+{
+    return scan_scalar_from(span, size, pattern, pattern_length, 0);
+}
+
+#ifdef USTREAM_FIND_X86_SIMD
+__attribute__((target("sse2")))
+static size_t scan_sse2(const uint8_t* span, size_t size, const uint8_t* pattern, size_t pattern_length)
+{
+    const __m128i first = _mm_set1_epi8((char)pattern[0]);
+    const __m128i last = _mm_set1_epi8((char)pattern[pattern_length - 1]);
+    size_t i = 0;
+
+    if(size >= pattern_length)
+    {
+        for(; (size - pattern_length + 1 - i) >= 16; i += 16)
+        {
+            __m128i block_first = _mm_loadu_si128((const __m128i*)&span[i]);
+            __m128i block_last = _mm_loadu_si128((const __m128i*)&span[i + pattern_length - 1]);
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last)));
+            while(mask != 0)
+            {
+                size_t candidate = i + (size_t)__builtin_ctz(mask);
+                if(memcmp(&span[candidate], pattern, pattern_length) == 0)
+                {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    return scan_scalar_from(span, size, pattern, pattern_length, i);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const uint8_t* span, size_t size, const uint8_t* pattern, size_t pattern_length)
+{
+    const __m256i first = _mm256_set1_epi8((char)pattern[0]);
+    const __m256i last = _mm256_set1_epi8((char)pattern[pattern_length - 1]);
+    size_t i = 0;
+
+    if(size >= pattern_length)
+    {
+        for(; (size - pattern_length + 1 - i) >= 32; i += 32)
+        {
+            __m256i block_first = _mm256_loadu_si256((const __m256i*)&span[i]);
+            __m256i block_last = _mm256_loadu_si256((const __m256i*)&span[i + pattern_length - 1]);
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last)));
+            while(mask != 0)
+            {
+                size_t candidate = i + (size_t)__builtin_ctz(mask);
+                if(memcmp(&span[candidate], pattern, pattern_length) == 0)
+                {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    return scan_sse2(&span[i], size - i, pattern, pattern_length) + i;
+}
+#endif /* USTREAM_FIND_X86_SIMD */
+
+static scan_function resolve_scan_function(void)
+{
+#ifdef USTREAM_FIND_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return scan_avx2;
+    }
+    if(__builtin_cpu_supports("sse2"))
+    {
+        return scan_sse2;
+    }
+#endif /* USTREAM_FIND_X86_SIMD */
+    return scan_scalar;
+}
+
+static scan_function get_scan_function(void)
+{
+    /*
+     * The CPU does not change, so the dispatch is resolved only in the first find. Threads that race in the first
+     *  find resolve and store the same function.
+     */
+    static volatile scan_function scan_cache = NULL;
+    scan_function function = scan_cache;
+
+    if(function == NULL)
+    {
+        function = resolve_scan_function();
+        scan_cache = function;
+    }
+
+    return function;
+}
+
+/* Compare the pattern with the content of the ustream from the position, up to the end of the pattern. */
+static az_ulib_result match_from_position(
+    az_ulib_ustream* ustream_instance,
+    offset_t position,
+    const uint8_t* pattern,
+    size_t pattern_length,
+    uint8_t* local_buffer,
+    bool* match)
+{
+    az_ulib_result result = az_ulib_ustream_set_position(ustream_instance, position);
+
+    while((result == AZ_ULIB_SUCCESS) && (pattern_length > 0))
+    {
+        const uint8_t* span;
+        size_t size;
+        if((result = az_ulib_ustream_get_span(ustream_instance, local_buffer, AZ_ULIB_CONFIG_USTREAM_FIND_BUFFER_SIZE,
+                        &span, &size)) == AZ_ULIB_SUCCESS)
+        {
+            size_t compare_size = (size < pattern_length) ? size : pattern_length;
+            if(memcmp(span, pattern, compare_size) != 0)
+            {
+                break;
+            }
+            pattern += compare_size;
+            pattern_length -= compare_size;
+            result = az_ulib_ustream_advance(ustream_instance, compare_size);
+        }
+    }
+
+    if(result == AZ_ULIB_EOF)
+    {
+        /* The ustream ended before the end of the pattern. */
+        result = AZ_ULIB_SUCCESS;
+    }
+    *match = (pattern_length == 0);
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_find(
+    az_ulib_ustream* ustream_instance,
+    const uint8_t* const pattern,
+    size_t pattern_length,
+    offset_t* const position)
+{
+    /*[az_ulib_ustream_find_null_instance_failed]*/
+    /*[az_ulib_ustream_find_null_pattern_failed]*/
+    /*[az_ulib_ustream_find_zero_pattern_length_failed]*/
+    /*[az_ulib_ustream_find_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pattern, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(pattern_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    uint8_t local_buffer[AZ_ULIB_CONFIG_USTREAM_FIND_BUFFER_SIZE];
+    scan_function scan = get_scan_function();
+    offset_t start_position;
+    offset_t span_position;
+    bool found = false;
+
+    /*[az_ulib_ustream_find_get_position_failed]*/
+    if((result = az_ulib_ustream_get_position(ustream_instance, &start_position)) == AZ_ULIB_SUCCESS)
+    {
+        span_position = start_position;
+        while(!found && (result == AZ_ULIB_SUCCESS))
+        {
+            const uint8_t* span;
+            size_t size;
+
+            /*[az_ulib_ustream_find_not_found_succeed]*/
+            if((result = az_ulib_ustream_get_span(ustream_instance, local_buffer, sizeof(local_buffer),
+                            &span, &size)) == AZ_ULIB_SUCCESS)
+            {
+                /*[az_ulib_ustream_find_succeed]*/
+                /*[az_ulib_ustream_find_from_current_position_succeed]*/
+                /*[az_ulib_ustream_find_many_candidates_succeed]*/
+                size_t index = scan(span, size, pattern, pattern_length);
+                if(index < size)
+                {
+                    *position = span_position + index;
+                    found = true;
+                }
+                else
+                {
+                    /* The matches that start in the end of this span and continue in the next ones. */
+                    size_t tail = (size >= pattern_length) ? (size - pattern_length + 1) : 0;
+                    for(; !found && (result == AZ_ULIB_SUCCESS) && (tail < size); tail++)
+                    {
+                        if((span[tail] == pattern[0]) && (memcmp(&span[tail], pattern, size - tail) == 0))
+                        {
+                            /*[az_ulib_ustream_find_across_concat_boundary_succeed]*/
+                            /*[az_ulib_ustream_find_across_multiple_concat_boundaries_succeed]*/
+                            /*[az_ulib_ustream_find_partial_match_at_the_end_succeed]*/
+                            if((result = match_from_position(ustream_instance, span_position + size, &pattern[size - tail],
+                                            pattern_length - (size - tail), local_buffer, &found)) == AZ_ULIB_SUCCESS)
+                            {
+                                if(found)
+                                {
+                                    *position = span_position + tail;
+                                }
+                                else if(((result = az_ulib_ustream_set_position(ustream_instance, span_position)) == AZ_ULIB_SUCCESS) &&
+                                        (span == local_buffer))
+                                {
+                                    /* The local buffer was reused by the match, so get the span back. */
+                                    result = az_ulib_ustream_get_span(ustream_instance, local_buffer, sizeof(local_buffer),
+                                                &span, &size);
+                                }
+                            }
+                        }
+                    }
+
+                    if(!found && (result == AZ_ULIB_SUCCESS))
+                    {
+                        span_position += size;
+                        result = az_ulib_ustream_set_position(ustream_instance, span_position);
+                    }
+                }
+            }
+        }
+
+        (void)az_ulib_ustream_set_position(ustream_instance, start_position);
+    }
+
+    if(found)
+    {
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
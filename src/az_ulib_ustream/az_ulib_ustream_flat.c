@@ -0,0 +1,627 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_result.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_ustream_aux.h"
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+static void destroy_instance(az_ulib_ustream* ustream_instance)
+{
+    az_ulib_ustream_flat_data_cb* flat_data = (az_ulib_ustream_flat_data_cb*)ustream_instance->control_block->ptr;
+
+    for(size_t i = 0; i < flat_data->segment_count; i++)
+    {
+        (void)az_ulib_ustream_dispose(&(flat_data->segments[i].ustream));
+    }
+    az_pal_os_lock_deinit(&flat_data->lock);
+
+    if(ustream_instance->control_block->data_release != NULL)
+    {
+        ustream_instance->control_block->data_release(ustream_instance->control_block->ptr);
+    }
+}
+
+/* Binary search for the segment that contains the inner position. */
+static size_t find_segment(const az_ulib_ustream_flat_data_cb* flat_data, offset_t inner_position)
+{
+    size_t low = 0;
+    size_t high = flat_data->segment_count;
+
+    while(low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+        if(flat_data->segments[middle].end <= inner_position)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/* The first segment shares the inner positions with the flat instance, the other ones were cloned
+ * with their logical positions starting at the end of the previous segment. */
+static offset_t segment_position(const az_ulib_ustream_flat_data_cb* flat_data, size_t index, offset_t inner_position)
+{
+    return (index == 0) ? (inner_position + flat_data->segments[0].ustream.offset_diff) : inner_position;
+}
+
+static az_ulib_result concrete_set_position(
+        az_ulib_ustream* ustream_instance,
+        offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+       (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+    return AZ_ULIB_SUCCESS;
+}
+
+/* Copy the content from the inner position to the local buffers, in order, crossing the segments when
+ * needed. The segment of the inner position is found by a binary search, and the next ones are just the
+ * next entries in the table. The instance is not changed, the caller shall move its current position when
+ * it is the case. */
+static az_ulib_result flat_read_iov(
+        az_ulib_ustream* ustream_instance,
+        offset_t inner_position,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    az_ulib_ustream_flat_data_cb* flat_data = (az_ulib_ustream_flat_data_cb*)ustream_instance->control_block->ptr;
+    size_t remain_size = (inner_position < ustream_instance->length) ?
+                            (ustream_instance->length - (size_t)inner_position) : 0;
+    size_t segment_index = find_segment(flat_data, inner_position);
+    size_t iov_index = 0;
+    size_t iov_offset = 0;
+
+    *size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (iov_index < iov_count) && (*size < remain_size) &&
+            (segment_index < flat_data->segment_count))
+    {
+        if(iov_offset >= iov[iov_index].buffer_length)
+        {
+            iov_index++;
+            iov_offset = 0;
+        }
+        else if(inner_position >= flat_data->segments[segment_index].end)
+        {
+            segment_index++;
+        }
+        else
+        {
+            az_ulib_ustream* current_ustream = &(flat_data->segments[segment_index].ustream);
+            size_t copied_size;
+            size_t copy_size = iov[iov_index].buffer_length - iov_offset;
+            if(copy_size > (remain_size - *size))
+            {
+                copy_size = remain_size - *size;
+            }
+
+            /*[az_ulib_ustream_flat_read_clone_and_original_in_parallel_succeed]*/
+            if((result = _az_ulib_ustream_read_inner(&flat_data->lock, current_ustream,
+                            segment_position(flat_data, segment_index, inner_position),
+                            &(iov[iov_index].buffer[iov_offset]), copy_size, &copied_size)) == AZ_ULIB_SUCCESS)
+            {
+                *size += copied_size;
+                inner_position += copied_size;
+                iov_offset += copied_size;
+                if(copied_size == 0)
+                {
+                    result = AZ_ULIB_EOF;
+                }
+            }
+        }
+    }
+
+    if(*size != 0)
+    {
+        /*[az_ulib_ustream_concat_n_read_from_multiple_buffers_succeed]*/
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(remain_size == 0)
+    {
+        result = AZ_ULIB_EOF;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    az_ulib_ustream_iovec iov = { buffer, buffer_length };
+
+    /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+    /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+    if((result = flat_read_iov(ustream_instance, ustream_instance->inner_current_position, &iov, 1, size)) == AZ_ULIB_SUCCESS)
+    {
+        ustream_instance->inner_current_position += *size;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+    /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_no_memory_to_create_instance_failed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    ustream_instance_clone->inner_current_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->inner_first_valid_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->offset_diff = offset - ustream_instance->inner_current_position;
+    ustream_instance_clone->control_block = ustream_instance->control_block;
+    ustream_instance_clone->length = ustream_instance->length;
+
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        destroy_instance(ustream_instance);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    offset_t inner_position = ustream_instance->inner_current_position;
+    az_ulib_ustream_flat_data_cb* flat_data = (az_ulib_ustream_flat_data_cb*)ustream_instance->control_block->ptr;
+    size_t segment_index = find_segment(flat_data, inner_position);
+
+    if((inner_position >= ustream_instance->length) || (segment_index >= flat_data->segment_count))
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        az_ulib_ustream* current_ustream = &(flat_data->segments[segment_index].ustream);
+
+        //Critical section to make sure another instance doesn't set_position before this one peeks
+        az_pal_os_lock_acquire(&flat_data->lock);
+        /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+        if((result = az_ulib_ustream_set_position(current_ustream,
+                        segment_position(flat_data, segment_index, inner_position))) == AZ_ULIB_SUCCESS)
+        {
+            result = az_ulib_ustream_peek(current_ustream, buffer, size);
+        }
+        az_pal_os_lock_release(&flat_data->lock);
+
+        /* A split flat instance may end before the end of its segments. */
+        if((result == AZ_ULIB_SUCCESS) && (*size > (ustream_instance->length - inner_position)))
+        {
+            *size = ustream_instance->length - inner_position;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+        if((result = flat_read_iov(ustream_instance, ustream_instance->inner_current_position, iov, iov_count, size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        az_ulib_ustream_iovec iov = { buffer, buffer_length };
+        result = flat_read_iov(ustream_instance, inner_position, &iov, 1, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_flat_hint_forward_to_segments_succeed]*/
+        /*[az_ulib_ustream_flat_hint_forward_failed]*/
+        az_ulib_ustream_flat_data_cb* flat_data = (az_ulib_ustream_flat_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+
+        /* The hint does not change the segments, so it is forwarded without the lock, only to the segments that
+         * contain part of the range. */
+        result = AZ_ULIB_SUCCESS;
+        for(size_t index = find_segment(flat_data, inner_position);
+            (result == AZ_ULIB_SUCCESS) && (inner_position < inner_end); index++)
+        {
+            offset_t segment_end = (inner_end < flat_data->segments[index].end) ? inner_end : flat_data->segments[index].end;
+            result = az_ulib_ustream_hint(&flat_data->segments[index].ustream, hint,
+                            segment_position(flat_data, index, inner_position), (size_t)(segment_end - inner_position));
+            inner_position = segment_end;
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_concat_n(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream* ustreams_to_concat,
+    size_t ustream_count,
+    az_ulib_ustream_flat_data_cb* flat_data,
+    az_ulib_release_callback flat_data_release)
+{
+    /*[az_ulib_ustream_concat_n_null_instance_failed]*/
+    /*[az_ulib_ustream_concat_n_null_ustreams_to_concat_failed]*/
+    /*[az_ulib_ustream_concat_n_zero_ustream_count_failed]*/
+    /*[az_ulib_ustream_concat_n_null_flat_data_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustreams_to_concat, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(ustream_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(flat_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    az_ulib_ustream_flat_segment* segments = (az_ulib_ustream_flat_segment*)(flat_data + 1);
+    offset_t end = ustream_instance->length;
+    size_t i;
+
+    /* Clone the ustreams to concat first, so the ustream_instance is not changed if any of them fails. */
+    for(i = 0; (result == AZ_ULIB_SUCCESS) && (i < ustream_count); i++)
+    {
+        /*[az_ulib_ustream_concat_n_multiple_buffers_succeed]*/
+        /*[az_ulib_ustream_concat_n_clone_failed]*/
+        if((result = az_ulib_ustream_clone(&(segments[i + 1].ustream), &(ustreams_to_concat[i]), end)) == AZ_ULIB_SUCCESS)
+        {
+            size_t remaining_size;
+            if((result = az_ulib_ustream_get_remaining_size(&(segments[i + 1].ustream), &remaining_size)) == AZ_ULIB_SUCCESS)
+            {
+                end += remaining_size;
+                segments[i + 1].end = end;
+            }
+            else
+            {
+                /*[az_ulib_ustream_concat_n_get_remaining_size_failed]*/
+                (void)az_ulib_ustream_dispose(&(segments[i + 1].ustream));
+            }
+        }
+    }
+
+    if(result != AZ_ULIB_SUCCESS)
+    {
+        /* The segment i failed and was not cloned, dispose all the previous ones. */
+        for(i = i - 1; i > 0; i--)
+        {
+            (void)az_ulib_ustream_dispose(&(segments[i].ustream));
+        }
+    }
+    else
+    {
+        segments[0].ustream = *ustream_instance;
+        segments[0].end = ustream_instance->length;
+        flat_data->segments = segments;
+        flat_data->segment_count = ustream_count + 1;
+        az_pal_os_lock_init(&flat_data->lock);
+
+        flat_data->control_block.api = &api;
+        flat_data->control_block.ptr = (void*)flat_data;
+        flat_data->control_block.ref_count = 1;
+        flat_data->control_block.control_block_release = NULL;
+        flat_data->control_block.data_release = flat_data_release;
+
+        ustream_instance->control_block = &(flat_data->control_block);
+        ustream_instance->length = end;
+    }
+
+    return result;
+}
@@ -0,0 +1,1192 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_lz.h"
+#include "az_ulib_config.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_ustream_aux.h"
+
+#if (AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE > 65535)
+#error "AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE shall fit in the 16 bits of the chunk header"
+#endif
+
+#if (AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE < 2) || ((AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE % 2) != 0)
+#error "AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE shall be an even number bigger than 0"
+#endif
+
+/* Constants of the LZ4 block format. */
+#define LZ_MIN_MATCH            4
+#define LZ_LAST_LITERALS        5
+#define LZ_MATCH_FIND_LIMIT     12
+#define LZ_LENGTH_MASK          0x0F
+#define LZ_LENGTH_EXTENDED      15
+#define LZ_LENGTH_BYTE_MAX      255
+#define LZ_SKIP_TRIGGER         6
+#define LZ_HASH_MULTIPLIER      2654435761u
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+/*
+ * LZ codec. The payload of each compressed chunk follows the LZ4 block format: a sequence of tokens, each one with
+ *  a number of literals copied from the payload, followed by a match copied from the content already decompressed
+ *  in the chunk. The chunks are independent, so a match never refers to the content of a previous chunk.
+ */
+static inline uint32_t read_32(const uint8_t* source)
+{
+    uint32_t value;
+    (void)memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+static inline size_t hash_32(uint32_t value)
+{
+    return (size_t)((value * LZ_HASH_MULTIPLIER) >> (32 - AZ_ULIB_USTREAM_LZ_HASH_LOG));
+}
+
+static inline uint8_t* write_length(uint8_t* destination, size_t length)
+{
+    if(length >= LZ_LENGTH_EXTENDED)
+    {
+        length -= LZ_LENGTH_EXTENDED;
+        while(length >= LZ_LENGTH_BYTE_MAX)
+        {
+            *(destination++) = LZ_LENGTH_BYTE_MAX;
+            length -= LZ_LENGTH_BYTE_MAX;
+        }
+        *(destination++) = (uint8_t)length;
+    }
+
+    return destination;
+}
+
+/* Write one sequence with the literals and the match. The last sequence of the chunk has only literals, and it is
+ * written with the match_length zero. Returns false if the sequence does not fit up to the destination_end. */
+static bool write_sequence(
+    uint8_t** destination,
+    const uint8_t* destination_end,
+    const uint8_t* literals,
+    size_t literal_length,
+    size_t offset,
+    size_t match_length)
+{
+    uint8_t* current = *destination;
+    size_t extra_match_length = (match_length != 0) ? (match_length - LZ_MIN_MATCH) : 0;
+    size_t max_size = 1 + (literal_length / LZ_LENGTH_BYTE_MAX) + 1 + literal_length +
+                        ((match_length != 0) ? (2 + (extra_match_length / LZ_LENGTH_BYTE_MAX) + 1) : 0);
+    bool result;
+
+    if((size_t)(destination_end - current) < max_size)
+    {
+        result = false;
+    }
+    else
+    {
+        uint8_t* token = current++;
+        *token = (uint8_t)(((literal_length < LZ_LENGTH_EXTENDED) ? literal_length : LZ_LENGTH_EXTENDED) << 4);
+        current = write_length(current, literal_length);
+        (void)memcpy(current, literals, literal_length);
+        current += literal_length;
+
+        if(match_length != 0)
+        {
+            *(current++) = (uint8_t)(offset & 0xFF);
+            *(current++) = (uint8_t)(offset >> 8);
+            *token |= (uint8_t)((extra_match_length < LZ_LENGTH_EXTENDED) ? extra_match_length : LZ_LENGTH_EXTENDED);
+            current = write_length(current, extra_match_length);
+        }
+
+        *destination = current;
+        result = true;
+    }
+
+    return result;
+}
+
+/* Compress the source in the destination, with a greedy search of the last position with the same hash. Returns
+ * the size of the compressed content, or zero if it does not fit in the destination_size. */
+static size_t lz_compress(
+    const uint8_t* source,
+    size_t source_size,
+    uint8_t* destination,
+    size_t destination_size,
+    uint16_t* hash_table)
+{
+    uint8_t* current = destination;
+    const uint8_t* destination_end = destination + destination_size;
+    size_t anchor = 0;
+    bool fit = true;
+
+    if(source_size > LZ_MATCH_FIND_LIMIT)
+    {
+        /* The LZ4 block format requires the last match to start 12 bytes before the end of the block, and to end 5
+         * bytes before it. The zeros in the hash table point to the position 0, matches are always verified. */
+        size_t find_limit = source_size - LZ_MATCH_FIND_LIMIT;
+        size_t match_limit = source_size - LZ_LAST_LITERALS;
+        size_t position = 1;
+
+        (void)memset(hash_table, 0, sizeof(uint16_t) << AZ_ULIB_USTREAM_LZ_HASH_LOG);
+
+        while(fit && (position < find_limit))
+        {
+            uint32_t sequence = read_32(&source[position]);
+            size_t hash = hash_32(sequence);
+            size_t candidate = hash_table[hash];
+            hash_table[hash] = (uint16_t)position;
+
+            if((candidate < position) && (read_32(&source[candidate]) == sequence))
+            {
+                size_t match_length = LZ_MIN_MATCH;
+
+                while((position > anchor) && (candidate > 0) && (source[position - 1] == source[candidate - 1]))
+                {
+                    position--;
+                    candidate--;
+                    match_length++;
+                }
+                while(((position + match_length) < match_limit) &&
+                        (source[position + match_length] == source[candidate + match_length]))
+                {
+                    match_length++;
+                }
+
+                fit = write_sequence(&current, destination_end, &source[anchor], position - anchor,
+                        position - candidate, match_length);
+
+                position += match_length;
+                anchor = position;
+                if(position < find_limit)
+                {
+                    hash_table[hash_32(read_32(&source[position - 2]))] = (uint16_t)(position - 2);
+                }
+            }
+            else
+            {
+                /* Skip faster over content that does not compress. */
+                position += 1 + ((position - anchor) >> LZ_SKIP_TRIGGER);
+            }
+        }
+    }
+
+    return (fit && write_sequence(&current, destination_end, &source[anchor], source_size - anchor, 0, 0)) ?
+                (size_t)(current - destination) : 0;
+}
+
+static inline bool read_length(const uint8_t* source, size_t source_size, size_t* position, size_t* length)
+{
+    bool result = true;
+
+    if(*length == LZ_LENGTH_EXTENDED)
+    {
+        uint8_t value;
+        do
+        {
+            if(*position >= source_size)
+            {
+                result = false;
+                break;
+            }
+            value = source[(*position)++];
+            *length += value;
+        } while(value == LZ_LENGTH_BYTE_MAX);
+    }
+
+    return result;
+}
+
+/* Decompress the source in the destination. Returns false if the source is not a valid LZ4 block, or if it does
+ * not decompress in exactly destination_size bytes. */
+static bool lz_decompress(
+    const uint8_t* source,
+    size_t source_size,
+    uint8_t* destination,
+    size_t destination_size)
+{
+    size_t source_position = 0;
+    size_t destination_position = 0;
+    bool result = false;
+
+    while(source_position < source_size)
+    {
+        uint8_t token = source[source_position++];
+        size_t length = (size_t)(token >> 4);
+        size_t offset;
+
+        if(!read_length(source, source_size, &source_position, &length) ||
+                (length > (source_size - source_position)) ||
+                (length > (destination_size - destination_position)))
+        {
+            break;
+        }
+        (void)memcpy(&destination[destination_position], &source[source_position], length);
+        source_position += length;
+        destination_position += length;
+
+        if(source_position == source_size)
+        {
+            /* The last sequence has only literals. */
+            result = (destination_position == destination_size);
+            break;
+        }
+
+        if((source_size - source_position) < 2)
+        {
+            break;
+        }
+        offset = (size_t)source[source_position] | ((size_t)source[source_position + 1] << 8);
+        source_position += 2;
+        length = (size_t)(token & LZ_LENGTH_MASK);
+        if((offset == 0) || (offset > destination_position) ||
+                !read_length(source, source_size, &source_position, &length) ||
+                ((length + LZ_MIN_MATCH) > (destination_size - destination_position)))
+        {
+            break;
+        }
+        length += LZ_MIN_MATCH;
+
+        /* The match may overlap the content that it copies, which repeats it. Each copy doubles the distance
+         * between the source and destination of the copy, so they never overlap. */
+        size_t match_position = destination_position - offset;
+        while(length > 0)
+        {
+            size_t copy_size = destination_position - match_position;
+            if(copy_size > length)
+            {
+                copy_size = length;
+            }
+            (void)memcpy(&destination[destination_position], &destination[match_position], copy_size);
+            destination_position += copy_size;
+            length -= copy_size;
+        }
+    }
+
+    return result;
+}
+
+/* Read the source from the position up to the size, crossing the boundaries of composed sources. The source
+ * is shared by all the instances, so it is read with read_at, or under the lock if it does not support it. */
+static az_ulib_result read_source(
+    az_ulib_ustream_lz_data_cb* lz_data,
+    offset_t position,
+    uint8_t* buffer,
+    size_t size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t read_size = 0;
+
+    while((result == AZ_ULIB_SUCCESS) && (read_size < size))
+    {
+        size_t copied_size;
+        if((result = _az_ulib_ustream_read_inner(&lz_data->source_lock, &lz_data->source, position + read_size,
+                        &buffer[read_size], size - read_size, &copied_size)) == AZ_ULIB_SUCCESS)
+        {
+            read_size += copied_size;
+        }
+    }
+
+    return result;
+}
+
+/* Read and validate the header of the compressed chunk in the source position. */
+static az_ulib_result read_chunk_header(
+    az_ulib_ustream_lz_data_cb* lz_data,
+    offset_t source_position,
+    size_t* size,
+    size_t* payload_size)
+{
+    az_ulib_result result;
+    uint8_t header[AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE];
+    size_t remaining_size = lz_data->source_length - (size_t)source_position;
+
+    if(remaining_size < AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE)
+    {
+        /*[az_ulib_ustream_lz_decompress_invalid_chunk_header_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else if((result = read_source(lz_data, source_position, header, AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE)) ==
+                AZ_ULIB_SUCCESS)
+    {
+        *size = (size_t)header[0] | ((size_t)header[1] << 8);
+        *payload_size = (size_t)header[2] | ((size_t)header[3] << 8);
+
+        if((*size == 0) || (*size > AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE) || (*payload_size == 0) ||
+                (*payload_size > *size) || (*payload_size > (remaining_size - AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE)))
+        {
+            /*[az_ulib_ustream_lz_decompress_invalid_chunk_header_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+    }
+
+    return result;
+}
+
+/* Compress the chunk of the source that starts in the source position. */
+static az_ulib_result compress_chunk(az_ulib_ustream_lz_data_cb* lz_data, offset_t chunk_position, offset_t source_position)
+{
+    az_ulib_result result;
+    size_t size = lz_data->source_length - (size_t)source_position;
+
+    if(size > AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE)
+    {
+        size = AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE;
+    }
+
+    lz_data->chunk_size = 0;
+    if((result = read_source(lz_data, source_position, lz_data->work, size)) == AZ_ULIB_SUCCESS)
+    {
+        /* The payload shall be smaller than the content, otherwise the content is stored as is. */
+        size_t payload_size = lz_compress(lz_data->work, size, &lz_data->chunk[AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE],
+                                size - 1, lz_data->hash_table);
+        if(payload_size == 0)
+        {
+            /*[az_ulib_ustream_lz_compress_incompressible_content_succeed]*/
+            (void)memcpy(&lz_data->chunk[AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE], lz_data->work, size);
+            payload_size = size;
+        }
+
+        lz_data->chunk[0] = (uint8_t)(size & 0xFF);
+        lz_data->chunk[1] = (uint8_t)(size >> 8);
+        lz_data->chunk[2] = (uint8_t)(payload_size & 0xFF);
+        lz_data->chunk[3] = (uint8_t)(payload_size >> 8);
+
+        lz_data->chunk_position = chunk_position;
+        lz_data->chunk_size = AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE + payload_size;
+        lz_data->chunk_source_position = source_position;
+        lz_data->chunk_source_size = size;
+    }
+
+    return result;
+}
+
+/* Decompress the chunk of the source that starts in the source position, with the size and payload_size from its
+ * header. */
+static az_ulib_result decompress_chunk(
+    az_ulib_ustream_lz_data_cb* lz_data,
+    offset_t chunk_position,
+    offset_t source_position,
+    size_t size,
+    size_t payload_size)
+{
+    az_ulib_result result;
+    offset_t payload_position = source_position + AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE;
+
+    lz_data->chunk_size = 0;
+    if(payload_size == size)
+    {
+        /* The content was stored as is. */
+        result = read_source(lz_data, payload_position, lz_data->chunk, size);
+    }
+    else if(((result = read_source(lz_data, payload_position, lz_data->work, payload_size)) == AZ_ULIB_SUCCESS) &&
+                !lz_decompress(lz_data->work, payload_size, lz_data->chunk, size))
+    {
+        /*[az_ulib_ustream_lz_decompress_invalid_payload_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        lz_data->chunk_position = chunk_position;
+        lz_data->chunk_size = size;
+        lz_data->chunk_source_position = source_position;
+        lz_data->chunk_source_size = AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE + payload_size;
+    }
+
+    return result;
+}
+
+/* Record the chunk with the provided number in the index, if it is in the stride. The factories call it for each
+ * chunk in order. When the index is full, it drops every other entry and doubles the stride, so the index covers
+ * contents of any size with a fixed number of entries. */
+static void index_add(
+    az_ulib_ustream_lz_data_cb* lz_data,
+    size_t chunk_number,
+    offset_t chunk_position,
+    offset_t source_position)
+{
+    if((chunk_number % lz_data->index_stride) == 0)
+    {
+        if(lz_data->index_count == AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE)
+        {
+            for(size_t i = 1; i < (AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE / 2); i++)
+            {
+                lz_data->index[i] = lz_data->index[i * 2];
+            }
+            lz_data->index_count = AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE / 2;
+            lz_data->index_stride *= 2;
+        }
+
+        if((chunk_number % lz_data->index_stride) == 0)
+        {
+            lz_data->index[lz_data->index_count].position = chunk_position;
+            lz_data->index[lz_data->index_count].source_position = source_position;
+            lz_data->index_count++;
+        }
+    }
+}
+
+/* Returns the last indexed chunk that starts at or before the position of the transformed content. The first chunk
+ * is always indexed. */
+static const az_ulib_ustream_lz_index_entry* index_find(az_ulib_ustream_lz_data_cb* lz_data, offset_t position)
+{
+    size_t first = 0;
+    size_t last = lz_data->index_count - 1;
+
+    while(first < last)
+    {
+        size_t middle = first + ((last - first + 1) / 2);
+        if(lz_data->index[middle].position <= position)
+        {
+            first = middle;
+        }
+        else
+        {
+            last = middle - 1;
+        }
+    }
+
+    return &lz_data->index[first];
+}
+
+/* Load the chunk with the position of the transformed content. It walks from the current chunk if the position is
+ * after it, and no indexed chunk is closer, or from the closest indexed chunk otherwise. Shall be called under the
+ * lock. */
+static az_ulib_result load_chunk(az_ulib_ustream_lz_data_cb* lz_data, offset_t position)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    const az_ulib_ustream_lz_index_entry* entry = index_find(lz_data, position);
+    offset_t chunk_position = entry->position;
+    offset_t source_position = entry->source_position;
+
+    if((lz_data->chunk_size != 0) && (position >= lz_data->chunk_position) &&
+            (lz_data->chunk_position >= chunk_position))
+    {
+        chunk_position = lz_data->chunk_position + lz_data->chunk_size;
+        source_position = lz_data->chunk_source_position + lz_data->chunk_source_size;
+    }
+
+    while(result == AZ_ULIB_SUCCESS)
+    {
+        if(source_position >= lz_data->source_length)
+        {
+            result = AZ_ULIB_EOF;
+        }
+        else if(lz_data->decompress)
+        {
+            size_t size;
+            size_t payload_size;
+            if((result = read_chunk_header(lz_data, source_position, &size, &payload_size)) == AZ_ULIB_SUCCESS)
+            {
+                if(position < (chunk_position + size))
+                {
+                    /*[az_ulib_ustream_lz_decompress_set_position_succeed]*/
+                    result = decompress_chunk(lz_data, chunk_position, source_position, size, payload_size);
+                    break;
+                }
+                /* Skip the chunk without decompressing it. */
+                chunk_position += size;
+                source_position += AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE + payload_size;
+            }
+        }
+        else if((result = compress_chunk(lz_data, chunk_position, source_position)) == AZ_ULIB_SUCCESS)
+        {
+            if(position < (chunk_position + lz_data->chunk_size))
+            {
+                /*[az_ulib_ustream_lz_compress_set_position_succeed]*/
+                break;
+            }
+            chunk_position += lz_data->chunk_size;
+            source_position += lz_data->chunk_source_size;
+        }
+    }
+
+    return result;
+}
+
+/* Copy the transformed content from the position. Each call loads at most one new chunk, so the work does not
+ * depend on the size of the buffer. */
+static az_ulib_result transform_copy(
+    az_ulib_ustream* ustream_instance,
+    offset_t inner_position,
+    uint8_t* buffer,
+    size_t buffer_length,
+    size_t* size)
+{
+    az_ulib_ustream_lz_data_cb* lz_data = (az_ulib_ustream_lz_data_cb*)ustream_instance->control_block->ptr;
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t remaining_size = ustream_instance->length - (size_t)inner_position;
+    bool loaded = false;
+
+    if(buffer_length > remaining_size)
+    {
+        buffer_length = remaining_size;
+    }
+    *size = 0;
+
+    az_pal_os_lock_acquire(&lz_data->lock);
+    while((result == AZ_ULIB_SUCCESS) && (*size < buffer_length))
+    {
+        offset_t position = inner_position + *size;
+
+        if((lz_data->chunk_size == 0) || (position < lz_data->chunk_position) ||
+                (position >= (lz_data->chunk_position + lz_data->chunk_size)))
+        {
+            if(loaded)
+            {
+                /*[az_ulib_ustream_lz_decompress_read_one_chunk_per_call_succeed]*/
+                break;
+            }
+            result = load_chunk(lz_data, position);
+            loaded = true;
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            size_t chunk_offset = (size_t)(position - lz_data->chunk_position);
+            size_t copy_size = lz_data->chunk_size - chunk_offset;
+            if(copy_size > (buffer_length - *size))
+            {
+                copy_size = buffer_length - *size;
+            }
+            (void)memcpy(&buffer[*size], &lz_data->chunk[chunk_offset], copy_size);
+            *size += copy_size;
+        }
+    }
+    az_pal_os_lock_release(&lz_data->lock);
+
+    /* The content copied before a failure is returned, the next read will report the failure. */
+    if(*size != 0)
+    {
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+    ustream_instance->inner_current_position = inner_current_position;
+    ustream_instance->inner_first_valid_position = inner_current_position;
+    ustream_instance->offset_diff = offset - inner_current_position;
+    ustream_instance->control_block = control_block;
+    ustream_instance->length = data_buffer_length;
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+static void destroy_instance(az_ulib_ustream* ustream_instance)
+{
+    az_ulib_ustream_lz_data_cb* lz_data = (az_ulib_ustream_lz_data_cb*)ustream_instance->control_block->ptr;
+
+    (void)az_ulib_ustream_dispose(&lz_data->source);
+    az_pal_os_lock_deinit(&lz_data->source_lock);
+    az_pal_os_lock_deinit(&lz_data->lock);
+
+    if(ustream_instance->control_block->data_release != NULL)
+    {
+        ustream_instance->control_block->data_release(ustream_instance->control_block->ptr);
+    }
+}
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_lz_compress_set_position_succeed]*/
+        /*[az_ulib_ustream_lz_decompress_set_position_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+        /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_lz_compress_succeed]*/
+        /*[az_ulib_ustream_lz_decompress_succeed]*/
+        if((result = transform_copy(ustream_instance, ustream_instance->inner_current_position, buffer, buffer_length,
+                        size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+        /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    init_instance(ustream_instance_clone, ustream_instance->control_block, ustream_instance->inner_current_position, offset,
+                                                            ustream_instance->length);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    /*[az_ulib_ustream_lz_dispose_source_succeed]*/
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        destroy_instance(ustream_instance);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_peek_compliance_not_supported_failed]*/
+    /* The transformed content only exists in the chunk shared by the instances, which changes on each read. */
+    return AZ_ULIB_NOT_SUPPORTED_ERROR;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        if(ustream_instance->inner_current_position >= ustream_instance->length)
+        {
+            /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+            *size = 0;
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+            /*[az_ulib_ustream_lz_compress_readv_cross_chunks_succeed]*/
+            /*[az_ulib_ustream_lz_decompress_readv_cross_chunks_succeed]*/
+            offset_t inner_position = ustream_instance->inner_current_position;
+            *size = 0;
+
+            for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < iov_count) && (inner_position < ustream_instance->length); i++)
+            {
+                /* Each copy stops at the end of a chunk, so fill the buffer before moving to the next one, otherwise
+                 * the content would not be contiguous in the buffers. */
+                size_t buffer_size = 0;
+                while((result == AZ_ULIB_SUCCESS) && (buffer_size < iov[i].buffer_length) &&
+                        (inner_position < ustream_instance->length))
+                {
+                    size_t copied_size;
+                    if((result = transform_copy(ustream_instance, inner_position, &iov[i].buffer[buffer_size],
+                                    iov[i].buffer_length - buffer_size, &copied_size)) == AZ_ULIB_SUCCESS)
+                    {
+                        buffer_size += copied_size;
+                        *size += copied_size;
+                        inner_position += copied_size;
+                    }
+                }
+            }
+
+            if(*size != 0)
+            {
+                ustream_instance->inner_current_position += *size;
+                result = AZ_ULIB_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(inner_position == ustream_instance->length)
+    {
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        result = transform_copy(ustream_instance, inner_position, buffer, buffer_length, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_lz_hint_forward_to_source_succeed]*/
+        az_ulib_ustream_lz_data_cb* lz_data = (az_ulib_ustream_lz_data_cb*)ustream_instance->control_block->ptr;
+
+        /* The range of the source that produces a range of the transformed content is only known after the
+         * transformation, so only the access patterns are forwarded, for the whole source. */
+        if((hint == AZ_ULIB_USTREAM_HINT_SEQUENTIAL) || (hint == AZ_ULIB_USTREAM_HINT_RANDOM))
+        {
+            result = az_ulib_ustream_hint(&lz_data->source, hint, 0, lz_data->source_length);
+        }
+        else
+        {
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+
+/* Clone the source and initialize the control block, without the instance. */
+static az_ulib_result lz_data_init(
+    az_ulib_ustream_lz_data_cb* lz_data,
+    az_ulib_release_callback lz_data_release,
+    az_ulib_ustream* ustream_to_transform,
+    bool decompress)
+{
+    az_ulib_result result;
+
+    if((result = az_ulib_ustream_get_remaining_size(ustream_to_transform, &lz_data->source_length)) == AZ_ULIB_SUCCESS)
+    {
+        if(lz_data->source_length == 0)
+        {
+            /*[az_ulib_ustream_lz_compress_empty_source_failed]*/
+            /*[az_ulib_ustream_lz_decompress_empty_source_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else if((result = az_ulib_ustream_clone(&lz_data->source, ustream_to_transform, 0)) == AZ_ULIB_SUCCESS)
+        {
+            az_pal_os_lock_init(&lz_data->lock);
+            az_pal_os_lock_init(&lz_data->source_lock);
+            lz_data->decompress = decompress;
+            lz_data->chunk_position = 0;
+            lz_data->chunk_size = 0;
+            lz_data->chunk_source_position = 0;
+            lz_data->chunk_source_size = 0;
+            lz_data->index_count = 0;
+            lz_data->index_stride = 1;
+
+            lz_data->control_block.api = &api;
+            lz_data->control_block.ptr = (void*)lz_data;
+            lz_data->control_block.ref_count = 0;
+            lz_data->control_block.data_release = lz_data_release;
+            lz_data->control_block.control_block_release = NULL;
+        }
+    }
+
+    return result;
+}
+
+static void lz_data_deinit(az_ulib_ustream_lz_data_cb* lz_data)
+{
+    (void)az_ulib_ustream_dispose(&lz_data->source);
+    az_pal_os_lock_deinit(&lz_data->source_lock);
+    az_pal_os_lock_deinit(&lz_data->lock);
+}
+
+az_ulib_result az_ulib_ustream_lz_compress(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_lz_data_cb* lz_data,
+    az_ulib_release_callback lz_data_release,
+    az_ulib_ustream* ustream_to_compress)
+{
+    /*[az_ulib_ustream_lz_compress_null_instance_failed]*/
+    /*[az_ulib_ustream_lz_compress_null_lz_data_failed]*/
+    /*[az_ulib_ustream_lz_compress_null_ustream_to_compress_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(lz_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_compress, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if((result = lz_data_init(lz_data, lz_data_release, ustream_to_compress, false)) == AZ_ULIB_SUCCESS)
+    {
+        /* Compress all chunks to find the size of the compressed content, and index them. The last chunk stays
+         * loaded. */
+        offset_t source_position = 0;
+        size_t length = 0;
+
+        for(size_t chunk_number = 0; (result == AZ_ULIB_SUCCESS) && (source_position < lz_data->source_length);
+                chunk_number++)
+        {
+            index_add(lz_data, chunk_number, (offset_t)length, source_position);
+            if((result = compress_chunk(lz_data, (offset_t)length, source_position)) == AZ_ULIB_SUCCESS)
+            {
+                if(lz_data->chunk_size > (AZ_ULIB_OFFSET_MAX - length))
+                {
+                    /* The compressed content would not fit in the positions of a ustream. */
+                    result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+                }
+                else
+                {
+                    length += lz_data->chunk_size;
+                    source_position += lz_data->chunk_source_size;
+                }
+            }
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_lz_compress_succeed]*/
+            init_instance(ustream_instance, &lz_data->control_block, 0, 0, length);
+        }
+        else
+        {
+            lz_data_deinit(lz_data);
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_lz_decompress(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_lz_data_cb* lz_data,
+    az_ulib_release_callback lz_data_release,
+    az_ulib_ustream* ustream_to_decompress)
+{
+    /*[az_ulib_ustream_lz_decompress_null_instance_failed]*/
+    /*[az_ulib_ustream_lz_decompress_null_lz_data_failed]*/
+    /*[az_ulib_ustream_lz_decompress_null_ustream_to_decompress_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(lz_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_decompress, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if((result = lz_data_init(lz_data, lz_data_release, ustream_to_decompress, true)) == AZ_ULIB_SUCCESS)
+    {
+        /* Walk the chunk headers to validate them, to find the size of the decompressed content, and to index
+         * the chunks. */
+        offset_t source_position = 0;
+        size_t length = 0;
+
+        for(size_t chunk_number = 0; (result == AZ_ULIB_SUCCESS) && (source_position < lz_data->source_length);
+                chunk_number++)
+        {
+            size_t size;
+            size_t payload_size;
+            index_add(lz_data, chunk_number, (offset_t)length, source_position);
+            if((result = read_chunk_header(lz_data, source_position, &size, &payload_size)) == AZ_ULIB_SUCCESS)
+            {
+                if(size > (AZ_ULIB_OFFSET_MAX - length))
+                {
+                    /* The decompressed content would not fit in the positions of a ustream. */
+                    result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+                }
+                else
+                {
+                    length += size;
+                    source_position += AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE + payload_size;
+                }
+            }
+        }
+
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_lz_decompress_succeed]*/
+            init_instance(ustream_instance, &lz_data->control_block, 0, 0, length);
+        }
+        else
+        {
+            lz_data_deinit(lz_data);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,749 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/* Files bigger than 4GB need a 64 bits off_t, also in 32 bits systems. */
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+/* madvise() is not part of POSIX, glibc only exposes it with the default features. */
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream_mmap.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+    ustream_instance->inner_current_position = inner_current_position;
+    ustream_instance->inner_first_valid_position = inner_current_position;
+    ustream_instance->offset_diff = offset - inner_current_position;
+    ustream_instance->control_block = control_block;
+    ustream_instance->length = data_buffer_length;
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+static void destroy_instance(az_ulib_ustream* ustream_instance)
+{
+    az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr;
+
+    for(size_t i = 0; i < AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS; i++)
+    {
+        if(mmap_data->windows[i] != NULL)
+        {
+            size_t window_offset = i * mmap_data->window_size;
+            size_t window_length = mmap_data->file_size - window_offset;
+            if(window_length > mmap_data->window_size)
+            {
+                window_length = mmap_data->window_size;
+            }
+            (void)munmap((void*)mmap_data->windows[i], window_length);
+            mmap_data->windows[i] = NULL;
+        }
+    }
+    (void)close(mmap_data->file_descriptor);
+    az_pal_os_lock_deinit(&mmap_data->lock);
+
+    if(ustream_instance->control_block->data_release != NULL)
+    {
+        ustream_instance->control_block->data_release(ustream_instance->control_block->ptr);
+    }
+}
+
+/* Return the address of the window, mapping it if this is the first access to it. The lock only protects the
+ * map itself, once the window is in the table, it stays there up to the destroy_instance. */
+static uint8_t* get_window(az_ulib_ustream_mmap_data_cb* mmap_data, size_t window_index)
+{
+    uint8_t* window = mmap_data->windows[window_index];
+
+    if(window == NULL)
+    {
+        az_pal_os_lock_acquire(&mmap_data->lock);
+        if((window = mmap_data->windows[window_index]) == NULL)
+        {
+            size_t window_offset = window_index * mmap_data->window_size;
+            size_t window_length = mmap_data->file_size - window_offset;
+            if(window_length > mmap_data->window_size)
+            {
+                window_length = mmap_data->window_size;
+            }
+
+            void* address = mmap(NULL, window_length, PROT_READ, MAP_SHARED, mmap_data->file_descriptor, (off_t)window_offset);
+            if(address != MAP_FAILED)
+            {
+                window = (uint8_t*)address;
+                mmap_data->windows[window_index] = window;
+            }
+        }
+        az_pal_os_lock_release(&mmap_data->lock);
+    }
+
+    return window;
+}
+
+/* Copy size bytes starting at the inner position, crossing windows when needed. */
+static az_ulib_result copy_from_windows(
+        az_ulib_ustream_mmap_data_cb* mmap_data,
+        offset_t inner_position,
+        uint8_t* const buffer,
+        size_t size,
+        size_t* const copied_size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    *copied_size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (*copied_size < size))
+    {
+        size_t window_index = inner_position / mmap_data->window_size;
+        size_t window_offset = inner_position - (window_index * mmap_data->window_size);
+        uint8_t* window = get_window(mmap_data, window_index);
+
+        if(window == NULL)
+        {
+            /*[az_ulib_ustream_mmap_map_failed]*/
+            result = AZ_ULIB_SYSTEM_ERROR;
+        }
+        else
+        {
+            size_t copy_size = mmap_data->window_size - window_offset;
+            if(copy_size > (size - *copied_size))
+            {
+                copy_size = size - *copied_size;
+            }
+            (void)memcpy(&buffer[*copied_size], window + window_offset, copy_size);
+            *copied_size += copy_size;
+            inner_position += copy_size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+        /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_mmap_read_across_windows_succeed]*/
+        size_t remain_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+        result = copy_from_windows(
+                    (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr,
+                    ustream_instance->inner_current_position,
+                    buffer,
+                    (buffer_length < remain_size) ? buffer_length : remain_size,
+                    size);
+        if(*size != 0)
+        {
+            ustream_instance->inner_current_position += *size;
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+        /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_mmap_release_across_windows_succeed]*/
+        az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr;
+
+        /* Only the pages that are fully before the new first valid position can be returned to the system. The
+         * mapping is backed by the file, so if another instance still needs these pages, the system will
+         * bring them back from the file. */
+        offset_t page_position = ustream_instance->inner_first_valid_position -
+                                    (ustream_instance->inner_first_valid_position % mmap_data->page_size);
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        offset_t page_end = ustream_instance->inner_first_valid_position -
+                                    (ustream_instance->inner_first_valid_position % mmap_data->page_size);
+        while(page_position < page_end)
+        {
+            size_t window_index = page_position / mmap_data->window_size;
+            size_t window_offset = page_position - (window_index * mmap_data->window_size);
+            size_t release_size = mmap_data->window_size - window_offset;
+            if(release_size > (page_end - page_position))
+            {
+                release_size = page_end - page_position;
+            }
+
+            uint8_t* window = mmap_data->windows[window_index];
+            if(window != NULL)
+            {
+                (void)madvise((void*)(window + window_offset), release_size, MADV_DONTNEED);
+            }
+            page_position += release_size;
+        }
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    init_instance(ustream_instance_clone, ustream_instance->control_block, ustream_instance->inner_current_position, offset,
+                                                            ustream_instance->length);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        destroy_instance(ustream_instance);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr;
+        size_t window_index = ustream_instance->inner_current_position / mmap_data->window_size;
+        size_t window_offset = ustream_instance->inner_current_position - (window_index * mmap_data->window_size);
+        uint8_t* window = get_window(mmap_data, window_index);
+
+        if(window == NULL)
+        {
+            result = AZ_ULIB_SYSTEM_ERROR;
+        }
+        else
+        {
+            /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+            /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+            /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+            /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+            /*[az_ulib_ustream_mmap_peek_stops_at_the_end_of_the_window_succeed]*/
+            *buffer = window + window_offset;
+            *size = mmap_data->window_size - window_offset;
+            if(*size > (ustream_instance->length - ustream_instance->inner_current_position))
+            {
+                *size = ustream_instance->length - ustream_instance->inner_current_position;
+            }
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        if(ustream_instance->inner_current_position >= ustream_instance->length)
+        {
+            /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+            *size = 0;
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+            /*[az_ulib_ustream_mmap_readv_across_windows_succeed]*/
+            az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr;
+            size_t remain_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+            *size = 0;
+            for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < iov_count) && (*size < remain_size); i++)
+            {
+                if(iov[i].buffer_length != 0)
+                {
+                    size_t copied_size;
+                    size_t copy_size = remain_size - *size;
+                    if(iov[i].buffer_length < copy_size)
+                    {
+                        copy_size = iov[i].buffer_length;
+                    }
+                    result = copy_from_windows(mmap_data, ustream_instance->inner_current_position + *size,
+                                                iov[i].buffer, copy_size, &copied_size);
+                    *size += copied_size;
+                }
+            }
+
+            if(*size != 0)
+            {
+                ustream_instance->inner_current_position += *size;
+                result = AZ_ULIB_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(inner_position == ustream_instance->length)
+    {
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        result = copy_from_windows(
+                    (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr,
+                    inner_position,
+                    buffer,
+                    (buffer_length < remain_size) ? buffer_length : remain_size,
+                    size);
+        if(*size != 0)
+        {
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_mmap_hint_will_need_maps_windows_succeed]*/
+        /*[az_ulib_ustream_mmap_hint_done_across_windows_succeed]*/
+        az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+        offset_t page_position;
+        offset_t page_end;
+        int advice;
+
+        if(hint == AZ_ULIB_USTREAM_HINT_DONE)
+        {
+            /* Like the release, only the pages fully inside the range can be returned to the system. The last
+             * page of the file has nothing after the end of the file. */
+            advice = MADV_DONTNEED;
+            page_position = ((inner_position + mmap_data->page_size - 1) / mmap_data->page_size) * mmap_data->page_size;
+            page_end = (inner_end == mmap_data->file_size) ? inner_end : (inner_end - (inner_end % mmap_data->page_size));
+        }
+        else
+        {
+            advice = (hint == AZ_ULIB_USTREAM_HINT_SEQUENTIAL) ? MADV_SEQUENTIAL :
+                        (hint == AZ_ULIB_USTREAM_HINT_RANDOM) ? MADV_RANDOM : MADV_WILLNEED;
+            page_position = inner_position - (inner_position % mmap_data->page_size);
+            page_end = inner_end;
+        }
+
+        /* The windows start at a page boundary, so each window in the range receives its own advice. The
+         * windows that are not mapped yet are mapped now, except to drop pages, which a window that was never
+         * mapped does not have. */
+        while(page_position < page_end)
+        {
+            size_t window_index = page_position / mmap_data->window_size;
+            size_t window_offset = page_position - (window_index * mmap_data->window_size);
+            size_t advice_size = mmap_data->window_size - window_offset;
+            if(advice_size > (page_end - page_position))
+            {
+                advice_size = page_end - page_position;
+            }
+
+            uint8_t* window = (hint == AZ_ULIB_USTREAM_HINT_DONE) ?
+                                mmap_data->windows[window_index] : get_window(mmap_data, window_index);
+            if(window != NULL)
+            {
+                (void)madvise((void*)(window + window_offset), advice_size, advice);
+            }
+            page_position += advice_size;
+        }
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_mmap_init(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_mmap_data_cb* mmap_data,
+    az_ulib_release_callback mmap_data_release,
+    const char* const file_name)
+{
+    /*[az_ulib_ustream_mmap_init_null_instance_failed]*/
+    /*[az_ulib_ustream_mmap_init_null_mmap_data_failed]*/
+    /*[az_ulib_ustream_mmap_init_null_file_name_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(mmap_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(file_name, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    struct stat file_status;
+
+    int file_descriptor = open(file_name, O_RDONLY);
+    if(file_descriptor < 0)
+    {
+        /*[az_ulib_ustream_mmap_init_file_not_found_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(fstat(file_descriptor, &file_status) != 0)
+    {
+        (void)close(file_descriptor);
+        result = AZ_ULIB_SYSTEM_ERROR;
+    }
+    else if((file_status.st_size <= 0) || ((uintmax_t)file_status.st_size > (uintmax_t)AZ_ULIB_OFFSET_MAX))
+    {
+        /*[az_ulib_ustream_mmap_init_empty_file_failed]*/
+        (void)close(file_descriptor);
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_mmap_init_succeed]*/
+        size_t file_size = (size_t)file_status.st_size;
+        size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+        /* All windows shall fit in the table, and start at a page boundary. */
+        size_t window_size = (file_size + AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS - 1) / AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS;
+        if(window_size < AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE)
+        {
+            window_size = AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE;
+        }
+        window_size = ((window_size + page_size - 1) / page_size) * page_size;
+
+        mmap_data->file_descriptor = file_descriptor;
+        mmap_data->file_size = file_size;
+        mmap_data->window_size = window_size;
+        mmap_data->page_size = page_size;
+        for(size_t i = 0; i < AZ_ULIB_CONFIG_USTREAM_MMAP_MAX_WINDOWS; i++)
+        {
+            mmap_data->windows[i] = NULL;
+        }
+        az_pal_os_lock_init(&mmap_data->lock);
+
+        mmap_data->control_block.api = &api;
+        mmap_data->control_block.ptr = (void*)mmap_data;
+        mmap_data->control_block.ref_count = 0;
+        mmap_data->control_block.data_release = mmap_data_release;
+        mmap_data->control_block.control_block_release = NULL;
+
+        init_instance(ustream_instance, &mmap_data->control_block, 0, 0, file_size);
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
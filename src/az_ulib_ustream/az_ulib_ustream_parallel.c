@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_parallel.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ulog.h"
+
+/*
+ * The workers share one round of tasks, protected by the pool lock. Each worker takes the next task in the round,
+ *  releases the lock while it runs the work, and decrements the number of pending tasks when it is done. The
+ *  lock is taken twice per slice, which is negligible for slices big enough to be worth processing in parallel.
+ */
+static void worker_thread(void* arg)
+{
+    az_ulib_ustream_worker_pool* pool = (az_ulib_ustream_worker_pool*)arg;
+
+    az_pal_os_lock_acquire(&(pool->lock));
+    while(!pool->stop)
+    {
+        if(pool->next_task < pool->task_count)
+        {
+            size_t task_index = pool->next_task++;
+            az_ulib_ustream_parallel_task* task = &(pool->tasks[task_index]);
+            az_pal_os_lock_release(&(pool->lock));
+
+            /*[az_ulib_ustream_parallel_run_succeed]*/
+            task->result = pool->work(&(task->slice), pool->first_index + task_index, pool->context);
+
+            az_pal_os_lock_acquire(&(pool->lock));
+            if(--pool->pending_tasks == 0)
+            {
+                az_pal_os_condition_notify_all(&(pool->work_done));
+            }
+        }
+        else
+        {
+            az_pal_os_condition_wait(&(pool->work_ready), &(pool->lock));
+        }
+    }
+    az_pal_os_lock_release(&(pool->lock));
+}
+
+static void stop_workers(az_ulib_ustream_worker_pool* pool, size_t thread_count)
+{
+    az_pal_os_lock_acquire(&(pool->lock));
+    pool->stop = true;
+    az_pal_os_condition_notify_all(&(pool->work_ready));
+    az_pal_os_lock_release(&(pool->lock));
+
+    for(size_t i = 0; i < thread_count; i++)
+    {
+        az_pal_os_thread_join(&(pool->threads[i]));
+    }
+
+    az_pal_os_condition_deinit(&(pool->work_done));
+    az_pal_os_condition_deinit(&(pool->work_ready));
+    az_pal_os_lock_deinit(&(pool->lock));
+}
+
+az_ulib_result az_ulib_ustream_worker_pool_init(
+    az_ulib_ustream_worker_pool* pool,
+    az_ulib_pal_os_thread* threads,
+    size_t thread_count)
+{
+    /*[az_ulib_ustream_worker_pool_init_null_pool_failed]*/
+    /*[az_ulib_ustream_worker_pool_init_null_threads_failed]*/
+    /*[az_ulib_ustream_worker_pool_init_zero_thread_count_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(threads, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(thread_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    az_pal_os_lock_init(&(pool->lock));
+    az_pal_os_condition_init(&(pool->work_ready));
+    az_pal_os_condition_init(&(pool->work_done));
+    pool->threads = threads;
+    pool->thread_count = 0;
+    pool->tasks = NULL;
+    pool->task_count = 0;
+    pool->next_task = 0;
+    pool->pending_tasks = 0;
+    pool->first_index = 0;
+    pool->work = NULL;
+    pool->context = NULL;
+    pool->running = false;
+    pool->stop = false;
+
+    /*[az_ulib_ustream_worker_pool_init_succeed]*/
+    while((result == AZ_ULIB_SUCCESS) && (pool->thread_count < thread_count))
+    {
+        if(az_pal_os_thread_create(&(threads[pool->thread_count]), worker_thread, pool))
+        {
+            pool->thread_count++;
+        }
+        else
+        {
+            stop_workers(pool, pool->thread_count);
+            result = AZ_ULIB_SYSTEM_ERROR;
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_worker_pool_deinit(az_ulib_ustream_worker_pool* pool)
+{
+    /*[az_ulib_ustream_worker_pool_deinit_null_pool_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    az_pal_os_lock_acquire(&(pool->lock));
+    bool running = pool->running;
+    az_pal_os_lock_release(&(pool->lock));
+
+    if(running)
+    {
+        /*[az_ulib_ustream_worker_pool_deinit_running_failed]*/
+        result = AZ_ULIB_BUSY_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_worker_pool_deinit_succeed]*/
+        stop_workers(pool, pool->thread_count);
+        pool->thread_count = 0;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+/* Hand one round of slices to the workers and wait for all of them. */
+static void run_round(
+    az_ulib_ustream_worker_pool* pool,
+    az_ulib_ustream_parallel_task* tasks,
+    size_t task_count,
+    size_t first_index,
+    az_ulib_ustream_parallel_work work,
+    void* context)
+{
+    az_pal_os_lock_acquire(&(pool->lock));
+    pool->work = work;
+    pool->context = context;
+    pool->tasks = tasks;
+    pool->first_index = first_index;
+    pool->next_task = 0;
+    pool->pending_tasks = task_count;
+    pool->task_count = task_count;
+    az_pal_os_condition_notify_all(&(pool->work_ready));
+    while(pool->pending_tasks != 0)
+    {
+        az_pal_os_condition_wait(&(pool->work_done), &(pool->lock));
+    }
+    pool->tasks = NULL;
+    pool->task_count = 0;
+    pool->next_task = 0;
+    az_pal_os_lock_release(&(pool->lock));
+}
+
+az_ulib_result az_ulib_ustream_parallel_run(
+    az_ulib_ustream_worker_pool* pool,
+    az_ulib_ustream* ustream_instance,
+    size_t chunk_size,
+    az_ulib_ustream_parallel_task* tasks,
+    size_t max_tasks,
+    az_ulib_ustream_parallel_work work,
+    az_ulib_ustream_parallel_join join,
+    void* context)
+{
+    /*[az_ulib_ustream_parallel_run_null_pool_failed]*/
+    /*[az_ulib_ustream_parallel_run_null_instance_failed]*/
+    /*[az_ulib_ustream_parallel_run_zero_chunk_size_failed]*/
+    /*[az_ulib_ustream_parallel_run_null_tasks_failed]*/
+    /*[az_ulib_ustream_parallel_run_zero_max_tasks_failed]*/
+    /*[az_ulib_ustream_parallel_run_null_work_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(chunk_size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(tasks, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(max_tasks, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(work, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    az_pal_os_lock_acquire(&(pool->lock));
+    bool running = pool->running;
+    pool->running = true;
+    az_pal_os_lock_release(&(pool->lock));
+
+    if(running)
+    {
+        /*[az_ulib_ustream_parallel_run_busy_failed]*/
+        result = AZ_ULIB_BUSY_ERROR;
+    }
+    else
+    {
+        offset_t position = 0;
+        size_t remaining_size = 0;
+        /*[az_ulib_ustream_parallel_run_get_position_failed]*/
+        /*[az_ulib_ustream_parallel_run_get_remaining_size_failed]*/
+        if(((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_ULIB_SUCCESS) &&
+            ((result = az_ulib_ustream_get_remaining_size(ustream_instance, &remaining_size)) == AZ_ULIB_SUCCESS) &&
+            (remaining_size == 0))
+        {
+            /*[az_ulib_ustream_parallel_run_empty_ustream_failed]*/
+            result = AZ_ULIB_EOF;
+        }
+
+        size_t first_index = 0;
+        while((result == AZ_ULIB_SUCCESS) && (remaining_size != 0))
+        {
+            /*[az_ulib_ustream_parallel_run_more_slices_than_tasks_succeed]*/
+            size_t task_count = 0;
+            while((result == AZ_ULIB_SUCCESS) && (remaining_size != 0) && (task_count < max_tasks))
+            {
+                size_t size = (remaining_size < chunk_size) ? remaining_size : chunk_size;
+                if((result = az_ulib_ustream_slice(ustream_instance, position, size, &(tasks[task_count].slice))) ==
+                    AZ_ULIB_SUCCESS)
+                {
+                    position += size;
+                    remaining_size -= size;
+                    task_count++;
+                }
+            }
+
+            if(result == AZ_ULIB_SUCCESS)
+            {
+                run_round(pool, tasks, task_count, first_index, work, context);
+            }
+
+            /*[az_ulib_ustream_parallel_run_work_failed]*/
+            /*[az_ulib_ustream_parallel_run_join_failed]*/
+            for(size_t i = 0; i < task_count; i++)
+            {
+                if(result == AZ_ULIB_SUCCESS)
+                {
+                    result = tasks[i].result;
+                    if((result == AZ_ULIB_SUCCESS) && (join != NULL))
+                    {
+                        /*[az_ulib_ustream_parallel_run_join_in_order_succeed]*/
+                        result = join(first_index + i, context);
+                    }
+                }
+                (void)az_ulib_ustream_dispose(&(tasks[i].slice));
+            }
+            first_index += task_count;
+        }
+
+        az_pal_os_lock_acquire(&(pool->lock));
+        pool->running = false;
+        az_pal_os_lock_release(&(pool->lock));
+    }
+
+    return result;
+}
@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_index_stack.h"
+
+/* The free list is a lock-free stack of the blocks, see internal/az_ulib_index_stack.h. */
+static az_ulib_ustream_pool_block* pop_block(az_ulib_ustream_pool* pool)
+{
+    uint32_t index = _az_ulib_index_stack_pop(&pool->free_list, pool->blocks,
+                        sizeof(az_ulib_ustream_pool_block), offsetof(az_ulib_ustream_pool_block, next));
+
+    return (index == 0) ? NULL : &pool->blocks[index - 1];
+}
+
+static void push_block(az_ulib_ustream_pool* pool, az_ulib_ustream_pool_block* block)
+{
+    _az_ulib_index_stack_push(&pool->free_list, pool->blocks,
+        sizeof(az_ulib_ustream_pool_block), offsetof(az_ulib_ustream_pool_block, next),
+        (uint32_t)(block - pool->blocks) + 1);
+}
+
+az_ulib_result az_ulib_ustream_pool_init(
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream_pool_block* blocks,
+    size_t block_count)
+{
+    /*[az_ulib_ustream_pool_init_null_pool_failed]*/
+    /*[az_ulib_ustream_pool_init_null_blocks_failed]*/
+    /*[az_ulib_ustream_pool_init_zero_block_count_failed]*/
+    /*[az_ulib_ustream_pool_init_block_count_exceed_max_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(blocks, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(block_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE((block_count <= AZ_ULIB_USTREAM_POOL_MAX_BLOCKS), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_pool_init_succeed]*/
+    for(size_t i = 0; i < block_count; i++)
+    {
+        blocks[i].pool = pool;
+        blocks[i].next = (i + 1 < block_count) ? (uint32_t)(i + 2) : 0;
+    }
+    pool->blocks = blocks;
+    pool->block_count = block_count;
+    pool->free_list = 1;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_pool_get_data_cb(
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream_data_cb** data_cb)
+{
+    /*[az_ulib_ustream_pool_get_data_cb_null_pool_failed]*/
+    /*[az_ulib_ustream_pool_get_data_cb_null_data_cb_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(data_cb, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_ustream_pool_block* block = pop_block(pool);
+    if(block == NULL)
+    {
+        /*[az_ulib_ustream_pool_get_data_cb_empty_pool_failed]*/
+        return AZ_ULIB_OUT_OF_MEMORY_ERROR;
+    }
+
+    /*[az_ulib_ustream_pool_get_data_cb_succeed]*/
+    *data_cb = &block->control_block.data_cb;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_pool_get_multi_data_cb(
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream_multi_data_cb** multi_data_cb)
+{
+    /*[az_ulib_ustream_pool_get_multi_data_cb_null_pool_failed]*/
+    /*[az_ulib_ustream_pool_get_multi_data_cb_null_multi_data_cb_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(multi_data_cb, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_ustream_pool_block* block = pop_block(pool);
+    if(block == NULL)
+    {
+        /*[az_ulib_ustream_pool_get_multi_data_cb_empty_pool_failed]*/
+        return AZ_ULIB_OUT_OF_MEMORY_ERROR;
+    }
+
+    /*[az_ulib_ustream_pool_get_multi_data_cb_succeed]*/
+    *multi_data_cb = &block->control_block.multi_data_cb;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_pool_get_rope_node(
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream_rope_node** rope_node)
+{
+    /*[az_ulib_ustream_pool_get_rope_node_null_pool_failed]*/
+    /*[az_ulib_ustream_pool_get_rope_node_null_rope_node_failed]*/
+    AZ_ULIB_UCONTRACT(
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+        AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(rope_node, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_ustream_pool_block* block = pop_block(pool);
+    if(block == NULL)
+    {
+        /*[az_ulib_ustream_pool_get_rope_node_empty_pool_failed]*/
+        return AZ_ULIB_OUT_OF_MEMORY_ERROR;
+    }
+
+    /*[az_ulib_ustream_pool_get_rope_node_succeed]*/
+    *rope_node = &block->control_block.rope_node;
+    return AZ_ULIB_SUCCESS;
+}
+
+void az_ulib_ustream_pool_release(void* release_pointer)
+{
+    AZ_ULIB_UASSERT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL_HARD_FAULT(release_pointer));
+
+    /*[az_ulib_ustream_pool_release_succeed]*/
+    /* The control block is the first field of the block. */
+    az_ulib_ustream_pool_block* block = (az_ulib_ustream_pool_block*)release_pointer;
+    push_block(block->pool, block);
+}
@@ -0,0 +1,1197 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream_rope.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_result.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+#include "internal/az_ulib_ustream_aux.h"
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+/*
+ * The tree is an AVL tree of immutable nodes. The functions that create nodes take the ownership of the
+ *  references to the nodes that they receive, releasing them if they fail, and return a new reference. A
+ *  NULL node is an empty tree. Because the nodes never change, the operations copy only the nodes in the path
+ *  that changed, and the ropes share all the other ones.
+ */
+
+static inline uint32_t node_height(const az_ulib_ustream_rope_node* node)
+{
+    return node->height;
+}
+
+static inline az_ulib_ustream_rope_node* node_retain(az_ulib_ustream_rope_node* node)
+{
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(node->control_block.ref_count));
+    return node;
+}
+
+static void node_release(az_ulib_ustream_rope_node* node)
+{
+    if(node != NULL)
+    {
+        AZ_ULIB_PORT_ATOMIC_DEC_W(&(node->control_block.ref_count));
+        if(node->control_block.ref_count == 0)
+        {
+            if(node->height == 0)
+            {
+                (void)az_ulib_ustream_dispose(&(node->content.leaf.ustream));
+                az_pal_os_lock_deinit(&(node->content.leaf.lock));
+            }
+            else
+            {
+                node_release(node->content.branch.left);
+                node_release(node->content.branch.right);
+            }
+            node->control_block.control_block_release(&(node->control_block));
+        }
+    }
+}
+
+static void node_init(az_ulib_ustream_rope_node* node, size_t length, uint32_t height)
+{
+    node->control_block.api = &api;
+    node->control_block.ptr = (void*)node;
+    node->control_block.ref_count = 1;
+    node->control_block.data_release = NULL;
+    node->control_block.control_block_release = az_ulib_ustream_pool_release;
+    node->length = length;
+    node->height = height;
+}
+
+/* Create a leaf with the content of the ustream from its current position, up to length bytes. */
+static az_ulib_result make_leaf(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream* ustream,
+        size_t length,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* leaf;
+
+    if((result = az_ulib_ustream_pool_get_rope_node(pool, &leaf)) == AZ_ULIB_SUCCESS)
+    {
+        if((result = az_ulib_ustream_clone(&(leaf->content.leaf.ustream), ustream, 0)) == AZ_ULIB_SUCCESS)
+        {
+            node_init(leaf, length, 0);
+            az_pal_os_lock_init(&(leaf->content.leaf.lock));
+            *node = leaf;
+        }
+        else
+        {
+            az_ulib_ustream_pool_release(leaf);
+        }
+    }
+
+    return result;
+}
+
+/* Create a leaf with part of the content of another leaf. The clone starts at the current position of the
+ * ustream, so it is moved under the lock of the leaf, like a read from a ustream that does not support read_at. */
+static az_ulib_result make_sub_leaf(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* leaf,
+        size_t offset,
+        size_t length,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+
+    az_pal_os_lock_acquire(&(leaf->content.leaf.lock));
+    if((result = az_ulib_ustream_set_position(&(leaf->content.leaf.ustream), (offset_t)offset)) == AZ_ULIB_SUCCESS)
+    {
+        result = make_leaf(pool, &(leaf->content.leaf.ustream), length, node);
+    }
+    az_pal_os_lock_release(&(leaf->content.leaf.lock));
+
+    return result;
+}
+
+/* Create a branch with the left and the right subtrees, that shall not be empty. */
+static az_ulib_result make_branch(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* left,
+        az_ulib_ustream_rope_node* right,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* branch;
+
+    if((result = az_ulib_ustream_pool_get_rope_node(pool, &branch)) == AZ_ULIB_SUCCESS)
+    {
+        uint32_t height = (node_height(left) > node_height(right)) ? node_height(left) : node_height(right);
+        node_init(branch, left->length + right->length, height + 1);
+        branch->content.branch.left = left;
+        branch->content.branch.right = right;
+        *node = branch;
+    }
+    else
+    {
+        node_release(left);
+        node_release(right);
+    }
+
+    return result;
+}
+
+/* Create a branch with the left and the right subtrees, which heights may differ by up to 2, rotating the
+ * nodes of the higher subtree when they differ by 2. */
+static az_ulib_result balance(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* left,
+        az_ulib_ustream_rope_node* right,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* high;
+    az_ulib_ustream_rope_node* outer;
+    az_ulib_ustream_rope_node* inner;
+    az_ulib_ustream_rope_node* subtree;
+
+    if(node_height(left) > (node_height(right) + 1))
+    {
+        high = left;
+        outer = node_retain(high->content.branch.left);
+        inner = node_retain(high->content.branch.right);
+        node_release(high);
+        if(node_height(outer) >= node_height(inner))
+        {
+            /* Single rotation to the right. */
+            if((result = make_branch(pool, inner, right, &subtree)) == AZ_ULIB_SUCCESS)
+            {
+                result = make_branch(pool, outer, subtree, node);
+            }
+            else
+            {
+                node_release(outer);
+            }
+        }
+        else
+        {
+            /* Double rotation, left and right. */
+            az_ulib_ustream_rope_node* inner_left = node_retain(inner->content.branch.left);
+            az_ulib_ustream_rope_node* inner_right = node_retain(inner->content.branch.right);
+            node_release(inner);
+            if((result = make_branch(pool, outer, inner_left, &subtree)) == AZ_ULIB_SUCCESS)
+            {
+                az_ulib_ustream_rope_node* other_subtree;
+                if((result = make_branch(pool, inner_right, right, &other_subtree)) == AZ_ULIB_SUCCESS)
+                {
+                    result = make_branch(pool, subtree, other_subtree, node);
+                }
+                else
+                {
+                    node_release(subtree);
+                }
+            }
+            else
+            {
+                node_release(inner_right);
+                node_release(right);
+            }
+        }
+    }
+    else if(node_height(right) > (node_height(left) + 1))
+    {
+        high = right;
+        outer = node_retain(high->content.branch.right);
+        inner = node_retain(high->content.branch.left);
+        node_release(high);
+        if(node_height(outer) >= node_height(inner))
+        {
+            /* Single rotation to the left. */
+            if((result = make_branch(pool, left, inner, &subtree)) == AZ_ULIB_SUCCESS)
+            {
+                result = make_branch(pool, subtree, outer, node);
+            }
+            else
+            {
+                node_release(outer);
+            }
+        }
+        else
+        {
+            /* Double rotation, right and left. */
+            az_ulib_ustream_rope_node* inner_left = node_retain(inner->content.branch.left);
+            az_ulib_ustream_rope_node* inner_right = node_retain(inner->content.branch.right);
+            node_release(inner);
+            if((result = make_branch(pool, left, inner_left, &subtree)) == AZ_ULIB_SUCCESS)
+            {
+                az_ulib_ustream_rope_node* other_subtree;
+                if((result = make_branch(pool, inner_right, outer, &other_subtree)) == AZ_ULIB_SUCCESS)
+                {
+                    result = make_branch(pool, subtree, other_subtree, node);
+                }
+                else
+                {
+                    node_release(subtree);
+                }
+            }
+            else
+            {
+                node_release(inner_right);
+                node_release(outer);
+            }
+        }
+    }
+    else
+    {
+        result = make_branch(pool, left, right, node);
+    }
+
+    return result;
+}
+
+/* Join two trees, descending the spine of the higher one up to a subtree with about the same height of the
+ * other one, and balancing the path back to the root. It costs O(difference of the heights). */
+static az_ulib_result join(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* left,
+        az_ulib_ustream_rope_node* right,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* subtree;
+
+    if(left == NULL)
+    {
+        *node = right;
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(right == NULL)
+    {
+        *node = left;
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(node_height(left) > (node_height(right) + 1))
+    {
+        az_ulib_ustream_rope_node* left_left = node_retain(left->content.branch.left);
+        az_ulib_ustream_rope_node* left_right = node_retain(left->content.branch.right);
+        node_release(left);
+        if((result = join(pool, left_right, right, &subtree)) == AZ_ULIB_SUCCESS)
+        {
+            result = balance(pool, left_left, subtree, node);
+        }
+        else
+        {
+            node_release(left_left);
+        }
+    }
+    else if(node_height(right) > (node_height(left) + 1))
+    {
+        az_ulib_ustream_rope_node* right_left = node_retain(right->content.branch.left);
+        az_ulib_ustream_rope_node* right_right = node_retain(right->content.branch.right);
+        node_release(right);
+        if((result = join(pool, left, right_left, &subtree)) == AZ_ULIB_SUCCESS)
+        {
+            result = balance(pool, subtree, right_right, node);
+        }
+        else
+        {
+            node_release(right_right);
+        }
+    }
+    else
+    {
+        result = make_branch(pool, left, right, node);
+    }
+
+    return result;
+}
+
+/* Split the tree at the offset, returning new references to the trees before and after it. The tree is not
+ * consumed. Each level joins the part that does not contain the offset with the result of the level below,
+ * and the heights of these joins add up to O(log n). */
+static az_ulib_result split(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* node,
+        size_t offset,
+        az_ulib_ustream_rope_node** left,
+        az_ulib_ustream_rope_node** right)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* part_left;
+    az_ulib_ustream_rope_node* part_right;
+
+    if(offset == 0)
+    {
+        *left = NULL;
+        *right = node_retain(node);
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(offset >= node->length)
+    {
+        *left = node_retain(node);
+        *right = NULL;
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(node_height(node) == 0)
+    {
+        if((result = make_sub_leaf(pool, node, 0, offset, &part_left)) == AZ_ULIB_SUCCESS)
+        {
+            if((result = make_sub_leaf(pool, node, offset, node->length - offset, &part_right)) == AZ_ULIB_SUCCESS)
+            {
+                *left = part_left;
+                *right = part_right;
+            }
+            else
+            {
+                node_release(part_left);
+            }
+        }
+    }
+    else if(offset < node->content.branch.left->length)
+    {
+        if((result = split(pool, node->content.branch.left, offset, &part_left, &part_right)) == AZ_ULIB_SUCCESS)
+        {
+            if((result = join(pool, part_right, node_retain(node->content.branch.right), right)) == AZ_ULIB_SUCCESS)
+            {
+                *left = part_left;
+            }
+            else
+            {
+                node_release(part_left);
+            }
+        }
+    }
+    else
+    {
+        if((result = split(pool, node->content.branch.right, offset - node->content.branch.left->length,
+                        &part_left, &part_right)) == AZ_ULIB_SUCCESS)
+        {
+            if((result = join(pool, node_retain(node->content.branch.left), part_left, left)) == AZ_ULIB_SUCCESS)
+            {
+                *right = part_right;
+            }
+            else
+            {
+                node_release(part_right);
+            }
+        }
+    }
+
+    return result;
+}
+
+/* Get a new reference to a tree with the length bytes after the offset of the tree. */
+static az_ulib_result slice(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream_rope_node* node,
+        size_t offset,
+        size_t length,
+        az_ulib_ustream_rope_node** sliced)
+{
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* before;
+    az_ulib_ustream_rope_node* after;
+
+    if((offset == 0) && (length == node->length))
+    {
+        *sliced = node_retain(node);
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if((result = split(pool, node, offset, &before, &after)) == AZ_ULIB_SUCCESS)
+    {
+        node_release(before);
+        if(after == NULL)
+        {
+            *sliced = NULL;
+        }
+        else
+        {
+            az_ulib_ustream_rope_node* tail;
+            if((result = split(pool, after, length, sliced, &tail)) == AZ_ULIB_SUCCESS)
+            {
+                node_release(tail);
+            }
+            node_release(after);
+        }
+    }
+
+    return result;
+}
+
+/* Get a new reference to a tree with the content of the ustream from its current position. The trees of
+ * the rope ustreams are shared, and the other ustreams are cloned in a new leaf. */
+static az_ulib_result get_tree(
+        az_ulib_ustream_pool* pool,
+        az_ulib_ustream* ustream,
+        az_ulib_ustream_rope_node** node)
+{
+    az_ulib_result result;
+
+    if(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream, api))
+    {
+        /*[az_ulib_ustream_rope_concat_shares_rope_nodes_succeed]*/
+        size_t offset = (size_t)ustream->inner_current_position;
+        result = slice(pool, (az_ulib_ustream_rope_node*)ustream->control_block->ptr,
+                    offset, ustream->length - offset, node);
+    }
+    else
+    {
+        size_t remaining_size;
+        if((result = az_ulib_ustream_get_remaining_size(ustream, &remaining_size)) == AZ_ULIB_SUCCESS)
+        {
+            if(remaining_size == 0)
+            {
+                *node = NULL;
+            }
+            else
+            {
+                result = make_leaf(pool, ustream, remaining_size, node);
+            }
+        }
+    }
+
+    return result;
+}
+
+/* Find the leaf with the inner position, that shall be smaller than the length of the tree. */
+static az_ulib_ustream_rope_node* find_leaf(az_ulib_ustream_rope_node* node, offset_t inner_position, size_t* leaf_offset)
+{
+    size_t offset = (size_t)inner_position;
+
+    while(node_height(node) != 0)
+    {
+        if(offset < node->content.branch.left->length)
+        {
+            node = node->content.branch.left;
+        }
+        else
+        {
+            offset -= node->content.branch.left->length;
+            node = node->content.branch.right;
+        }
+    }
+
+    *leaf_offset = offset;
+    return node;
+}
+
+static void init_instance(az_ulib_ustream* ustream_instance, az_ulib_ustream_rope_node* root)
+{
+    ustream_instance->control_block = &(root->control_block);
+    ustream_instance->offset_diff = 0;
+    ustream_instance->inner_current_position = 0;
+    ustream_instance->inner_first_valid_position = 0;
+    ustream_instance->length = root->length;
+}
+
+static az_ulib_result concrete_set_position(
+        az_ulib_ustream* ustream_instance,
+        offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+       (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+    return AZ_ULIB_SUCCESS;
+}
+
+/* Copy the content from the inner position to the local buffers, in order, crossing the leaves when
+ * needed. Each leaf is found by a descent from the root. The instance is not changed, the caller shall
+ * move its current position when it is the case. */
+static az_ulib_result rope_read_iov(
+        az_ulib_ustream* ustream_instance,
+        offset_t inner_position,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    az_ulib_ustream_rope_node* root = (az_ulib_ustream_rope_node*)ustream_instance->control_block->ptr;
+    size_t remain_size = (inner_position < ustream_instance->length) ?
+                            (ustream_instance->length - (size_t)inner_position) : 0;
+    size_t iov_index = 0;
+    size_t iov_offset = 0;
+
+    *size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (iov_index < iov_count) && (*size < remain_size))
+    {
+        if(iov_offset >= iov[iov_index].buffer_length)
+        {
+            iov_index++;
+            iov_offset = 0;
+        }
+        else
+        {
+            size_t leaf_offset;
+            az_ulib_ustream_rope_node* leaf = find_leaf(root, inner_position, &leaf_offset);
+            size_t copied_size;
+            size_t copy_size = iov[iov_index].buffer_length - iov_offset;
+            if(copy_size > (remain_size - *size))
+            {
+                copy_size = remain_size - *size;
+            }
+            if(copy_size > (leaf->length - leaf_offset))
+            {
+                copy_size = leaf->length - leaf_offset;
+            }
+
+            /*[az_ulib_ustream_rope_read_clone_and_original_in_parallel_succeed]*/
+            if((result = _az_ulib_ustream_read_inner(&(leaf->content.leaf.lock), &(leaf->content.leaf.ustream),
+                            (offset_t)leaf_offset, &(iov[iov_index].buffer[iov_offset]), copy_size, &copied_size)) == AZ_ULIB_SUCCESS)
+            {
+                *size += copied_size;
+                inner_position += copied_size;
+                iov_offset += copied_size;
+                if(copied_size == 0)
+                {
+                    result = AZ_ULIB_EOF;
+                }
+            }
+        }
+    }
+
+    if(*size != 0)
+    {
+        /*[az_ulib_ustream_rope_read_from_multiple_leaves_succeed]*/
+        result = AZ_ULIB_SUCCESS;
+    }
+    else if(remain_size == 0)
+    {
+        result = AZ_ULIB_EOF;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    az_ulib_ustream_iovec iov = { buffer, buffer_length };
+
+    /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+    /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+    /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+    /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+    if((result = rope_read_iov(ustream_instance, ustream_instance->inner_current_position, &iov, 1, size)) == AZ_ULIB_SUCCESS)
+    {
+        ustream_instance->inner_current_position += *size;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+    /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_no_memory_to_create_instance_failed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    ustream_instance_clone->inner_current_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->inner_first_valid_position = ustream_instance->inner_current_position;
+    ustream_instance_clone->offset_diff = offset - ustream_instance->inner_current_position;
+    ustream_instance_clone->control_block = ustream_instance->control_block;
+    ustream_instance_clone->length = ustream_instance->length;
+
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    /*[az_ulib_ustream_rope_dispose_returns_nodes_to_pool_succeed]*/
+    node_release((az_ulib_ustream_rope_node*)ustream_instance->control_block->ptr);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    offset_t inner_position = ustream_instance->inner_current_position;
+
+    if(inner_position >= ustream_instance->length)
+    {
+        /*[az_ulib_ustream_peek_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        size_t leaf_offset;
+        az_ulib_ustream_rope_node* leaf =
+                find_leaf((az_ulib_ustream_rope_node*)ustream_instance->control_block->ptr, inner_position, &leaf_offset);
+        size_t leaf_remaining = leaf->length - leaf_offset;
+
+        //Critical section to make sure another instance doesn't set_position before this one peeks
+        az_pal_os_lock_acquire(&(leaf->content.leaf.lock));
+        /*[az_ulib_ustream_peek_compliance_new_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed]*/
+        if((result = az_ulib_ustream_set_position(&(leaf->content.leaf.ustream), (offset_t)leaf_offset)) == AZ_ULIB_SUCCESS)
+        {
+            result = az_ulib_ustream_peek(&(leaf->content.leaf.ustream), buffer, size);
+        }
+        az_pal_os_lock_release(&(leaf->content.leaf.lock));
+
+        /* A leaf may end before the end of its ustream, and the instance may end before the end of the leaf. */
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_rope_peek_limited_to_leaf_succeed]*/
+            if(*size > leaf_remaining)
+            {
+                *size = leaf_remaining;
+            }
+            if(*size > (ustream_instance->length - inner_position))
+            {
+                *size = ustream_instance->length - inner_position;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+        if((result = rope_read_iov(ustream_instance, ustream_instance->inner_current_position, iov, iov_count, size)) == AZ_ULIB_SUCCESS)
+        {
+            ustream_instance->inner_current_position += *size;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        az_ulib_ustream_iovec iov = { buffer, buffer_length };
+        result = rope_read_iov(ustream_instance, inner_position, &iov, 1, size);
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_rope_hint_forward_to_leaves_succeed]*/
+        az_ulib_ustream_rope_node* root = (az_ulib_ustream_rope_node*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+
+        /* The hint does not change the leaves, so it is forwarded without the lock of the leaf, only to the
+         * leaves that contain part of the range. */
+        result = AZ_ULIB_SUCCESS;
+        while((result == AZ_ULIB_SUCCESS) && (inner_position < inner_end))
+        {
+            size_t leaf_offset;
+            az_ulib_ustream_rope_node* leaf = find_leaf(root, inner_position, &leaf_offset);
+            size_t hint_size = leaf->length - leaf_offset;
+            if(hint_size > (inner_end - inner_position))
+            {
+                hint_size = inner_end - inner_position;
+            }
+            result = az_ulib_ustream_hint(&(leaf->content.leaf.ustream), hint, (offset_t)leaf_offset, hint_size);
+            inner_position += hint_size;
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_rope_init(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream* ustream_to_wrap)
+{
+    /*[az_ulib_ustream_rope_init_null_instance_failed]*/
+    /*[az_ulib_ustream_rope_init_null_pool_failed]*/
+    /*[az_ulib_ustream_rope_init_null_ustream_to_wrap_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_wrap, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* root;
+
+    /*[az_ulib_ustream_rope_init_succeed]*/
+    /*[az_ulib_ustream_rope_init_from_rope_succeed]*/
+    /*[az_ulib_ustream_rope_init_empty_pool_failed]*/
+    if((result = get_tree(pool, ustream_to_wrap, &root)) == AZ_ULIB_SUCCESS)
+    {
+        if(root == NULL)
+        {
+            /*[az_ulib_ustream_rope_init_empty_ustream_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else
+        {
+            init_instance(ustream_instance, root);
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_rope_concat(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream* ustream_left,
+    az_ulib_ustream* ustream_right)
+{
+    /*[az_ulib_ustream_rope_concat_null_instance_failed]*/
+    /*[az_ulib_ustream_rope_concat_null_pool_failed]*/
+    /*[az_ulib_ustream_rope_concat_null_left_failed]*/
+    /*[az_ulib_ustream_rope_concat_null_right_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_left, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_right, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* left;
+    az_ulib_ustream_rope_node* right;
+    az_ulib_ustream_rope_node* root;
+
+    if((result = get_tree(pool, ustream_left, &left)) == AZ_ULIB_SUCCESS)
+    {
+        if((result = get_tree(pool, ustream_right, &right)) != AZ_ULIB_SUCCESS)
+        {
+            /*[az_ulib_ustream_rope_concat_empty_pool_failed]*/
+            node_release(left);
+        }
+        else if((result = join(pool, left, right, &root)) == AZ_ULIB_SUCCESS)
+        {
+            if(root == NULL)
+            {
+                /*[az_ulib_ustream_rope_concat_both_empty_failed]*/
+                result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            }
+            else
+            {
+                /*[az_ulib_ustream_rope_concat_succeed]*/
+                /*[az_ulib_ustream_rope_concat_many_keeps_balance_succeed]*/
+                init_instance(ustream_instance, root);
+            }
+        }
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_rope_split(
+    az_ulib_ustream* ustream_to_split,
+    az_ulib_ustream_pool* pool,
+    size_t split_offset,
+    az_ulib_ustream* ustream_left,
+    az_ulib_ustream* ustream_right)
+{
+    /*[az_ulib_ustream_rope_split_null_ustream_to_split_failed]*/
+    /*[az_ulib_ustream_rope_split_null_pool_failed]*/
+    /*[az_ulib_ustream_rope_split_zero_offset_failed]*/
+    /*[az_ulib_ustream_rope_split_null_left_failed]*/
+    /*[az_ulib_ustream_rope_split_null_right_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_split, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(split_offset, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_left, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_right, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* root;
+
+    if((result = get_tree(pool, ustream_to_split, &root)) == AZ_ULIB_SUCCESS)
+    {
+        if((root == NULL) || (split_offset >= root->length))
+        {
+            /*[az_ulib_ustream_rope_split_offset_at_the_end_failed]*/
+            /*[az_ulib_ustream_rope_split_offset_after_the_end_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else
+        {
+            az_ulib_ustream_rope_node* left;
+            az_ulib_ustream_rope_node* right;
+
+            /*[az_ulib_ustream_rope_split_succeed]*/
+            /*[az_ulib_ustream_rope_split_in_the_middle_of_a_leaf_succeed]*/
+            /*[az_ulib_ustream_rope_split_does_not_change_ustream_to_split_succeed]*/
+            /*[az_ulib_ustream_rope_split_empty_pool_failed]*/
+            if((result = split(pool, root, split_offset, &left, &right)) == AZ_ULIB_SUCCESS)
+            {
+                init_instance(ustream_left, left);
+                init_instance(ustream_right, right);
+            }
+        }
+        node_release(root);
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_rope_slice(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_pool* pool,
+    az_ulib_ustream* ustream_to_slice,
+    size_t offset,
+    size_t length)
+{
+    /*[az_ulib_ustream_rope_slice_null_instance_failed]*/
+    /*[az_ulib_ustream_rope_slice_null_pool_failed]*/
+    /*[az_ulib_ustream_rope_slice_null_ustream_to_slice_failed]*/
+    /*[az_ulib_ustream_rope_slice_zero_length_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(pool, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_to_slice, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    az_ulib_ustream_rope_node* root;
+
+    if((result = get_tree(pool, ustream_to_slice, &root)) == AZ_ULIB_SUCCESS)
+    {
+        if((root == NULL) || (offset > root->length) || (length > (root->length - offset)))
+        {
+            /*[az_ulib_ustream_rope_slice_after_the_end_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+        }
+        else
+        {
+            az_ulib_ustream_rope_node* sliced;
+
+            /*[az_ulib_ustream_rope_slice_succeed]*/
+            /*[az_ulib_ustream_rope_slice_across_leaves_succeed]*/
+            /*[az_ulib_ustream_rope_slice_empty_pool_failed]*/
+            if((result = slice(pool, root, offset, length, &sliced)) == AZ_ULIB_SUCCESS)
+            {
+                init_instance(ustream_instance, sliced);
+            }
+        }
+        node_release(root);
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_rope_index(
+    az_ulib_ustream* ustream_instance,
+    size_t offset,
+    uint8_t* const value)
+{
+    /*[az_ulib_ustream_rope_index_null_instance_failed]*/
+    /*[az_ulib_ustream_rope_index_non_rope_failed]*/
+    /*[az_ulib_ustream_rope_index_null_value_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(value, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    size_t remaining_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+
+    if(offset >= remaining_size)
+    {
+        /*[az_ulib_ustream_rope_index_after_the_end_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        size_t leaf_offset;
+        size_t size;
+        az_ulib_ustream_rope_node* leaf = find_leaf((az_ulib_ustream_rope_node*)ustream_instance->control_block->ptr,
+                ustream_instance->inner_current_position + offset, &leaf_offset);
+
+        /*[az_ulib_ustream_rope_index_succeed]*/
+        /*[az_ulib_ustream_rope_index_does_not_change_position_succeed]*/
+        if(((result = _az_ulib_ustream_read_inner(&(leaf->content.leaf.lock), &(leaf->content.leaf.ustream),
+                        (offset_t)leaf_offset, value, 1, &size)) == AZ_ULIB_EOF) || ((result == AZ_ULIB_SUCCESS) && (size == 0)))
+        {
+            result = AZ_ULIB_SYSTEM_ERROR;
+        }
+    }
+
+    return result;
+}
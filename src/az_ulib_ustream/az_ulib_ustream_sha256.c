@@ -0,0 +1,347 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_sha256.h"
+#include "internal/az_ulib_sha256.h"
+#include "az_ulib_config.h"
+#include "az_ulib_result.h"
+#include "az_ulib_ulog.h"
+
+#if defined(AZ_ULIB_CONFIG_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define USTREAM_SHA256_X86_SIMD
+#include <immintrin.h>
+#endif
+
+static const uint32_t sha256_initial_state[8] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint32_t sha256_k[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+static inline uint32_t load_be32(const uint8_t* buffer)
+{
+    return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
+}
+
+static inline void store_be32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+static void sha256_transform_portable(uint32_t* state, const uint8_t* blocks, size_t block_count)
+{
+    uint32_t w[64];
+
+    for(; block_count > 0; block_count--, blocks += AZ_ULIB_SHA256_BLOCK_SIZE)
+    {
+        for(size_t i = 0; i < 16; i++)
+        {
+            w[i] = load_be32(&blocks[i * 4]);
+        }
+        for(size_t i = 16; i < 64; i++)
+        {
+            uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        for(size_t i = 0; i < 64; i++)
+        {
+            uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+            uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef USTREAM_SHA256_X86_SIMD
+/*
+ * SHA-256 with the SHA extensions. The state is kept in two registers in the order required by the
+ *  sha256rnds2 instruction (ABEF and CDGH). Each group of 4 rounds uses one of the 4 message registers,
+ *  and calculates the message schedule of the next groups with sha256msg1 and sha256msg2.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256_transform_shani(uint32_t* state, const uint8_t* blocks, size_t block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);     /* CDAB */
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);  /* EFGH */
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);                                       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                            /* CDGH */
+
+    for(; block_count > 0; block_count--, blocks += AZ_ULIB_SHA256_BLOCK_SIZE)
+    {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i message[4];
+
+        for(size_t i = 0; i < 16; i++)
+        {
+            if(i < 4)
+            {
+                message[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&blocks[i * 16]), byte_swap);
+            }
+            __m128i rounds = _mm_add_epi32(message[i & 3], _mm_loadu_si128((const __m128i*)&sha256_k[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, rounds);
+            if((i >= 3) && (i <= 14))
+            {
+                tmp = _mm_alignr_epi8(message[i & 3], message[(i - 1) & 3], 4);
+                message[(i + 1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(message[(i + 1) & 3], tmp), message[i & 3]);
+            }
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(rounds, 0x0E));
+            if((i >= 1) && (i <= 12))
+            {
+                message[(i - 1) & 3] = _mm_sha256msg1_epu32(message[(i - 1) & 3], message[i & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                                                  /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                                               /* DCHG */
+    _mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));              /* DCBA */
+    _mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(state1, tmp, 8));                 /* HGFE */
+}
+#endif /* USTREAM_SHA256_X86_SIMD */
+
+static az_ulib_sha256_transform resolve_transform_function(void)
+{
+#ifdef USTREAM_SHA256_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1"))
+    {
+        return sha256_transform_shani;
+    }
+#endif /* USTREAM_SHA256_X86_SIMD */
+    return sha256_transform_portable;
+}
+
+static az_ulib_sha256_transform get_transform_function(void)
+{
+    /* Only the first context resolves the dispatch. Threads that race in it store the same function. */
+    static volatile az_ulib_sha256_transform transform_cache = NULL;
+    az_ulib_sha256_transform function = transform_cache;
+
+    if(function == NULL)
+    {
+        function = resolve_transform_function();
+        transform_cache = function;
+    }
+
+    return function;
+}
+
+static void sha256_start(az_ulib_sha256_context* context, az_ulib_sha256_transform transform)
+{
+    (void)memcpy(context->state, sha256_initial_state, sizeof(context->state));
+    context->length = 0;
+    context->buffer_length = 0;
+    context->transform = transform;
+}
+
+/* Complete blocks are hashed directly from the provided buffer, only the rest is copied to the context. */
+static void sha256_add(az_ulib_sha256_context* context, const uint8_t* buffer, size_t size)
+{
+    context->length += size;
+
+    if(context->buffer_length != 0)
+    {
+        size_t copy_size = AZ_ULIB_SHA256_BLOCK_SIZE - context->buffer_length;
+        if(copy_size > size)
+        {
+            copy_size = size;
+        }
+        (void)memcpy(&context->buffer[context->buffer_length], buffer, copy_size);
+        context->buffer_length += copy_size;
+        buffer += copy_size;
+        size -= copy_size;
+        if(context->buffer_length < AZ_ULIB_SHA256_BLOCK_SIZE)
+        {
+            return;
+        }
+        context->transform(context->state, context->buffer, 1);
+        context->buffer_length = 0;
+    }
+
+    size_t block_count = size / AZ_ULIB_SHA256_BLOCK_SIZE;
+    if(block_count != 0)
+    {
+        context->transform(context->state, buffer, block_count);
+        buffer += block_count * AZ_ULIB_SHA256_BLOCK_SIZE;
+        size -= block_count * AZ_ULIB_SHA256_BLOCK_SIZE;
+    }
+
+    if(size != 0)
+    {
+        (void)memcpy(context->buffer, buffer, size);
+        context->buffer_length = size;
+    }
+}
+
+az_ulib_result az_ulib_sha256_init(
+    az_ulib_sha256_context* context)
+{
+    /*[az_ulib_sha256_init_null_context_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(context, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_sha256_init_succeed]*/
+    sha256_start(context, get_transform_function());
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result _az_ulib_sha256_init_portable(
+    az_ulib_sha256_context* context)
+{
+    /*[az_ulib_sha256_init_portable_null_context_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(context, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_sha256_portable_vectors_succeed]*/
+    sha256_start(context, sha256_transform_portable);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_sha256_update(
+    az_ulib_sha256_context* context,
+    const uint8_t* const buffer,
+    size_t size)
+{
+    /*[az_ulib_sha256_update_null_context_failed]*/
+    /*[az_ulib_sha256_update_null_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(context, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE(((buffer != NULL) || (size == 0)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_sha256_vectors_succeed]*/
+    /*[az_ulib_sha256_update_byte_by_byte_succeed]*/
+    if(size != 0)
+    {
+        sha256_add(context, buffer, size);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+az_ulib_result az_ulib_ustream_sha256_update(
+    az_ulib_sha256_context* context,
+    az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_sha256_update_null_context_failed]*/
+    /*[az_ulib_ustream_sha256_update_null_instance_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(context, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+    uint8_t local_buffer[AZ_ULIB_CONFIG_USTREAM_CHECKSUM_BUFFER_SIZE];
+    offset_t start_position;
+
+    /*[az_ulib_ustream_sha256_update_get_position_failed]*/
+    if((result = az_ulib_ustream_get_position(ustream_instance, &start_position)) == AZ_ULIB_SUCCESS)
+    {
+        while(result == AZ_ULIB_SUCCESS)
+        {
+            const uint8_t* span;
+            size_t size;
+
+            /*[az_ulib_ustream_sha256_update_succeed]*/
+            /*[az_ulib_ustream_sha256_update_multibuffer_succeed]*/
+            if((result = az_ulib_ustream_get_span(ustream_instance, local_buffer, sizeof(local_buffer),
+                            &span, &size)) == AZ_ULIB_SUCCESS)
+            {
+                sha256_add(context, span, size);
+                result = az_ulib_ustream_advance(ustream_instance, size);
+            }
+        }
+
+        if(result == AZ_ULIB_EOF)
+        {
+            result = AZ_ULIB_SUCCESS;
+        }
+
+        (void)az_ulib_ustream_set_position(ustream_instance, start_position);
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_sha256_final(
+    az_ulib_sha256_context* context,
+    uint8_t* const digest)
+{
+    /*[az_ulib_sha256_final_null_context_failed]*/
+    /*[az_ulib_sha256_final_null_digest_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(context, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(digest, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /* Pad with 0x80 and zeros up to the last 8 bytes of a block, which receive the length in bits. */
+    uint64_t length_in_bits = context->length * 8;
+    context->buffer[context->buffer_length++] = 0x80;
+    if(context->buffer_length > (AZ_ULIB_SHA256_BLOCK_SIZE - 8))
+    {
+        (void)memset(&context->buffer[context->buffer_length], 0, AZ_ULIB_SHA256_BLOCK_SIZE - context->buffer_length);
+        context->transform(context->state, context->buffer, 1);
+        context->buffer_length = 0;
+    }
+    (void)memset(&context->buffer[context->buffer_length], 0, AZ_ULIB_SHA256_BLOCK_SIZE - 8 - context->buffer_length);
+    store_be32(&context->buffer[AZ_ULIB_SHA256_BLOCK_SIZE - 8], (uint32_t)(length_in_bits >> 32));
+    store_be32(&context->buffer[AZ_ULIB_SHA256_BLOCK_SIZE - 4], (uint32_t)length_in_bits);
+    context->transform(context->state, context->buffer, 1);
+
+    /*[az_ulib_sha256_vectors_succeed]*/
+    for(size_t i = 0; i < 8; i++)
+    {
+        store_be32(&digest[i * 4], context->state[i]);
+    }
+    context->buffer_length = 0;
+
+    return AZ_ULIB_SUCCESS;
+}
@@ -0,0 +1,1024 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/* Files bigger than 4GB need a 64 bits off_t, also in 32 bits systems. */
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+/* syscall() and pread() are not part of the POSIX level used by the build, glibc only exposes them with the
+ * default features. */
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "az_ulib_ucontract.h"
+#include "az_ulib_ustream_uring.h"
+#include "az_ulib_result.h"
+#include "az_ulib_port.h"
+#include "az_ulib_pal_os_api.h"
+#include "az_ulib_ulog.h"
+
+#define CHUNK_EMPTY         0
+#define CHUNK_IN_FLIGHT     1
+#define CHUNK_READY         2
+#define CHUNK_FAILED        3
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_read(az_ulib_ustream* ustream_instance, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset);
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_ulib_result concrete_peek(az_ulib_ustream* ustream_instance, const uint8_t** const buffer, size_t* const size);
+static az_ulib_result concrete_readv(az_ulib_ustream* ustream_instance, const az_ulib_ustream_iovec* const iov, size_t iov_count, size_t* const size);
+static az_ulib_result concrete_read_at(az_ulib_ustream* ustream_instance, offset_t position, uint8_t* const buffer, size_t buffer_length, size_t* const size);
+static az_ulib_result concrete_hint(az_ulib_ustream* ustream_instance, az_ulib_ustream_hint_type hint, offset_t position, size_t size);
+static const az_ulib_ustream_interface api =
+{
+        concrete_set_position,
+        concrete_reset,
+        concrete_read,
+        concrete_get_remaining_size,
+        concrete_get_position,
+        concrete_release,
+        concrete_clone,
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
+};
+
+/*
+ * io_uring helpers. The ring is only touched with the uring_data lock held, so there is a single producer for
+ *  the submission queue and a single consumer for the completion queue.
+ */
+static void ring_deinit(az_ulib_ustream_uring_ring* ring)
+{
+    if(ring->sqes != NULL)
+    {
+        (void)munmap(ring->sqes, ring->sqes_size);
+        ring->sqes = NULL;
+    }
+    if(ring->cq_ring != NULL)
+    {
+        (void)munmap(ring->cq_ring, ring->cq_ring_size);
+        ring->cq_ring = NULL;
+    }
+    if(ring->sq_ring != NULL)
+    {
+        (void)munmap(ring->sq_ring, ring->sq_ring_size);
+        ring->sq_ring = NULL;
+    }
+    if(ring->ring_fd >= 0)
+    {
+        (void)close(ring->ring_fd);
+        ring->ring_fd = -1;
+    }
+}
+
+static void* ring_map(int ring_fd, size_t size, off_t offset)
+{
+    void* address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, ring_fd, offset);
+    return (address == MAP_FAILED) ? NULL : address;
+}
+
+static bool ring_init(az_ulib_ustream_uring_ring* ring, unsigned entries)
+{
+    struct io_uring_params params;
+
+    (void)memset(ring, 0, sizeof(az_ulib_ustream_uring_ring));
+    (void)memset(&params, 0, sizeof(params));
+
+    ring->ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if(ring->ring_fd < 0)
+    {
+        ring->ring_fd = -1;
+    }
+    else
+    {
+        ring->sq_ring_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+        ring->cq_ring_size = params.cq_off.cqes + (params.cq_entries * sizeof(struct io_uring_cqe));
+        ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        ring->sq_ring = ring_map(ring->ring_fd, ring->sq_ring_size, (off_t)IORING_OFF_SQ_RING);
+        ring->cq_ring = ring_map(ring->ring_fd, ring->cq_ring_size, (off_t)IORING_OFF_CQ_RING);
+        ring->sqes = ring_map(ring->ring_fd, ring->sqes_size, (off_t)IORING_OFF_SQES);
+
+        if((ring->sq_ring == NULL) || (ring->cq_ring == NULL) || (ring->sqes == NULL))
+        {
+            ring_deinit(ring);
+        }
+        else
+        {
+            ring->sq_tail = (unsigned*)((uint8_t*)ring->sq_ring + params.sq_off.tail);
+            ring->sq_mask = (unsigned*)((uint8_t*)ring->sq_ring + params.sq_off.ring_mask);
+            ring->sq_array = (unsigned*)((uint8_t*)ring->sq_ring + params.sq_off.array);
+            ring->cq_head = (unsigned*)((uint8_t*)ring->cq_ring + params.cq_off.head);
+            ring->cq_tail = (unsigned*)((uint8_t*)ring->cq_ring + params.cq_off.tail);
+            ring->cq_mask = (unsigned*)((uint8_t*)ring->cq_ring + params.cq_off.ring_mask);
+            ring->cqes = (void*)((uint8_t*)ring->cq_ring + params.cq_off.cqes);
+        }
+    }
+
+    return (ring->ring_fd >= 0);
+}
+
+static bool ring_submit_read(
+    az_ulib_ustream_uring_ring* ring,
+    int file_descriptor,
+    uint8_t* buffer,
+    size_t length,
+    offset_t position,
+    size_t chunk_index)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &((struct io_uring_sqe*)ring->sqes)[index];
+    int submitted;
+
+    (void)memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = file_descriptor;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = (uint32_t)length;
+    sqe->off = (uint64_t)position;
+    sqe->user_data = (uint64_t)chunk_index;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    do
+    {
+        submitted = (int)syscall(__NR_io_uring_enter, ring->ring_fd, 1, 0, 0, NULL, 0);
+    } while((submitted < 0) && (errno == EINTR));
+
+    if(submitted != 1)
+    {
+        /* The kernel did not consume the entry, take it back. */
+        __atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return (submitted == 1);
+}
+
+/*
+ * Chunk helpers, all of them shall be called with the uring_data lock held.
+ */
+static void read_chunk_sync(az_ulib_ustream_uring_data_cb* uring_data, size_t chunk_index)
+{
+    az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[chunk_index];
+
+    while(chunk->filled < chunk->length)
+    {
+        ssize_t result = pread(uring_data->file_descriptor, &uring_data->buffers[chunk_index][chunk->filled],
+                                    chunk->length - chunk->filled, (off_t)(chunk->position + chunk->filled));
+        if(result > 0)
+        {
+            chunk->filled += (size_t)result;
+        }
+        else if((result == 0) || (errno != EINTR))
+        {
+            break;
+        }
+    }
+
+    chunk->state = (chunk->filled == chunk->length) ? CHUNK_READY : CHUNK_FAILED;
+}
+
+static void submit_chunk(az_ulib_ustream_uring_data_cb* uring_data, size_t chunk_index)
+{
+    az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[chunk_index];
+
+    chunk->state = CHUNK_IN_FLIGHT;
+    if((uring_data->ring.ring_fd < 0) ||
+        !ring_submit_read(&uring_data->ring, uring_data->file_descriptor, &uring_data->buffers[chunk_index][chunk->filled],
+                            chunk->length - chunk->filled, chunk->position + chunk->filled, chunk_index))
+    {
+        /*[az_ulib_ustream_uring_sync_read_succeed]*/
+        read_chunk_sync(uring_data, chunk_index);
+    }
+}
+
+static void request_chunk(az_ulib_ustream_uring_data_cb* uring_data, size_t chunk_index, offset_t chunk_position)
+{
+    az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[chunk_index];
+
+    chunk->position = chunk_position;
+    chunk->length = uring_data->file_size - chunk_position;
+    if(chunk->length > AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE)
+    {
+        chunk->length = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE;
+    }
+    chunk->filled = 0;
+    submit_chunk(uring_data, chunk_index);
+}
+
+static void reap_completions(az_ulib_ustream_uring_data_cb* uring_data, bool wait)
+{
+    az_ulib_ustream_uring_ring* ring = &uring_data->ring;
+
+    if(ring->ring_fd >= 0)
+    {
+        if(wait)
+        {
+            (void)syscall(__NR_io_uring_enter, ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        }
+
+        unsigned head = *ring->cq_head;
+        unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        while(head != tail)
+        {
+            struct io_uring_cqe* cqe = &((struct io_uring_cqe*)ring->cqes)[head & *ring->cq_mask];
+            size_t chunk_index = (size_t)cqe->user_data;
+            int result = cqe->res;
+            head++;
+            __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+            az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[chunk_index];
+            if(result > 0)
+            {
+                chunk->filled += (size_t)result;
+            }
+            if((result > 0) || (result == -EINTR) || (result == -EAGAIN))
+            {
+                if(chunk->filled < chunk->length)
+                {
+                    /* Short read, request the rest of the chunk. */
+                    submit_chunk(uring_data, chunk_index);
+                }
+                else
+                {
+                    chunk->state = CHUNK_READY;
+                }
+            }
+            else
+            {
+                /*[az_ulib_ustream_uring_read_failed]*/
+                chunk->state = CHUNK_FAILED;
+            }
+            tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        }
+    }
+}
+
+static size_t find_chunk(az_ulib_ustream_uring_data_cb* uring_data, offset_t chunk_position)
+{
+    size_t chunk_index;
+
+    for(chunk_index = 0; chunk_index < uring_data->queue_depth; chunk_index++)
+    {
+        if((uring_data->chunks[chunk_index].state != CHUNK_EMPTY) &&
+            (uring_data->chunks[chunk_index].position == chunk_position))
+        {
+            break;
+        }
+    }
+
+    return chunk_index;
+}
+
+/* Select a buffer for a new chunk. Empty buffers come first, followed by the chunks behind the current one,
+ * which the consumer is less likely to read again. Only a read on demand evicts a chunk ahead of the current one,
+ * the read-ahead never discards a chunk that may be read soon. */
+static size_t select_buffer(az_ulib_ustream_uring_data_cb* uring_data, offset_t current_position, bool on_demand)
+{
+    size_t selected = uring_data->queue_depth;
+
+    for(size_t i = 0; i < uring_data->queue_depth; i++)
+    {
+        if(uring_data->chunks[i].state == CHUNK_EMPTY)
+        {
+            return i;
+        }
+    }
+
+    for(size_t i = 0; i < uring_data->queue_depth; i++)
+    {
+        az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[i];
+        if((chunk->state != CHUNK_IN_FLIGHT) && (chunk->position < current_position) &&
+            ((selected == uring_data->queue_depth) || (chunk->position < uring_data->chunks[selected].position)))
+        {
+            selected = i;
+        }
+    }
+
+    if((selected == uring_data->queue_depth) && on_demand)
+    {
+        for(size_t i = 0; i < uring_data->queue_depth; i++)
+        {
+            az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[i];
+            if((chunk->state != CHUNK_IN_FLIGHT) && (chunk->position > current_position) &&
+                ((selected == uring_data->queue_depth) || (chunk->position > uring_data->chunks[selected].position)))
+            {
+                selected = i;
+            }
+        }
+    }
+
+    return selected;
+}
+
+static void read_ahead(az_ulib_ustream_uring_data_cb* uring_data, offset_t chunk_position)
+{
+    /* There is no gain to read ahead with synchronous reads. */
+    if(uring_data->ring.ring_fd >= 0)
+    {
+        for(size_t i = 1; i <= uring_data->read_ahead; i++)
+        {
+            offset_t next_position = chunk_position + (i * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE);
+            if(next_position >= uring_data->file_size)
+            {
+                break;
+            }
+            if(find_chunk(uring_data, next_position) == uring_data->queue_depth)
+            {
+                size_t chunk_index = select_buffer(uring_data, chunk_position, false);
+                if(chunk_index == uring_data->queue_depth)
+                {
+                    break;
+                }
+                request_chunk(uring_data, chunk_index, next_position);
+            }
+        }
+    }
+}
+
+static az_ulib_result get_chunk(az_ulib_ustream_uring_data_cb* uring_data, offset_t inner_position, size_t* chunk_index)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    offset_t chunk_position = inner_position - (inner_position % AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE);
+    bool done = false;
+
+    reap_completions(uring_data, false);
+    while(!done)
+    {
+        *chunk_index = find_chunk(uring_data, chunk_position);
+        if(*chunk_index == uring_data->queue_depth)
+        {
+            *chunk_index = select_buffer(uring_data, chunk_position, true);
+            if(*chunk_index != uring_data->queue_depth)
+            {
+                request_chunk(uring_data, *chunk_index, chunk_position);
+            }
+        }
+
+        if((*chunk_index == uring_data->queue_depth) || (uring_data->chunks[*chunk_index].state == CHUNK_IN_FLIGHT))
+        {
+            reap_completions(uring_data, true);
+        }
+        else
+        {
+            if(uring_data->chunks[*chunk_index].state == CHUNK_FAILED)
+            {
+                /* Drop the chunk, so the next read will try again. */
+                uring_data->chunks[*chunk_index].state = CHUNK_EMPTY;
+                result = AZ_ULIB_SYSTEM_ERROR;
+            }
+            done = true;
+        }
+    }
+
+    return result;
+}
+
+/* Copy size bytes starting at the inner position, crossing chunks when needed. */
+static az_ulib_result copy_from_chunks(
+        az_ulib_ustream_uring_data_cb* uring_data,
+        offset_t inner_position,
+        uint8_t* const buffer,
+        size_t size,
+        size_t* const copied_size)
+{
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    *copied_size = 0;
+    while((result == AZ_ULIB_SUCCESS) && (*copied_size < size))
+    {
+        size_t chunk_index;
+        if((result = get_chunk(uring_data, inner_position, &chunk_index)) == AZ_ULIB_SUCCESS)
+        {
+            az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[chunk_index];
+            size_t chunk_offset = inner_position - chunk->position;
+            size_t copy_size = chunk->length - chunk_offset;
+            if(copy_size > (size - *copied_size))
+            {
+                copy_size = size - *copied_size;
+            }
+            (void)memcpy(&buffer[*copied_size], &uring_data->buffers[chunk_index][chunk_offset], copy_size);
+            *copied_size += copy_size;
+            inner_position += copy_size;
+            read_ahead(uring_data, chunk->position);
+        }
+    }
+
+    return result;
+}
+
+static void init_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t data_buffer_length)
+{
+    ustream_instance->inner_current_position = inner_current_position;
+    ustream_instance->inner_first_valid_position = inner_current_position;
+    ustream_instance->offset_diff = offset - inner_current_position;
+    ustream_instance->control_block = control_block;
+    ustream_instance->length = data_buffer_length;
+    AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
+}
+
+static void destroy_instance(az_ulib_ustream* ustream_instance)
+{
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+
+    /* The kernel may still write in the buffers, wait for all the reads in flight. */
+    for(size_t i = 0; i < uring_data->queue_depth; i++)
+    {
+        while(uring_data->chunks[i].state == CHUNK_IN_FLIGHT)
+        {
+            reap_completions(uring_data, true);
+        }
+    }
+    ring_deinit(&uring_data->ring);
+    (void)close(uring_data->file_descriptor);
+    az_pal_os_lock_deinit(&uring_data->lock);
+
+    if(ustream_instance->control_block->data_release != NULL)
+    {
+        ustream_instance->control_block->data_release(ustream_instance->control_block->ptr);
+    }
+}
+
+static az_ulib_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_set_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_set_position_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_set_position_compliance_forward_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_failed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_before_first_valid_position_with_offset_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_set_position_compliance_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_to_beginning_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_back_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_forward_to_the_end_position_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_set_position_compliance_cloned_buffer_run_full_buffer_byte_by_byte_reverse_order_succeed]*/
+        ustream_instance->inner_current_position = inner_position;
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_reset(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_reset_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    /*[az_ulib_ustream_reset_compliance_back_to_beginning_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_back_position_succeed]*/
+    /*[az_ulib_ustream_reset_compliance_cloned_buffer_succeed]*/
+    ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_read(
+        az_ulib_ustream* ustream_instance,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_compliance_null_return_size_failed]*/
+    /*[az_ulib_ustream_read_compliance_buffer_with_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    if(ustream_instance->inner_current_position >= ustream_instance->length)
+    {
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_compliance_single_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_left_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_read_compliance_single_byte_succeed]*/
+        /*[az_ulib_ustream_read_compliance_get_from_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_read_compliance_cloned_buffer_right_boundary_condition_succeed]*/
+        /*[az_ulib_ustream_uring_read_full_file_succeed]*/
+        az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+
+        az_pal_os_lock_acquire(&uring_data->lock);
+        result = copy_from_chunks(uring_data, ustream_instance->inner_current_position, buffer,
+                                    (buffer_length < remain_size) ? buffer_length : remain_size, size);
+        az_pal_os_lock_release(&uring_data->lock);
+
+        if(*size != 0)
+        {
+            ustream_instance->inner_current_position += *size;
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_null_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_remaining_size_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+    /*[az_ulib_ustream_get_current_position_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_null_position_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(position, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_new_buffer_with_non_zero_current_position_succeed]*/
+    /*[az_ulib_ustream_get_current_position_compliance_cloned_buffer_with_non_zero_current_position_succeed]*/
+    *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+    /*[az_ulib_ustream_release_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_release_compliance_non_type_of_buffer_api_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position >= ustream_instance->inner_current_position) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_release_compliance_release_after_current_failed]*/
+        /*[az_ulib_ustream_release_compliance_release_position_already_released_failed]*/
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_release_compliance_succeed]*/
+        /*[az_ulib_ustream_release_compliance_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_release_all_succeed]*/
+        /*[az_ulib_ustream_release_compliance_cloned_buffer_run_full_buffer_byte_by_byte_succeed]*/
+        /*[az_ulib_ustream_uring_release_drops_chunks_succeed]*/
+        az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+
+        ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+
+        /* Drop the chunks fully before the new first valid position. If another instance still needs them, they
+         * will be read again from the file. */
+        az_pal_os_lock_acquire(&uring_data->lock);
+        for(size_t i = 0; i < uring_data->queue_depth; i++)
+        {
+            az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[i];
+            if((chunk->state == CHUNK_READY) &&
+                ((chunk->position + chunk->length) <= ustream_instance->inner_first_valid_position))
+            {
+                chunk->state = CHUNK_EMPTY;
+            }
+        }
+        az_pal_os_lock_release(&uring_data->lock);
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_clone(az_ulib_ustream* ustream_instance_clone, az_ulib_ustream* ustream_instance, offset_t offset)
+{
+    /*[az_ulib_ustream_clone_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_failed]*/
+    /*[az_ulib_ustream_clone_compliance_null_buffer_clone_failed]*/
+    /*[az_ulib_ustream_clone_compliance_offset_exceed_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance_clone, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((offset <= (AZ_ULIB_OFFSET_MAX - ustream_instance->length)), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "offset exceeds max size"));
+
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_zero_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_new_buffer_with_non_zero_current_and_released_positions_cloned_with_negative_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_cloned_buffer_with_non_zero_current_and_released_positions_cloned_with_offset_succeed]*/
+    /*[az_ulib_ustream_clone_compliance_empty_buffer_succeed]*/
+    init_instance(ustream_instance_clone, ustream_instance->control_block, ustream_instance->inner_current_position, offset,
+                                                            ustream_instance->length);
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_dispose(az_ulib_ustream* ustream_instance)
+{
+    /*[az_ulib_ustream_dispose_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING));
+
+    az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_first_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_cloned_instance_disposed_second_succeed]*/
+    /*[az_ulib_ustream_dispose_compliance_single_instance_succeed]*/
+    AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
+    if(control_block->ref_count == 0)
+    {
+        destroy_instance(ustream_instance);
+    }
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_peek_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_peek_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    /*[az_ulib_ustream_peek_compliance_not_supported_failed]*/
+    /* The chunk buffers are recycled by the other instances, so they cannot be exposed. */
+    return AZ_ULIB_NOT_SUPPORTED_ERROR;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_readv_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_iov_failed]*/
+    /*[az_ulib_ustream_readv_compliance_zero_iov_count_failed]*/
+    /*[az_ulib_ustream_readv_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(iov, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(iov_count, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        if((iov[i].buffer == NULL) && (iov[i].buffer_length != 0))
+        {
+            /*[az_ulib_ustream_readv_compliance_null_iov_buffer_failed]*/
+            result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+    }
+
+    if(result == AZ_ULIB_SUCCESS)
+    {
+        if(ustream_instance->inner_current_position >= ustream_instance->length)
+        {
+            /*[az_ulib_ustream_readv_compliance_end_of_buffer_failed]*/
+            *size = 0;
+            result = AZ_ULIB_EOF;
+        }
+        else
+        {
+            /*[az_ulib_ustream_readv_compliance_single_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_multiple_buffers_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed]*/
+            /*[az_ulib_ustream_readv_compliance_cloned_buffer_succeed]*/
+            az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+            size_t remain_size = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+            *size = 0;
+
+            az_pal_os_lock_acquire(&uring_data->lock);
+            for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < iov_count) && (*size < remain_size); i++)
+            {
+                if(iov[i].buffer_length != 0)
+                {
+                    size_t copied_size;
+                    size_t copy_size = remain_size - *size;
+                    if(iov[i].buffer_length < copy_size)
+                    {
+                        copy_size = iov[i].buffer_length;
+                    }
+                    result = copy_from_chunks(uring_data, ustream_instance->inner_current_position + *size,
+                                                iov[i].buffer, copy_size, &copied_size);
+                    *size += copied_size;
+                }
+            }
+            az_pal_os_lock_release(&uring_data->lock);
+
+            if(*size != 0)
+            {
+                ustream_instance->inner_current_position += *size;
+                result = AZ_ULIB_SUCCESS;
+            }
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    /*[az_ulib_ustream_read_at_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_buffer_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed]*/
+    /*[az_ulib_ustream_read_at_compliance_null_return_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(buffer, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(buffer_length, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(size, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_read_at_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(inner_position == ustream_instance->length)
+    {
+        /*[az_ulib_ustream_read_at_compliance_end_of_buffer_failed]*/
+        *size = 0;
+        result = AZ_ULIB_EOF;
+    }
+    else
+    {
+        /*[az_ulib_ustream_read_at_compliance_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_does_not_change_position_succeed]*/
+        /*[az_ulib_ustream_read_at_compliance_cloned_buffer_succeed]*/
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+
+        /* The chunks are shared by all the instances, but the position comes from the caller, so no instance
+         * state is changed. */
+        az_pal_os_lock_acquire(&uring_data->lock);
+        result = copy_from_chunks(uring_data, inner_position, buffer,
+                                    (buffer_length < remain_size) ? buffer_length : remain_size, size);
+        az_pal_os_lock_release(&uring_data->lock);
+        if(*size != 0)
+        {
+            result = AZ_ULIB_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    /*[az_ulib_ustream_hint_compliance_null_buffer_failed]*/
+    /*[az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed]*/
+    /*[az_ulib_ustream_hint_compliance_invalid_hint_failed]*/
+    /*[az_ulib_ustream_hint_compliance_zero_size_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE(!AZ_ULIB_USTREAM_IS_NOT_TYPE_OF(ustream_instance, api),
+                                            AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, AZ_ULIB_ULOG_USTREAM_ILLEGAL_ARGUMENT_ERROR_STRING),
+                    AZ_ULIB_UCONTRACT_REQUIRE(AZ_ULIB_USTREAM_HINT_IS_VALID(hint), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "invalid hint"),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(size, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR));
+
+    az_ulib_result result;
+
+    offset_t inner_position = position - ustream_instance->offset_diff;
+
+    if((inner_position > (offset_t)(ustream_instance->length)) ||
+            (inner_position < ustream_instance->inner_first_valid_position))
+    {
+        /*[az_ulib_ustream_hint_compliance_out_of_the_buffer_failed]*/
+        /*[az_ulib_ustream_hint_compliance_before_first_valid_position_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_hint_compliance_succeed]*/
+        /*[az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed]*/
+        /*[az_ulib_ustream_uring_hint_sequential_and_random_change_read_ahead_succeed]*/
+        /*[az_ulib_ustream_uring_hint_will_need_requests_chunks_succeed]*/
+        /*[az_ulib_ustream_uring_hint_done_drops_chunks_succeed]*/
+        az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)ustream_instance->control_block->ptr;
+        size_t remain_size = ustream_instance->length - (size_t)inner_position;
+        offset_t inner_end = inner_position + ((size < remain_size) ? size : remain_size);
+
+        /* The chunks are shared by all the instances, so the access pattern applies to all of them. */
+        az_pal_os_lock_acquire(&uring_data->lock);
+        if(hint == AZ_ULIB_USTREAM_HINT_SEQUENTIAL)
+        {
+            uring_data->read_ahead = uring_data->queue_depth - 1;
+        }
+        else if(hint == AZ_ULIB_USTREAM_HINT_RANDOM)
+        {
+            uring_data->read_ahead = 0;
+        }
+        else if(hint == AZ_ULIB_USTREAM_HINT_WILL_NEED)
+        {
+            /* Request the chunks of the range that fit in the free buffers, the same way as the read-ahead. */
+            offset_t first_chunk_position = inner_position - (inner_position % AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE);
+            reap_completions(uring_data, false);
+            for(offset_t chunk_position = first_chunk_position;
+                (uring_data->ring.ring_fd >= 0) && (chunk_position < inner_end);
+                chunk_position += AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE)
+            {
+                if(find_chunk(uring_data, chunk_position) == uring_data->queue_depth)
+                {
+                    size_t chunk_index = select_buffer(uring_data, first_chunk_position, false);
+                    if(chunk_index == uring_data->queue_depth)
+                    {
+                        break;
+                    }
+                    request_chunk(uring_data, chunk_index, chunk_position);
+                }
+            }
+        }
+        else
+        {
+            /* Drop the chunks fully inside the range, like the release does for the chunks before the first
+             * valid position. */
+            for(size_t i = 0; i < uring_data->queue_depth; i++)
+            {
+                az_ulib_ustream_uring_chunk* chunk = &uring_data->chunks[i];
+                if(((chunk->state == CHUNK_READY) || (chunk->state == CHUNK_FAILED)) &&
+                    (chunk->position >= inner_position) && ((chunk->position + chunk->length) <= inner_end))
+                {
+                    chunk->state = CHUNK_EMPTY;
+                }
+            }
+        }
+        az_pal_os_lock_release(&uring_data->lock);
+
+        /* The page cache of the file receives the same hint, which also covers the synchronous reads. */
+        if(inner_position < inner_end)
+        {
+            (void)posix_fadvise(uring_data->file_descriptor, (off_t)inner_position, (off_t)(inner_end - inner_position),
+                    (hint == AZ_ULIB_USTREAM_HINT_SEQUENTIAL) ? POSIX_FADV_SEQUENTIAL :
+                    (hint == AZ_ULIB_USTREAM_HINT_RANDOM) ? POSIX_FADV_RANDOM :
+                    (hint == AZ_ULIB_USTREAM_HINT_WILL_NEED) ? POSIX_FADV_WILLNEED : POSIX_FADV_DONTNEED);
+        }
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
+
+az_ulib_result az_ulib_ustream_uring_init(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_uring_data_cb* uring_data,
+    az_ulib_release_callback uring_data_release,
+    const char* const file_name,
+    size_t queue_depth,
+    size_t read_ahead)
+{
+    /*[az_ulib_ustream_uring_init_null_instance_failed]*/
+    /*[az_ulib_ustream_uring_init_null_uring_data_failed]*/
+    /*[az_ulib_ustream_uring_init_null_file_name_failed]*/
+    /*[az_ulib_ustream_uring_init_zero_queue_depth_failed]*/
+    /*[az_ulib_ustream_uring_init_queue_depth_too_big_failed]*/
+    /*[az_ulib_ustream_uring_init_read_ahead_too_big_failed]*/
+    AZ_ULIB_UCONTRACT(AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(ustream_instance, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(uring_data, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_NULL(file_name, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE_NOT_EQUALS(queue_depth, 0, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR),
+                    AZ_ULIB_UCONTRACT_REQUIRE((queue_depth <= AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "queue depth exceeds max size"),
+                    AZ_ULIB_UCONTRACT_REQUIRE((read_ahead < queue_depth), AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, "read ahead exceeds queue depth"));
+
+    az_ulib_result result;
+    struct stat file_status;
+
+    int file_descriptor = open(file_name, O_RDONLY);
+    if(file_descriptor < 0)
+    {
+        /*[az_ulib_ustream_uring_init_file_not_found_failed]*/
+        result = AZ_ULIB_NO_SUCH_ELEMENT_ERROR;
+    }
+    else if(fstat(file_descriptor, &file_status) != 0)
+    {
+        (void)close(file_descriptor);
+        result = AZ_ULIB_SYSTEM_ERROR;
+    }
+    else if((file_status.st_size <= 0) || ((uintmax_t)file_status.st_size > (uintmax_t)AZ_ULIB_OFFSET_MAX))
+    {
+        /*[az_ulib_ustream_uring_init_empty_file_failed]*/
+        (void)close(file_descriptor);
+        result = AZ_ULIB_ILLEGAL_ARGUMENT_ERROR;
+    }
+    else
+    {
+        /*[az_ulib_ustream_uring_init_succeed]*/
+        uring_data->file_descriptor = file_descriptor;
+        uring_data->file_size = (size_t)file_status.st_size;
+        uring_data->queue_depth = queue_depth;
+        uring_data->read_ahead = read_ahead;
+        for(size_t i = 0; i < AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH; i++)
+        {
+            uring_data->chunks[i].state = CHUNK_EMPTY;
+        }
+
+        /* If the system does not support io_uring, the ustream uses synchronous reads. */
+        (void)ring_init(&uring_data->ring, (unsigned)queue_depth);
+        az_pal_os_lock_init(&uring_data->lock);
+
+        uring_data->control_block.api = &api;
+        uring_data->control_block.ptr = (void*)uring_data;
+        uring_data->control_block.ref_count = 0;
+        uring_data->control_block.data_release = uring_data_release;
+        uring_data->control_block.control_block_release = NULL;
+
+        init_instance(ustream_instance, &uring_data->control_block, 0, 0, uring_data->file_size);
+
+        result = AZ_ULIB_SUCCESS;
+    }
+
+    return result;
+}
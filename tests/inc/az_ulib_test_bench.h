@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef AZ_ULIB_TEST_BENCH_H
+#define AZ_ULIB_TEST_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Minimum time that each benchmark case shall run. */
+#define TEST_BENCH_MIN_TIME_NS  (200ull * 1000ull * 1000ull)
+
+/* Return a monotonic time in nanoseconds. */
+uint64_t test_bench_get_time_ns(void);
+
+/* Start the JSON document of a benchmark. */
+void test_bench_begin(const char* bench_name);
+
+/* Add one result to the JSON document. The bytes may be 0 for benchmarks that only count operations. */
+void test_bench_report(
+    const char* case_name,
+    const char* parameter_name,
+    uint64_t parameter_value,
+    uint64_t operations,
+    uint64_t bytes,
+    uint64_t elapsed_ns);
+
+/* Close the JSON document of a benchmark. */
+void test_bench_end(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AZ_ULIB_TEST_BENCH_H */
@@ -20,6 +20,8 @@
 #error "USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH must be at least 20 uint8_t long"
 #endif
 
+/* ustreams that cannot expose their content without a copy shall define USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED. */
+
 /* split the content in 4 parts. */
 #define USTREAM_COMPLIANCE_LENGTH_1           (USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH >> 2)
 #define USTREAM_COMPLIANCE_LENGTH_2           (USTREAM_COMPLIANCE_LENGTH_1 + USTREAM_COMPLIANCE_LENGTH_1)
@@ -609,7 +611,7 @@ TEST_FUNCTION(az_ulib_ustream_clone_compliance_buffer_is_not_type_of_buffer_fail
     (void)az_ulib_ustream_dispose(&ustream_instance);
 }
 
-/* If the offset plus the buffer length bypass UINT32_MAX, the clone shall return NULL. */
+/* If the offset plus the buffer length bypass AZ_ULIB_OFFSET_MAX, the clone shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
 TEST_FUNCTION(az_ulib_ustream_clone_compliance_offset_exceed_size_failed)
 {
     ///arrange
@@ -620,7 +622,7 @@ TEST_FUNCTION(az_ulib_ustream_clone_compliance_offset_exceed_size_failed)
 
     ///act
     az_ulib_result result =
-        az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, UINT32_MAX - 2);
+        az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, AZ_ULIB_OFFSET_MAX - 2);
 
     ///assert
     ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
@@ -629,6 +631,47 @@ TEST_FUNCTION(az_ulib_ustream_clone_compliance_offset_exceed_size_failed)
     (void)az_ulib_ustream_dispose(&ustream_instance);
 }
 
+#if SIZE_MAX > UINT32_MAX
+/* The clone shall accept offsets bigger than 4GB, and all the positions in the clone shall use the full offset_t. */
+TEST_FUNCTION(az_ulib_ustream_clone_compliance_offset_bigger_than_4gb_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_clone;
+    offset_t offset = (offset_t)UINT32_MAX + 10000;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, offset);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+
+    offset_t ustream_clone_current_position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_get_position(&ustream_instance_clone, &ustream_clone_current_position));
+    ASSERT_ARE_EQUAL(size_t, offset, ustream_clone_current_position);
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance_clone, offset + 10));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_release(&ustream_instance_clone, offset + 4));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&ustream_instance_clone));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_get_position(&ustream_instance_clone, &ustream_clone_current_position));
+    ASSERT_ARE_EQUAL(size_t, offset + 5, ustream_clone_current_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, az_ulib_ustream_set_position(&ustream_instance_clone, offset + 4));
+
+    check_buffer(
+        &ustream_instance_clone,
+        5,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#endif /* SIZE_MAX > UINT32_MAX */
+
 /* The get_remaining_size shall return the number of bytes between the current position and the end of the buffer. */
 TEST_FUNCTION(az_ulib_ustream_get_remaining_size_compliance_new_buffer_succeed)
 {
@@ -2395,4 +2438,1380 @@ TEST_FUNCTION(az_ulib_ustream_reset_compliance_non_type_of_buffer_api_failed)
     (void)az_ulib_ustream_dispose(&ustream_instance);
 }
 
+#ifndef USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED
+/* The peek shall return a span with the content of the buffer at the current position. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_new_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    const uint8_t* span = NULL;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_NOT_NULL(span);
+    ASSERT_IS_TRUE(size_result > 0);
+    ASSERT_IS_TRUE(size_result <= USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, span, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The peek shall not change the current position of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_does_not_change_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    const uint8_t* span = NULL;
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_TRUE(size_result <= (USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_1));
+    ASSERT_BUFFER_ARE_EQUAL(
+        uint8_t_ptr,
+        (const uint8_t* const)(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1),
+        span,
+        size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_cloned_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    az_ulib_ustream ustream_instance_clone;
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 100));
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    const uint8_t* span = NULL;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance_clone, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_TRUE(size_result <= (USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_1));
+    ASSERT_BUFFER_ARE_EQUAL(
+        uint8_t_ptr,
+        (const uint8_t* const)(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1),
+        span,
+        size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+}
+
+/* Peek and advance shall expose the full content of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_run_full_buffer_with_advance_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t total_size = 0;
+    const uint8_t* span;
+    size_t size_result;
+    az_ulib_result result;
+
+    ///act
+    while((result = az_ulib_ustream_peek(&ustream_instance, &span, &size_result)) == AZ_ULIB_SUCCESS)
+    {
+        ASSERT_IS_TRUE((total_size + size_result) <= USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+        (void)memcpy(&buf_result[total_size], span, size_result);
+        total_size += size_result;
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_advance(&ustream_instance, size_result));
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, total_size);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, total_size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If there is no more content to return, the peek shall return AZ_ULIB_EOF and size shall receive 0. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_end_of_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH));
+    const uint8_t* span;
+    size_t size_result = 10;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, 0, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#else
+/* If the ustream cannot expose its content without a copy, the peek shall return AZ_ULIB_NOT_SUPPORTED_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_not_supported_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    const uint8_t* span;
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NOT_SUPPORTED_ERROR, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#endif /* USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED */
+
+/* If the provided handle is NULL, the peek shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->peek(NULL, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is not the implemented buffer type, the peek shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_non_type_of_buffer_api_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->peek(ustream_mock_create(), &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided buffer pointer is NULL, the peek shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_null_return_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, NULL, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided return size pointer is NULL, the peek shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_peek_compliance_null_return_size_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    const uint8_t* span;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall copy the full content to a single local buffer. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_single_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, size_result);
+    check_buffer(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall fill the local buffers in order, each one up to its size. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_multiple_buffers_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result_1[USTREAM_COMPLIANCE_LENGTH_1];
+    uint8_t buf_result_2[USTREAM_COMPLIANCE_LENGTH_2];
+    uint8_t buf_result_3[USTREAM_COMPLIANCE_LENGTH_1];
+    az_ulib_ustream_iovec iov[3] = 
+    {
+        { buf_result_1, USTREAM_COMPLIANCE_LENGTH_1 },
+        { buf_result_2, USTREAM_COMPLIANCE_LENGTH_2 },
+        { buf_result_3, USTREAM_COMPLIANCE_LENGTH_1 }
+    };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 3, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1 + USTREAM_COMPLIANCE_LENGTH_3, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result_1, USTREAM_COMPLIANCE_LENGTH_1);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1, 
+                            buf_result_2, USTREAM_COMPLIANCE_LENGTH_2);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_3, 
+                            buf_result_3, USTREAM_COMPLIANCE_LENGTH_1);
+    check_buffer(
+        &ustream_instance, 
+        USTREAM_COMPLIANCE_LENGTH_1 + USTREAM_COMPLIANCE_LENGTH_3, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the local buffers are bigger than the remaining content, the readv shall copy only the remaining content. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_buffers_bigger_than_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    uint8_t buf_result_1[USTREAM_COMPLIANCE_LENGTH_2];
+    uint8_t buf_result_2[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    uint8_t buf_result_3[USTREAM_COMPLIANCE_LENGTH_1];
+    az_ulib_ustream_iovec iov[3] = 
+    {
+        { buf_result_1, USTREAM_COMPLIANCE_LENGTH_2 },
+        { buf_result_2, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH },
+        { buf_result_3, USTREAM_COMPLIANCE_LENGTH_1 }
+    };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 3, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1, 
+                            buf_result_1, USTREAM_COMPLIANCE_LENGTH_2);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_3, 
+                            buf_result_2, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_3);
+    check_buffer(
+        &ustream_instance, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall skip the local buffers with size zero. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_skip_zero_length_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result_1[USTREAM_COMPLIANCE_LENGTH_1];
+    uint8_t buf_result_2[USTREAM_COMPLIANCE_LENGTH_1];
+    az_ulib_ustream_iovec iov[4] = 
+    {
+        { NULL, 0 },
+        { buf_result_1, USTREAM_COMPLIANCE_LENGTH_1 },
+        { NULL, 0 },
+        { buf_result_2, USTREAM_COMPLIANCE_LENGTH_1 }
+    };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 4, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_2, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result_1, USTREAM_COMPLIANCE_LENGTH_1);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1, 
+                            buf_result_2, USTREAM_COMPLIANCE_LENGTH_1);
+    check_buffer(
+        &ustream_instance, 
+        USTREAM_COMPLIANCE_LENGTH_2, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall copy the content of a cloned buffer from its current position. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_cloned_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    az_ulib_ustream ustream_instance_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 100));
+    uint8_t buf_result_1[USTREAM_COMPLIANCE_LENGTH_1];
+    uint8_t buf_result_2[USTREAM_COMPLIANCE_LENGTH_1];
+    az_ulib_ustream_iovec iov[2] = 
+    {
+        { buf_result_1, USTREAM_COMPLIANCE_LENGTH_1 },
+        { buf_result_2, USTREAM_COMPLIANCE_LENGTH_1 }
+    };
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance_clone, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_2, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1, 
+                            buf_result_1, USTREAM_COMPLIANCE_LENGTH_1);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_2, 
+                            buf_result_2, USTREAM_COMPLIANCE_LENGTH_1);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance_clone, &position));
+    ASSERT_ARE_EQUAL(int, 100 + USTREAM_COMPLIANCE_LENGTH_2, position);
+    check_buffer(
+        &ustream_instance, 
+        USTREAM_COMPLIANCE_LENGTH_1, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+}
+
+/* If there is no more content to return, the readv shall return AZ_ULIB_EOF, size shall receive 0. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_end_of_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, 
+                    az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH));
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+    size_t size_result = 10;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, 0, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is NULL, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->readv(NULL, iov, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is not the implemented buffer type, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_non_type_of_buffer_api_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->readv(ustream_mock_create(), iov, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided iov is NULL, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_null_iov_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, NULL, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided iov_count is zero, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_zero_iov_count_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 0, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If one of the local buffers is NULL with a size bigger than zero, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_null_iov_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_LENGTH_1];
+    az_ulib_ustream_iovec iov[2] = 
+    {
+        { buf_result, USTREAM_COMPLIANCE_LENGTH_1 },
+        { NULL, USTREAM_COMPLIANCE_LENGTH_1 }
+    };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided return size pointer is NULL, the readv shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_readv_compliance_null_return_size_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH } };
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 1, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    check_buffer(
+        &ustream_instance, 
+        0, 
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The read_at shall copy the content starting at the provided position to the local buffer. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+                            buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The read_at shall not change the current position of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_does_not_change_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    uint8_t buf_result[USTREAM_COMPLIANCE_LENGTH_1];
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_2, buf_result,
+                                USTREAM_COMPLIANCE_LENGTH_1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_2,
+                            buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, position);
+    check_buffer(
+        &ustream_instance,
+        USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The read_at shall use the logical positions of a cloned buffer. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_cloned_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    az_ulib_ustream ustream_instance_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 100));
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance_clone, 100 + USTREAM_COMPLIANCE_LENGTH_1, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_2, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_2,
+                            buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+}
+
+/* If the position is the end of the buffer, the read_at shall return AZ_ULIB_EOF, size shall receive 0. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_end_of_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result = 10;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+                                buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, 0, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the position is after the end of the buffer, the read_at shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_out_of_the_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1,
+                                buf_result, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the position is before the first valid position, the read_at shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_before_first_valid_position_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_release(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1 - 1));
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, 0, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is NULL, the read_at shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->read_at(NULL, 0, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is not the implemented buffer type, the read_at shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_non_type_of_buffer_api_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->read_at(ustream_mock_create(), 0, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided buffer pointer is NULL, the read_at shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_null_return_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, 0, NULL,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided buffer_length is zero, the read_at shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_buffer_with_zero_size_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, 0, buf_result, 0, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided return size pointer is NULL, the read_at shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_read_at_compliance_null_return_size_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance, 0, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint shall not change the content or the current position of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    offset_t position;
+
+    ///act
+    az_ulib_result result_sequential = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_SEQUENTIAL,
+                                            USTREAM_COMPLIANCE_LENGTH_1, USTREAM_COMPLIANCE_LENGTH_1);
+    az_ulib_result result_random = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_RANDOM,
+                                            USTREAM_COMPLIANCE_LENGTH_1, USTREAM_COMPLIANCE_LENGTH_1);
+    az_ulib_result result_will_need = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED,
+                                            USTREAM_COMPLIANCE_LENGTH_1, USTREAM_COMPLIANCE_LENGTH_1);
+    az_ulib_result result_done = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_DONE,
+                                            USTREAM_COMPLIANCE_LENGTH_1, USTREAM_COMPLIANCE_LENGTH_1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_sequential);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_random);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_will_need);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_done);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, position);
+    check_buffer(
+        &ustream_instance,
+        USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint shall only consider the part of the range before the end of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_size_bigger_than_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result_will_need = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, SIZE_MAX);
+    az_ulib_result result_done = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_DONE,
+                                        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, SIZE_MAX);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_will_need);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_done);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint at the end of a slice shall return AZ_ULIB_SUCCESS, even if the slice ends in the middle of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_end_of_slice_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                        USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice));
+
+    ///act
+    az_ulib_result result_will_need = az_ulib_ustream_hint(&ustream_instance_slice, AZ_ULIB_USTREAM_HINT_WILL_NEED,
+                                            USTREAM_COMPLIANCE_LENGTH_2, 1);
+    az_ulib_result result_done = az_ulib_ustream_hint(&ustream_instance_slice, AZ_ULIB_USTREAM_HINT_DONE,
+                                        USTREAM_COMPLIANCE_LENGTH_2, SIZE_MAX);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_will_need);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_done);
+    check_buffer(
+        &ustream_instance_slice,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LENGTH_1);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* If the position is after the end of the buffer, the hint shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_out_of_the_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED,
+                                USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the position is before the first valid position, the hint shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_before_first_valid_position_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_release(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1 - 1));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is NULL, the hint shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->hint(NULL, AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is not the implemented buffer type, the hint shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_non_type_of_buffer_api_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = (&ustream_instance)->control_block->api->hint(ustream_mock_create(),
+                                AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided hint is not valid, the hint shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_invalid_hint_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance,
+                                (az_ulib_ustream_hint_type)(AZ_ULIB_USTREAM_HINT_DONE + 1), 0, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided size is zero, the hint shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_hint_compliance_zero_size_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The slice shall create a ustream with the provided part of the buffer, keeping the positions of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    offset_t position;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance_slice, &position));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance_slice, &size));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, size);
+    check_buffer(
+        &ustream_instance_slice,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LENGTH_1);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* The slice shall not change the current position of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_does_not_change_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_2));
+    az_ulib_ustream ustream_instance_slice;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, 0, USTREAM_COMPLIANCE_LENGTH_3,
+                                &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_2, position);
+    check_buffer(
+        &ustream_instance,
+        USTREAM_COMPLIANCE_LENGTH_2,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    check_buffer(&ustream_instance_slice, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_LENGTH_3);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* The slice shall use the logical positions of a cloned buffer, and remain valid after the buffer is disposed. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_cloned_buffer_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    az_ulib_ustream ustream_instance_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 100));
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance_clone, 100 + USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice);
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    offset_t position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance_slice, &position));
+    ASSERT_ARE_EQUAL(int, 100 + USTREAM_COMPLIANCE_LENGTH_1, position);
+    check_buffer(
+        &ustream_instance_slice,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_2,
+        USTREAM_COMPLIANCE_LENGTH_1);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* The slice of a slice shall be bounded by the first slice. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_slice_of_slice_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_2, &ustream_instance_slice));
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice_2;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance_slice, USTREAM_COMPLIANCE_LENGTH_2,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice_2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, az_ulib_ustream_slice(&ustream_instance_slice,
+                                USTREAM_COMPLIANCE_LENGTH_2, USTREAM_COMPLIANCE_LENGTH_2, &ustream_instance_slice_2));
+    check_buffer(
+        &ustream_instance_slice_2,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_2,
+        USTREAM_COMPLIANCE_LENGTH_1);
+    check_buffer(
+        &ustream_instance_slice,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LENGTH_2);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice_2);
+}
+
+/* The slice shall not move the current position out of the slice. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_set_position_out_of_the_slice_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice));
+
+    ///act
+    az_ulib_result result_before =
+        az_ulib_ustream_set_position(&ustream_instance_slice, USTREAM_COMPLIANCE_LENGTH_1 - 1);
+    az_ulib_result result_after =
+        az_ulib_ustream_set_position(&ustream_instance_slice, USTREAM_COMPLIANCE_LENGTH_2 + 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result_before);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result_after);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance_slice, USTREAM_COMPLIANCE_LENGTH_2));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&ustream_instance_slice));
+    check_buffer(
+        &ustream_instance_slice,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+        USTREAM_COMPLIANCE_LENGTH_1);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* The read_at and readv in a slice shall not return content after the end of the slice. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_read_at_and_readv_bounded_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice));
+    uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+    az_ulib_ustream_iovec iov[2] =
+    {
+        { buf_result, 1 },
+        { buf_result + 1, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH - 1 }
+    };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&ustream_instance_slice, USTREAM_COMPLIANCE_LENGTH_1 + 1, buf_result,
+                                USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1 - 1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1 + 1,
+                            buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_readv(&ustream_instance_slice, iov, 2, &size_result));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+                            buf_result, size_result);
+    check_buffer(&ustream_instance_slice, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 0);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+#ifndef USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED
+/* The peek in a slice shall not expose content after the end of the slice. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_peek_bounded_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_LENGTH_1, &ustream_instance_slice));
+    const uint8_t* span;
+    size_t size_result;
+    size_t total_size = 0;
+
+    ///act
+    while(az_ulib_ustream_peek(&ustream_instance_slice, &span, &size_result) == AZ_ULIB_SUCCESS)
+    {
+        ///assert
+        ASSERT_IS_TRUE(total_size + size_result <= USTREAM_COMPLIANCE_LENGTH_1);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr,
+                            USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1 + total_size,
+                            span, size_result);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_advance(&ustream_instance_slice, size_result));
+        total_size += size_result;
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LENGTH_1, total_size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+#endif /* USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED */
+
+/* The slice shall accept an empty slice at the end of the buffer. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_empty_slice_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, 0,
+                                &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    check_buffer(&ustream_instance_slice, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 0);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_slice);
+}
+
+/* If the offset is before the first valid position, the slice shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_before_first_valid_position_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_release(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1 - 1));
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1 - 1, 1,
+                                &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the offset is after the end of the buffer, the slice shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_out_of_the_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1, 0,
+                                &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the slice goes after the end of the buffer, the slice shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_length_out_of_the_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1,
+                                USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided handle is NULL, the slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(NULL, 0, 1, &ustream_instance_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* If the provided slice is NULL, the slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR. */
+TEST_FUNCTION(az_ulib_ustream_slice_compliance_null_buffer_slice_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(&ustream_instance, 0, 1, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
 #endif /* AZ_ULIB_USTREAM_COMPLIANCE_UT_H */
@@ -25,6 +25,12 @@ void set_get_position_result(az_ulib_result result);
 void set_release_result(az_ulib_result result);
 void set_clone_result(az_ulib_result result);
 void set_dispose_result(az_ulib_result result);
+void set_peek_result(az_ulib_result result);
+void set_readv_result(az_ulib_result result);
+void set_read_at_result(az_ulib_result result);
+void set_hint_result(az_ulib_result result);
+
+size_t get_hint_call(az_ulib_ustream_hint_type* hint, offset_t* position, size_t* size);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "az_ulib_test_bench.h"
+
+static int bench_result_count;
+
+void test_bench_begin(const char* bench_name)
+{
+    bench_result_count = 0;
+    (void)printf("{\n  \"benchmark\": \"%s\",\n  \"results\": [", bench_name);
+}
+
+void test_bench_report(
+    const char* case_name,
+    const char* parameter_name,
+    uint64_t parameter_value,
+    uint64_t operations,
+    uint64_t bytes,
+    uint64_t elapsed_ns)
+{
+    double seconds = (elapsed_ns == 0) ? 1e-9 : ((double)elapsed_ns / 1e9);
+
+    (void)printf("%s\n    { \"name\": \"%s\", \"%s\": %" PRIu64 ", \"operations\": %" PRIu64
+                    ", \"bytes\": %" PRIu64 ", \"elapsed_ns\": %" PRIu64
+                    ", \"operations_per_second\": %.1f, \"megabytes_per_second\": %.2f }",
+                    (bench_result_count == 0) ? "" : ",",
+                    case_name, parameter_name, parameter_value, operations, bytes, elapsed_ns,
+                    (double)operations / seconds, ((double)bytes / (1024.0 * 1024.0)) / seconds);
+    (void)fflush(stdout);
+    bench_result_count++;
+}
+
+void test_bench_end(void)
+{
+    (void)printf("\n  ]\n}\n");
+}
@@ -14,6 +14,10 @@ static az_ulib_result _concrete_get_position_result = AZ_ULIB_SUCCESS;
 static az_ulib_result _concrete_release_result = AZ_ULIB_SUCCESS;
 static az_ulib_result _concrete_clone_result = AZ_ULIB_SUCCESS;
 static az_ulib_result _concrete_dispose_result = AZ_ULIB_SUCCESS;
+static az_ulib_result _concrete_peek_result = AZ_ULIB_SUCCESS;
+static az_ulib_result _concrete_readv_result = AZ_ULIB_SUCCESS;
+static az_ulib_result _concrete_read_at_result = AZ_ULIB_NOT_SUPPORTED_ERROR;
+static az_ulib_result _concrete_hint_result = AZ_ULIB_SUCCESS;
 
 #define READ_BUFFER_SIZE 10
 static offset_t current_position = 0;
@@ -22,11 +26,17 @@ static uint8_t read_buffer[READ_BUFFER_SIZE];
 static bool concurrency_ustream = false;
 static uint32_t delay_return_value = 0;
 
+static size_t hint_count = 0;
+static az_ulib_ustream_hint_type last_hint = AZ_ULIB_USTREAM_HINT_SEQUENTIAL;
+static offset_t last_hint_position = 0;
+static size_t last_hint_size = 0;
+
 void reset_mock_buffer(void)
 {
     current_position = 0;
     concurrency_ustream = false;
     delay_return_value = 0;
+    hint_count = 0;
 }
 
 void set_concurrency_ustream(void)
@@ -173,6 +183,79 @@ static az_ulib_result concrete_dispose(
     return result;
 }
 
+static az_ulib_result concrete_peek(
+        az_ulib_ustream* ustream_instance,
+        const uint8_t** const buffer,
+        size_t* const size)
+{
+    (void)ustream_instance;
+
+    *buffer = read_buffer;
+    *size = READ_BUFFER_SIZE;
+
+    az_ulib_result result = _concrete_peek_result;
+    _concrete_peek_result = AZ_ULIB_SUCCESS;
+    return result;
+}
+
+static az_ulib_result concrete_readv(
+        az_ulib_ustream* ustream_instance,
+        const az_ulib_ustream_iovec* const iov,
+        size_t iov_count,
+        size_t* const size)
+{
+    (void)ustream_instance;
+
+    *size = 0;
+    for(size_t i = 0; i < iov_count; i++)
+    {
+        *size += iov[i].buffer_length;
+    }
+    current_position += *size;
+
+    az_ulib_result result = _concrete_readv_result;
+    _concrete_readv_result = AZ_ULIB_SUCCESS;
+    return result;
+}
+
+/* The mock does not support read_at by default, so the consumers exercise the set_position and read. */
+static az_ulib_result concrete_read_at(
+        az_ulib_ustream* ustream_instance,
+        offset_t position,
+        uint8_t* const buffer,
+        size_t buffer_length,
+        size_t* const size)
+{
+    (void)ustream_instance;
+    (void)position;
+    (void)buffer;
+
+    *size = buffer_length;
+
+    az_ulib_result result = _concrete_read_at_result;
+    _concrete_read_at_result = AZ_ULIB_NOT_SUPPORTED_ERROR;
+    return result;
+}
+
+/* The mock records the last hint, so the consumers can check what was forwarded to it. */
+static az_ulib_result concrete_hint(
+        az_ulib_ustream* ustream_instance,
+        az_ulib_ustream_hint_type hint,
+        offset_t position,
+        size_t size)
+{
+    (void)ustream_instance;
+
+    hint_count++;
+    last_hint = hint;
+    last_hint_position = position;
+    last_hint_size = size;
+
+    az_ulib_result result = _concrete_hint_result;
+    _concrete_hint_result = AZ_ULIB_SUCCESS;
+    return result;
+}
+
 static const az_ulib_ustream_interface api =
 {
         concrete_set_position,
@@ -182,7 +265,11 @@ static const az_ulib_ustream_interface api =
         concrete_get_position,
         concrete_release,
         concrete_clone,
-        concrete_dispose
+        concrete_dispose,
+        concrete_peek,
+        concrete_readv,
+        concrete_read_at,
+        concrete_hint
 };
 
 static const int TEST_DATA = 1;
@@ -215,6 +302,9 @@ az_ulib_ustream* ustream_mock_create(void)
     _concrete_release_result = AZ_ULIB_SUCCESS;
     _concrete_clone_result = AZ_ULIB_SUCCESS;
     _concrete_dispose_result = AZ_ULIB_SUCCESS;
+    _concrete_peek_result = AZ_ULIB_SUCCESS;
+    _concrete_readv_result = AZ_ULIB_SUCCESS;
+    _concrete_hint_result = AZ_ULIB_SUCCESS;
 
     return &USTREAM_COMPLIANCE_MOCK_BUFFER;
 }
@@ -258,3 +348,31 @@ void set_dispose_result(az_ulib_result result)
 {
     _concrete_dispose_result = result;
 }
+
+void set_peek_result(az_ulib_result result)
+{
+    _concrete_peek_result = result;
+}
+
+void set_readv_result(az_ulib_result result)
+{
+    _concrete_readv_result = result;
+}
+
+void set_read_at_result(az_ulib_result result)
+{
+    _concrete_read_at_result = result;
+}
+
+void set_hint_result(az_ulib_result result)
+{
+    _concrete_hint_result = result;
+}
+
+size_t get_hint_call(az_ulib_ustream_hint_type* hint, offset_t* position, size_t* size)
+{
+    *hint = last_hint;
+    *position = last_hint_position;
+    *size = last_hint_size;
+    return hint_count;
+}
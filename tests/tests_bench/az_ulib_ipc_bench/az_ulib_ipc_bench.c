@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_action_api.h"
+#include "az_ulib_config.h"
+#include "az_ulib_descriptor_api.h"
+#include "az_ulib_ipc_api.h"
+#include "az_ulib_result.h"
+#include "az_ulib_test_bench.h"
+#include "az_ulib_test_thread.h"
+
+/**
+ * Micro-benchmark of the az_ulib_ipc_call() hot path. The result is a JSON document in the stdout with one entry for
+ * each case, so it can be compared between releases, and between values of AZ_ULIB_CONFIG_IPC_CALL_SHARDS.
+ *
+ * Cases:
+ *      1) call: 1 to 8 threads calling an empty method of the same interface, each thread with its own handle.
+ *      2) call_private: 1 to 8 threads calling an empty method, each thread in its own interface. It is the
+ *          reference for the call case, without any data shared between the threads.
+ */
+
+#define BENCH_CALLS_PER_THREAD  1000000
+#define BENCH_MAX_THREADS       8
+#define BENCH_NAME_SIZE         16
+
+typedef struct bench_thread_context_tag
+{
+    const char* name;
+    uint64_t operations;
+} bench_thread_context;
+
+static az_ulib_ipc bench_ipc;
+static char bench_names[BENCH_MAX_THREADS][BENCH_NAME_SIZE];
+static az_ulib_interface_descriptor bench_descriptors[BENCH_MAX_THREADS];
+
+static az_ulib_result bench_method(const void* const model_in, const void* model_out)
+{
+    (void)model_in;
+    (void)model_out;
+
+    return AZ_ULIB_SUCCESS;
+}
+
+static az_ulib_action_descriptor bench_actions[1] = { AZ_ULIB_DESCRIPTOR_ADD_METHOD("bench_method", bench_method) };
+
+static int threaded_call(void* arg)
+{
+    bench_thread_context* context = (bench_thread_context*)arg;
+    az_ulib_ipc_interface_handle handle;
+
+    context->operations = 0;
+    if(az_ulib_ipc_try_get_interface(context->name, 1, AZ_ULIB_VERSION_EQUALS_TO, &handle) != AZ_ULIB_SUCCESS)
+    {
+        return 1;
+    }
+    for(size_t i = 0; i < BENCH_CALLS_PER_THREAD; i++)
+    {
+        if(az_ulib_ipc_call(handle, 0, NULL, NULL) != AZ_ULIB_SUCCESS)
+        {
+            (void)az_ulib_ipc_release_interface(handle);
+            return 1;
+        }
+    }
+    context->operations = BENCH_CALLS_PER_THREAD;
+    (void)az_ulib_ipc_release_interface(handle);
+
+    return 0;
+}
+
+static void bench_threaded_call(const char* case_name, bool private_interface)
+{
+    for(size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2)
+    {
+        THREAD_HANDLE threads[BENCH_MAX_THREADS];
+        bench_thread_context contexts[BENCH_MAX_THREADS];
+        uint64_t operations = 0;
+
+        uint64_t start = test_bench_get_time_ns();
+        for(size_t i = 0; i < thread_count; i++)
+        {
+            contexts[i].name = bench_names[private_interface ? i : 0];
+            if(test_thread_create(&threads[i], threaded_call, &contexts[i]) != TEST_THREAD_OK)
+            {
+                (void)printf("failed to create the thread\r\n");
+                exit(1);
+            }
+        }
+        for(size_t i = 0; i < thread_count; i++)
+        {
+            int thread_result;
+            if((test_thread_join(threads[i], &thread_result) != TEST_THREAD_OK) || (thread_result != 0))
+            {
+                (void)printf("failed to run the thread\r\n");
+                exit(1);
+            }
+            operations += contexts[i].operations;
+        }
+        uint64_t elapsed = test_bench_get_time_ns() - start;
+
+        test_bench_report(case_name, "threads", thread_count, operations, 0, elapsed);
+    }
+}
+
+int main(void)
+{
+    if(az_ulib_ipc_init(&bench_ipc) != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to initialize the IPC\r\n");
+        exit(1);
+    }
+    for(size_t i = 0; i < BENCH_MAX_THREADS; i++)
+    {
+        (void)snprintf(bench_names[i], sizeof(bench_names[i]), "bench_%u", (unsigned int)i);
+        bench_descriptors[i].name = bench_names[i];
+        bench_descriptors[i].version = 1;
+        bench_descriptors[i].size = 1;
+        bench_descriptors[i].action_list = bench_actions;
+        if(az_ulib_ipc_publish(&bench_descriptors[i], NULL) != AZ_ULIB_SUCCESS)
+        {
+            (void)printf("failed to publish the interface\r\n");
+            exit(1);
+        }
+    }
+
+    test_bench_begin("ipc");
+    bench_threaded_call("call", false);
+    bench_threaded_call("call_private", true);
+    test_bench_end();
+
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+    for(size_t i = 0; i < BENCH_MAX_THREADS; i++)
+    {
+        (void)az_ulib_ipc_unpublish(&bench_descriptors[i], AZ_ULIB_NO_WAIT);
+    }
+    (void)az_ulib_ipc_deinit();
+#endif /* AZ_ULIB_CONFIG_IPC_UNPUBLISH */
+
+    return 0;
+}
@@ -0,0 +1,722 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_lz.h"
+#include "az_ulib_ustream_parallel.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_ustream_rope.h"
+#include "az_ulib_ustream_sha256.h"
+#include "internal/az_ulib_sha256.h"
+#include "az_ulib_result.h"
+#include "az_ulib_test_bench.h"
+#include "az_ulib_test_thread.h"
+
+/**
+ * Micro-benchmark of the ustream hot path. The result is a JSON document in the stdout with one entry for each
+ * case, so it can be compared between releases.
+ *
+ * Cases:
+ *      1) read: az_ulib_ustream_read() over a 1MB memory ustream, with read sizes from 1B to 1MB.
+ *      2) clone_dispose: az_ulib_ustream_clone() followed by az_ulib_ustream_dispose().
+ *      3) concat_read: read with 4KB buffers over a 1MB ustream composed by a chain of 1 to 64 concatenated ustreams.
+ *      4) split: clone and split in the middle a ustream composed by 1 and 8 concatenated ustreams.
+ *      5) threaded_read: 1 to 8 threads reading clones of the same ustream composed by 8 concatenated ustreams.
+ *      6) init_dispose: az_ulib_ustream_init() followed by az_ulib_ustream_dispose(), with the control block
+ *          allocated by malloc (pool = 0) or taken from an az_ulib_ustream_pool (pool = 1).
+ *      7) sha256: az_ulib_ustream_sha256_update() over a 1MB ustream composed by 8 concatenated ustreams, with the
+ *          transform selected for the processor (portable = 0) or the portable one (portable = 1).
+ *      8) flat_concat_read: same as concat_read, with the ustreams concatenated by az_ulib_ustream_concat_n().
+ *      9) split_concat_read: split a 1MB ustream composed by 64 ustreams in a pseudo-random position and concatenate
+ *          the parts back, 64 times, and then read it with 4KB buffers. The ustream is a chain of
+ *          az_ulib_ustream_split() and az_ulib_ustream_concat() (rope = 0), or a rope (rope = 1).
+ *      10) chunk: cut a 1MB ustream composed by 8 concatenated ustreams in 4KB chunks, and dispose them. The chunks
+ *          are created by a chain of az_ulib_ustream_split() (chunk = 0), or by az_ulib_ustream_chunk() (chunk = 1).
+ *      11) parallel: az_ulib_ustream_parallel_run() hashing the 64KB slices of a 1MB ustream composed by 8
+ *          concatenated ustreams, and hashing the digests of the slices in order in the join, with 1 to 8 threads.
+ *      12) lz_compress and lz_decompress: create an LZ compress ustream over 1MB of JSON telemetry, or an LZ
+ *          decompress ustream over the compressed telemetry, and read it with 4KB buffers. The bytes are the
+ *          uncompressed telemetry in both cases, and the parameter is the size of the compressed telemetry, in
+ *          thousandths of the original size.
+ */
+
+#define BENCH_DATA_SIZE         (1024 * 1024)
+#define BENCH_READ_BUFFER_SIZE  4096
+#define BENCH_BATCH_SIZE        1000
+#define BENCH_THREAD_PASSES     256
+#define BENCH_THREADED_DEPTH    8
+#define BENCH_MAX_THREADS       8
+#define BENCH_POOL_SIZE         16
+#define BENCH_ROPE_POOL_SIZE    1024
+#define BENCH_SPLIT_CONCAT_ROUNDS   64
+#define BENCH_CHUNK_SIZE        4096
+#define BENCH_CHUNK_COUNT       (BENCH_DATA_SIZE / BENCH_CHUNK_SIZE)
+#define BENCH_SLICE_SIZE        (64 * 1024)
+#define BENCH_SLICE_COUNT       (BENCH_DATA_SIZE / BENCH_SLICE_SIZE)
+#define BENCH_LZ_MAX_SIZE       (BENCH_DATA_SIZE + \
+                                    ((BENCH_DATA_SIZE / AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE) + 1) * AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE)
+
+static uint8_t bench_data[BENCH_DATA_SIZE];
+static uint8_t bench_read_buffer[BENCH_DATA_SIZE];
+static az_ulib_ustream_pool bench_pool;
+static az_ulib_ustream_pool_block bench_pool_blocks[BENCH_POOL_SIZE];
+static az_ulib_ustream_pool bench_rope_pool;
+static az_ulib_ustream_pool_block bench_rope_pool_blocks[BENCH_ROPE_POOL_SIZE];
+static az_ulib_ustream bench_chunks[BENCH_CHUNK_COUNT];
+static az_ulib_pal_os_thread bench_threads[BENCH_MAX_THREADS];
+static az_ulib_ustream_parallel_task bench_tasks[BENCH_SLICE_COUNT];
+static uint8_t bench_slice_digests[BENCH_SLICE_COUNT][AZ_ULIB_SHA256_DIGEST_SIZE];
+static uint8_t bench_telemetry[BENCH_DATA_SIZE];
+static uint8_t bench_compressed[BENCH_LZ_MAX_SIZE];
+static az_ulib_ustream_lz_data_cb bench_lz_data;
+
+typedef struct bench_thread_context_tag
+{
+    az_ulib_ustream* shared_ustream;
+    uint64_t operations;
+    uint64_t bytes;
+} bench_thread_context;
+
+static void create_ustream(az_ulib_ustream* ustream, const uint8_t* const data, size_t size)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    if((control_block == NULL) ||
+        (az_ulib_ustream_init(ustream, control_block, free, data, size, NULL) != AZ_ULIB_SUCCESS))
+    {
+        (void)printf("failed to create the ustream\r\n");
+        exit(1);
+    }
+}
+
+/* Create a ustream with the BENCH_DATA_SIZE bytes split in depth concatenated ustreams. */
+static void create_concat_ustream(az_ulib_ustream* ustream, size_t depth)
+{
+    size_t part_size = BENCH_DATA_SIZE / depth;
+
+    create_ustream(ustream, bench_data, part_size);
+    for(size_t i = 1; i < depth; i++)
+    {
+        az_ulib_ustream part;
+        size_t offset = i * part_size;
+        create_ustream(&part, &bench_data[offset], (i == (depth - 1)) ? (BENCH_DATA_SIZE - offset) : part_size);
+
+        az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+        if((multi_data == NULL) || (az_ulib_ustream_concat(ustream, &part, multi_data, free) != AZ_ULIB_SUCCESS))
+        {
+            (void)printf("failed to concat the ustream\r\n");
+            exit(1);
+        }
+        (void)az_ulib_ustream_dispose(&part);
+    }
+}
+
+/* Create a ustream with the BENCH_DATA_SIZE bytes split in depth ustreams in a flat concatenation. */
+static void create_flat_concat_ustream(az_ulib_ustream* ustream, size_t depth)
+{
+    size_t part_size = BENCH_DATA_SIZE / depth;
+
+    create_ustream(ustream, bench_data, part_size);
+    if(depth > 1)
+    {
+        az_ulib_ustream* parts = (az_ulib_ustream*)malloc((depth - 1) * sizeof(az_ulib_ustream));
+        az_ulib_ustream_flat_data_cb* flat_data =
+            (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(depth));
+        if((parts == NULL) || (flat_data == NULL))
+        {
+            (void)printf("failed to concat the ustream\r\n");
+            exit(1);
+        }
+        for(size_t i = 1; i < depth; i++)
+        {
+            size_t offset = i * part_size;
+            create_ustream(&(parts[i - 1]), &bench_data[offset], (i == (depth - 1)) ? (BENCH_DATA_SIZE - offset) : part_size);
+        }
+        if(az_ulib_ustream_concat_n(ustream, parts, depth - 1, flat_data, free) != AZ_ULIB_SUCCESS)
+        {
+            (void)printf("failed to concat the ustream\r\n");
+            exit(1);
+        }
+        for(size_t i = 0; i < (depth - 1); i++)
+        {
+            (void)az_ulib_ustream_dispose(&(parts[i]));
+        }
+        free(parts);
+    }
+}
+
+/* Read the ustream up to the end, returning the number of bytes read and the number of calls to read. */
+static uint64_t read_all(az_ulib_ustream* ustream, uint8_t* buffer, size_t buffer_size, uint64_t* operations)
+{
+    uint64_t bytes = 0;
+    size_t size;
+
+    while(az_ulib_ustream_read(ustream, buffer, buffer_size, &size) == AZ_ULIB_SUCCESS)
+    {
+        bytes += size;
+        (*operations)++;
+    }
+
+    return bytes;
+}
+
+static void bench_read(void)
+{
+    static const size_t read_sizes[] = { 1, 16, 256, 4096, 65536, BENCH_DATA_SIZE };
+
+    for(size_t i = 0; i < sizeof(read_sizes) / sizeof(read_sizes[0]); i++)
+    {
+        az_ulib_ustream ustream;
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t elapsed;
+
+        create_ustream(&ustream, bench_data, BENCH_DATA_SIZE);
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            (void)az_ulib_ustream_set_position(&ustream, 0);
+            bytes += read_all(&ustream, bench_read_buffer, read_sizes[i], &operations);
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+        (void)az_ulib_ustream_dispose(&ustream);
+
+        test_bench_report("read", "read_size", read_sizes[i], operations, bytes, elapsed);
+    }
+}
+
+static void bench_clone_dispose(void)
+{
+    az_ulib_ustream ustream;
+    az_ulib_ustream clone;
+    uint64_t operations = 0;
+    uint64_t elapsed;
+
+    create_ustream(&ustream, bench_data, BENCH_DATA_SIZE);
+    uint64_t start = test_bench_get_time_ns();
+    do
+    {
+        for(size_t i = 0; i < BENCH_BATCH_SIZE; i++)
+        {
+            (void)az_ulib_ustream_clone(&clone, &ustream, 0);
+            (void)az_ulib_ustream_dispose(&clone);
+        }
+        operations += BENCH_BATCH_SIZE;
+    } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+    (void)az_ulib_ustream_dispose(&ustream);
+
+    test_bench_report("clone_dispose", "depth", 1, operations, 0, elapsed);
+}
+
+static void bench_concat_read(void)
+{
+    for(size_t depth = 1; depth <= 64; depth *= 2)
+    {
+        az_ulib_ustream ustream;
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t elapsed;
+
+        create_concat_ustream(&ustream, depth);
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            (void)az_ulib_ustream_set_position(&ustream, 0);
+            bytes += read_all(&ustream, bench_read_buffer, BENCH_READ_BUFFER_SIZE, &operations);
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+        (void)az_ulib_ustream_dispose(&ustream);
+
+        test_bench_report("concat_read", "depth", depth, operations, bytes, elapsed);
+    }
+}
+
+static void bench_flat_concat_read(void)
+{
+    for(size_t depth = 1; depth <= 64; depth *= 2)
+    {
+        az_ulib_ustream ustream;
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t elapsed;
+
+        create_flat_concat_ustream(&ustream, depth);
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            (void)az_ulib_ustream_set_position(&ustream, 0);
+            bytes += read_all(&ustream, bench_read_buffer, BENCH_READ_BUFFER_SIZE, &operations);
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+        (void)az_ulib_ustream_dispose(&ustream);
+
+        test_bench_report("flat_concat_read", "depth", depth, operations, bytes, elapsed);
+    }
+}
+
+static void bench_split(void)
+{
+    static const size_t depths[] = { 1, 8 };
+
+    for(size_t i = 0; i < sizeof(depths) / sizeof(depths[0]); i++)
+    {
+        az_ulib_ustream ustream;
+        az_ulib_ustream clone;
+        az_ulib_ustream split;
+        uint64_t operations = 0;
+        uint64_t elapsed;
+
+        create_concat_ustream(&ustream, depths[i]);
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            for(size_t j = 0; j < BENCH_BATCH_SIZE; j++)
+            {
+                (void)az_ulib_ustream_clone(&clone, &ustream, 0);
+                (void)az_ulib_ustream_split(&clone, &split, BENCH_DATA_SIZE / 2);
+                (void)az_ulib_ustream_dispose(&split);
+                (void)az_ulib_ustream_dispose(&clone);
+            }
+            operations += BENCH_BATCH_SIZE;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+        (void)az_ulib_ustream_dispose(&ustream);
+
+        test_bench_report("split", "depth", depths[i], operations, 0, elapsed);
+    }
+}
+
+static int threaded_read(void* arg)
+{
+    bench_thread_context* context = (bench_thread_context*)arg;
+    uint8_t buffer[BENCH_READ_BUFFER_SIZE];
+    az_ulib_ustream clone;
+
+    context->operations = 0;
+    context->bytes = 0;
+    for(size_t i = 0; i < BENCH_THREAD_PASSES; i++)
+    {
+        if(az_ulib_ustream_clone(&clone, context->shared_ustream, 0) != AZ_ULIB_SUCCESS)
+        {
+            return 1;
+        }
+        context->bytes += read_all(&clone, buffer, sizeof(buffer), &context->operations);
+        (void)az_ulib_ustream_dispose(&clone);
+    }
+
+    return 0;
+}
+
+static void bench_threaded_read(void)
+{
+    az_ulib_ustream ustream;
+
+    create_concat_ustream(&ustream, BENCH_THREADED_DEPTH);
+    for(size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2)
+    {
+        THREAD_HANDLE threads[BENCH_MAX_THREADS];
+        bench_thread_context contexts[BENCH_MAX_THREADS];
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+
+        uint64_t start = test_bench_get_time_ns();
+        for(size_t i = 0; i < thread_count; i++)
+        {
+            contexts[i].shared_ustream = &ustream;
+            if(test_thread_create(&threads[i], threaded_read, &contexts[i]) != TEST_THREAD_OK)
+            {
+                (void)printf("failed to create the thread\r\n");
+                exit(1);
+            }
+        }
+        for(size_t i = 0; i < thread_count; i++)
+        {
+            int thread_result;
+            if((test_thread_join(threads[i], &thread_result) != TEST_THREAD_OK) || (thread_result != 0))
+            {
+                (void)printf("failed to run the thread\r\n");
+                exit(1);
+            }
+            operations += contexts[i].operations;
+            bytes += contexts[i].bytes;
+        }
+        uint64_t elapsed = test_bench_get_time_ns() - start;
+
+        test_bench_report("threaded_read", "threads", thread_count, operations, bytes, elapsed);
+    }
+    (void)az_ulib_ustream_dispose(&ustream);
+}
+
+static void bench_init_dispose(void)
+{
+    if(az_ulib_ustream_pool_init(&bench_pool, bench_pool_blocks, BENCH_POOL_SIZE) != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to create the pool\r\n");
+        exit(1);
+    }
+
+    for(size_t use_pool = 0; use_pool <= 1; use_pool++)
+    {
+        az_ulib_ustream ustream;
+        uint64_t operations = 0;
+        uint64_t elapsed;
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            for(size_t i = 0; i < BENCH_BATCH_SIZE; i++)
+            {
+                az_ulib_ustream_data_cb* control_block;
+                if(use_pool == 0)
+                {
+                    control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+                }
+                else if(az_ulib_ustream_pool_get_data_cb(&bench_pool, &control_block) != AZ_ULIB_SUCCESS)
+                {
+                    control_block = NULL;
+                }
+                if((control_block == NULL) ||
+                    (az_ulib_ustream_init(&ustream, control_block, (use_pool == 0) ? free : az_ulib_ustream_pool_release,
+                        bench_data, BENCH_DATA_SIZE, NULL) != AZ_ULIB_SUCCESS))
+                {
+                    (void)printf("failed to create the ustream\r\n");
+                    exit(1);
+                }
+                (void)az_ulib_ustream_dispose(&ustream);
+            }
+            operations += BENCH_BATCH_SIZE;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report("init_dispose", "pool", use_pool, operations, 0, elapsed);
+    }
+}
+
+static void bench_sha256(void)
+{
+    az_ulib_ustream ustream;
+
+    create_concat_ustream(&ustream, BENCH_THREADED_DEPTH);
+    for(size_t portable = 0; portable <= 1; portable++)
+    {
+        az_ulib_sha256_context context;
+        uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+        uint64_t operations = 0;
+        uint64_t elapsed;
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            (void)((portable == 0) ? az_ulib_sha256_init(&context) : _az_ulib_sha256_init_portable(&context));
+            (void)az_ulib_ustream_sha256_update(&context, &ustream);
+            (void)az_ulib_sha256_final(&context, digest);
+            operations++;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report("sha256", "portable", portable, operations, operations * BENCH_DATA_SIZE, elapsed);
+    }
+    (void)az_ulib_ustream_dispose(&ustream);
+}
+
+/* Split the ustream in the position and concatenate the parts back, with the chained split and concat. */
+static void split_concat_chain(az_ulib_ustream* ustream, size_t position)
+{
+    az_ulib_ustream tail;
+    az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+
+    if((multi_data == NULL) ||
+        (az_ulib_ustream_split(ustream, &tail, position) != AZ_ULIB_SUCCESS) ||
+        (az_ulib_ustream_concat(ustream, &tail, multi_data, free) != AZ_ULIB_SUCCESS))
+    {
+        (void)printf("failed to split and concat the ustream\r\n");
+        exit(1);
+    }
+    (void)az_ulib_ustream_dispose(&tail);
+}
+
+/* Split the ustream in the position and concatenate the parts back, with the rope split and concat. */
+static void split_concat_rope(az_ulib_ustream* ustream, size_t position)
+{
+    az_ulib_ustream left;
+    az_ulib_ustream right;
+
+    if(az_ulib_ustream_rope_split(ustream, &bench_rope_pool, position, &left, &right) != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to split the rope\r\n");
+        exit(1);
+    }
+    (void)az_ulib_ustream_dispose(ustream);
+    if(az_ulib_ustream_rope_concat(ustream, &bench_rope_pool, &left, &right) != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to concat the rope\r\n");
+        exit(1);
+    }
+    (void)az_ulib_ustream_dispose(&left);
+    (void)az_ulib_ustream_dispose(&right);
+}
+
+static void bench_split_concat_read(void)
+{
+    if(az_ulib_ustream_pool_init(&bench_rope_pool, bench_rope_pool_blocks, BENCH_ROPE_POOL_SIZE) != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to initialize the pool\r\n");
+        exit(1);
+    }
+
+    for(int use_rope = 0; use_rope <= 1; use_rope++)
+    {
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t elapsed;
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            az_ulib_ustream ustream;
+            create_flat_concat_ustream(&ustream, 64);
+            if(use_rope != 0)
+            {
+                az_ulib_ustream flat = ustream;
+                if(az_ulib_ustream_rope_init(&ustream, &bench_rope_pool, &flat) != AZ_ULIB_SUCCESS)
+                {
+                    (void)printf("failed to create the rope\r\n");
+                    exit(1);
+                }
+                (void)az_ulib_ustream_dispose(&flat);
+            }
+            for(size_t i = 0; i < BENCH_SPLIT_CONCAT_ROUNDS; i++)
+            {
+                size_t position = ((i * 104729) % (BENCH_DATA_SIZE - 1)) + 1;
+                if(use_rope != 0)
+                {
+                    split_concat_rope(&ustream, position);
+                }
+                else
+                {
+                    split_concat_chain(&ustream, position);
+                }
+            }
+            operations += BENCH_SPLIT_CONCAT_ROUNDS;
+            bytes += read_all(&ustream, bench_read_buffer, BENCH_READ_BUFFER_SIZE, &operations);
+            (void)az_ulib_ustream_dispose(&ustream);
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report("split_concat_read", "rope", use_rope, operations, bytes, elapsed);
+    }
+}
+
+static void bench_chunk(void)
+{
+    az_ulib_ustream ustream;
+    create_concat_ustream(&ustream, 8);
+
+    for(int use_chunk = 0; use_chunk <= 1; use_chunk++)
+    {
+        uint64_t operations = 0;
+        uint64_t elapsed;
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            size_t chunk_count;
+            if(use_chunk != 0)
+            {
+                if(az_ulib_ustream_chunk(&ustream, BENCH_CHUNK_SIZE, bench_chunks, BENCH_CHUNK_COUNT, &chunk_count) !=
+                    AZ_ULIB_SUCCESS)
+                {
+                    (void)printf("failed to chunk the ustream\r\n");
+                    exit(1);
+                }
+            }
+            else
+            {
+                (void)az_ulib_ustream_clone(&bench_chunks[0], &ustream, 0);
+                for(chunk_count = 1; chunk_count < BENCH_CHUNK_COUNT; chunk_count++)
+                {
+                    (void)az_ulib_ustream_split(&bench_chunks[chunk_count - 1], &bench_chunks[chunk_count],
+                                                chunk_count * BENCH_CHUNK_SIZE);
+                }
+            }
+            for(size_t i = 0; i < chunk_count; i++)
+            {
+                (void)az_ulib_ustream_dispose(&bench_chunks[i]);
+            }
+            operations += chunk_count;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report("chunk", "chunk", use_chunk, operations, 0, elapsed);
+    }
+
+    (void)az_ulib_ustream_dispose(&ustream);
+}
+
+static az_ulib_result parallel_hash_slice(az_ulib_ustream* slice, size_t index, void* context)
+{
+    (void)context;
+    az_ulib_sha256_context sha256_context;
+    az_ulib_result result;
+
+    if(((result = az_ulib_sha256_init(&sha256_context)) == AZ_ULIB_SUCCESS) &&
+        ((result = az_ulib_ustream_sha256_update(&sha256_context, slice)) == AZ_ULIB_SUCCESS))
+    {
+        result = az_ulib_sha256_final(&sha256_context, bench_slice_digests[index]);
+    }
+
+    return result;
+}
+
+static az_ulib_result parallel_hash_join(size_t index, void* context)
+{
+    return az_ulib_sha256_update((az_ulib_sha256_context*)context, bench_slice_digests[index],
+                                 AZ_ULIB_SHA256_DIGEST_SIZE);
+}
+
+static void bench_parallel(void)
+{
+    az_ulib_ustream ustream;
+    create_concat_ustream(&ustream, BENCH_THREADED_DEPTH);
+
+    for(size_t thread_count = 1; thread_count <= BENCH_MAX_THREADS; thread_count *= 2)
+    {
+        az_ulib_ustream_worker_pool pool;
+        uint64_t operations = 0;
+        uint64_t elapsed;
+
+        if(az_ulib_ustream_worker_pool_init(&pool, bench_threads, thread_count) != AZ_ULIB_SUCCESS)
+        {
+            (void)printf("failed to initialize the worker pool\r\n");
+            exit(1);
+        }
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            az_ulib_sha256_context context;
+            uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+            (void)az_ulib_sha256_init(&context);
+            if(az_ulib_ustream_parallel_run(&pool, &ustream, BENCH_SLICE_SIZE, bench_tasks, BENCH_SLICE_COUNT,
+                                            parallel_hash_slice, parallel_hash_join, &context) != AZ_ULIB_SUCCESS)
+            {
+                (void)printf("failed to hash the ustream in parallel\r\n");
+                exit(1);
+            }
+            (void)az_ulib_sha256_final(&context, digest);
+            operations++;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report("parallel", "threads", thread_count, operations, operations * BENCH_DATA_SIZE, elapsed);
+        (void)az_ulib_ustream_worker_pool_deinit(&pool);
+    }
+
+    (void)az_ulib_ustream_dispose(&ustream);
+}
+
+/* Fill the buffer with JSON lines similar to the telemetry of a fleet of devices. */
+static void fill_telemetry(uint8_t* buffer, size_t size)
+{
+    uint32_t seed = 42;
+    size_t position = 0;
+    char line[192];
+
+    for(uint32_t i = 0; position < size; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        int line_size = snprintf(line, sizeof(line),
+            "{\"deviceId\":\"sensor-%04u\",\"ts\":%u,\"temperature\":%u.%02u,\"humidity\":%u.%u,"
+            "\"pressure\":%u.%u,\"status\":\"%s\"}\n",
+            (unsigned)(i % 64), (unsigned)(1700000000u + (i * 5)), (unsigned)(18 + ((seed >> 16) % 8)),
+            (unsigned)((seed >> 8) % 100), (unsigned)(35 + ((seed >> 20) % 30)), (unsigned)((seed >> 4) % 10),
+            (unsigned)(1000 + ((seed >> 12) % 30)), (unsigned)((seed >> 24) % 10),
+            (((seed >> 28) % 16) == 0) ? "warning" : "ok");
+        size_t copy_size = ((size - position) < (size_t)line_size) ? (size - position) : (size_t)line_size;
+        (void)memcpy(&buffer[position], line, copy_size);
+        position += copy_size;
+    }
+}
+
+/* Create an LZ ustream over the content, exiting if it fails. */
+static void create_lz_ustream(az_ulib_ustream* ustream, const uint8_t* const data, size_t size, bool decompress)
+{
+    az_ulib_ustream source;
+    az_ulib_result result;
+
+    create_ustream(&source, data, size);
+    result = decompress ?
+        az_ulib_ustream_lz_decompress(ustream, &bench_lz_data, NULL, &source) :
+        az_ulib_ustream_lz_compress(ustream, &bench_lz_data, NULL, &source);
+    (void)az_ulib_ustream_dispose(&source);
+    if(result != AZ_ULIB_SUCCESS)
+    {
+        (void)printf("failed to create the LZ ustream\r\n");
+        exit(1);
+    }
+}
+
+static void bench_lz(void)
+{
+    az_ulib_ustream ustream;
+    size_t compressed_size = 0;
+    size_t size;
+
+    fill_telemetry(bench_telemetry, BENCH_DATA_SIZE);
+    create_lz_ustream(&ustream, bench_telemetry, BENCH_DATA_SIZE, false);
+    while(az_ulib_ustream_read(&ustream, &bench_compressed[compressed_size], BENCH_LZ_MAX_SIZE - compressed_size,
+            &size) == AZ_ULIB_SUCCESS)
+    {
+        compressed_size += size;
+    }
+    (void)az_ulib_ustream_dispose(&ustream);
+
+    for(int decompress = 0; decompress <= 1; decompress++)
+    {
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t elapsed;
+
+        uint64_t start = test_bench_get_time_ns();
+        do
+        {
+            uint64_t reads = 0;
+            if(decompress == 0)
+            {
+                create_lz_ustream(&ustream, bench_telemetry, BENCH_DATA_SIZE, false);
+            }
+            else
+            {
+                create_lz_ustream(&ustream, bench_compressed, compressed_size, true);
+            }
+            (void)read_all(&ustream, bench_read_buffer, BENCH_READ_BUFFER_SIZE, &reads);
+            (void)az_ulib_ustream_dispose(&ustream);
+            operations++;
+            bytes += BENCH_DATA_SIZE;
+        } while((elapsed = test_bench_get_time_ns() - start) < TEST_BENCH_MIN_TIME_NS);
+
+        test_bench_report((decompress == 0) ? "lz_compress" : "lz_decompress", "compressed_per_mille",
+                            ((uint64_t)compressed_size * 1000) / BENCH_DATA_SIZE, operations, bytes, elapsed);
+    }
+}
+
+int main(void)
+{
+    for(size_t i = 0; i < BENCH_DATA_SIZE; i++)
+    {
+        bench_data[i] = (uint8_t)i;
+    }
+
+    test_bench_begin("ustream");
+    bench_read();
+    bench_clone_dispose();
+    bench_concat_read();
+    bench_split();
+    bench_threaded_read();
+    bench_init_dispose();
+    bench_sha256();
+    bench_flat_concat_read();
+    bench_split_concat_read();
+    bench_chunk();
+    bench_parallel();
+    bench_lz();
+    test_bench_end();
+
+    return 0;
+}
@@ -252,6 +252,54 @@ static int call_sync_thread(void* arg) {
   return (int)result;
 }
 
+#define NUMBER_PUBLISH_CYCLES 100
+
+static volatile long g_stop_thread;
+
+static int try_get_thread(void* arg) {
+  (void)arg;
+  my_method_model_in in;
+  in.action = MY_METHOD_ACTION_JUST_RETURN;
+  in.return_result = AZ_ULIB_SUCCESS;
+
+  az_ulib_result result = AZ_ULIB_SUCCESS;
+
+  while ((g_stop_thread == 0) && (result == AZ_ULIB_SUCCESS)) {
+    az_ulib_ipc_interface_handle local_handle;
+    az_ulib_result get_result = az_ulib_ipc_try_get_interface(
+        MY_INTERFACE_1_V123.name, 0, AZ_ULIB_VERSION_ANY, &local_handle);
+
+    if (get_result == AZ_ULIB_SUCCESS) {
+      az_ulib_result out = AZ_ULIB_PENDING;
+      az_ulib_result call_result
+          = az_ulib_ipc_call(local_handle, MY_INTERFACE_METHOD, &in, &out);
+      if ((call_result != AZ_ULIB_SUCCESS) && (call_result != AZ_ULIB_NO_SUCH_ELEMENT_ERROR)) {
+        (void)printf("ipc call returned: %d\r\n", call_result);
+        result = call_result;
+      }
+      if ((get_result = az_ulib_ipc_release_interface(local_handle)) != AZ_ULIB_SUCCESS) {
+        (void)printf("release interface returned: %d\r\n", get_result);
+        result = get_result;
+      }
+    } else if (get_result != AZ_ULIB_NO_SUCH_ELEMENT_ERROR) {
+      (void)printf("try get interface returned: %d\r\n", get_result);
+      result = get_result;
+    }
+  }
+
+  return (int)result;
+}
+
+static volatile long g_unpublish_result;
+
+static int unpublish_thread(void* arg) {
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
+      &g_unpublish_result,
+      az_ulib_ipc_unpublish((const az_ulib_interface_descriptor*)arg, AZ_ULIB_WAIT_FOREVER));
+
+  return 0;
+}
+
 /**
  * Beginning of the E2E for interface module.
  */
@@ -277,6 +325,7 @@ TEST_FUNCTION_INITIALIZE(test_method_initialize) {
 
   g_sum_sleep = 0;
   g_lock_thread = 0;
+  g_stop_thread = 0;
 
   umock_c_reset_all_calls();
 }
@@ -646,4 +695,112 @@ TEST_FUNCTION(az_ulib_ipc_e2e_call_sync_method_in_multiple_threads_and_unpublish
   ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_deinit());
 }
 
+TEST_FUNCTION(az_ulib_ipc_e2e_try_get_interface_in_multiple_threads_and_publish_succeed) {
+  /// arrange
+  init_ipc_and_publish_interfaces(true);
+
+  THREAD_HANDLE thread_handle[SMALL_NUMBER_THREAD];
+  for (int i = 0; i < SMALL_NUMBER_THREAD; i++) {
+    (void)test_thread_create(&thread_handle[i], &try_get_thread, NULL);
+  }
+
+  /// act
+  for (int i = 0; i < NUMBER_PUBLISH_CYCLES; i++) {
+    ASSERT_ARE_EQUAL(
+        int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_1_V123, AZ_ULIB_WAIT_FOREVER));
+    ASSERT_ARE_EQUAL(
+        int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_1_V2, AZ_ULIB_WAIT_FOREVER));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&MY_INTERFACE_1_V2, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&MY_INTERFACE_1_V123, NULL));
+  }
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&g_stop_thread, 1);
+
+  /// assert
+  for (int i = 0; i < SMALL_NUMBER_THREAD; i++) {
+    int res;
+    test_thread_join(thread_handle[i], &res);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, res);
+  }
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+TEST_FUNCTION(az_ulib_ipc_e2e_unpublish_waiting_for_call_does_not_block_ipc_succeed) {
+  /// arrange
+  g_thread_max_sum = 10;
+  g_sum_sleep = 0;
+  init_ipc_and_publish_interfaces(true);
+
+  az_ulib_ipc_interface_handle interface_handle;
+  ASSERT_ARE_EQUAL(
+      int,
+      AZ_ULIB_SUCCESS,
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123.name,
+          MY_INTERFACE_1_V123.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle));
+  THREAD_HANDLE call_thread_handle;
+  THREAD_HANDLE unpublish_thread_handle;
+
+  g_is_running = 0; // Assume that the method is not running in the thread.
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(&g_unpublish_result, AZ_ULIB_PENDING);
+
+  (void)AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
+      &g_lock_thread, 1); // Lock the method that will run in the thread to do not finish until we
+                          // complete the test.
+
+  (void)test_thread_create(&call_thread_handle, &call_sync_thread, interface_handle);
+
+  // Wait for the method start to work.
+  while (g_is_running == 0) {
+  };
+
+  /// act
+  // Unpublish the interface in another thread, it shall wait for the method.
+  (void)test_thread_create(
+      &unpublish_thread_handle, &unpublish_thread, (void*)&MY_INTERFACE_1_V123);
+
+  // Wait for the unpublish to block the interface.
+  az_ulib_ipc_interface_handle blocked_handle;
+  while (az_ulib_ipc_try_get_interface(
+             MY_INTERFACE_1_V123.name,
+             MY_INTERFACE_1_V123.version,
+             AZ_ULIB_VERSION_EQUALS_TO,
+             &blocked_handle)
+         == AZ_ULIB_SUCCESS) {
+    az_ulib_ipc_release_interface(blocked_handle);
+  }
+
+  // While the unpublish waits for the method, the IPC shall accept other publish and unpublish.
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_ELEMENT_DUPLICATE_ERROR, az_ulib_ipc_publish(&MY_INTERFACE_1_V123, NULL));
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_3_V123, AZ_ULIB_NO_WAIT));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&MY_INTERFACE_3_V123, NULL));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_PENDING, g_unpublish_result);
+
+  // Release the method, the unpublish shall end as soon as the method returns.
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&g_lock_thread);
+  int unpublish_res;
+  test_thread_join(unpublish_thread_handle, &unpublish_res);
+  az_ulib_ipc_release_interface(interface_handle);
+
+  /// assert
+  int res;
+  test_thread_join(call_thread_handle, &res);
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, res);
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, g_unpublish_result);
+
+  /// cleanup
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_2_V123, AZ_ULIB_NO_WAIT));
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_1_V2, AZ_ULIB_NO_WAIT));
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_3_V123, AZ_ULIB_NO_WAIT));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_deinit());
+}
+
 END_TEST_SUITE(az_ulib_ipc_e2e)
@@ -4,6 +4,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -165,6 +166,10 @@ AZ_ULIB_DESCRIPTOR_CREATE(
 
 static az_ulib_ipc g_ipc;
 
+#ifdef AZ_ULIB_CONFIG_IPC_GROWABLE
+#define TEST_GROWABLE_IPC_INTERFACES 1000
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
+
 void init_ipc_and_publish_interfaces(void) {
   ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_init(&g_ipc));
   ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&MY_INTERFACE_1_V123, NULL));
@@ -284,6 +289,10 @@ TEST_FUNCTION_CLEANUP(test_method_cleanup) { TEST_MUTEX_RELEASE(g_test_by_test);
 /* The az_ulib_ipc_init shall initialize the lock mechanism. */
 TEST_FUNCTION(az_ulib_ipc_init_succeed) {
   /// arrange
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  STRICT_EXPECTED_CALL(az_pal_os_lock_init(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_condition_init(IGNORED_PTR_ARG));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
   STRICT_EXPECTED_CALL(az_pal_os_lock_init(IGNORED_PTR_ARG));
 
   /// act
@@ -498,6 +507,7 @@ TEST_FUNCTION(az_ulib_ipc_publish_with_descriptor_with_same_name_and_version_fai
   az_ulib_ipc_deinit();
 }
 
+#ifndef AZ_ULIB_CONFIG_IPC_GROWABLE
 /* If there is no more memory to store a new descriptor, the az_ulib_ipc_publish shall return
  * AZ_ULIB_OUT_OF_MEMORY_ERROR. */
 TEST_FUNCTION(az_ulib_ipc_publish_out_of_memory_failed) {
@@ -530,6 +540,50 @@ TEST_FUNCTION(az_ulib_ipc_publish_out_of_memory_failed) {
   }
   az_ulib_ipc_deinit();
 }
+#else
+/* If the IPC is growable, the az_ulib_ipc_publish shall store more interfaces than the static IPC,
+ * and the handles of the published interfaces shall stay valid while the IPC grows. */
+TEST_FUNCTION(az_ulib_ipc_publish_growable_succeed) {
+  /// arrange
+  static az_ulib_interface_descriptor descriptors[TEST_GROWABLE_IPC_INTERFACES];
+  static char names[TEST_GROWABLE_IPC_INTERFACES][20];
+  static az_ulib_ipc_interface_handle publish_handle[TEST_GROWABLE_IPC_INTERFACES];
+  az_ulib_action_descriptor actions[1] = AZ_ULIB_DESCRIPTOR_ADD_PROPERTY("my_property", NULL, NULL);
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_init(&g_ipc));
+  for (int i = 0; i < TEST_GROWABLE_IPC_INTERFACES; i++) {
+    (void)snprintf(names[i], sizeof(names[i]), "my_interface_%d", i);
+    descriptors[i].name = names[i];
+    descriptors[i].version = 1;
+    descriptors[i].size = 1;
+    descriptors[i].action_list = actions;
+  }
+  umock_c_reset_all_calls();
+
+  /// act
+  for (int i = 0; i < TEST_GROWABLE_IPC_INTERFACES; i++) {
+    ASSERT_ARE_EQUAL(
+        int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&descriptors[i], &publish_handle[i]));
+  }
+
+  /// assert
+  for (int i = 0; i < TEST_GROWABLE_IPC_INTERFACES; i++) {
+    az_ulib_ipc_interface_handle interface_handle;
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ipc_try_get_interface(names[i], 1, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle));
+    ASSERT_ARE_EQUAL(void_ptr, publish_handle[i], interface_handle);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_release_interface(interface_handle));
+  }
+  ASSERT_ARE_EQUAL(int, 0, g_count_lock);
+
+  /// cleanup
+  for (int i = 0; i < TEST_GROWABLE_IPC_INTERFACES; i++) {
+    az_ulib_ipc_unpublish(&descriptors[i], AZ_ULIB_NO_WAIT);
+  }
+  az_ulib_ipc_deinit();
+}
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
 
 /* The az_ulib_ipc_unpublish shall remove a descriptor for the IPC. The az_ulib_ipc_unpublish shall
  * be thread safe. */
@@ -828,9 +882,68 @@ TEST_FUNCTION(az_ulib_ipc_unpublish_with_method_running_with_small_timeout_faile
   umock_c_reset_all_calls();
 
   STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  for (int i = 0; i < 8; i++) {
-    STRICT_EXPECTED_CALL(az_pal_os_sleep((in.wait_policy_ms >> 3)));
-  }
+  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms());
+  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms());
+  STRICT_EXPECTED_CALL(
+      az_pal_os_condition_timed_wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, in.wait_policy_ms));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
+
+  /// act
+  // call unpublish inside of the method.
+  az_ulib_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_METHOD, &in, &out);
+
+  /// assert
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, out);
+  ASSERT_ARE_EQUAL(int, 0, g_count_lock);
+  ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+  /// cleanup
+  az_ulib_ipc_release_interface(interface_handle);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+/* If the wait for the running methods wakes up before the end of the methods, the
+ * az_ulib_ipc_unpublish shall only wait the remaining time of the wait policy. */
+TEST_FUNCTION(az_ulib_ipc_unpublish_with_method_running_and_early_wakeup_waits_remaining_time_failed) {
+  /// arrange
+  init_ipc_and_publish_interfaces();
+
+  my_method_model_in in;
+  in.action = MY_METHOD_ACTION_UNPUBLISH;
+  in.descriptor = &MY_INTERFACE_1_V123;
+  in.wait_policy_ms = 100;
+  az_ulib_result out = AZ_ULIB_PENDING;
+
+  az_ulib_ipc_interface_handle interface_handle;
+  ASSERT_ARE_EQUAL(
+      int,
+      AZ_ULIB_SUCCESS,
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123.name,
+          MY_INTERFACE_1_V123.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle));
+
+  umock_c_reset_all_calls();
+
+  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms()).SetReturn(1000);
+  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms()).SetReturn(1000);
+  STRICT_EXPECTED_CALL(az_pal_os_condition_timed_wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 100))
+      .SetReturn(true);
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms()).SetReturn(1060);
+  STRICT_EXPECTED_CALL(az_pal_os_condition_timed_wait(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 40))
+      .SetReturn(true);
+  STRICT_EXPECTED_CALL(az_pal_os_get_time_ms()).SetReturn(1100);
+  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
   STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
 
   /// act
@@ -903,9 +1016,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_equals_succeed) {
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name,
@@ -929,9 +1039,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_any_succeed) {
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name, 0, AZ_ULIB_VERSION_ANY, &interface_handle);
@@ -961,9 +1068,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_greater_than_succeed) {
           &interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V2.name,
@@ -998,9 +1102,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_lower_than_succeed) {
           &interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name,
@@ -1035,9 +1136,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_lower_or_equal_succeed) {
           &interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V2.name,
@@ -1057,6 +1155,90 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_version_lower_or_equal_succeed) {
   unpublish_interfaces_and_deinit_ipc();
 }
 
+/* The az_ulib_ipc_try_get_interface shall find interfaces with names in the same bucket of the name
+ * index. */
+TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_many_names_succeed) {
+  /// arrange
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_init(&g_ipc));
+  az_ulib_interface_descriptor descriptors[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
+  char names[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE][16];
+  az_ulib_ipc_interface_handle publish_handle[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
+  az_ulib_action_descriptor actions[1] = AZ_ULIB_DESCRIPTOR_ADD_PROPERTY("my_property", NULL, NULL);
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
+    (void)snprintf(names[i], sizeof(names[i]), "my_interface_%d", i);
+    descriptors[i].name = names[i];
+    descriptors[i].version = 1;
+    descriptors[i].size = 1;
+    descriptors[i].action_list = actions;
+    ASSERT_ARE_EQUAL(
+        int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&descriptors[i], &publish_handle[i]));
+  }
+  umock_c_reset_all_calls();
+
+  /// act
+  /// assert
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
+    char name[16];
+    az_ulib_ipc_interface_handle interface_handle;
+    (void)snprintf(name, sizeof(name), "my_interface_%d", i);
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ipc_try_get_interface(name, 1, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle));
+    ASSERT_ARE_EQUAL(void_ptr, publish_handle[i], interface_handle);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_release_interface(interface_handle));
+  }
+  ASSERT_ARE_EQUAL(int, 0, g_count_lock);
+
+  /// cleanup
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INTERFACE; i++) {
+    az_ulib_ipc_unpublish(&descriptors[i], AZ_ULIB_NO_WAIT);
+  }
+  az_ulib_ipc_deinit();
+}
+
+/* The az_ulib_ipc_try_get_interface shall find the other versions of an interface after its first
+ * published version is unpublished. */
+TEST_FUNCTION(az_ulib_ipc_try_get_interface_after_unpublish_first_version_succeed) {
+  /// arrange
+  az_ulib_ipc_interface_handle interface_handle;
+  init_ipc_and_publish_interfaces();
+  ASSERT_ARE_EQUAL(
+      int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_1_V123, AZ_ULIB_NO_WAIT));
+  umock_c_reset_all_calls();
+
+  /// act
+  az_ulib_result result = az_ulib_ipc_try_get_interface(
+      MY_INTERFACE_1_V123.name, 0, AZ_ULIB_VERSION_ANY, &interface_handle);
+
+  /// assert
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+  ASSERT_ARE_EQUAL(
+      int,
+      AZ_ULIB_NO_SUCH_ELEMENT_ERROR,
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123.name,
+          MY_INTERFACE_1_V123.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_release_interface(interface_handle));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_publish(&MY_INTERFACE_1_V123, NULL));
+  ASSERT_ARE_EQUAL(
+      int,
+      AZ_ULIB_SUCCESS,
+      az_ulib_ipc_try_get_interface(
+          MY_INTERFACE_1_V123.name,
+          MY_INTERFACE_1_V123.version,
+          AZ_ULIB_VERSION_EQUALS_TO,
+          &interface_handle));
+  ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_release_interface(interface_handle));
+  ASSERT_ARE_EQUAL(int, 0, g_count_lock);
+
+  /// cleanup
+  unpublish_interfaces_and_deinit_ipc();
+}
+
+#ifndef AZ_ULIB_CONFIG_IPC_GROWABLE
 /* If the IPC reach the maximun number of allawed instances for a single interface, the
  * az_ulib_ipc_try_get_interface shall return AZ_ULIB_BUSY_ERROR. */
 TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_max_interface_instances_failed) {
@@ -1079,9 +1261,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_max_interface_instances_failed)
 
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name,
@@ -1100,6 +1279,39 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_max_interface_instances_failed)
   }
   unpublish_interfaces_and_deinit_ipc();
 }
+#else
+/* If the IPC is growable, the az_ulib_ipc_try_get_interface shall not limit the number of instances
+ * of a single interface. */
+TEST_FUNCTION(az_ulib_ipc_try_get_interface_growable_instances_succeed) {
+  /// arrange
+  az_ulib_ipc_interface_handle interface_handle[AZ_ULIB_CONFIG_MAX_IPC_INSTANCES + 1];
+
+  init_ipc_and_publish_interfaces();
+  umock_c_reset_all_calls();
+
+  /// act
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES + 1; i++) {
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ipc_try_get_interface(
+            MY_INTERFACE_1_V123.name,
+            MY_INTERFACE_1_V123.version,
+            AZ_ULIB_VERSION_EQUALS_TO,
+            &interface_handle[i]));
+  }
+
+  /// assert
+  ASSERT_ARE_EQUAL(int, 0, g_count_lock);
+  ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+  /// cleanup
+  for (int i = 0; i < AZ_ULIB_CONFIG_MAX_IPC_INSTANCES + 1; i++) {
+    az_ulib_ipc_release_interface(interface_handle[i]);
+  }
+  unpublish_interfaces_and_deinit_ipc();
+}
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
 
 /* If the provided interface name does not exist, the az_ulib_ipc_try_get_interface shall return
  * AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
@@ -1109,9 +1321,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_unknown_name_failed) {
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       "unknown_name", MY_INTERFACE_1_V123.version, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle);
@@ -1131,9 +1340,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_with_unknown_version_failed) {
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name, 9999, AZ_ULIB_VERSION_EQUALS_TO, &interface_handle);
@@ -1153,9 +1359,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_without_version_greater_than_failed)
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V123.name,
@@ -1178,9 +1381,6 @@ TEST_FUNCTION(az_ulib_ipc_try_get_interface_without_version_lower_than_failed) {
   init_ipc_and_publish_interfaces();
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_try_get_interface(
       MY_INTERFACE_1_V2.name,
@@ -1276,9 +1476,6 @@ TEST_FUNCTION(az_ulib_ipc_get_interface_succeed) {
           &interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
 
@@ -1293,6 +1490,7 @@ TEST_FUNCTION(az_ulib_ipc_get_interface_succeed) {
   unpublish_interfaces_and_deinit_ipc();
 }
 
+#ifndef AZ_ULIB_CONFIG_IPC_GROWABLE
 /* If the IPC reach the maximun number of allawed instances for a single interface, the
  * az_ulib_ipc_get_interface shall return AZ_ULIB_BUSY_ERROR. */
 TEST_FUNCTION(az_ulib_ipc_get_interface_with_max_interface_instances_failed) {
@@ -1315,9 +1513,6 @@ TEST_FUNCTION(az_ulib_ipc_get_interface_with_max_interface_instances_failed) {
 
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result
       = az_ulib_ipc_get_interface(interface_handle[0], &interface_handle_plus_one);
@@ -1333,6 +1528,7 @@ TEST_FUNCTION(az_ulib_ipc_get_interface_with_max_interface_instances_failed) {
   }
   unpublish_interfaces_and_deinit_ipc();
 }
+#endif // AZ_ULIB_CONFIG_IPC_GROWABLE
 
 /* If the provided interface name does not exist, the az_ulib_ipc_get_interface shall return
  * AZ_ULIB_NO_SUCH_ELEMENT_ERROR. */
@@ -1353,9 +1549,6 @@ TEST_FUNCTION(az_ulib_ipc_get_interface_with_unpublished_interface_failed) {
       int, AZ_ULIB_SUCCESS, az_ulib_ipc_unpublish(&MY_INTERFACE_1_V123, AZ_ULIB_NO_WAIT));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_get_interface(interface_handle, &new_interface_handle);
 
@@ -1455,9 +1648,6 @@ TEST_FUNCTION(az_ulib_ipc_release_interface_succeed) {
           &interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_release_interface(interface_handle);
 
@@ -1487,9 +1677,6 @@ TEST_FUNCTION(az_ulib_ipc_release_interface_double_release_failed) {
   ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_release_interface(interface_handle));
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   az_ulib_result result = az_ulib_ipc_release_interface(interface_handle);
 
@@ -1561,9 +1748,6 @@ TEST_FUNCTION(az_ulib_ipc_release_interface_with_method_running_failed) {
 
   umock_c_reset_all_calls();
 
-  STRICT_EXPECTED_CALL(az_pal_os_lock_acquire(IGNORED_PTR_ARG));
-  STRICT_EXPECTED_CALL(az_pal_os_lock_release(IGNORED_PTR_ARG));
-
   /// act
   // call release inside of the method.
   az_ulib_result result = az_ulib_ipc_call(interface_handle, MY_INTERFACE_METHOD, &in, &out);
@@ -1715,6 +1899,10 @@ TEST_FUNCTION(az_ulib_ipc_deinit_succeed) {
   ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ipc_init(&g_ipc));
   umock_c_reset_all_calls();
 
+#ifdef AZ_ULIB_CONFIG_IPC_UNPUBLISH
+  STRICT_EXPECTED_CALL(az_pal_os_condition_deinit(IGNORED_PTR_ARG));
+  STRICT_EXPECTED_CALL(az_pal_os_lock_deinit(IGNORED_PTR_ARG));
+#endif // AZ_ULIB_CONFIG_IPC_UNPUBLISH
   STRICT_EXPECTED_CALL(az_pal_os_lock_deinit(IGNORED_PTR_ARG));
 
   /// act
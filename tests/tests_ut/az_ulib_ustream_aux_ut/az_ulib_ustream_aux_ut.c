@@ -90,6 +90,64 @@ static void create_test_default_multibuffer(az_ulib_ustream* ustream)
 
 }
 
+/* Create a ustream with the concatenation of the provided contents. */
+static void create_test_concat_ustream(az_ulib_ustream* ustream, const char* const* parts, size_t part_count)
+{
+    for(size_t i = 0; i < part_count; i++)
+    {
+        az_ulib_ustream part;
+        az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+        ASSERT_IS_NOT_NULL(control_block);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init((i == 0) ? ustream : &part, control_block, free,
+                            (const uint8_t*)parts[i], strlen(parts[i]), NULL));
+        if(i != 0)
+        {
+            az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+            ASSERT_IS_NOT_NULL(multi_data);
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(ustream, &part, multi_data, free));
+            (void)az_ulib_ustream_dispose(&part);
+        }
+    }
+}
+
+/* Bitwise CRC with the reflected polynomial, used as the reference for the optimized ones. */
+#define TEST_CRC32C_POLYNOMIAL  0x82F63B78
+#define TEST_CRC32_POLYNOMIAL   0xEDB88320
+static uint32_t test_crc_reference(uint32_t polynomial, uint32_t crc, const uint8_t* buffer, size_t size)
+{
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++)
+    {
+        crc ^= buffer[i];
+        for(int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+/* Create a ustream with the content split in parts with the provided sizes. */
+static void create_test_split_ustream(az_ulib_ustream* ustream, const uint8_t* content, const size_t* part_sizes, size_t part_count)
+{
+    for(size_t i = 0; i < part_count; i++)
+    {
+        az_ulib_ustream part;
+        az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+        ASSERT_IS_NOT_NULL(control_block);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init((i == 0) ? ustream : &part, control_block, free,
+                            content, part_sizes[i], NULL));
+        content += part_sizes[i];
+        if(i != 0)
+        {
+            az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+            ASSERT_IS_NOT_NULL(multi_data);
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(ustream, &part, multi_data, free));
+            (void)az_ulib_ustream_dispose(&part);
+        }
+    }
+}
+
 /* define constants for the compliance test */
 #define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
 #define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
@@ -624,6 +682,245 @@ TEST_FUNCTION(az_ulib_ustream_multi_read_clone_and_original_in_parallel_succeed)
     (void)az_ulib_ustream_dispose(&multibuffer_clone);
 }
 
+/* az_ulib_ustream_readv shall return the content read before an inner ustream failed */
+TEST_FUNCTION(az_ulib_ustream_multi_readv_with_failed_inner_read_succeed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+
+    result = az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free);
+    set_read_result(AZ_ULIB_SYSTEM_ERROR);
+
+    uint8_t buf_result_1[5];
+    uint8_t buf_result_2[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    az_ulib_ustream_iovec iov[2] = { { buf_result_1, 5 }, { buf_result_2, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH } };
+    size_t size_result;
+
+    ///act
+    result = az_ulib_ustream_readv(&multibuffer, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 10, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, buf_result_1, 5);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1 + 5, buf_result_2, 5);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_readv shall return the inner ustream error if it failed to read the requested bytes */
+TEST_FUNCTION(az_ulib_ustream_multi_readv_with_failed_inner_read_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+
+    result = az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&multibuffer, 10));
+    set_read_result(AZ_ULIB_SYSTEM_ERROR);
+
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    az_ulib_ustream_iovec iov[1] = { { buf_result, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH } };
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    result = az_ulib_ustream_readv(&multibuffer, iov, 1, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 10, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_read shall fall back to set_position and read if the inner ustream does not support read_at */
+TEST_FUNCTION(az_ulib_ustream_multi_read_inner_read_at_not_supported_succeed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free));
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    result = az_ulib_ustream_read(&multibuffer, buf_result, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 20, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, buf_result, 10);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 20, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_read shall return the error of the inner read_at without falling back to read */
+TEST_FUNCTION(az_ulib_ustream_multi_read_inner_read_at_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&multibuffer, 10));
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+    offset_t position;
+
+    set_read_at_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    result = az_ulib_ustream_read(&multibuffer, buf_result, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 10, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_read_at shall read across the concatenated ustreams without changing the current position */
+TEST_FUNCTION(az_ulib_ustream_multi_read_at_across_multiple_buffers_succeed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&multibuffer);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&multibuffer, 5));
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&multibuffer, 8, buf_result, 40, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 40, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 8, buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 5, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_hint shall forward the part of the range in each concatenated ustream */
+TEST_FUNCTION(az_ulib_ustream_multi_hint_forward_to_both_ustreams_succeed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free));
+    az_ulib_ustream_hint_type hint;
+    offset_t position;
+    size_t size;
+
+    ///act
+    az_ulib_result result_first = az_ulib_ustream_hint(&multibuffer, AZ_ULIB_USTREAM_HINT_DONE, 2, 5);
+    size_t hint_count_first = get_hint_call(&hint, &position, &size);
+    result = az_ulib_ustream_hint(&multibuffer, AZ_ULIB_USTREAM_HINT_WILL_NEED, 5, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_first);
+    ASSERT_ARE_EQUAL(int, 0, hint_count_first);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 1, get_hint_call(&hint, &position, &size));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_USTREAM_HINT_WILL_NEED, hint);
+    ASSERT_ARE_EQUAL(int, 10, position);
+    ASSERT_ARE_EQUAL(int, 10, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_hint shall return the error of the hint in the concatenated ustream */
+TEST_FUNCTION(az_ulib_ustream_multi_hint_forward_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free));
+
+    set_hint_result(AZ_ULIB_BUSY_ERROR);
+
+    ///act
+    result = az_ulib_ustream_hint(&multibuffer, AZ_ULIB_USTREAM_HINT_SEQUENTIAL, 0, 20);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
 /*-------------------az_ulib_ustream_split() unit tests----------------------*/
 
 /* az_ulib_ustream_split shall return AZ_ULIB_SUCCESS if the split is successful */
@@ -919,6 +1216,1090 @@ TEST_FUNCTION(az_ulib_ustream_split_set_position_second_failed)
     az_ulib_ustream_dispose(test_ustream);
 }
 
+/*-------------------az_ulib_ustream_slice() unit tests----------------------*/
+
+/* az_ulib_ustream_slice shall return the return value of az_ulib_ustream_clone if it fails */
+TEST_FUNCTION(az_ulib_ustream_slice_clone_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream ustream_slice;
+
+    set_clone_result(AZ_ULIB_OUT_OF_MEMORY_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_slice(test_ustream, 0, 1, &ustream_slice);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/*-------------------az_ulib_ustream_chunk() unit tests----------------------*/
+
+/* az_ulib_ustream_chunk shall cut the ustream in chunks with chunk_size bytes */
+TEST_FUNCTION(az_ulib_ustream_chunk_success)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    az_ulib_ustream chunks[4];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(&multibuffer, 16, chunks, 4, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 4, chunk_count);
+    for(size_t i = 0; i < chunk_count; i++)
+    {
+        size_t size = (i < 3) ? 16 : 14;
+        size_t remaining_size;
+        offset_t position;
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&chunks[i], &remaining_size));
+        ASSERT_ARE_EQUAL(int, size, remaining_size);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&chunks[i], &position));
+        ASSERT_ARE_EQUAL(int, i * 16, position);
+        check_buffer(&chunks[i], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + (i * 16), (uint8_t)size);
+    }
+
+    /* the original ustream is not changed */
+    check_buffer(&multibuffer, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    for(size_t i = 0; i < chunk_count; i++)
+    {
+        (void)az_ulib_ustream_dispose(&chunks[i]);
+    }
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_chunk shall create one chunk with all the content if chunk_size is bigger than the remaining size */
+TEST_FUNCTION(az_ulib_ustream_chunk_last_chunk_smaller_success)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(&multibuffer, 100, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 1, chunk_count);
+    check_buffer(&chunks[0], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&chunks[0]);
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_chunk shall create only max_chunks chunks if the content needs more chunks */
+TEST_FUNCTION(az_ulib_ustream_chunk_limited_by_max_chunks_success)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(&multibuffer, 10, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 2, chunk_count);
+    check_buffer(&chunks[0], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 10);
+    check_buffer(&chunks[1], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 10, 10);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&chunks[0]);
+    (void)az_ulib_ustream_dispose(&chunks[1]);
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_chunk shall start the first chunk at the current position of the ustream */
+TEST_FUNCTION(az_ulib_ustream_chunk_from_current_position_success)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&multibuffer, 20));
+    az_ulib_ustream chunks[3];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(&multibuffer, 20, chunks, 3, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 3, chunk_count);
+    offset_t position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&chunks[1], &position));
+    ASSERT_ARE_EQUAL(int, 40, position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 20, position);
+    check_buffer(&chunks[2], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 60, 2);
+    check_buffer(&chunks[1], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 40, 20);
+    check_buffer(&chunks[0], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 20, 20);
+
+    ///cleanup
+    for(size_t i = 0; i < chunk_count; i++)
+    {
+        (void)az_ulib_ustream_dispose(&chunks[i]);
+    }
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_chunk shall create chunks that are independent of each other and of the original ustream */
+TEST_FUNCTION(az_ulib_ustream_chunk_original_disposed_first_success)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_chunk(&multibuffer, 31, chunks, 2, &chunk_count));
+
+    ///act
+    (void)az_ulib_ustream_dispose(&multibuffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&chunks[1], 40));
+    check_buffer(&chunks[1], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 40, 22);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, az_ulib_ustream_set_position(&chunks[0], 32));
+    check_buffer(&chunks[0], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 31);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&chunks[1]));
+    check_buffer(&chunks[1], 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 31, 31);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&chunks[0]);
+    (void)az_ulib_ustream_dispose(&chunks[1]);
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_EOF if there are no remaining bytes in the ustream */
+TEST_FUNCTION(az_ulib_ustream_chunk_empty_ustream_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    create_test_default_multibuffer(&multibuffer);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&multibuffer, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH));
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(&multibuffer, 10, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, 0, chunk_count);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_chunk_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(NULL, 10, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunk_size is zero */
+TEST_FUNCTION(az_ulib_ustream_chunk_zero_chunk_size_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 0, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunks is NULL */
+TEST_FUNCTION(az_ulib_ustream_chunk_null_chunks_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 10, NULL, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided max_chunks is zero */
+TEST_FUNCTION(az_ulib_ustream_chunk_zero_max_chunks_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 10, chunks, 0, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunk_count is NULL */
+TEST_FUNCTION(az_ulib_ustream_chunk_null_chunk_count_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 10, chunks, 2, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return the return value of az_ulib_ustream_get_position if it fails */
+TEST_FUNCTION(az_ulib_ustream_chunk_get_position_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    set_get_position_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 5, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, chunk_count);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return the return value of az_ulib_ustream_get_remaining_size if it fails */
+TEST_FUNCTION(az_ulib_ustream_chunk_get_remaining_size_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    set_get_remaining_size_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 5, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, chunk_count);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_chunk shall return the return value of az_ulib_ustream_clone if it fails */
+TEST_FUNCTION(az_ulib_ustream_chunk_clone_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_ustream chunks[2];
+    size_t chunk_count;
+
+    set_clone_result(AZ_ULIB_OUT_OF_MEMORY_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_chunk(test_ustream, 5, chunks, 2, &chunk_count);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, chunk_count);
+
+    ///cleanup
+    az_ulib_ustream_dispose(test_ustream);
+}
+
+/*-------------------az_ulib_ustream_peek() multi unit tests----------------------*/
+
+/* az_ulib_ustream_peek shall return the result of the inner ustream peek */
+TEST_FUNCTION(az_ulib_ustream_multi_peek_not_supported_inner_ustream_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_result result =
+        az_ulib_ustream_init(&multibuffer, control_block1, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+
+    az_ulib_ustream* test_buffer2 = ustream_mock_create();
+
+    az_ulib_ustream_multi_data_cb* multi_data1 =
+        (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free));
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&multibuffer, strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1)));
+    set_peek_result(AZ_ULIB_NOT_SUPPORTED_ERROR);
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    result = az_ulib_ustream_peek(&multibuffer, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NOT_SUPPORTED_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+    (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/*-------------------az_ulib_ustream_advance() unit tests----------------------*/
+
+/* az_ulib_ustream_advance shall move the current position forward */
+TEST_FUNCTION(az_ulib_ustream_advance_succeed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&multibuffer);
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_advance(&multibuffer, 15);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 15, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_advance shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR if the new position is after the end of the ustream */
+TEST_FUNCTION(az_ulib_ustream_advance_after_the_end_failed)
+{
+    ///arrange
+    az_ulib_ustream multibuffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&multibuffer);
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_advance(&multibuffer, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&multibuffer, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&multibuffer);
+}
+
+/* az_ulib_ustream_advance shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_advance_null_instance_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_advance(NULL, 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_get_span() unit tests----------------------*/
+
+/* az_ulib_ustream_get_span shall return a span over the ustream content if the ustream supports peek */
+TEST_FUNCTION(az_ulib_ustream_get_span_zero_copy_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_ustream;
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(
+        int,
+        AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, control_block, free,
+                           USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+                           strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    uint8_t local_buffer[5];
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(&test_ustream, local_buffer, sizeof(local_buffer), &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, (void*)span);
+    ASSERT_ARE_EQUAL(int, strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_get_span shall copy the content to the local buffer if the ustream does not support peek */
+TEST_FUNCTION(az_ulib_ustream_get_span_copy_fallback_succeed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    uint8_t local_buffer[5];
+    const uint8_t* span;
+    size_t size_result;
+    set_peek_result(AZ_ULIB_NOT_SUPPORTED_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(test_ustream, local_buffer, sizeof(local_buffer), &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)local_buffer, (void*)span);
+    ASSERT_ARE_EQUAL(int, sizeof(local_buffer), size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_get_span shall not change the current position when it falls back to a copy */
+TEST_FUNCTION(az_ulib_ustream_get_span_copy_fallback_does_not_change_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    uint8_t local_buffer[5];
+    const uint8_t* span;
+    size_t size_result;
+    offset_t position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(test_ustream, 3));
+    set_peek_result(AZ_ULIB_NOT_SUPPORTED_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(test_ustream, local_buffer, sizeof(local_buffer), &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 3, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_get_span shall return AZ_ULIB_NOT_SUPPORTED_ERROR if the ustream does not support peek and
+    there is no local buffer */
+TEST_FUNCTION(az_ulib_ustream_get_span_no_local_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    const uint8_t* span;
+    size_t size_result;
+    set_peek_result(AZ_ULIB_NOT_SUPPORTED_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(test_ustream, NULL, 0, &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NOT_SUPPORTED_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_get_span shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_get_span_null_instance_failed)
+{
+    ///arrange
+    uint8_t local_buffer[5];
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(NULL, local_buffer, sizeof(local_buffer), &span, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_get_span shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided span is NULL */
+TEST_FUNCTION(az_ulib_ustream_get_span_null_span_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    uint8_t local_buffer[5];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(test_ustream, local_buffer, sizeof(local_buffer), NULL, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_get_span shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided size is NULL */
+TEST_FUNCTION(az_ulib_ustream_get_span_null_size_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    uint8_t local_buffer[5];
+    const uint8_t* span;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_span(test_ustream, local_buffer, sizeof(local_buffer), &span, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_find shall return the position of the first occurrence of the pattern, without changing the current position */
+TEST_FUNCTION(az_ulib_ustream_find_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_ustream;
+    create_test_default_multibuffer(&test_ustream);
+    offset_t found_position;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"DEF", 3, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 13, found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall search from the current position */
+TEST_FUNCTION(az_ulib_ustream_find_from_current_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_ustream;
+    create_test_default_multibuffer(&test_ustream);
+    offset_t found_position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, 20));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"K", 1, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 20, found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, 21));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_find(&test_ustream, (const uint8_t*)"K", 1, &found_position));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall return AZ_ULIB_EOF if the pattern is not in the ustream, without changing the current position */
+TEST_FUNCTION(az_ulib_ustream_find_not_found_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_ustream;
+    create_test_default_multibuffer(&test_ustream);
+    offset_t found_position;
+    offset_t position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, 5));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"xyz0", 4, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 5, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall find a pattern that crosses the boundary between concatenated ustreams */
+TEST_FUNCTION(az_ulib_ustream_find_across_concat_boundary_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_ustream;
+    create_test_default_multibuffer(&test_ustream);
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"789ABC", 6, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 7, found_position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall find a pattern that crosses more than one boundary between concatenated ustreams */
+TEST_FUNCTION(az_ulib_ustream_find_across_multiple_concat_boundaries_succeed)
+{
+    ///arrange
+    static const char* const parts[] = { "0123", "45", "6789" };
+    az_ulib_ustream test_ustream;
+    create_test_concat_ustream(&test_ustream, parts, 3);
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"34567", 5, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 3, found_position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall keep searching after a partial match in the end of a concatenated ustream */
+TEST_FUNCTION(az_ulib_ustream_find_partial_match_at_the_end_succeed)
+{
+    ///arrange
+    static const char* const parts[] = { "0129", "9AB", "CD9" };
+    az_ulib_ustream test_ustream;
+    create_test_concat_ustream(&test_ustream, parts, 3);
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, (const uint8_t*)"9AB", 3, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 4, found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_find(&test_ustream, (const uint8_t*)"9XY", 3, &found_position));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall find long patterns in spans with many candidates */
+TEST_FUNCTION(az_ulib_ustream_find_many_candidates_succeed)
+{
+    ///arrange
+    static uint8_t content[1024];
+    uint8_t pattern[40];
+    for(size_t i = 0; i < sizeof(content); i++)
+    {
+        content[i] = 'a';
+    }
+    content[900] = 'b';
+    for(size_t i = 0; i < sizeof(pattern); i++)
+    {
+        pattern[i] = 'a';
+    }
+    pattern[sizeof(pattern) - 1] = 'b';
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content), NULL));
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&test_ustream, pattern, sizeof(pattern), &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 900 - (sizeof(pattern) - 1), found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_find(&test_ustream, (const uint8_t*)"ba", 2, &found_position));
+    ASSERT_ARE_EQUAL(int, 900, found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_find(&test_ustream, (const uint8_t*)"bb", 2, &found_position));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_find shall return the error if it cannot get the current position */
+TEST_FUNCTION(az_ulib_ustream_find_get_position_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    offset_t found_position;
+    set_get_position_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(test_ustream, (const uint8_t*)"A", 1, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_find shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_find_null_instance_failed)
+{
+    ///arrange
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(NULL, (const uint8_t*)"A", 1, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_find shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pattern is NULL */
+TEST_FUNCTION(az_ulib_ustream_find_null_pattern_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(test_ustream, NULL, 1, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_find shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pattern length is zero */
+TEST_FUNCTION(az_ulib_ustream_find_zero_pattern_length_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    offset_t found_position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(test_ustream, (const uint8_t*)"A", 0, &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_find shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided position is NULL */
+TEST_FUNCTION(az_ulib_ustream_find_null_position_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(test_ustream, (const uint8_t*)"A", 1, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_crc32c shall return the CRC32C of the content, without changing the current position */
+TEST_FUNCTION(az_ulib_ustream_crc32c_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "123456789";
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content) - 1, NULL));
+    uint32_t crc = 0;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0xE3069283, crc);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32c shall calculate the CRC32C from the current position */
+TEST_FUNCTION(az_ulib_ustream_crc32c_from_current_position_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "xyz123456789";
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content) - 1, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, 3));
+    uint32_t crc = 0;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0xE3069283, crc);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 3, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32c shall continue the CRC32C provided in the crc */
+TEST_FUNCTION(az_ulib_ustream_crc32c_incremental_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "123456789";
+    az_ulib_ustream_data_cb control_block_1;
+    az_ulib_ustream_data_cb control_block_2;
+    az_ulib_ustream test_ustream_1;
+    az_ulib_ustream test_ustream_2;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream_1, &control_block_1, NULL, content, 4, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream_2, &control_block_2, NULL, &content[4], 5, NULL));
+    uint32_t crc = 0;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_crc32c(&test_ustream_1, &crc));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(&test_ustream_2, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0xE3069283, crc);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream_1);
+    (void)az_ulib_ustream_dispose(&test_ustream_2);
+}
+
+/* az_ulib_ustream_crc32c shall calculate the CRC32C over all the ustreams in a concatenation */
+TEST_FUNCTION(az_ulib_ustream_crc32c_multibuffer_succeed)
+{
+    ///arrange
+    static uint8_t content[3000];
+    static const size_t part_sizes[] = { 1, 7, 100, 1000, 13, 1879 };
+    for(size_t i = 0; i < sizeof(content); i++)
+    {
+        content[i] = (uint8_t)((i * 7) + (i >> 8));
+    }
+    az_ulib_ustream test_ustream;
+    create_test_split_ustream(&test_ustream, content, part_sizes, sizeof(part_sizes) / sizeof(part_sizes[0]));
+    uint32_t crc = 0;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, test_crc_reference(TEST_CRC32C_POLYNOMIAL, 0, content, sizeof(content)), crc);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32c shall return the error if it cannot get the current position */
+TEST_FUNCTION(az_ulib_ustream_crc32c_get_position_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    uint32_t crc = 0;
+    set_get_position_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0, crc);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_crc32c shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_crc32c_null_instance_failed)
+{
+    ///arrange
+    uint32_t crc = 0;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(NULL, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_crc32c shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided crc is NULL */
+TEST_FUNCTION(az_ulib_ustream_crc32c_null_crc_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(test_ustream, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_crc32 shall return the CRC32 of the content, without changing the current position */
+TEST_FUNCTION(az_ulib_ustream_crc32_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "123456789";
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content) - 1, NULL));
+    uint32_t crc = 0;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0xCBF43926, crc);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32 shall calculate the CRC32 over all the ustreams in a concatenation, with any size */
+TEST_FUNCTION(az_ulib_ustream_crc32_multibuffer_succeed)
+{
+    ///arrange
+    static uint8_t content[3000];
+    static const size_t part_sizes[] = { 63, 64, 65, 1000, 17, 1791 };
+    for(size_t i = 0; i < sizeof(content); i++)
+    {
+        content[i] = (uint8_t)((i * 7) + (i >> 8));
+    }
+    az_ulib_ustream test_ustream;
+    create_test_split_ustream(&test_ustream, content, part_sizes, sizeof(part_sizes) / sizeof(part_sizes[0]));
+    uint32_t crc = 0;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, test_crc_reference(TEST_CRC32_POLYNOMIAL, 0, content, sizeof(content)), crc);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32 shall not change the crc if there is no content after the current position */
+TEST_FUNCTION(az_ulib_ustream_crc32_end_of_ustream_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "123456789";
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content) - 1, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, sizeof(content) - 1));
+    uint32_t crc = 0x12345678;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32(&test_ustream, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, 0x12345678, crc);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_crc32 shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL */
+TEST_FUNCTION(az_ulib_ustream_crc32_null_instance_failed)
+{
+    ///arrange
+    uint32_t crc = 0;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32(NULL, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_crc32 shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided crc is NULL */
+TEST_FUNCTION(az_ulib_ustream_crc32_null_crc_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32(test_ustream, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
 #include "az_ulib_ustream_compliance_ut.h"
 
 END_TEST_SUITE(ustream_aux_ut)
@@ -0,0 +1,682 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_base64.h"
+
+/* Not a multiple of 3, so the encoded content ends with padding. */
+#define TEST_BIG_CONTENT_LENGTH         10001
+#define TEST_BIG_ENCODED_LENGTH         (((TEST_BIG_CONTENT_LENGTH + 2) / 3) * 4)
+#define TEST_BIG_CONTENT_BYTE(pos)      ((uint8_t)(((pos) * 7919) >> 3))
+
+/* Read sizes that cross the blocks of both the binary and the base64 content in all alignments. */
+static const size_t test_read_sizes[] = { 1, 2, 5, 7, 64, 3, 4, 1000, 11, 257, 12, 6 };
+#define TEST_READ_SIZES_COUNT           (sizeof(test_read_sizes) / sizeof(test_read_sizes[0]))
+
+static const char test_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static uint8_t test_big_content[TEST_BIG_CONTENT_LENGTH];
+static uint8_t test_big_encoded[TEST_BIG_ENCODED_LENGTH];
+static uint8_t test_buf_result[TEST_BIG_ENCODED_LENGTH];
+
+/* Reference encode, byte by byte, to check the block codecs. */
+static size_t reference_encode(const uint8_t* content, size_t content_length, uint8_t* encoded)
+{
+    size_t size = 0;
+
+    for(size_t i = 0; i < content_length; i += 3)
+    {
+        uint32_t value = (uint32_t)content[i] << 16;
+        if((i + 1) < content_length)
+        {
+            value |= (uint32_t)content[i + 1] << 8;
+        }
+        if((i + 2) < content_length)
+        {
+            value |= (uint32_t)content[i + 2];
+        }
+        encoded[size++] = (uint8_t)test_alphabet[(value >> 18) & 0x3F];
+        encoded[size++] = (uint8_t)test_alphabet[(value >> 12) & 0x3F];
+        encoded[size++] = ((i + 1) < content_length) ? (uint8_t)test_alphabet[(value >> 6) & 0x3F] : '=';
+        encoded[size++] = ((i + 2) < content_length) ? (uint8_t)test_alphabet[value & 0x3F] : '=';
+    }
+
+    return size;
+}
+
+static void create_test_buffer(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_IS_NOT_NULL(control_block);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init(ustream, control_block, free, content, content_length, NULL));
+}
+
+/* Create a base64 ustream over a buffer with the provided content. */
+static void create_test_base64_ustream(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length, bool decode)
+{
+    az_ulib_ustream source;
+    az_ulib_ustream_base64_data_cb* base64_data =
+        (az_ulib_ustream_base64_data_cb*)malloc(sizeof(az_ulib_ustream_base64_data_cb));
+    ASSERT_IS_NOT_NULL(base64_data);
+
+    create_test_buffer(&source, content, content_length);
+    if(decode)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_base64_decode(ustream, base64_data, free, &source));
+    }
+    else
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_base64_encode(ustream, base64_data, free, &source));
+    }
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+static void create_test_default_base64_ustream(az_ulib_ustream* ustream)
+{
+    create_test_base64_ustream(ustream,
+        (const uint8_t*)"MDEyMzQ1Njc4OUFCQ0RFRkdISUpLTE1OT1BRUlNUVVZXWFlaYWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXo=", 84, true);
+}
+
+/* Read all the content of the ustream with the test read sizes. */
+static void read_with_test_sizes(az_ulib_ustream* ustream, uint8_t* buf_result, size_t expected_length)
+{
+    size_t total_size = 0;
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; result == AZ_ULIB_SUCCESS; i++)
+    {
+        size_t size_result;
+        size_t read_size = test_read_sizes[i % TEST_READ_SIZES_COUNT];
+        if(read_size > (expected_length + 1 - total_size))
+        {
+            read_size = expected_length + 1 - total_size;
+        }
+        result = az_ulib_ustream_read(ustream, &buf_result[total_size], read_size, &size_result);
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            total_size += size_result;
+        }
+    }
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, expected_length, total_size);
+}
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+#define USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT =
+        (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)           create_test_default_base64_ustream(ustream)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_base64.c module.
+ */
+BEGIN_TEST_SUITE(ustream_base64_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    for(size_t i = 0; i < TEST_BIG_CONTENT_LENGTH; i++)
+    {
+        test_big_content[i] = TEST_BIG_CONTENT_BYTE(i);
+    }
+    ASSERT_ARE_EQUAL(int, TEST_BIG_ENCODED_LENGTH,
+        reference_encode(test_big_content, TEST_BIG_CONTENT_LENGTH, test_big_encoded));
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(test_buf_result, 0, sizeof(test_buf_result));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/*-------------------az_ulib_ustream_base64_encode() unit tests----------------------*/
+
+/* az_ulib_ustream_base64_encode shall expose the base64 encode of the source, with padding (RFC 4648 test vectors). */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_succeed)
+{
+    ///arrange
+    static const char* const vectors[][2] =
+    {
+        { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" }, { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" },
+        { "foobar", "Zm9vYmFy" }
+    };
+
+    for(size_t i = 0; i < (sizeof(vectors) / sizeof(vectors[0])); i++)
+    {
+        az_ulib_ustream test_base64;
+        size_t size_result;
+        create_test_base64_ustream(&test_base64, (const uint8_t*)vectors[i][0], strlen(vectors[i][0]), false);
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_read(&test_base64, test_buf_result, sizeof(test_buf_result), &size_result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, strlen(vectors[i][1]), size_result);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, (const uint8_t*)vectors[i][1], test_buf_result, size_result);
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&test_base64);
+    }
+}
+
+/* az_ulib_ustream_base64_encode shall encode big content in any read size, with the same result of a byte by byte
+ * encode. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_big_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    size_t size_result;
+    create_test_base64_ustream(&test_base64, test_big_content, TEST_BIG_CONTENT_LENGTH, false);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_remaining_size(&test_base64, &size_result);
+    read_with_test_sizes(&test_base64, test_buf_result, TEST_BIG_ENCODED_LENGTH);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_ENCODED_LENGTH, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_encoded, test_buf_result, TEST_BIG_ENCODED_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_encode shall encode the content from the position in the middle of a block. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_set_position_in_the_middle_of_a_block_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    size_t size_result;
+    create_test_base64_ustream(&test_base64, test_big_content, TEST_BIG_CONTENT_LENGTH, false);
+
+    for(offset_t position = 4997; position < 5003; position++)
+    {
+        ///act
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_base64, position));
+        az_ulib_result result = az_ulib_ustream_read(&test_base64, test_buf_result, 1023, &size_result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, 1023, size_result);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_encoded[position], test_buf_result, size_result);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_encode shall encode the content of a concatenated source across its boundaries. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_concat_source_succeed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream source_tail;
+    az_ulib_ustream test_base64;
+    size_t size_result;
+    az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, test_big_content, 1000);
+    create_test_buffer(&source_tail, &test_big_content[1000], TEST_BIG_CONTENT_LENGTH - 1000);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(&source, &source_tail, multi_data, free));
+    (void)az_ulib_ustream_dispose(&source_tail);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(&test_base64, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&source);
+    read_with_test_sizes(&test_base64, test_buf_result, TEST_BIG_ENCODED_LENGTH);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_encoded, test_buf_result, TEST_BIG_ENCODED_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_encode shall encode the source from its current position. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_from_current_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+    size_t size_result;
+    create_test_buffer(&source, (const uint8_t*)"xxfoobar", 8);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, 2));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(&test_base64, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_base64, test_buf_result, sizeof(test_buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, 8, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, (const uint8_t*)"Zm9vYmFy", test_buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_encode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is empty. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_empty_source_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"foo", 3);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, 3));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(&test_base64, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_encode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"foo", 3);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(NULL, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_encode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided base64 data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_null_base64_data_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    create_test_buffer(&source, (const uint8_t*)"foo", 3);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(&test_base64, NULL, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_encode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_encode_null_ustream_to_encode_failed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_encode(&test_base64, &base64_data, NULL, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_base64_decode() unit tests----------------------*/
+
+/* az_ulib_ustream_base64_decode shall expose the base64 decode of the source (RFC 4648 test vectors). */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_succeed)
+{
+    ///arrange
+    static const char* const vectors[][2] =
+    {
+        { "Zg==", "f" }, { "Zm8=", "fo" }, { "Zm9v", "foo" }, { "Zm9vYg==", "foob" }, { "Zm9vYmE=", "fooba" },
+        { "Zm9vYmFy", "foobar" }, { "+/+/", "\xfb\xff\xbf" }
+    };
+
+    for(size_t i = 0; i < (sizeof(vectors) / sizeof(vectors[0])); i++)
+    {
+        az_ulib_ustream test_base64;
+        size_t size_result;
+        create_test_base64_ustream(&test_base64, (const uint8_t*)vectors[i][0], strlen(vectors[i][0]), true);
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_read(&test_base64, test_buf_result, sizeof(test_buf_result), &size_result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, strlen(vectors[i][1]), size_result);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, (const uint8_t*)vectors[i][1], test_buf_result, size_result);
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&test_base64);
+    }
+}
+
+/* az_ulib_ustream_base64_decode shall decode big content in any read size. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_big_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    size_t size_result;
+    create_test_base64_ustream(&test_base64, test_big_encoded, TEST_BIG_ENCODED_LENGTH, true);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_remaining_size(&test_base64, &size_result);
+    read_with_test_sizes(&test_base64, test_buf_result, TEST_BIG_CONTENT_LENGTH);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, test_buf_result, TEST_BIG_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_decode shall decode the encode of a ustream back to the original content. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_encoded_ustream_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_encoded;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_base64_ustream(&test_encoded, test_big_content, TEST_BIG_CONTENT_LENGTH, false);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, &test_encoded);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&test_encoded);
+    read_with_test_sizes(&test_base64, test_buf_result, TEST_BIG_CONTENT_LENGTH);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, test_buf_result, TEST_BIG_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_base64_decode shall decode the content from the position in the middle of a block. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_set_position_in_the_middle_of_a_block_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    size_t size_result;
+    create_test_base64_ustream(&test_base64, test_big_encoded, TEST_BIG_ENCODED_LENGTH, true);
+
+    for(offset_t position = 4997; position < 5003; position++)
+    {
+        ///act
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_base64, position));
+        az_ulib_result result = az_ulib_ustream_read(&test_base64, test_buf_result, 1023, &size_result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, 1023, size_result);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[position], test_buf_result, size_result);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_base64);
+}
+
+/* az_ulib_ustream_read shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR when it reaches a character that is not in the
+ * base64 alphabet, and accept all the characters in the alphabet. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_invalid_character_failed)
+{
+    ///arrange
+    static uint8_t encoded[TEST_BIG_ENCODED_LENGTH];
+
+    for(int character = 0; character < 256; character++)
+    {
+        az_ulib_ustream test_base64;
+        size_t size_result;
+        bool valid = (character != 0) && (strchr(test_alphabet, character) != NULL);
+        (void)memcpy(encoded, test_big_encoded, TEST_BIG_ENCODED_LENGTH);
+        encoded[1001] = (uint8_t)character;
+        create_test_base64_ustream(&test_base64, encoded, TEST_BIG_ENCODED_LENGTH, true);
+
+        ///act
+        az_ulib_result result;
+        do
+        {
+            result = az_ulib_ustream_read(&test_base64, test_buf_result, 1000, &size_result);
+        } while(result == AZ_ULIB_SUCCESS);
+
+        ///assert
+        if(valid)
+        {
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result, "character %d", character);
+        }
+        else
+        {
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result, "character %d", character);
+        }
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&test_base64);
+    }
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the size of the source is not a
+ * multiple of 4. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_invalid_size_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"Zm9vYmF", 7);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the last block of the source is not
+ * valid base64. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_invalid_last_block_failed)
+{
+    ///arrange
+    static const char* const invalid_blocks[] = { "Zm9vZ===", "Zm9vZm=v", "Zm9v====", "Zm9vZm9*" };
+
+    for(size_t i = 0; i < (sizeof(invalid_blocks) / sizeof(invalid_blocks[0])); i++)
+    {
+        az_ulib_ustream source;
+        az_ulib_ustream test_base64;
+        az_ulib_ustream_base64_data_cb base64_data;
+        create_test_buffer(&source, (const uint8_t*)invalid_blocks[i], 8);
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, &source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&source);
+    }
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is empty. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_empty_source_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"Zm9v", 4);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, 4));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"Zm9v", 4);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(NULL, &base64_data, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided base64 data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_null_base64_data_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    create_test_buffer(&source, (const uint8_t*)"Zm9v", 4);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, NULL, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_base64_decode shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is NULL. */
+TEST_FUNCTION(az_ulib_ustream_base64_decode_null_ustream_to_decode_failed)
+{
+    ///arrange
+    az_ulib_ustream test_base64;
+    az_ulib_ustream_base64_data_cb base64_data;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_dispose shall dispose the clone of the source when the last instance is disposed. */
+TEST_FUNCTION(az_ulib_ustream_base64_dispose_source_succeed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_base64;
+    az_ulib_ustream test_base64_clone;
+    az_ulib_ustream_base64_data_cb base64_data;
+    create_test_buffer(&source, (const uint8_t*)"Zm9v", 4);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_base64_decode(&test_base64, &base64_data, NULL, &source));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_base64_clone, &test_base64, 0));
+    ASSERT_ARE_EQUAL(int, 2, source.control_block->ref_count);
+
+    ///act
+    (void)az_ulib_ustream_dispose(&test_base64);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 2, source.control_block->ref_count);
+    (void)az_ulib_ustream_dispose(&test_base64_clone);
+    ASSERT_ARE_EQUAL(int, 1, source.control_block->ref_count);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_base64_ut)
@@ -0,0 +1,828 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_builder.h"
+
+#define TEST_CHUNK_SIZE         AZ_ULIB_CONFIG_USTREAM_BUILDER_CHUNK_SIZE
+#define TEST_POOL_SIZE          8
+#define TEST_BIG_CONTENT_LENGTH ((2 * TEST_CHUNK_SIZE) + (TEST_CHUNK_SIZE / 2))
+#define TEST_BIG_CONTENT_CHUNKS 3
+#define TEST_BIG_CONTENT_BYTE(pos)  ((uint8_t)((pos) % 251))
+#define TEST_LARGE_POOL_SIZE    4096
+#define TEST_LARGE_PART_SIZE    1000
+#define TEST_LARGE_READ_SIZE    256
+
+static az_ulib_ustream_builder_pool test_pool;
+static az_ulib_ustream_builder_chunk test_chunks[TEST_POOL_SIZE];
+static uint8_t test_big_content[TEST_BIG_CONTENT_LENGTH];
+static int test_control_block_release_count;
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+static size_t count_free_chunks(az_ulib_ustream_builder_pool* pool)
+{
+    size_t count = 0;
+
+    for(uint32_t index = pool->free_list & 0xFFFF; (index != 0) && (count <= TEST_POOL_SIZE);
+            index = pool->chunks[index - 1].next_free)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+static void test_control_block_release(void* release_pointer)
+{
+    test_control_block_release_count++;
+    free(release_pointer);
+}
+
+/* Freeze the builder in a new ustream with a control block allocated by malloc. */
+static void freeze_test_builder(az_ulib_ustream_builder* builder, az_ulib_ustream* ustream)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_IS_NOT_NULL(control_block);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_builder_freeze(builder, control_block, test_control_block_release, ustream));
+}
+
+/* Create a ustream with the content appended in parts with the provided sizes. */
+static void create_test_builder_ustream(
+        az_ulib_ustream* ustream, const uint8_t* content, const size_t* part_sizes, size_t part_count)
+{
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+
+    for(size_t i = 0; i < part_count; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, content, part_sizes[i]));
+        content += part_sizes[i];
+    }
+
+    freeze_test_builder(&builder, ustream);
+}
+
+static void create_test_default_builder_ustream(az_ulib_ustream* ustream)
+{
+    static const size_t part_sizes[] = { 10, 26, 26 };
+    create_test_builder_ustream(ustream,
+            (const uint8_t*)"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", part_sizes, 3);
+}
+
+/* Create a ustream with TEST_BIG_CONTENT_LENGTH bytes, appended in parts that do not match the chunks. */
+static void create_test_big_builder_ustream(az_ulib_ustream* ustream)
+{
+    static const size_t part_sizes[] =
+        { 100, TEST_CHUNK_SIZE, TEST_CHUNK_SIZE - 200, 1, TEST_BIG_CONTENT_LENGTH - (2 * TEST_CHUNK_SIZE) + 99 };
+    create_test_builder_ustream(ustream, test_big_content, part_sizes, sizeof(part_sizes) / sizeof(part_sizes[0]));
+}
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT =
+        (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)           create_test_default_builder_ustream(ustream)
+
+/**
+ * Beginning of the UT for ustream_builder.c module.
+ */
+BEGIN_TEST_SUITE(ustream_builder_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    for(size_t i = 0; i < TEST_BIG_CONTENT_LENGTH; i++)
+    {
+        test_big_content[i] = TEST_BIG_CONTENT_BYTE(i);
+    }
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(test_chunks, 0, sizeof(test_chunks));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_pool_init(&test_pool, test_chunks, TEST_POOL_SIZE));
+    test_control_block_release_count = 0;
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/*-------------------az_ulib_ustream_builder_pool_init() unit tests----------------------*/
+
+/* az_ulib_ustream_builder_pool_init shall initialize the pool with all chunks free. */
+TEST_FUNCTION(az_ulib_ustream_builder_pool_init_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder_pool pool;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_pool_init(&pool, test_chunks, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_chunks(&pool));
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_ARE_EQUAL(void_ptr, (void*)&pool, (void*)test_chunks[i].pool);
+    }
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_pool_init_null_pool_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_pool_init(NULL, test_chunks, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunks is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_pool_init_null_chunks_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_pool_init(&test_pool, NULL, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunk count is zero. */
+TEST_FUNCTION(az_ulib_ustream_builder_pool_init_zero_chunk_count_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_pool_init(&test_pool, test_chunks, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunk count is bigger
+ * than AZ_ULIB_USTREAM_BUILDER_POOL_MAX_CHUNKS. */
+TEST_FUNCTION(az_ulib_ustream_builder_pool_init_chunk_count_exceed_max_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result =
+        az_ulib_ustream_builder_pool_init(&test_pool, test_chunks, AZ_ULIB_USTREAM_BUILDER_POOL_MAX_CHUNKS + 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_builder_init() unit tests----------------------*/
+
+/* az_ulib_ustream_builder_init shall initialize an empty builder without taking chunks from the pool. */
+TEST_FUNCTION(az_ulib_ustream_builder_init_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_init(&builder, &test_pool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 0, builder.length);
+    ASSERT_IS_NULL(builder.first_chunk);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_chunks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided builder is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_init_null_builder_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_init(NULL, &test_pool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_init_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_init(&builder, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_builder_append() unit tests----------------------*/
+
+/* az_ulib_ustream_builder_append shall copy the content to a chunk taken from the pool. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+                                USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, builder.length);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_chunks(&test_pool));
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, builder.first_chunk->data,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_deinit(&builder));
+}
+
+/* az_ulib_ustream_builder_append shall fill the free space in the last chunk before taking a new one. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_fill_last_chunk_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, 10));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, &test_big_content[10], TEST_CHUNK_SIZE - 10);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_CHUNK_SIZE, builder.length);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_chunks(&test_pool));
+    ASSERT_ARE_EQUAL(void_ptr, (void*)builder.first_chunk, (void*)builder.last_chunk);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, builder.first_chunk->data, TEST_CHUNK_SIZE);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_deinit(&builder));
+}
+
+/* az_ulib_ustream_builder_append shall split the content in as many chunks as needed. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_multiple_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, 100));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, &test_big_content[100],
+                                TEST_BIG_CONTENT_LENGTH - 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH, builder.length);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - TEST_BIG_CONTENT_CHUNKS, count_free_chunks(&test_pool));
+    az_ulib_ustream_builder_chunk* chunk = builder.first_chunk;
+    for(size_t i = 0; i < TEST_BIG_CONTENT_CHUNKS; i++)
+    {
+        size_t size = (i < (TEST_BIG_CONTENT_CHUNKS - 1)) ? TEST_CHUNK_SIZE : (TEST_CHUNK_SIZE / 2);
+        ASSERT_IS_NOT_NULL(chunk);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[i * TEST_CHUNK_SIZE], chunk->data, size);
+        chunk = chunk->next;
+    }
+    ASSERT_IS_NULL(chunk);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_deinit(&builder));
+}
+
+/* az_ulib_ustream_builder_append shall return AZ_ULIB_OUT_OF_MEMORY_ERROR, return the chunks taken by the append to
+ * the pool, and keep the builder unchanged if there are not enough free chunks in the pool. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_out_of_chunks_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, 10));
+    az_ulib_ustream_builder_chunk* last_chunk = builder.last_chunk;
+    static uint8_t big_buffer[TEST_POOL_SIZE * TEST_CHUNK_SIZE];
+    az_ulib_ustream result_ustream;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, big_buffer, sizeof(big_buffer) - 9);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 10, builder.length);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)last_chunk, (void*)builder.last_chunk);
+    ASSERT_IS_NULL(builder.last_chunk->next);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_chunks(&test_pool));
+    freeze_test_builder(&builder, &result_ustream);
+    check_buffer(&result_ustream, 0, test_big_content, 10);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&result_ustream);
+}
+
+/* az_ulib_ustream_builder_append shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided builder is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_null_builder_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(NULL, test_big_content, 10);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_append shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided buffer is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, NULL, 10);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, builder.length);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_append shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided size is zero. */
+TEST_FUNCTION(az_ulib_ustream_builder_append_zero_size_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_append(&builder, test_big_content, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, builder.length);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_builder_freeze() unit tests----------------------*/
+
+/* az_ulib_ustream_builder_freeze shall create a ustream over the chunks of the builder, without copying them. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+                                                USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH));
+    az_ulib_ustream_builder_chunk* first_chunk = builder.first_chunk;
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_ustream result_ustream;
+    const uint8_t* span;
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_freeze(&builder, control_block, test_control_block_release,
+                                &result_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_peek(&result_ustream, &span, &size_result));
+    ASSERT_ARE_EQUAL(void_ptr, (void*)first_chunk->data, (void*)span);
+    check_buffer(&result_ustream, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&result_ustream);
+}
+
+/* az_ulib_ustream_builder_freeze shall leave the builder empty, ready to build a new content. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_builder_reuse_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 10));
+    az_ulib_ustream first_ustream;
+    az_ulib_ustream second_ustream;
+
+    ///act
+    freeze_test_builder(&builder, &first_ustream);
+    ASSERT_ARE_EQUAL(int, 0, builder.length);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[10], 20));
+    freeze_test_builder(&builder, &second_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 2, count_free_chunks(&test_pool));
+    check_buffer(&first_ustream, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 10);
+    check_buffer(&second_ustream, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[10], 20);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&first_ustream);
+    (void)az_ulib_ustream_dispose(&second_ustream);
+}
+
+/* az_ulib_ustream_builder_freeze shall return AZ_ULIB_EOF if the builder is empty. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_empty_builder_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream result_ustream;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_freeze(&builder, &control_block, NULL, &result_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_freeze shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided builder is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_null_builder_failed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream result_ustream;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_freeze(NULL, &control_block, NULL, &result_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_freeze shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided control block is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_null_control_block_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, 10));
+    az_ulib_ustream result_ustream;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_freeze(&builder, NULL, NULL, &result_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 10, builder.length);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_deinit(&builder));
+}
+
+/* az_ulib_ustream_builder_freeze shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_freeze_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, 10));
+    az_ulib_ustream_data_cb control_block;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_freeze(&builder, &control_block, NULL, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 10, builder.length);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_deinit(&builder));
+}
+
+/*-------------------az_ulib_ustream_builder_deinit() unit tests----------------------*/
+
+/* az_ulib_ustream_builder_deinit shall return all the chunks of the builder to the pool. */
+TEST_FUNCTION(az_ulib_ustream_builder_deinit_succeed)
+{
+    ///arrange
+    az_ulib_ustream_builder builder;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, test_big_content, TEST_BIG_CONTENT_LENGTH));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_deinit(&builder);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 0, builder.length);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_chunks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_builder_deinit shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided builder is NULL. */
+TEST_FUNCTION(az_ulib_ustream_builder_deinit_null_builder_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_builder_deinit(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------frozen ustream unit tests----------------------*/
+
+/* az_ulib_ustream_dispose shall return the chunks to the pool and release the control block only when the last
+ * instance of the frozen ustream is disposed. */
+TEST_FUNCTION(az_ulib_ustream_builder_dispose_return_chunks_to_pool_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    az_ulib_ustream test_buffer_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_buffer_clone, &test_buffer, 0));
+
+    ///act
+    (void)az_ulib_ustream_dispose(&test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - TEST_BIG_CONTENT_CHUNKS, count_free_chunks(&test_pool));
+    ASSERT_ARE_EQUAL(int, 0, test_control_block_release_count);
+    (void)az_ulib_ustream_dispose(&test_buffer_clone);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_chunks(&test_pool));
+    ASSERT_ARE_EQUAL(int, 1, test_control_block_release_count);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_read shall read the content across the chunks. */
+TEST_FUNCTION(az_ulib_ustream_builder_read_across_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    uint8_t buf_result[TEST_BIG_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, TEST_CHUNK_SIZE - 3));
+    az_ulib_result result = az_ulib_ustream_read(&test_buffer, buf_result, TEST_CHUNK_SIZE + 6, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_CHUNK_SIZE + 6, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[TEST_CHUNK_SIZE - 3], buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&test_buffer));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_read and az_ulib_ustream_read_at shall find the chunks of a content with thousands of chunks. */
+TEST_FUNCTION(az_ulib_ustream_builder_read_large_content_succeed)
+{
+    ///arrange
+    static az_ulib_ustream_builder_chunk large_chunks[TEST_LARGE_POOL_SIZE];
+    static uint8_t part[TEST_LARGE_PART_SIZE];
+    az_ulib_ustream_builder_pool large_pool;
+    az_ulib_ustream_builder builder;
+    az_ulib_ustream test_buffer;
+    uint8_t buf_result[TEST_LARGE_READ_SIZE];
+    size_t size_result;
+    size_t content_length = 0;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_pool_init(&large_pool, large_chunks, TEST_LARGE_POOL_SIZE));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_init(&builder, &large_pool));
+    while((content_length + TEST_LARGE_PART_SIZE) <= (TEST_LARGE_POOL_SIZE * TEST_CHUNK_SIZE))
+    {
+        for(size_t i = 0; i < TEST_LARGE_PART_SIZE; i++)
+        {
+            part[i] = TEST_BIG_CONTENT_BYTE(content_length + i);
+        }
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_builder_append(&builder, part, TEST_LARGE_PART_SIZE));
+        content_length += TEST_LARGE_PART_SIZE;
+    }
+    freeze_test_builder(&builder, &test_buffer);
+
+    ///act
+    ///assert
+    for(size_t position = 0; position < content_length; position += size_result)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+        for(size_t i = 0; i < size_result; i++)
+        {
+            ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_BYTE(position + i), buf_result[i]);
+        }
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+    for(size_t position = content_length - 1; position > TEST_CHUNK_SIZE; position -= (TEST_CHUNK_SIZE + 1))
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read_at(&test_buffer, position, buf_result, 2, &size_result));
+        ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_BYTE(position), buf_result[0]);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    ASSERT_ARE_EQUAL(int, 1, test_control_block_release_count);
+}
+
+/* az_ulib_ustream_read_at shall read the content across the chunks without changing the current position. */
+TEST_FUNCTION(az_ulib_ustream_builder_read_at_across_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    uint8_t buf_result[TEST_BIG_CONTENT_LENGTH];
+    size_t size_result;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read_at(&test_buffer, (2 * TEST_CHUNK_SIZE) - 1, buf_result,
+                                sizeof(buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH - (2 * TEST_CHUNK_SIZE) + 1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[(2 * TEST_CHUNK_SIZE) - 1], buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_buffer, &position));
+    ASSERT_ARE_EQUAL(int, 0, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_readv shall scatter the content across the chunks in the local buffers. */
+TEST_FUNCTION(az_ulib_ustream_builder_readv_across_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    static uint8_t buf_result_1[TEST_CHUNK_SIZE + 1];
+    static uint8_t buf_result_2[TEST_BIG_CONTENT_LENGTH];
+    az_ulib_ustream_iovec iov[2] = { { buf_result_1, sizeof(buf_result_1) }, { buf_result_2, sizeof(buf_result_2) } };
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&test_buffer, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, buf_result_1, sizeof(buf_result_1));
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[sizeof(buf_result_1)], buf_result_2,
+        TEST_BIG_CONTENT_LENGTH - sizeof(buf_result_1));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_peek shall expose the content up to the end of the chunk in the current position. */
+TEST_FUNCTION(az_ulib_ustream_builder_peek_up_to_the_end_of_the_chunk_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    size_t position = 0;
+    size_t chunk = 0;
+
+    ///act
+    ///assert
+    while(position < TEST_BIG_CONTENT_LENGTH)
+    {
+        const uint8_t* span;
+        size_t size_result;
+        size_t expected_size = (chunk < (TEST_BIG_CONTENT_CHUNKS - 1)) ? TEST_CHUNK_SIZE : (TEST_CHUNK_SIZE / 2);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_peek(&test_buffer, &span, &size_result));
+        ASSERT_ARE_EQUAL(int, expected_size, size_result);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)test_chunks[chunk].data, (void*)span);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[position], span, size_result);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_advance(&test_buffer, size_result));
+        position += size_result;
+        chunk++;
+    }
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_CHUNKS, chunk);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_split shall split a frozen ustream in the middle of a chunk. */
+TEST_FUNCTION(az_ulib_ustream_builder_split_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_big_builder_ustream(&test_buffer);
+    az_ulib_ustream split_buffer;
+    uint8_t buf_result[TEST_BIG_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_split(&test_buffer, &split_buffer, TEST_CHUNK_SIZE + 10);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, TEST_CHUNK_SIZE + 10, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_big_content, buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&split_buffer, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH - TEST_CHUNK_SIZE - 10, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_big_content[TEST_CHUNK_SIZE + 10], buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&split_buffer);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_builder_ut)
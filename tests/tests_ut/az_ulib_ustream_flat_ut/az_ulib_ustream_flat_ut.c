@@ -0,0 +1,588 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream.h"
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1 =
+        (const uint8_t* const)"0123456789";
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2 =
+        (const uint8_t* const)"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3 =
+        (const uint8_t* const)"abcdefghijklmnopqrstuvwxyz";
+
+#define TEST_MANY_SEGMENTS_COUNT    64
+
+/* Create a ustream with the flat concatenation of the provided contents split in parts with the provided sizes. */
+static void create_test_flat_ustream(az_ulib_ustream* ustream, const uint8_t* content, const size_t* part_sizes, size_t part_count)
+{
+    az_ulib_ustream* parts = (az_ulib_ustream*)malloc(part_count * sizeof(az_ulib_ustream));
+    ASSERT_IS_NOT_NULL(parts);
+
+    for(size_t i = 0; i < part_count; i++)
+    {
+        az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+        ASSERT_IS_NOT_NULL(control_block);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init((i == 0) ? ustream : &(parts[i]), control_block, free,
+                            content, part_sizes[i], NULL));
+        content += part_sizes[i];
+    }
+
+    if(part_count > 1)
+    {
+        az_ulib_ustream_flat_data_cb* flat_data =
+            (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(part_count));
+        ASSERT_IS_NOT_NULL(flat_data);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat_n(ustream, &(parts[1]), part_count - 1, flat_data, free));
+        for(size_t i = 1; i < part_count; i++)
+        {
+            (void)az_ulib_ustream_dispose(&(parts[i]));
+        }
+    }
+
+    free(parts);
+}
+
+static void create_test_default_flat_ustream(az_ulib_ustream* ustream)
+{
+    static const size_t part_sizes[] = { 10, 26, 26 };
+    create_test_flat_ustream(ustream,
+            (const uint8_t*)"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", part_sizes, 3);
+}
+
+/* Create a ustream with the flat concatenation of TEST_MANY_SEGMENTS_COUNT segments with different sizes. */
+static void create_test_many_segments_ustream(az_ulib_ustream* ustream, uint8_t* content, size_t* content_length)
+{
+    size_t part_sizes[TEST_MANY_SEGMENTS_COUNT];
+
+    *content_length = 0;
+    for(size_t i = 0; i < TEST_MANY_SEGMENTS_COUNT; i++)
+    {
+        part_sizes[i] = (i % 7) + 1;
+        *content_length += part_sizes[i];
+    }
+    for(size_t i = 0; i < *content_length; i++)
+    {
+        content[i] = (uint8_t)(i * 31);
+    }
+
+    create_test_flat_ustream(ustream, content, part_sizes, TEST_MANY_SEGMENTS_COUNT);
+}
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT =
+        (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)           create_test_default_flat_ustream(ustream)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_flat.c module.
+ */
+BEGIN_TEST_SUITE(ustream_flat_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_ustream_concat_n shall return AZ_ULIB_SUCCESS if the ustreams were concatenated succesfully */
+TEST_FUNCTION(az_ulib_ustream_concat_n_multiple_buffers_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer1;
+    az_ulib_ustream test_buffers[2];
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_ustream_data_cb* control_block2 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_ustream_data_cb* control_block3 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_buffer1, control_block1, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&(test_buffers[0]), control_block2, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2), NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&(test_buffers[1]), control_block3, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3), NULL));
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(3));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&test_buffer1, test_buffers, 2, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+    (void)az_ulib_ustream_dispose(&(test_buffers[1]));
+    check_buffer(
+        &test_buffer1,
+        0,
+        (const uint8_t*)USTREAM_COMPLIANCE_EXPECTED_CONTENT,
+        (uint8_t)strlen(USTREAM_COMPLIANCE_EXPECTED_CONTENT));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer1);
+}
+
+/* az_ulib_ustream_concat_n shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL */
+TEST_FUNCTION(az_ulib_ustream_concat_n_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffers[1];
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(2));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(NULL, test_buffers, 1, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    free(flat_data);
+}
+
+/* az_ulib_ustream_concat_n shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustreams to concat is NULL */
+TEST_FUNCTION(az_ulib_ustream_concat_n_null_ustreams_to_concat_failed)
+{
+    ///arrange
+    az_ulib_ustream default_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&default_buffer);
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(2));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&default_buffer, NULL, 1, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    free(flat_data);
+    (void)az_ulib_ustream_dispose(&default_buffer);
+}
+
+/* az_ulib_ustream_concat_n shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream count is zero */
+TEST_FUNCTION(az_ulib_ustream_concat_n_zero_ustream_count_failed)
+{
+    ///arrange
+    az_ulib_ustream default_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&default_buffer);
+    az_ulib_ustream test_buffers[1];
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(1));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&default_buffer, test_buffers, 0, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    free(flat_data);
+    (void)az_ulib_ustream_dispose(&default_buffer);
+}
+
+/* az_ulib_ustream_concat_n shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided flat data is NULL */
+TEST_FUNCTION(az_ulib_ustream_concat_n_null_flat_data_failed)
+{
+    ///arrange
+    az_ulib_ustream default_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&default_buffer);
+    az_ulib_ustream test_buffers[1];
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&(test_buffers[0]), control_block, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&default_buffer, test_buffers, 1, NULL, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+    (void)az_ulib_ustream_dispose(&default_buffer);
+}
+
+/* az_ulib_ustream_concat_n shall return the error and do not change the instance if one of the clones failed */
+TEST_FUNCTION(az_ulib_ustream_concat_n_clone_failed)
+{
+    ///arrange
+    az_ulib_ustream default_buffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&default_buffer, control_block1, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    az_ulib_ustream test_buffers[2];
+    az_ulib_ustream_data_cb* control_block2 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&(test_buffers[0]), control_block2, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2), NULL));
+    test_buffers[1] = *ustream_mock_create();
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(3));
+
+    set_clone_result(AZ_ULIB_OUT_OF_MEMORY_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&default_buffer, test_buffers, 2, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    check_buffer(
+        &default_buffer,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+        (uint8_t)strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1));
+
+    ///cleanup
+    free(flat_data);
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+    (void)az_ulib_ustream_dispose(&(test_buffers[1]));
+    (void)az_ulib_ustream_dispose(&default_buffer);
+}
+
+/* az_ulib_ustream_concat_n shall return the error and do not change the instance if the internal call to
+    az_ulib_ustream_get_remaining_size failed */
+TEST_FUNCTION(az_ulib_ustream_concat_n_get_remaining_size_failed)
+{
+    ///arrange
+    az_ulib_ustream default_buffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&default_buffer, control_block1, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    az_ulib_ustream test_buffers[1];
+    test_buffers[0] = *ustream_mock_create();
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(2));
+
+    set_get_remaining_size_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat_n(&default_buffer, test_buffers, 1, flat_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    check_buffer(
+        &default_buffer,
+        0,
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+        (uint8_t)strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1));
+
+    ///cleanup
+    free(flat_data);
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+    (void)az_ulib_ustream_dispose(&default_buffer);
+}
+
+/* az_ulib_ustream_read shall read from all the concatenated ustreams and return AZ_ULIB_SUCCESS */
+TEST_FUNCTION(az_ulib_ustream_concat_n_read_from_multiple_buffers_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    uint8_t content[TEST_MANY_SEGMENTS_COUNT * 8];
+    size_t content_length;
+    create_test_many_segments_ustream(&test_buffer, content, &content_length);
+    uint8_t buf_result[TEST_MANY_SEGMENTS_COUNT * 8];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, content_length, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(content, buf_result, content_length));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_set_position shall find the segment of any position in a flat ustream with many segments */
+TEST_FUNCTION(az_ulib_ustream_concat_n_many_segments_set_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    uint8_t content[TEST_MANY_SEGMENTS_COUNT * 8];
+    size_t content_length;
+    create_test_many_segments_ustream(&test_buffer, content, &content_length);
+
+    ///act
+    ///assert
+    for(size_t i = content_length; i > 0; i--)
+    {
+        uint8_t buf_result[3];
+        size_t size_result;
+        size_t expected_size = ((content_length - (i - 1)) < sizeof(buf_result)) ?
+                                (content_length - (i - 1)) : sizeof(buf_result);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, (offset_t)(i - 1)));
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+        ASSERT_ARE_EQUAL(size_t, expected_size, size_result);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(&content[i - 1], buf_result, size_result));
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_peek shall return the span of the segment in the current position */
+TEST_FUNCTION(az_ulib_ustream_concat_n_peek_each_segment_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    uint8_t content[TEST_MANY_SEGMENTS_COUNT * 8];
+    size_t content_length;
+    create_test_many_segments_ustream(&test_buffer, content, &content_length);
+    size_t position = 0;
+
+    ///act
+    ///assert
+    for(size_t i = 0; i < TEST_MANY_SEGMENTS_COUNT; i++)
+    {
+        const uint8_t* span;
+        size_t size_result;
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_peek(&test_buffer, &span, &size_result));
+        ASSERT_ARE_EQUAL(size_t, (i % 7) + 1, size_result);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)&content[position], (void*)span);
+        position += size_result;
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_advance(&test_buffer, size_result));
+    }
+    ASSERT_ARE_EQUAL(size_t, content_length, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_split shall split a flat ustream in the middle of a segment */
+TEST_FUNCTION(az_ulib_ustream_concat_n_split_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream split_buffer;
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+    const uint8_t* span;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_split(&test_buffer, &split_buffer, 20);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 10));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_peek(&test_buffer, &span, &size_result));
+    ASSERT_ARE_EQUAL(size_t, 10, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&test_buffer));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(size_t, 20, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, 20));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&split_buffer, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(size_t, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 20, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(&USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[20], buf_result, size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&split_buffer);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_read shall return partial result if one of the segments failed. */
+TEST_FUNCTION(az_ulib_ustream_concat_n_read_failed_in_segment_with_some_valid_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_buffer, control_block, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    az_ulib_ustream test_buffers[1];
+    test_buffers[0] = *ustream_mock_create();
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(2));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat_n(&test_buffer, test_buffers, 1, flat_data, free));
+    set_read_result(AZ_ULIB_SYSTEM_ERROR);
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+}
+
+/* az_ulib_ustream_hint shall forward the part of the range in each segment that contains it. */
+TEST_FUNCTION(az_ulib_ustream_flat_hint_forward_to_segments_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    az_ulib_ustream_data_cb* control_block1 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_buffer, control_block1, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    az_ulib_ustream test_buffers[2];
+    az_ulib_ustream_data_cb* control_block2 = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&(test_buffers[0]), control_block2, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2), NULL));
+    test_buffers[1] = *ustream_mock_create();
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(3));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat_n(&test_buffer, test_buffers, 2, flat_data, free));
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+    az_ulib_ustream_hint_type hint;
+    offset_t position;
+    size_t size;
+
+    ///act
+    az_ulib_result result_middle = az_ulib_ustream_hint(&test_buffer, AZ_ULIB_USTREAM_HINT_DONE, 5, 20);
+    size_t hint_count_middle = get_hint_call(&hint, &position, &size);
+    az_ulib_result result = az_ulib_ustream_hint(&test_buffer, AZ_ULIB_USTREAM_HINT_RANDOM, 5, 100);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_middle);
+    ASSERT_ARE_EQUAL(int, 0, hint_count_middle);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 1, get_hint_call(&hint, &position, &size));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_USTREAM_HINT_RANDOM, hint);
+    ASSERT_ARE_EQUAL(int, 36, position);
+    ASSERT_ARE_EQUAL(int, 10, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    (void)az_ulib_ustream_dispose(&(test_buffers[1]));
+}
+
+/* az_ulib_ustream_hint shall return the error of the hint in the segment. */
+TEST_FUNCTION(az_ulib_ustream_flat_hint_forward_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_buffer, control_block, free, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+            strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1), NULL));
+    az_ulib_ustream test_buffers[1];
+    test_buffers[0] = *ustream_mock_create();
+    az_ulib_ustream_flat_data_cb* flat_data =
+        (az_ulib_ustream_flat_data_cb*)malloc(AZ_ULIB_USTREAM_FLAT_DATA_CB_SIZE(2));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat_n(&test_buffer, test_buffers, 1, flat_data, free));
+    set_hint_result(AZ_ULIB_BUSY_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&test_buffer, AZ_ULIB_USTREAM_HINT_WILL_NEED, 0, 20);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    (void)az_ulib_ustream_dispose(&(test_buffers[0]));
+}
+
+/* The flat ustream and its clone shall read independently, even after the original is disposed. */
+TEST_FUNCTION(az_ulib_ustream_flat_read_clone_and_original_in_parallel_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_buffer_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_buffer_clone, &test_buffer, 0));
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, 15, &size_result));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, 15));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer_clone, buf_result, 40, &size_result));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, 40));
+    (void)az_ulib_ustream_dispose(&test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_read(&test_buffer_clone, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(size_t, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 40, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(&USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[40], buf_result, size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer_clone);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_flat_ut)
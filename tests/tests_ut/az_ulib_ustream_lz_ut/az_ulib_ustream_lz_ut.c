@@ -0,0 +1,854 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_config.h"
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_lz.h"
+
+#define TEST_CHUNK_SIZE                 AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE
+#define TEST_HEADER_SIZE                AZ_ULIB_USTREAM_LZ_CHUNK_HEADER_SIZE
+/* 4 chunks and a half, so the last chunk is partial. */
+#define TEST_BIG_CONTENT_LENGTH         ((TEST_CHUNK_SIZE * 4) + (TEST_CHUNK_SIZE / 2))
+#define TEST_BIG_CHUNK_COUNT            5
+#define TEST_MAX_COMPRESSED_LENGTH      (TEST_BIG_CONTENT_LENGTH + (TEST_BIG_CHUNK_COUNT * TEST_HEADER_SIZE))
+
+/* More chunks than the index entries, so the index keeps one chunk out of 4. */
+#define TEST_INDEXED_CONTENT_LENGTH     ((TEST_CHUNK_SIZE * ((AZ_ULIB_CONFIG_USTREAM_LZ_INDEX_SIZE * 3) + 1)) + 17)
+#define TEST_INDEXED_READ_COUNT         50
+
+/* Read sizes that cross the chunks in all alignments. */
+static const size_t test_read_sizes[] = { 1, 2, 5, 7, 64, 3, 4, 1000, 11, 257, 12, 6 };
+#define TEST_READ_SIZES_COUNT           (sizeof(test_read_sizes) / sizeof(test_read_sizes[0]))
+
+/* 32 'a' compress in one literal, a match of 26 bytes with offset 1, and the 5 last literals. */
+static const uint8_t test_run_content[] = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+static const uint8_t test_run_compressed[] =
+{
+    32, 0, 11, 0,
+    0x1F, 'a', 0x01, 0x00, 0x07,
+    0x50, 'a', 'a', 'a', 'a', 'a'
+};
+
+/* 3 literals, a match of 12 bytes with offset 3, which overlaps the content that it copies, and 5 last literals. */
+static const uint8_t test_pattern_content[] = "abcabcabcabcabcabcab";
+static const uint8_t test_pattern_compressed[] =
+{
+    20, 0, 12, 0,
+    0x38, 'a', 'b', 'c', 0x03, 0x00,
+    0x50, 'a', 'b', 'c', 'a', 'b'
+};
+
+static uint8_t test_telemetry_content[TEST_BIG_CONTENT_LENGTH];
+static uint8_t test_random_content[TEST_BIG_CONTENT_LENGTH];
+/* One extra byte to read the EOF after the biggest content. */
+static uint8_t test_compressed[TEST_MAX_COMPRESSED_LENGTH + 1];
+static uint8_t test_buf_result[TEST_MAX_COMPRESSED_LENGTH + 1];
+
+/* Fill the buffer with JSON lines similar to the telemetry of a device. */
+static void fill_telemetry(uint8_t* buffer, size_t size)
+{
+    uint32_t seed = 42;
+    size_t position = 0;
+    char line[160];
+
+    for(uint32_t i = 0; position < size; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        int line_size = snprintf(line, sizeof(line),
+            "{\"deviceId\":\"sensor-%04u\",\"ts\":%u,\"temperature\":%u.%02u,\"humidity\":%u.%u,\"status\":\"ok\"}\n",
+            (unsigned)(i % 16), (unsigned)(1700000000u + i), (unsigned)(20 + ((seed >> 16) % 5)),
+            (unsigned)((seed >> 8) % 100), (unsigned)(40 + ((seed >> 20) % 20)), (unsigned)((seed >> 4) % 10));
+        size_t copy_size = ((size - position) < (size_t)line_size) ? (size - position) : (size_t)line_size;
+        (void)memcpy(&buffer[position], line, copy_size);
+        position += copy_size;
+    }
+}
+
+static void create_test_buffer(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_IS_NOT_NULL(control_block);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init(ustream, control_block, free, content, content_length, NULL));
+}
+
+static az_ulib_ustream_lz_data_cb* create_test_lz_data(void)
+{
+    az_ulib_ustream_lz_data_cb* lz_data = (az_ulib_ustream_lz_data_cb*)malloc(sizeof(az_ulib_ustream_lz_data_cb));
+    ASSERT_IS_NOT_NULL(lz_data);
+    return lz_data;
+}
+
+/* Create an LZ ustream over a buffer with the provided content. */
+static void create_test_lz_ustream(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length, bool decompress)
+{
+    az_ulib_ustream source;
+    create_test_buffer(&source, content, content_length);
+    if(decompress)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_lz_decompress(ustream, create_test_lz_data(), free, &source));
+    }
+    else
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_lz_compress(ustream, create_test_lz_data(), free, &source));
+    }
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* Create a decompress ustream over a compress ustream with the provided content. */
+static void create_test_round_trip_ustream(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length)
+{
+    az_ulib_ustream compressed;
+    create_test_lz_ustream(&compressed, content, content_length, false);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_lz_decompress(ustream, create_test_lz_data(), free, &compressed));
+    (void)az_ulib_ustream_dispose(&compressed);
+}
+
+static void create_test_default_lz_ustream(az_ulib_ustream* ustream)
+{
+    create_test_round_trip_ustream(ustream,
+        (const uint8_t*)"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", 62);
+}
+
+/* Read all the content of the ustream with the test read sizes, returning its size. */
+static size_t read_with_test_sizes(az_ulib_ustream* ustream, uint8_t* buf_result, size_t buffer_length)
+{
+    size_t total_size = 0;
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    for(size_t i = 0; result == AZ_ULIB_SUCCESS; i++)
+    {
+        size_t size_result;
+        size_t read_size = test_read_sizes[i % TEST_READ_SIZES_COUNT];
+        if(read_size > (buffer_length - total_size))
+        {
+            read_size = buffer_length - total_size;
+        }
+        ASSERT_ARE_NOT_EQUAL(int, 0, read_size);
+        result = az_ulib_ustream_read(ustream, &buf_result[total_size], read_size, &size_result);
+        if(result == AZ_ULIB_SUCCESS)
+        {
+            total_size += size_result;
+        }
+    }
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+
+    return total_size;
+}
+
+/* Read 8 bytes in positions from the end to the beginning of the ustream, in an order that also jumps forward, and
+ * compare them with the expected content. */
+static void check_read_at_indexed_chunks(az_ulib_ustream* ustream, const uint8_t* expected, size_t length)
+{
+    uint8_t buf_result[8];
+    size_t size_result;
+
+    for(size_t i = 0; i < TEST_INDEXED_READ_COUNT; i++)
+    {
+        offset_t position = ((length - sizeof(buf_result)) / TEST_INDEXED_READ_COUNT) *
+                                (TEST_INDEXED_READ_COUNT - 1 - (i ^ 1));
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read_at(ustream, 0, buf_result, 1, &size_result));
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+            az_ulib_ustream_read_at(ustream, position, buf_result, sizeof(buf_result), &size_result));
+        ASSERT_ARE_NOT_EQUAL(int, 0, size_result);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &expected[position], buf_result, size_result);
+    }
+}
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+#define USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT =
+        (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)           create_test_default_lz_ustream(ustream)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_lz.c module.
+ */
+BEGIN_TEST_SUITE(ustream_lz_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    fill_telemetry(test_telemetry_content, TEST_BIG_CONTENT_LENGTH);
+    uint32_t seed = 7;
+    for(size_t i = 0; i < TEST_BIG_CONTENT_LENGTH; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        test_random_content[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(test_buf_result, 0, sizeof(test_buf_result));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/*-------------------az_ulib_ustream_lz_compress() unit tests----------------------*/
+
+/* az_ulib_ustream_lz_compress shall expose the chunk header followed by the content compressed in the LZ4 block
+ * format. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_lz_ustream(&test_lz, test_run_content, sizeof(test_run_content) - 1, false);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, sizeof(test_run_compressed), size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_run_compressed, test_buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_compress shall compress telemetry in chunks that decompress back to the original content. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_big_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    az_ulib_ustream test_decompressed;
+    size_t remaining_size;
+    create_test_lz_ustream(&test_lz, test_telemetry_content, TEST_BIG_CONTENT_LENGTH, false);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_remaining_size(&test_lz, &remaining_size);
+    size_t compressed_size = read_with_test_sizes(&test_lz, test_compressed, sizeof(test_compressed));
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, remaining_size, compressed_size);
+    ASSERT_IS_TRUE(compressed_size < (TEST_BIG_CONTENT_LENGTH / 2));
+    create_test_lz_ustream(&test_decompressed, test_compressed, compressed_size, true);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_CONTENT_LENGTH,
+        read_with_test_sizes(&test_decompressed, test_buf_result, sizeof(test_buf_result)));
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_telemetry_content, test_buf_result, TEST_BIG_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_decompressed);
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_compress shall store the chunks that do not compress as they are. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_incompressible_content_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    size_t remaining_size;
+    create_test_lz_ustream(&test_lz, test_random_content, TEST_BIG_CONTENT_LENGTH, false);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_get_remaining_size(&test_lz, &remaining_size);
+    size_t compressed_size = read_with_test_sizes(&test_lz, test_compressed, sizeof(test_compressed));
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_MAX_COMPRESSED_LENGTH, remaining_size);
+    ASSERT_ARE_EQUAL(int, TEST_MAX_COMPRESSED_LENGTH, compressed_size);
+    for(size_t i = 0; i < TEST_BIG_CHUNK_COUNT; i++)
+    {
+        size_t chunk_size = (i < (TEST_BIG_CHUNK_COUNT - 1)) ? TEST_CHUNK_SIZE : (TEST_CHUNK_SIZE / 2);
+        const uint8_t* chunk = &test_compressed[i * (TEST_CHUNK_SIZE + TEST_HEADER_SIZE)];
+        ASSERT_ARE_EQUAL(int, chunk_size, (size_t)chunk[0] | ((size_t)chunk[1] << 8));
+        ASSERT_ARE_EQUAL(int, chunk_size, (size_t)chunk[2] | ((size_t)chunk[3] << 8));
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_random_content[i * TEST_CHUNK_SIZE], &chunk[TEST_HEADER_SIZE], chunk_size);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_compress shall compress the source from its current position. 13 bytes are too short to
+ * have a match, so the chunk is stored. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_from_current_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_buffer(&source, test_run_content, sizeof(test_run_content) - 1);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, 19));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_compress(&test_lz, create_test_lz_data(), free, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, TEST_HEADER_SIZE + 13, size_result);
+    ASSERT_ARE_EQUAL(int, 13, test_buf_result[0]);
+    ASSERT_ARE_EQUAL(int, 13, test_buf_result[2]);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_run_content[19], &test_buf_result[TEST_HEADER_SIZE], 13);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_compress shall compress the chunks up to the new position when it moves back or jumps forward. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_set_position_succeed)
+{
+    ///arrange
+    static const offset_t positions[] = { 5000, 10, 12000, 12001, 11999, 0, 17000 };
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_lz_ustream(&test_lz, test_telemetry_content, TEST_BIG_CONTENT_LENGTH, false);
+    size_t compressed_size = read_with_test_sizes(&test_lz, test_compressed, sizeof(test_compressed));
+    ASSERT_IS_TRUE(compressed_size > 1000);
+
+    for(size_t i = 0; i < (sizeof(positions) / sizeof(positions[0])); i++)
+    {
+        offset_t position = positions[i] % (compressed_size - 100);
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_set_position(&test_lz, position);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, 100, &size_result));
+        ASSERT_IS_TRUE(size_result != 0);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_compressed[position], test_buf_result, size_result);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_readv shall fill each buffer of the compressed content before the next one, even if the buffers
+ * cross the chunks. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_readv_cross_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    az_ulib_ustream test_expected;
+    size_t size_result;
+    create_test_lz_ustream(&test_expected, test_random_content, TEST_BIG_CONTENT_LENGTH, false);
+    size_t compressed_size = read_with_test_sizes(&test_expected, test_compressed, sizeof(test_compressed));
+    ASSERT_ARE_EQUAL(int, TEST_MAX_COMPRESSED_LENGTH, compressed_size);
+    create_test_lz_ustream(&test_lz, test_random_content, TEST_BIG_CONTENT_LENGTH, false);
+    az_ulib_ustream_iovec iov[2] =
+    {
+        { test_buf_result, TEST_CHUNK_SIZE + 1000 },
+        { &test_buf_result[TEST_CHUNK_SIZE + 1000], sizeof(test_buf_result) - (TEST_CHUNK_SIZE + 1000) }
+    };
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&test_lz, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, compressed_size, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_compressed, test_buf_result, compressed_size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_expected);
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_read_at shall compress the chunks from the closest indexed chunk, in contents with more chunks than
+ * the index entries. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_read_at_indexed_chunks_succeed)
+{
+    ///arrange
+    uint8_t* content = (uint8_t*)malloc(TEST_INDEXED_CONTENT_LENGTH);
+    uint8_t* compressed = (uint8_t*)malloc(TEST_INDEXED_CONTENT_LENGTH);
+    ASSERT_IS_NOT_NULL(content);
+    ASSERT_IS_NOT_NULL(compressed);
+    fill_telemetry(content, TEST_INDEXED_CONTENT_LENGTH);
+    az_ulib_ustream test_expected;
+    az_ulib_ustream test_lz;
+    create_test_lz_ustream(&test_expected, content, TEST_INDEXED_CONTENT_LENGTH, false);
+    size_t compressed_size = read_with_test_sizes(&test_expected, compressed, TEST_INDEXED_CONTENT_LENGTH);
+    create_test_lz_ustream(&test_lz, content, TEST_INDEXED_CONTENT_LENGTH, false);
+
+    ///act
+    ///assert
+    check_read_at_indexed_chunks(&test_lz, compressed, compressed_size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_expected);
+    (void)az_ulib_ustream_dispose(&test_lz);
+    free(compressed);
+    free(content);
+}
+
+/* az_ulib_ustream_lz_compress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is empty. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_empty_source_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+    create_test_buffer(&source, test_run_content, 3);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, 3));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_compress(&test_lz, lz_data, free, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    free(lz_data);
+}
+
+/* az_ulib_ustream_lz_compress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+    create_test_buffer(&source, test_run_content, 3);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_compress(NULL, lz_data, free, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    free(lz_data);
+}
+
+/* az_ulib_ustream_lz_compress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided LZ data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_null_lz_data_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    create_test_buffer(&source, test_run_content, 3);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_compress(&test_lz, NULL, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_lz_compress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_compress_null_ustream_to_compress_failed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_compress(&test_lz, lz_data, free, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    free(lz_data);
+}
+
+/*-------------------az_ulib_ustream_lz_decompress() unit tests----------------------*/
+
+/* az_ulib_ustream_lz_decompress shall expose the decompressed content of the chunks, including matches that overlap
+ * the content that they copy. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_lz_ustream(&test_lz, test_pattern_compressed, sizeof(test_pattern_compressed), true);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, sizeof(test_pattern_content) - 1, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_pattern_content, test_buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_decompress shall decompress the content of multiple chunks, compressed and stored. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_multiple_chunks_succeed)
+{
+    ///arrange
+    static uint8_t chunks[sizeof(test_run_compressed) + sizeof(test_pattern_compressed) + TEST_HEADER_SIZE + 3];
+    static uint8_t expected[(sizeof(test_run_content) - 1) + 3 + (sizeof(test_pattern_content) - 1)];
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    size_t position = 0;
+    (void)memcpy(&chunks[position], test_run_compressed, sizeof(test_run_compressed));
+    position += sizeof(test_run_compressed);
+    (void)memcpy(&chunks[position], "\x03\x00\x03\x00xyz", TEST_HEADER_SIZE + 3);
+    position += TEST_HEADER_SIZE + 3;
+    (void)memcpy(&chunks[position], test_pattern_compressed, sizeof(test_pattern_compressed));
+    (void)memcpy(expected, test_run_content, sizeof(test_run_content) - 1);
+    (void)memcpy(&expected[sizeof(test_run_content) - 1], "xyz", 3);
+    (void)memcpy(&expected[sizeof(test_run_content) + 2], test_pattern_content, sizeof(test_pattern_content) - 1);
+    create_test_lz_ustream(&test_lz, chunks, sizeof(chunks), true);
+
+    ///act
+    size_t decompressed_size = read_with_test_sizes(&test_lz, test_buf_result, sizeof(test_buf_result));
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, sizeof(expected), decompressed_size);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, expected, test_buf_result, decompressed_size);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read_at(&test_lz, 30, test_buf_result, 8, &size_result));
+    ASSERT_ARE_EQUAL(int, 2, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_decompress shall decompress only the chunk with the new position. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_set_position_succeed)
+{
+    ///arrange
+    static const offset_t positions[] =
+    {
+        TEST_CHUNK_SIZE - 1, TEST_CHUNK_SIZE, TEST_CHUNK_SIZE + 1, 10, (TEST_CHUNK_SIZE * 4) + 7, TEST_CHUNK_SIZE * 3, 0
+    };
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_round_trip_ustream(&test_lz, test_telemetry_content, TEST_BIG_CONTENT_LENGTH);
+
+    for(size_t i = 0; i < (sizeof(positions) / sizeof(positions[0])); i++)
+    {
+        ///act
+        az_ulib_result result = az_ulib_ustream_set_position(&test_lz, positions[i]);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, 100, &size_result));
+        ASSERT_IS_TRUE(size_result != 0);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_telemetry_content[positions[i]], test_buf_result, size_result);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_read_at shall decompress the chunk with the position, walking the headers from the closest indexed
+ * chunk, in contents with more chunks than the index entries. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_read_at_indexed_chunks_succeed)
+{
+    ///arrange
+    uint8_t* content = (uint8_t*)malloc(TEST_INDEXED_CONTENT_LENGTH);
+    ASSERT_IS_NOT_NULL(content);
+    fill_telemetry(content, TEST_INDEXED_CONTENT_LENGTH);
+    az_ulib_ustream test_lz;
+    create_test_round_trip_ustream(&test_lz, content, TEST_INDEXED_CONTENT_LENGTH);
+
+    ///act
+    ///assert
+    check_read_at_indexed_chunks(&test_lz, content, TEST_INDEXED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+    free(content);
+}
+
+/* az_ulib_ustream_read shall decompress at most one chunk in each call. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_read_one_chunk_per_call_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_round_trip_ustream(&test_lz, test_random_content, TEST_BIG_CONTENT_LENGTH);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_lz, 10));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, 1, &size_result));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, (TEST_CHUNK_SIZE * 2) - 11, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, &test_random_content[11], test_buf_result, size_result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result));
+    ASSERT_ARE_EQUAL(int, TEST_CHUNK_SIZE, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_readv shall fill each buffer of the decompressed content before the next one, even if the buffers
+ * cross the chunks. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_readv_cross_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    size_t size_result;
+    create_test_round_trip_ustream(&test_lz, test_telemetry_content, TEST_BIG_CONTENT_LENGTH);
+    az_ulib_ustream_iovec iov[2] =
+    {
+        { test_buf_result, TEST_CHUNK_SIZE + 1000 },
+        { &test_buf_result[TEST_CHUNK_SIZE + 1000], TEST_CHUNK_SIZE + 1000 }
+    };
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&test_lz, iov, 2, &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, (TEST_CHUNK_SIZE + 1000) * 2, size_result);
+    ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_telemetry_content, test_buf_result, size_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_lz);
+}
+
+/* az_ulib_ustream_lz_decompress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if one of the chunk headers is not valid. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_invalid_chunk_header_failed)
+{
+    ///arrange
+    static const struct
+    {
+        const char* content;
+        size_t size;
+    } invalid_chunks[] =
+    {
+        { "\x00\x00\x01\x00x", 5 },                     /* Empty chunk. */
+        { "\x03\x00\x00\x00", 4 },                      /* Empty payload. */
+        { "\x03\x00\x04\x00xyzw", 8 },                  /* Payload bigger than the chunk. */
+        { "\xFF\xFF\x01\x00x", 5 },                     /* Chunk bigger than AZ_ULIB_CONFIG_USTREAM_LZ_CHUNK_SIZE. */
+        { "\x03\x00\x03", 3 },                          /* Partial header. */
+        { "\x03\x00\x03\x00xy", 6 },                    /* Partial payload. */
+        { "\x03\x00\x03\x00xyz\x03\x00", 9 },           /* Partial header after a valid chunk. */
+    };
+
+    for(size_t i = 0; i < (sizeof(invalid_chunks) / sizeof(invalid_chunks[0])); i++)
+    {
+        az_ulib_ustream source;
+        az_ulib_ustream test_lz;
+        az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+        create_test_buffer(&source, (const uint8_t*)invalid_chunks[i].content, invalid_chunks[i].size);
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_lz_decompress(&test_lz, lz_data, free, &source);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&source);
+        free(lz_data);
+    }
+}
+
+/* az_ulib_ustream_read shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR when it reaches a chunk with an invalid payload. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_invalid_payload_failed)
+{
+    ///arrange
+    static const uint8_t* const invalid_payloads[] =
+    {
+        (const uint8_t*)"\x08\x00\x06\x00\x10" "a\x00\x00\x30" "a",        /* Offset zero. */
+        (const uint8_t*)"\x08\x00\x06\x00\x10" "a\x02\x00\x30" "a",        /* Offset before the chunk. */
+        (const uint8_t*)"\x08\x00\x06\x00\x60" "abcde",                   /* Literals beyond the payload. */
+        (const uint8_t*)"\x08\x00\x06\x00\x40" "abcd\x00",                /* Match without offset. */
+        (const uint8_t*)"\x08\x00\x06\x00\x10" "a\x01\x00\x3F" "a",        /* Match beyond the chunk. */
+        (const uint8_t*)"\x08\x00\x06\x00\x10" "a\x01\x00\x10" "b",        /* Content smaller than the chunk. */
+        (const uint8_t*)"\x08\x00\x06\x00\xF0\xFF\xFF\xFF\xFF\xFF",        /* Literal length beyond the payload. */
+    };
+
+    for(size_t i = 0; i < (sizeof(invalid_payloads) / sizeof(invalid_payloads[0])); i++)
+    {
+        static uint8_t chunks[sizeof(test_run_compressed) + TEST_HEADER_SIZE + 6];
+        az_ulib_ustream test_lz;
+        size_t size_result;
+        (void)memcpy(chunks, test_run_compressed, sizeof(test_run_compressed));
+        (void)memcpy(&chunks[sizeof(test_run_compressed)], invalid_payloads[i], TEST_HEADER_SIZE + 6);
+        create_test_lz_ustream(&test_lz, chunks, sizeof(chunks), true);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_lz, test_buf_result, 32, &size_result));
+
+        ///act
+        az_ulib_result result = az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result, "payload %d", (int)i);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR,
+            az_ulib_ustream_read(&test_lz, test_buf_result, sizeof(test_buf_result), &size_result));
+
+        ///cleanup
+        (void)az_ulib_ustream_dispose(&test_lz);
+    }
+}
+
+/* az_ulib_ustream_lz_decompress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is empty. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_empty_source_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+    create_test_buffer(&source, test_pattern_compressed, sizeof(test_pattern_compressed));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&source, sizeof(test_pattern_compressed)));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_decompress(&test_lz, lz_data, free, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    free(lz_data);
+}
+
+/* az_ulib_ustream_lz_decompress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+    create_test_buffer(&source, test_pattern_compressed, sizeof(test_pattern_compressed));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_decompress(NULL, lz_data, free, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+    free(lz_data);
+}
+
+/* az_ulib_ustream_lz_decompress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided LZ data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_null_lz_data_failed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    create_test_buffer(&source, test_pattern_compressed, sizeof(test_pattern_compressed));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_decompress(&test_lz, NULL, NULL, &source);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+/* az_ulib_ustream_lz_decompress shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided source is NULL. */
+TEST_FUNCTION(az_ulib_ustream_lz_decompress_null_ustream_to_decompress_failed)
+{
+    ///arrange
+    az_ulib_ustream test_lz;
+    az_ulib_ustream_lz_data_cb* lz_data = create_test_lz_data();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_lz_decompress(&test_lz, lz_data, free, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    free(lz_data);
+}
+
+/* az_ulib_ustream_dispose shall dispose the clone of the source when the last instance is disposed. */
+TEST_FUNCTION(az_ulib_ustream_lz_dispose_source_succeed)
+{
+    ///arrange
+    az_ulib_ustream source;
+    az_ulib_ustream test_lz;
+    az_ulib_ustream test_lz_clone;
+    create_test_buffer(&source, test_pattern_compressed, sizeof(test_pattern_compressed));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_lz_decompress(&test_lz, create_test_lz_data(), free, &source));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_lz_clone, &test_lz, 0));
+    ASSERT_ARE_EQUAL(int, 2, source.control_block->ref_count);
+
+    ///act
+    (void)az_ulib_ustream_dispose(&test_lz);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 2, source.control_block->ref_count);
+    (void)az_ulib_ustream_dispose(&test_lz_clone);
+    ASSERT_ARE_EQUAL(int, 1, source.control_block->ref_count);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&source);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_lz_ut)
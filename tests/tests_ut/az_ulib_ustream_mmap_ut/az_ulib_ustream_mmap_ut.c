@@ -0,0 +1,593 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/* The huge test file needs a 64 bits off_t. */
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_mmap.h"
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+
+#define TEST_CONTENT_FILE_NAME      "az_ulib_ustream_mmap_ut_content.bin"
+#define TEST_EMPTY_FILE_NAME        "az_ulib_ustream_mmap_ut_empty.bin"
+#define TEST_BIG_FILE_NAME          "az_ulib_ustream_mmap_ut_big.bin"
+#define TEST_NOT_FOUND_FILE_NAME    "az_ulib_ustream_mmap_ut_not_found.bin"
+
+/* Big enough to need 3 windows. */
+#define TEST_BIG_FILE_SIZE          ((2 * AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE) + (AZ_ULIB_CONFIG_USTREAM_MMAP_MIN_WINDOW_SIZE / 2))
+#define TEST_BIG_FILE_BYTE(pos)     ((uint8_t)((pos) % 251))
+#define TEST_READ_BUFFER_SIZE       100000
+
+#if SIZE_MAX > UINT32_MAX
+/* Sparse file bigger than 4GB, only the marks are written. */
+#define TEST_HUGE_FILE_NAME         "az_ulib_ustream_mmap_ut_huge.bin"
+#define TEST_HUGE_FILE_SIZE         (((offset_t)5 << 30) + 100)
+#define TEST_HUGE_MARK_SIZE         64
+static const offset_t test_huge_file_marks[] =
+{
+    0,
+    (offset_t)UINT32_MAX - (TEST_HUGE_MARK_SIZE / 2),
+    (offset_t)5 << 30,
+    TEST_HUGE_FILE_SIZE - TEST_HUGE_MARK_SIZE
+};
+#define TEST_HUGE_FILE_MARKS        (sizeof(test_huge_file_marks) / sizeof(test_huge_file_marks[0]))
+#endif /* SIZE_MAX > UINT32_MAX */
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+static az_ulib_ustream test_ustream_instance;
+static void ustream_factory(az_ulib_ustream* ustream)
+{
+    az_ulib_ustream_mmap_data_cb* mmap_data = (az_ulib_ustream_mmap_data_cb*)malloc(sizeof(az_ulib_ustream_mmap_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(ustream, mmap_data, free, TEST_CONTENT_FILE_NAME));
+}
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)         ustream_factory(ustream)
+
+static void create_test_file(const char* file_name, size_t size, const uint8_t* const content)
+{
+    FILE* file = fopen(file_name, "wb");
+    ASSERT_IS_NOT_NULL(file);
+    if(content != NULL)
+    {
+        ASSERT_ARE_EQUAL(int, size, fwrite(content, 1, size, file));
+    }
+    else
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_ARE_NOT_EQUAL(int, EOF, fputc(TEST_BIG_FILE_BYTE(i), file));
+        }
+    }
+    int result = fclose(file);
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+
+#if SIZE_MAX > UINT32_MAX
+static void create_huge_test_file(void)
+{
+    uint8_t mark[TEST_HUGE_MARK_SIZE];
+    int file_descriptor = open(TEST_HUGE_FILE_NAME, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_IS_TRUE(file_descriptor >= 0);
+    int result = ftruncate(file_descriptor, (off_t)TEST_HUGE_FILE_SIZE);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    for(size_t i = 0; i < TEST_HUGE_FILE_MARKS; i++)
+    {
+        for(size_t j = 0; j < TEST_HUGE_MARK_SIZE; j++)
+        {
+            mark[j] = TEST_BIG_FILE_BYTE(test_huge_file_marks[i] + j);
+        }
+        off_t file_offset = lseek(file_descriptor, (off_t)test_huge_file_marks[i], SEEK_SET);
+        ASSERT_IS_TRUE(file_offset == (off_t)test_huge_file_marks[i]);
+        ssize_t written = write(file_descriptor, mark, TEST_HUGE_MARK_SIZE);
+        ASSERT_ARE_EQUAL(int, TEST_HUGE_MARK_SIZE, written);
+    }
+    result = close(file_descriptor);
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+
+/* Read TEST_HUGE_MARK_SIZE bytes from the position, and compare with the content of the file in file_position. */
+static void check_huge_file_mark(az_ulib_ustream* ustream, offset_t position, offset_t file_position)
+{
+    uint8_t buf[TEST_HUGE_MARK_SIZE];
+    size_t size;
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(ustream, position));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(ustream, buf, TEST_HUGE_MARK_SIZE, &size));
+    ASSERT_ARE_EQUAL(int, TEST_HUGE_MARK_SIZE, size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(file_position + i), buf[i]);
+    }
+}
+#endif /* SIZE_MAX > UINT32_MAX */
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_mmap.c on ownership model.
+ */
+BEGIN_TEST_SUITE(ustream_mmap_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    create_test_file(TEST_CONTENT_FILE_NAME, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT);
+    create_test_file(TEST_EMPTY_FILE_NAME, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT);
+    create_test_file(TEST_BIG_FILE_NAME, TEST_BIG_FILE_SIZE, NULL);
+#if SIZE_MAX > UINT32_MAX
+    create_huge_test_file();
+#endif
+    (void)remove(TEST_NOT_FOUND_FILE_NAME);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    (void)remove(TEST_CONTENT_FILE_NAME);
+    (void)remove(TEST_EMPTY_FILE_NAME);
+    (void)remove(TEST_BIG_FILE_NAME);
+#if SIZE_MAX > UINT32_MAX
+    (void)remove(TEST_HUGE_FILE_NAME);
+#endif
+
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(&test_ustream_instance, 0, sizeof(az_ulib_ustream));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_ustream_mmap_init shall create an instance of the ustream and initialize the instance. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_CONTENT_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, size);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_mmap_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(NULL, &mmap_data, NULL, TEST_CONTENT_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_mmap_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided mmap data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_null_mmap_data_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, NULL, NULL, TEST_CONTENT_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_mmap_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided file name is NULL. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_null_file_name_failed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_mmap_init shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR if the file does not exist. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_file_not_found_failed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_NOT_FOUND_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_mmap_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the file is empty. */
+TEST_FUNCTION(az_ulib_ustream_mmap_init_empty_file_failed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_EMPTY_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_read shall copy the content of consecutive windows in a single read. */
+TEST_FUNCTION(az_ulib_ustream_mmap_read_across_windows_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    offset_t position = (offset_t)mmap_data.window_size - (TEST_READ_BUFFER_SIZE / 2);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    uint8_t* buf = (uint8_t*)malloc(TEST_READ_BUFFER_SIZE);
+    ASSERT_IS_NOT_NULL(buf);
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&ustream_instance, buf, TEST_READ_BUFFER_SIZE, &size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_READ_BUFFER_SIZE, size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + i), buf[i]);
+    }
+
+    ///cleanup
+    free(buf);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_readv shall copy the full content of a file with multiple windows. */
+TEST_FUNCTION(az_ulib_ustream_mmap_readv_across_windows_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    uint8_t* buf = (uint8_t*)malloc(TEST_BIG_FILE_SIZE);
+    ASSERT_IS_NOT_NULL(buf);
+    az_ulib_ustream_iovec iov[3];
+    iov[0].buffer = buf;
+    iov[0].buffer_length = TEST_READ_BUFFER_SIZE;
+    iov[1].buffer = buf + TEST_READ_BUFFER_SIZE;
+    iov[1].buffer_length = 0;
+    iov[2].buffer = buf + TEST_READ_BUFFER_SIZE;
+    iov[2].buffer_length = TEST_BIG_FILE_SIZE - TEST_READ_BUFFER_SIZE;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 3, &size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_SIZE, size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(i), buf[i]);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_readv(&ustream_instance, iov, 3, &size));
+
+    ///cleanup
+    free(buf);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_peek shall return a span up to the end of the current window. */
+TEST_FUNCTION(az_ulib_ustream_mmap_peek_stops_at_the_end_of_the_window_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    offset_t position = (offset_t)mmap_data.window_size - 10;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    const uint8_t* span;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&ustream_instance, &span, &size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 10, size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + i), span[i]);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_advance(&ustream_instance, size));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_peek(&ustream_instance, &span, &size));
+    ASSERT_ARE_EQUAL(int, mmap_data.window_size, size);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + 10), span[0]);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_release shall return the pages across multiple windows to the system, and keep the rest of the content. */
+TEST_FUNCTION(az_ulib_ustream_mmap_release_across_windows_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    offset_t position = (offset_t)mmap_data.window_size + (TEST_READ_BUFFER_SIZE / 2);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    uint8_t buf[16];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_release(&ustream_instance, position + 7);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&ustream_instance));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + 8 + i), buf[i]);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+#if SIZE_MAX > UINT32_MAX
+/* The hint will need shall map the windows of the range, without changing the current position. */
+TEST_FUNCTION(az_ulib_ustream_mmap_hint_will_need_maps_windows_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    offset_t position = (offset_t)mmap_data.window_size - 10;
+    uint8_t buf[16];
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED, position, 20);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_NOT_NULL(mmap_data.windows[0]);
+    ASSERT_IS_NOT_NULL(mmap_data.windows[1]);
+    ASSERT_IS_NULL(mmap_data.windows[2]);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(i), buf[i]);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint done shall drop the pages of the range, which are brought back from the file if read again. */
+TEST_FUNCTION(az_ulib_ustream_mmap_hint_done_across_windows_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_BIG_FILE_NAME));
+    offset_t position = (offset_t)mmap_data.window_size - (TEST_READ_BUFFER_SIZE / 2);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    uint8_t buf[16];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_DONE, 0, TEST_BIG_FILE_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + i), buf[i]);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The mmap ustream shall expose files bigger than 4GB, with positions bigger than UINT32_MAX. */
+TEST_FUNCTION(az_ulib_ustream_mmap_huge_file_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    size_t size;
+    uint8_t buf[TEST_HUGE_MARK_SIZE];
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_HUGE_FILE_NAME);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(size_t, TEST_HUGE_FILE_SIZE, size);
+    for(size_t i = 0; i < TEST_HUGE_FILE_MARKS; i++)
+    {
+        check_huge_file_mark(&ustream_instance, test_huge_file_marks[i], test_huge_file_marks[i]);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_split shall split a file bigger than 4GB in a position bigger than UINT32_MAX. */
+TEST_FUNCTION(az_ulib_ustream_mmap_split_huge_file_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb mmap_data;
+    az_ulib_ustream ustream_instance;
+    az_ulib_ustream ustream_instance_split;
+    offset_t split_position = test_huge_file_marks[2];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, &mmap_data, NULL, TEST_HUGE_FILE_NAME));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_split(&ustream_instance, &ustream_instance_split, split_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(size_t, split_position, size);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance_split, &size));
+    ASSERT_ARE_EQUAL(size_t, TEST_HUGE_FILE_SIZE - split_position, size);
+    check_huge_file_mark(&ustream_instance, test_huge_file_marks[1], test_huge_file_marks[1]);
+    check_huge_file_mark(&ustream_instance_split, split_position, split_position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance_split);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_concat shall concatenate files bigger than 4GB, with positions bigger than UINT32_MAX in both. */
+TEST_FUNCTION(az_ulib_ustream_mmap_concat_huge_files_succeed)
+{
+    ///arrange
+    az_ulib_ustream_mmap_data_cb* mmap_data_1 = (az_ulib_ustream_mmap_data_cb*)malloc(sizeof(az_ulib_ustream_mmap_data_cb));
+    az_ulib_ustream_mmap_data_cb* mmap_data_2 = (az_ulib_ustream_mmap_data_cb*)malloc(sizeof(az_ulib_ustream_mmap_data_cb));
+    az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+    ASSERT_IS_NOT_NULL(multi_data);
+    az_ulib_ustream ustream_instance;
+    az_ulib_ustream ustream_to_concat;
+    uint8_t buf[TEST_HUGE_MARK_SIZE];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_instance, mmap_data_1, free, TEST_HUGE_FILE_NAME));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_mmap_init(&ustream_to_concat, mmap_data_2, free, TEST_HUGE_FILE_NAME));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat(&ustream_instance, &ustream_to_concat, multi_data, free);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&ustream_to_concat);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(size_t, 2 * TEST_HUGE_FILE_SIZE, size);
+    for(size_t i = 0; i < TEST_HUGE_FILE_MARKS; i++)
+    {
+        check_huge_file_mark(&ustream_instance, test_huge_file_marks[i], test_huge_file_marks[i]);
+        check_huge_file_mark(&ustream_instance, TEST_HUGE_FILE_SIZE + test_huge_file_marks[i], test_huge_file_marks[i]);
+    }
+
+    /* One read across the end of the first file and the beginning of the second one. */
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_set_position(&ustream_instance, TEST_HUGE_FILE_SIZE - (TEST_HUGE_MARK_SIZE / 2)));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    for(size_t i = 0; i < (TEST_HUGE_MARK_SIZE / 2); i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(TEST_HUGE_FILE_SIZE - (TEST_HUGE_MARK_SIZE / 2) + i), buf[i]);
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(i), buf[(TEST_HUGE_MARK_SIZE / 2) + i]);
+    }
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#endif /* SIZE_MAX > UINT32_MAX */
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_mmap_ut)
@@ -0,0 +1,649 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_parallel.h"
+#include "az_ulib_pal_os.h"
+#include "az_ulib_pal_os_api.h"
+
+#define TEST_CONTENT            "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define TEST_CONTENT_LENGTH     62
+#define TEST_THREADS            4
+#define TEST_MAX_TASKS          8
+#define TEST_MAX_SLICES         TEST_CONTENT_LENGTH
+#define TEST_NO_FAILURE         ((size_t)-1)
+
+static const uint8_t* const test_content = (const uint8_t* const)TEST_CONTENT;
+static az_ulib_ustream_worker_pool test_pool;
+static az_ulib_pal_os_thread test_threads[TEST_THREADS];
+static az_ulib_ustream_parallel_task test_tasks[TEST_MAX_TASKS];
+
+typedef struct test_context_tag
+{
+    az_ulib_pal_os_lock lock;
+    uint8_t output[TEST_MAX_SLICES][TEST_CONTENT_LENGTH + 1];
+    size_t output_size[TEST_MAX_SLICES];
+    offset_t output_position[TEST_MAX_SLICES];
+    size_t work_count;
+    size_t join_order[TEST_MAX_SLICES];
+    size_t join_count;
+    size_t work_failure_index;
+    size_t join_failure_index;
+    az_ulib_result nested_run_result;
+    az_ulib_result nested_deinit_result;
+    bool nested_calls;
+} test_context;
+
+static test_context context;
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+static void create_test_ustream(az_ulib_ustream* ustream)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_IS_NOT_NULL(control_block);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(ustream, control_block, free, test_content, TEST_CONTENT_LENGTH, NULL));
+}
+
+static az_ulib_result test_work(az_ulib_ustream* slice, size_t index, void* arg)
+{
+    test_context* ctx = (test_context*)arg;
+    az_ulib_result result;
+    size_t size;
+
+    if(ctx->nested_calls)
+    {
+        ctx->nested_run_result = az_ulib_ustream_parallel_run(&test_pool, slice, 1, test_tasks, 1, test_work, NULL, NULL);
+        ctx->nested_deinit_result = az_ulib_ustream_worker_pool_deinit(&test_pool);
+    }
+
+    (void)az_ulib_ustream_get_position(slice, &(ctx->output_position[index]));
+    if((result = az_ulib_ustream_read(slice, ctx->output[index], TEST_CONTENT_LENGTH, &size)) == AZ_ULIB_SUCCESS)
+    {
+        ctx->output_size[index] = size;
+        if(az_ulib_ustream_read(slice, ctx->output[index] + size, TEST_CONTENT_LENGTH + 1 - size, &size) != AZ_ULIB_EOF)
+        {
+            result = AZ_ULIB_SYSTEM_ERROR;
+        }
+        else if(index == ctx->work_failure_index)
+        {
+            result = AZ_ULIB_CANCELLED_ERROR;
+        }
+    }
+
+    az_pal_os_lock_acquire(&(ctx->lock));
+    ctx->work_count++;
+    az_pal_os_lock_release(&(ctx->lock));
+
+    return result;
+}
+
+static az_ulib_result test_join(size_t index, void* arg)
+{
+    test_context* ctx = (test_context*)arg;
+
+    ctx->join_order[ctx->join_count++] = index;
+
+    return (index == ctx->join_failure_index) ? AZ_ULIB_BUSY_ERROR : AZ_ULIB_SUCCESS;
+}
+
+static void check_slices(size_t first_position, size_t chunk_size, size_t slice_count)
+{
+    for(size_t i = 0; i < slice_count; i++)
+    {
+        size_t start = first_position + (i * chunk_size);
+        size_t size = ((TEST_CONTENT_LENGTH - start) < chunk_size) ? (TEST_CONTENT_LENGTH - start) : chunk_size;
+        ASSERT_ARE_EQUAL(int, start, context.output_position[i]);
+        ASSERT_ARE_EQUAL(int, size, context.output_size[i]);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_content + start, context.output[i], size);
+    }
+}
+
+static void check_join_order(size_t join_count)
+{
+    ASSERT_ARE_EQUAL(int, join_count, context.join_count);
+    for(size_t i = 0; i < join_count; i++)
+    {
+        ASSERT_ARE_EQUAL(int, i, context.join_order[i]);
+    }
+}
+
+/**
+ * Beginning of the UT for ustream_parallel.c on ownership model.
+ */
+BEGIN_TEST_SUITE(ustream_parallel_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    az_pal_os_lock_init(&(context.lock));
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    az_pal_os_lock_deinit(&(context.lock));
+
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    az_ulib_pal_os_lock lock = context.lock;
+    memset(&context, 0, sizeof(context));
+    context.lock = lock;
+    context.work_failure_index = TEST_NO_FAILURE;
+    context.join_failure_index = TEST_NO_FAILURE;
+    memset(test_tasks, 0, sizeof(test_tasks));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/*-------------------az_ulib_ustream_worker_pool_init() unit tests----------------------*/
+
+/* az_ulib_ustream_worker_pool_init shall start the worker threads. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_init_succeed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_THREADS, test_pool.thread_count);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_worker_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_init_null_pool_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_init(NULL, test_threads, TEST_THREADS);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_worker_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided threads is NULL. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_init_null_threads_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_init(&test_pool, NULL, TEST_THREADS);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_worker_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided thread count is zero. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_init_zero_thread_count_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_init(&test_pool, test_threads, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/*-------------------az_ulib_ustream_worker_pool_deinit() unit tests----------------------*/
+
+/* az_ulib_ustream_worker_pool_deinit shall stop the worker threads. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_deinit_succeed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_deinit(&test_pool);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 0, test_pool.thread_count);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_worker_pool_deinit shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_deinit_null_pool_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_worker_pool_deinit(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_worker_pool_deinit shall return AZ_ULIB_BUSY_ERROR if there is a run in progress. */
+TEST_FUNCTION(az_ulib_ustream_worker_pool_deinit_running_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    context.nested_calls = true;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, TEST_CONTENT_LENGTH, test_tasks,
+                                TEST_MAX_TASKS, test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, context.nested_deinit_result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/*-------------------az_ulib_ustream_parallel_run() unit tests----------------------*/
+
+/* az_ulib_ustream_parallel_run shall call the work for each slice, and the join for each slice in order. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_succeed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 7, context.work_count);
+    check_slices(0, 10, 7);
+    check_join_order(7);
+    check_buffer(&ustream, 0, test_content, TEST_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall process the slices in rounds if there are more slices than tasks. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_more_slices_than_tasks_succeed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 1, test_tasks, 3,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_CONTENT_LENGTH, context.work_count);
+    check_slices(0, 1, TEST_CONTENT_LENGTH);
+    check_join_order(TEST_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall process the content from the current position, without changing the ustream. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_from_current_position_succeed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, 1));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream, 20));
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 16, test_tasks, TEST_MAX_TASKS,
+                                test_work, NULL, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 3, context.work_count);
+    for(size_t i = 0; i < 3; i++)
+    {
+        size_t size = (i < 2) ? 16 : 10;
+        ASSERT_ARE_EQUAL(int, 20 + (i * 16), context.output_position[i]);
+        ASSERT_ARE_EQUAL(int, size, context.output_size[i]);
+        ASSERT_BUFFER_ARE_EQUAL(uint8_t_ptr, test_content + 20 + (i * 16), context.output[i], size);
+    }
+    ASSERT_ARE_EQUAL(int, 0, context.join_count);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream, &position));
+    ASSERT_ARE_EQUAL(int, 20, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall accept more than one run in the same pool. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_twice_succeed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_parallel_run(&test_pool, &ustream, 31, test_tasks,
+                                TEST_MAX_TASKS, test_work, test_join, &context));
+    context.join_count = 0;
+    context.work_count = 0;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 5, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, 13, context.work_count);
+    check_slices(0, 5, 13);
+    check_join_order(13);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return the result of the first work that fails, and stop the joins on it. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_work_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    context.work_failure_index = 3;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 2, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_CANCELLED_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_MAX_TASKS, context.work_count);
+    check_join_order(3);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return the result of the first join that fails, and stop the run on it. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_join_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    context.join_failure_index = 9;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 2, test_tasks, 4,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 12, context.work_count);
+    check_join_order(10);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_BUSY_ERROR if there is another run in progress in the pool. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_busy_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    context.nested_calls = true;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, TEST_CONTENT_LENGTH, test_tasks,
+                                TEST_MAX_TASKS, test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_BUSY_ERROR, context.nested_run_result);
+    check_slices(0, TEST_CONTENT_LENGTH, 1);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_EOF if there are no remaining bytes in the ustream. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_empty_ustream_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream ustream;
+    create_test_ustream(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream, TEST_CONTENT_LENGTH));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, &ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, 0, context.work_count);
+    ASSERT_ARE_EQUAL(int, 0, context.join_count);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return the result of az_ulib_ustream_get_position if it fails. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_get_position_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    set_get_position_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, context.work_count);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return the result of az_ulib_ustream_get_remaining_size if it fails. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_get_remaining_size_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_init(&test_pool, test_threads, TEST_THREADS));
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    set_get_remaining_size_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+    ASSERT_ARE_EQUAL(int, 0, context.work_count);
+
+    ///cleanup
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_worker_pool_deinit(&test_pool));
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(NULL, test_ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_null_instance_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, NULL, 10, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided chunk size is zero. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_zero_chunk_size_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 0, test_tasks, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided tasks is NULL. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_null_tasks_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 10, NULL, TEST_MAX_TASKS,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided max tasks is zero. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_zero_max_tasks_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 10, test_tasks, 0,
+                                test_work, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_parallel_run shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided work is NULL. */
+TEST_FUNCTION(az_ulib_ustream_parallel_run_null_work_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_parallel_run(&test_pool, test_ustream, 10, test_tasks, TEST_MAX_TASKS,
+                                NULL, test_join, &context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+END_TEST_SUITE(ustream_parallel_ut)
@@ -0,0 +1,547 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+#include "az_ulib_test_thread.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_pool.h"
+
+#define TEST_CONTENT            "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define TEST_CONTENT_LENGTH     62
+#define TEST_POOL_SIZE          8
+#define TEST_THREADS            4
+#define TEST_THREAD_ITERATIONS  10000
+
+static const uint8_t* const test_content = (const uint8_t* const)TEST_CONTENT;
+static az_ulib_ustream_pool test_pool;
+static az_ulib_ustream_pool_block test_blocks[TEST_POOL_SIZE];
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+static size_t count_free_blocks(az_ulib_ustream_pool* pool)
+{
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE + 1];
+    size_t count = 0;
+
+    while((count <= TEST_POOL_SIZE) && (az_ulib_ustream_pool_get_data_cb(pool, &data_cb[count]) == AZ_ULIB_SUCCESS))
+    {
+        count++;
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+
+    return count;
+}
+
+static int get_release_thread(void* arg)
+{
+    az_ulib_ustream_pool* pool = (az_ulib_ustream_pool*)arg;
+
+    for(size_t i = 0; i < TEST_THREAD_ITERATIONS; i++)
+    {
+        az_ulib_ustream_data_cb* data_cb;
+        az_ulib_ustream_multi_data_cb* multi_data_cb;
+
+        if(az_ulib_ustream_pool_get_data_cb(pool, &data_cb) != AZ_ULIB_SUCCESS)
+        {
+            return 1;
+        }
+        if(az_ulib_ustream_pool_get_multi_data_cb(pool, &multi_data_cb) != AZ_ULIB_SUCCESS)
+        {
+            return 1;
+        }
+        /* Each block shall be owned by a single thread, so the marker of another thread cannot overwrite it. */
+        const uint8_t* marker = (const uint8_t*)&i;
+        *(const uint8_t* volatile*)&data_cb->ptr = marker;
+        *(const uint8_t* volatile*)&multi_data_cb->control_block.ptr = marker;
+        test_thread_sleep(0);
+        if((*(const uint8_t* volatile*)&data_cb->ptr != marker) ||
+            (*(const uint8_t* volatile*)&multi_data_cb->control_block.ptr != marker))
+        {
+            return 1;
+        }
+        az_ulib_ustream_pool_release(multi_data_cb);
+        az_ulib_ustream_pool_release(data_cb);
+    }
+
+    return 0;
+}
+
+/**
+ * Beginning of the UT for ustream_pool.c on ownership model.
+ */
+BEGIN_TEST_SUITE(ustream_pool_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(&test_pool, 0, sizeof(test_pool));
+    memset(test_blocks, 0, sizeof(test_blocks));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_ustream_pool_init shall initialize the pool with all blocks free. */
+TEST_FUNCTION(az_ulib_ustream_pool_init_succeed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_init_null_pool_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_init(NULL, test_blocks, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided blocks is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_init_null_blocks_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_init(&test_pool, NULL, TEST_POOL_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided block count is zero. */
+TEST_FUNCTION(az_ulib_ustream_pool_init_zero_block_count_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_init(&test_pool, test_blocks, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided block count is bigger than AZ_ULIB_USTREAM_POOL_MAX_BLOCKS. */
+TEST_FUNCTION(az_ulib_ustream_pool_init_block_count_exceed_max_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_init(&test_pool, test_blocks, AZ_ULIB_USTREAM_POOL_MAX_BLOCKS + 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_data_cb shall return a different control block from the pool in each call. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_data_cb_succeed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_result result = az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb[i]);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    }
+
+    ///assert
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_IS_TRUE((void*)data_cb[i] >= (void*)&test_blocks[0]);
+        ASSERT_IS_TRUE((void*)data_cb[i] < (void*)&test_blocks[TEST_POOL_SIZE]);
+        for(size_t j = i + 1; j < TEST_POOL_SIZE; j++)
+        {
+            ASSERT_IS_TRUE(data_cb[i] != data_cb[j]);
+        }
+    }
+
+    ///cleanup
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+}
+
+/* az_ulib_ustream_pool_get_data_cb shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_data_cb_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_data_cb(NULL, &data_cb);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_data_cb shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided data_cb is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_data_cb_null_data_cb_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_data_cb(&test_pool, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_data_cb shall return AZ_ULIB_OUT_OF_MEMORY_ERROR if there is no free block in the pool. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_data_cb_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE];
+    az_ulib_ustream_data_cb* extra_data_cb = NULL;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb[i]));
+    }
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_data_cb(&test_pool, &extra_data_cb);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_IS_NULL(extra_data_cb);
+
+    ///cleanup
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+}
+
+/* az_ulib_ustream_pool_get_multi_data_cb shall return a control block from the pool. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_multi_data_cb_succeed)
+{
+    ///arrange
+    az_ulib_ustream_multi_data_cb* multi_data_cb;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_multi_data_cb(&test_pool, &multi_data_cb);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_TRUE((void*)multi_data_cb >= (void*)&test_blocks[0]);
+    ASSERT_IS_TRUE((void*)multi_data_cb < (void*)&test_blocks[TEST_POOL_SIZE]);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_blocks(&test_pool));
+
+    ///cleanup
+    az_ulib_ustream_pool_release(multi_data_cb);
+}
+
+/* az_ulib_ustream_pool_get_multi_data_cb shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_multi_data_cb_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_multi_data_cb* multi_data_cb;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_multi_data_cb(NULL, &multi_data_cb);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_multi_data_cb shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided multi_data_cb is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_multi_data_cb_null_multi_data_cb_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_multi_data_cb(&test_pool, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_multi_data_cb shall return AZ_ULIB_OUT_OF_MEMORY_ERROR if there is no free block in the pool. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_multi_data_cb_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE];
+    az_ulib_ustream_multi_data_cb* multi_data_cb = NULL;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb[i]));
+    }
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_multi_data_cb(&test_pool, &multi_data_cb);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_IS_NULL(multi_data_cb);
+
+    ///cleanup
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+}
+
+/* az_ulib_ustream_pool_get_rope_node shall return a rope node from the pool. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_rope_node_succeed)
+{
+    ///arrange
+    az_ulib_ustream_rope_node* rope_node;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_rope_node(&test_pool, &rope_node);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_IS_TRUE((void*)rope_node >= (void*)&test_blocks[0]);
+    ASSERT_IS_TRUE((void*)rope_node < (void*)&test_blocks[TEST_POOL_SIZE]);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_blocks(&test_pool));
+
+    ///cleanup
+    az_ulib_ustream_pool_release(rope_node);
+}
+
+/* az_ulib_ustream_pool_get_rope_node shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_rope_node_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_rope_node* rope_node;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_rope_node(NULL, &rope_node);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_rope_node shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided rope_node is NULL. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_rope_node_null_rope_node_failed)
+{
+    ///arrange
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_rope_node(&test_pool, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool_get_rope_node shall return AZ_ULIB_OUT_OF_MEMORY_ERROR if there is no free block in the pool. */
+TEST_FUNCTION(az_ulib_ustream_pool_get_rope_node_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE];
+    az_ulib_ustream_rope_node* rope_node = NULL;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb[i]));
+    }
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_pool_get_rope_node(&test_pool, &rope_node);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_IS_NULL(rope_node);
+
+    ///cleanup
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+}
+
+/* az_ulib_ustream_pool_release shall return the block to the pool, making it available for the next get. */
+TEST_FUNCTION(az_ulib_ustream_pool_release_succeed)
+{
+    ///arrange
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE];
+    az_ulib_ustream_multi_data_cb* multi_data_cb;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb[i]));
+    }
+
+    ///act
+    az_ulib_ustream_pool_release(data_cb[3]);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_multi_data_cb(&test_pool, &multi_data_cb));
+    ASSERT_IS_TRUE((void*)multi_data_cb == (void*)data_cb[3]);
+
+    ///cleanup
+    data_cb[3] = &multi_data_cb->control_block;
+    for(size_t i = 0; i < TEST_POOL_SIZE; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_pool_release shall be usable as the release callback of ustreams and concatenations. */
+TEST_FUNCTION(az_ulib_ustream_pool_release_as_release_callback_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    az_ulib_ustream ustream_two;
+    az_ulib_ustream_data_cb* data_cb;
+    az_ulib_ustream_multi_data_cb* multi_data_cb;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&ustream_instance, data_cb, az_ulib_ustream_pool_release, test_content, TEST_CONTENT_LENGTH, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&test_pool, &data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&ustream_two, data_cb, az_ulib_ustream_pool_release, test_content, TEST_CONTENT_LENGTH, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_multi_data_cb(&test_pool, &multi_data_cb));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_concat(&ustream_instance, &ustream_two, multi_data_cb, az_ulib_ustream_pool_release);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_dispose(&ustream_two));
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 3, count_free_blocks(&test_pool));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_dispose(&ustream_instance));
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_pool shall hand out each block to a single owner when multiple threads get and release blocks. */
+TEST_FUNCTION(az_ulib_ustream_pool_multiple_threads_succeed)
+{
+    ///arrange
+    THREAD_HANDLE threads[TEST_THREADS];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+
+    ///act
+    for(size_t i = 0; i < TEST_THREADS; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_THREAD_OK, test_thread_create(&threads[i], get_release_thread, &test_pool));
+    }
+
+    ///assert
+    for(size_t i = 0; i < TEST_THREADS; i++)
+    {
+        int thread_result;
+        ASSERT_ARE_EQUAL(int, TEST_THREAD_OK, test_thread_join(threads[i], &thread_result));
+        ASSERT_ARE_EQUAL(int, 0, thread_result);
+    }
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+END_TEST_SUITE(ustream_pool_ut)
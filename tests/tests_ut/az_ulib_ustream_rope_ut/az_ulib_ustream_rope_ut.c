@@ -0,0 +1,1230 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_ustream_rope.h"
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1 =
+        (const uint8_t* const)"0123456789";
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2 =
+        (const uint8_t* const)"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+#define TEST_POOL_SIZE              4096
+#define TEST_MANY_LEAVES_COUNT      256
+#define TEST_MANY_LEAVES_LENGTH     (TEST_MANY_LEAVES_COUNT * 4)
+#define TEST_SPLIT_CONCAT_ROUNDS    1000
+
+static az_ulib_ustream_pool test_pool;
+static az_ulib_ustream_pool_block test_blocks[TEST_POOL_SIZE];
+
+static size_t count_free_blocks(az_ulib_ustream_pool* pool)
+{
+    az_ulib_ustream_data_cb* data_cb[TEST_POOL_SIZE + 1];
+    size_t count = 0;
+
+    while((count <= TEST_POOL_SIZE) && (az_ulib_ustream_pool_get_data_cb(pool, &data_cb[count]) == AZ_ULIB_SUCCESS))
+    {
+        count++;
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+        az_ulib_ustream_pool_release(data_cb[i]);
+    }
+
+    return count;
+}
+
+static void create_test_buffer(az_ulib_ustream* ustream, const uint8_t* content, size_t content_length)
+{
+    az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    ASSERT_IS_NOT_NULL(control_block);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init(ustream, control_block, free, content, content_length, NULL));
+}
+
+/* Create a rope with the concatenation of the provided content split in leaves with the provided sizes. */
+static void create_test_rope_ustream(az_ulib_ustream* ustream, const uint8_t* content, const size_t* leaf_sizes, size_t leaf_count)
+{
+    az_ulib_ustream leaf;
+
+    create_test_buffer(&leaf, content, leaf_sizes[0]);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_rope_init(ustream, &test_pool, &leaf));
+    (void)az_ulib_ustream_dispose(&leaf);
+    content += leaf_sizes[0];
+
+    for(size_t i = 1; i < leaf_count; i++)
+    {
+        az_ulib_ustream rope;
+        create_test_buffer(&leaf, content, leaf_sizes[i]);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_rope_concat(&rope, &test_pool, ustream, &leaf));
+        (void)az_ulib_ustream_dispose(&leaf);
+        (void)az_ulib_ustream_dispose(ustream);
+        *ustream = rope;
+        content += leaf_sizes[i];
+    }
+}
+
+static void create_test_default_rope_ustream(az_ulib_ustream* ustream)
+{
+    static const size_t leaf_sizes[] = { 10, 26, 26 };
+    create_test_rope_ustream(ustream,
+            (const uint8_t*)"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", leaf_sizes, 3);
+}
+
+/* Create a rope with TEST_MANY_LEAVES_COUNT leaves with different sizes. */
+static void create_test_many_leaves_ustream(az_ulib_ustream* ustream, uint8_t* content, size_t* content_length)
+{
+    size_t leaf_sizes[TEST_MANY_LEAVES_COUNT];
+
+    *content_length = 0;
+    for(size_t i = 0; i < TEST_MANY_LEAVES_COUNT; i++)
+    {
+        leaf_sizes[i] = (i % 7) + 1;
+        *content_length += leaf_sizes[i];
+    }
+    for(size_t i = 0; i < *content_length; i++)
+    {
+        content[i] = (uint8_t)(i * 31);
+    }
+
+    create_test_rope_ustream(ustream, content, leaf_sizes, TEST_MANY_LEAVES_COUNT);
+}
+
+static void check_rope_content(az_ulib_ustream* ustream, const uint8_t* expected_content, size_t expected_content_length)
+{
+    uint8_t buf_result[TEST_MANY_LEAVES_LENGTH];
+    size_t total_size = 0;
+    size_t size_result;
+    az_ulib_result result;
+
+    while((result = az_ulib_ustream_read(ustream, &buf_result[total_size], sizeof(buf_result) - total_size,
+                    &size_result)) == AZ_ULIB_SUCCESS)
+    {
+        total_size += size_result;
+    }
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(size_t, expected_content_length, total_size);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(expected_content, buf_result, expected_content_length));
+}
+
+/* Check that the tree of the rope is an AVL tree, returning the number of leaves. */
+static size_t check_rope_node(const az_ulib_ustream_rope_node* node)
+{
+    size_t leaf_count;
+
+    if(node->height == 0)
+    {
+        ASSERT_ARE_NOT_EQUAL(size_t, 0, node->length);
+        leaf_count = 1;
+    }
+    else
+    {
+        const az_ulib_ustream_rope_node* left = node->content.branch.left;
+        const az_ulib_ustream_rope_node* right = node->content.branch.right;
+        uint32_t higher = (left->height > right->height) ? left->height : right->height;
+        uint32_t lower = (left->height > right->height) ? right->height : left->height;
+        ASSERT_IS_TRUE((higher - lower) <= 1);
+        ASSERT_ARE_EQUAL(int, higher + 1, node->height);
+        ASSERT_ARE_EQUAL(size_t, left->length + right->length, node->length);
+        leaf_count = check_rope_node(left) + check_rope_node(right);
+    }
+
+    return leaf_count;
+}
+
+static void check_rope_balance(az_ulib_ustream* ustream)
+{
+    const az_ulib_ustream_rope_node* root = (const az_ulib_ustream_rope_node*)ustream->control_block->ptr;
+    size_t leaf_count = check_rope_node(root);
+    uint32_t log2_leaf_count = 0;
+
+    while(((size_t)1 << log2_leaf_count) < leaf_count)
+    {
+        log2_leaf_count++;
+    }
+
+    /* The height of an AVL tree is smaller than 1.45 * log2(n + 2). */
+    ASSERT_IS_TRUE(root->height <= (((log2_leaf_count + 1) * 3) / 2));
+}
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT =
+        (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)           create_test_default_rope_ustream(ustream)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_rope.c module.
+ */
+BEGIN_TEST_SUITE(ustream_rope_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&test_pool, test_blocks, TEST_POOL_SIZE));
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_ustream_rope_init shall create a rope with one leaf with the content of the provided ustream. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 10));
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, &test_pool, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 1, count_free_blocks(&test_pool));
+    check_rope_content(&test_rope, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[10], USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 10);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_init shall share the nodes if the provided ustream is a rope. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_from_rope_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    size_t free_blocks = count_free_blocks(&test_pool);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, &test_pool, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, free_blocks, count_free_blocks(&test_pool));
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    check_rope_content(&test_rope, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(NULL, &test_pool, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, NULL, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream to wrap is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_null_ustream_to_wrap_failed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, &test_pool, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_rope_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream has no remaining content. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_empty_ustream_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 10));
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, &test_pool, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_init shall return AZ_ULIB_OUT_OF_MEMORY_ERROR if there is no free block in the pool. */
+TEST_FUNCTION(az_ulib_ustream_rope_init_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream_pool empty_pool;
+    az_ulib_ustream_pool_block empty_pool_blocks[1];
+    az_ulib_ustream_data_cb* data_cb;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&empty_pool, empty_pool_blocks, 1));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&empty_pool, &data_cb));
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_init(&test_rope, &empty_pool, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    check_buffer(&test_buffer, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+
+    ///cleanup
+    az_ulib_ustream_pool_release(data_cb);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall create a rope with the content of both ustreams, without changing them. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer1;
+    az_ulib_ustream test_buffer2;
+    create_test_buffer(&test_buffer1, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 36);
+    create_test_buffer(&test_buffer2, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[36], USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 36);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, &test_buffer1, &test_buffer2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE - 3, count_free_blocks(&test_pool));
+    check_buffer(&test_buffer1, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 36);
+    (void)az_ulib_ustream_dispose(&test_buffer1);
+    (void)az_ulib_ustream_dispose(&test_buffer2);
+    check_rope_content(&test_rope, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_concat shall share the nodes of the ropes, only creating the nodes to join them. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_shares_rope_nodes_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_rope1;
+    az_ulib_ustream test_rope2;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope1);
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope2);
+    size_t free_blocks = count_free_blocks(&test_pool);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, &test_rope1, &test_rope2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, free_blocks - 1, count_free_blocks(&test_pool));
+    check_buffer(&test_rope1, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    (void)az_ulib_ustream_dispose(&test_rope1);
+    (void)az_ulib_ustream_dispose(&test_rope2);
+    check_rope_balance(&test_rope);
+    check_rope_content(&test_rope, (const uint8_t*)USTREAM_COMPLIANCE_EXPECTED_CONTENT USTREAM_COMPLIANCE_EXPECTED_CONTENT,
+        2 * USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_concat shall keep the rope balanced, no matter the order of the concatenations. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_many_keeps_balance_succeed)
+{
+    ///arrange
+    uint8_t content[TEST_MANY_LEAVES_LENGTH];
+    size_t content_length;
+    az_ulib_ustream test_rope;
+    az_ulib_ustream test_head;
+    az_ulib_ustream test_prepended;
+
+    ///act
+    create_test_many_leaves_ustream(&test_rope, content, &content_length);
+    create_test_buffer(&test_head, content, 3);
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_prepended, &test_pool, &test_head, &test_rope);
+    for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < (TEST_MANY_LEAVES_COUNT - 1)); i++)
+    {
+        az_ulib_ustream test_next;
+        result = az_ulib_ustream_rope_concat(&test_next, &test_pool, &test_head, &test_prepended);
+        (void)az_ulib_ustream_dispose(&test_prepended);
+        test_prepended = test_next;
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    check_rope_balance(&test_rope);
+    check_rope_balance(&test_prepended);
+    check_rope_content(&test_rope, content, content_length);
+    size_t prepended_length;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&test_prepended, &prepended_length));
+    ASSERT_ARE_EQUAL(size_t, content_length + (3 * TEST_MANY_LEAVES_COUNT), prepended_length);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_head);
+    (void)az_ulib_ustream_dispose(&test_prepended);
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(NULL, &test_pool, &test_buffer, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, NULL, &test_buffer, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided left ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_null_left_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, NULL, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided right ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_null_right_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, &test_buffer, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if both ustreams have no remaining content. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_both_empty_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 10));
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, &test_buffer, &test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_concat shall return AZ_ULIB_OUT_OF_MEMORY_ERROR and release all the nodes that it
+    created if there is not enough free blocks in the pool. */
+TEST_FUNCTION(az_ulib_ustream_rope_concat_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer1;
+    az_ulib_ustream test_buffer2;
+    create_test_buffer(&test_buffer1, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    create_test_buffer(&test_buffer2, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2, 26);
+    az_ulib_ustream_pool small_pool;
+    az_ulib_ustream_pool_block small_pool_blocks[2];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&small_pool, small_pool_blocks, 2));
+    az_ulib_ustream test_rope;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_concat(&test_rope, &small_pool, &test_buffer1, &test_buffer2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    check_buffer(&test_buffer1, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    check_buffer(&test_buffer2, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2, 26);
+    az_ulib_ustream_data_cb* data_cb[2];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&small_pool, &data_cb[0]));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&small_pool, &data_cb[1]));
+
+    ///cleanup
+    az_ulib_ustream_pool_release(data_cb[0]);
+    az_ulib_ustream_pool_release(data_cb[1]);
+    (void)az_ulib_ustream_dispose(&test_buffer1);
+    (void)az_ulib_ustream_dispose(&test_buffer2);
+}
+
+/* az_ulib_ustream_rope_split shall create two ropes with the content before and after the offset. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 36, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    check_rope_balance(&test_left);
+    check_rope_balance(&test_right);
+    check_buffer(&test_left, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 36);
+    check_buffer(&test_right, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[36], USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 36);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_left);
+    (void)az_ulib_ustream_dispose(&test_right);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_split shall split a leaf in two leaves if the offset is in the middle of it. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_in_the_middle_of_a_leaf_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 5));
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 15, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    check_rope_balance(&test_left);
+    check_rope_balance(&test_right);
+    check_buffer(&test_left, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[5], 15);
+    check_buffer(&test_right, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[20], USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 20);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_left);
+    (void)az_ulib_ustream_dispose(&test_right);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_split shall not change the ustream to split. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_does_not_change_ustream_to_split_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 20, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    check_buffer(&test_buffer, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    check_buffer(&test_left, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 20);
+    check_buffer(&test_right, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[20], USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 20);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_left);
+    (void)az_ulib_ustream_dispose(&test_right);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream to split is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_null_ustream_to_split_failed)
+{
+    ///arrange
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(NULL, &test_pool, 5, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, NULL, 5, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided offset is zero. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_zero_offset_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 0, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided left ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_null_left_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 5, NULL, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided right ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_null_right_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_left;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 5, &test_left, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided offset is the end of the ustream. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_offset_at_the_end_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_buffer, 10));
+    size_t free_blocks = count_free_blocks(&test_pool);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 10, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, free_blocks, count_free_blocks(&test_pool));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided offset is after the end of the ustream. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_offset_after_the_end_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &test_pool, 11, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split shall return AZ_ULIB_OUT_OF_MEMORY_ERROR and release all the nodes that it
+    created if there is not enough free blocks in the pool. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_empty_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream_pool small_pool;
+    az_ulib_ustream_pool_block small_pool_blocks[1];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_init(&small_pool, small_pool_blocks, 1));
+    size_t free_blocks = count_free_blocks(&test_pool);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_split(&test_buffer, &small_pool, 15, &test_left, &test_right);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_OUT_OF_MEMORY_ERROR, result);
+    ASSERT_ARE_EQUAL(int, free_blocks, count_free_blocks(&test_pool));
+    check_buffer(&test_buffer, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    az_ulib_ustream_data_cb* data_cb;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_pool_get_data_cb(&small_pool, &data_cb));
+
+    ///cleanup
+    az_ulib_ustream_pool_release(data_cb);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_split and az_ulib_ustream_rope_concat shall keep the rope balanced and the number of nodes
+    bounded when the same content is split and concatenated over and over. */
+TEST_FUNCTION(az_ulib_ustream_rope_split_and_concat_many_times_succeed)
+{
+    ///arrange
+    uint8_t content[TEST_MANY_LEAVES_LENGTH];
+    size_t content_length;
+    az_ulib_ustream test_rope;
+    create_test_many_leaves_ustream(&test_rope, content, &content_length);
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+
+    ///act
+    for(size_t i = 0; (result == AZ_ULIB_SUCCESS) && (i < TEST_SPLIT_CONCAT_ROUNDS); i++)
+    {
+        az_ulib_ustream test_left;
+        az_ulib_ustream test_right;
+        size_t split_offset = ((i * 7919) % (content_length - 1)) + 1;
+        if((result = az_ulib_ustream_rope_split(&test_rope, &test_pool, split_offset, &test_left, &test_right)) == AZ_ULIB_SUCCESS)
+        {
+            (void)az_ulib_ustream_dispose(&test_rope);
+            result = az_ulib_ustream_rope_concat(&test_rope, &test_pool, &test_left, &test_right);
+            (void)az_ulib_ustream_dispose(&test_left);
+            (void)az_ulib_ustream_dispose(&test_right);
+        }
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    check_rope_balance(&test_rope);
+    /* Each split in the middle of a leaf adds one leaf, and a tree with N leaves has N - 1 branches. */
+    ASSERT_IS_TRUE((TEST_POOL_SIZE - count_free_blocks(&test_pool)) < (2 * (TEST_MANY_LEAVES_COUNT + TEST_SPLIT_CONCAT_ROUNDS)));
+    check_rope_content(&test_rope, content, content_length);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_slice shall create a rope with the provided part of the ustream. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, &test_pool, &test_buffer, 12, 20);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    check_buffer(&test_buffer, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    check_buffer(&test_slice, 0, &USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[12], 20);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_slice);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_slice shall create a rope with the content of multiple leaves. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_across_leaves_succeed)
+{
+    ///arrange
+    uint8_t content[TEST_MANY_LEAVES_LENGTH];
+    size_t content_length;
+    az_ulib_ustream test_rope;
+    create_test_many_leaves_ustream(&test_rope, content, &content_length);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_rope, 100));
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, &test_pool, &test_rope, 211, 500);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    (void)az_ulib_ustream_dispose(&test_rope);
+    check_rope_balance(&test_slice);
+    check_rope_content(&test_slice, &content[311], 500);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_slice);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+}
+
+/* az_ulib_ustream_rope_slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_null_instance_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(NULL, &test_pool, &test_buffer, 0, 5);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided pool is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_null_pool_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, NULL, &test_buffer, 0, 5);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream to slice is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_null_ustream_to_slice_failed)
+{
+    ///arrange
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, &test_pool, NULL, 0, 5);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_rope_slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided length is zero. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_zero_length_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, &test_pool, &test_buffer, 5, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_slice shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the slice does not fit in the ustream. */
+TEST_FUNCTION(az_ulib_ustream_rope_slice_after_the_end_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    size_t free_blocks = count_free_blocks(&test_pool);
+    az_ulib_ustream test_slice;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_slice(&test_slice, &test_pool, &test_buffer,
+        USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 5, 6);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+    ASSERT_ARE_EQUAL(int, free_blocks, count_free_blocks(&test_pool));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_index shall return the byte at the provided offset from the current position. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_succeed)
+{
+    ///arrange
+    uint8_t content[TEST_MANY_LEAVES_LENGTH];
+    size_t content_length;
+    az_ulib_ustream test_rope;
+    create_test_many_leaves_ustream(&test_rope, content, &content_length);
+    az_ulib_result result = AZ_ULIB_SUCCESS;
+    size_t i;
+
+    ///act
+    for(i = 0; (result == AZ_ULIB_SUCCESS) && (i < content_length); i++)
+    {
+        uint8_t value;
+        if((result = az_ulib_ustream_rope_index(&test_rope, i, &value)) == AZ_ULIB_SUCCESS)
+        {
+            ASSERT_ARE_EQUAL(int, content[i], value);
+        }
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, content_length, i);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+}
+
+/* az_ulib_ustream_rope_index shall not change the current position of the rope. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_does_not_change_position_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_rope, 20));
+    uint8_t value;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_index(&test_rope, 20, &value);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[40], value);
+    check_buffer(&test_rope, 20, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+}
+
+/* az_ulib_ustream_rope_index shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR if the offset is not smaller than the remaining size. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_after_the_end_failed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_rope, 2));
+    uint8_t value;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_index(&test_rope, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 2, &value);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+}
+
+/* az_ulib_ustream_rope_index shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_null_instance_failed)
+{
+    ///arrange
+    uint8_t value;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_index(NULL, 0, &value);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_rope_index shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is not a rope. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_non_rope_failed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, 10);
+    uint8_t value;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_index(&test_buffer, 0, &value);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_rope_index shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided value is NULL. */
+TEST_FUNCTION(az_ulib_ustream_rope_index_null_value_failed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_rope_index(&test_rope, 0, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+}
+
+/* az_ulib_ustream_read shall read the content of multiple leaves in one call. */
+TEST_FUNCTION(az_ulib_ustream_rope_read_from_multiple_leaves_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope);
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_read(&test_rope, buf_result, sizeof(buf_result), &size_result);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_rope);
+}
+
+/* az_ulib_ustream_peek shall return only the content of the leaf, even if the ustream in the leaf goes further. */
+TEST_FUNCTION(az_ulib_ustream_rope_peek_limited_to_leaf_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    create_test_buffer(&test_buffer, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_rope_split(&test_buffer, &test_pool, 20, &test_left, &test_right));
+    (void)az_ulib_ustream_dispose(&test_buffer);
+    const uint8_t* buffer;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_peek(&test_left, &buffer, &size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, 20, size);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buffer, size));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_left);
+    (void)az_ulib_ustream_dispose(&test_right);
+}
+
+/* az_ulib_ustream_dispose shall return all the nodes to the pool when the last rope that uses them is disposed. */
+TEST_FUNCTION(az_ulib_ustream_rope_dispose_returns_nodes_to_pool_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_rope;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_rope);
+    az_ulib_ustream test_left;
+    az_ulib_ustream test_right;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_rope_split(&test_rope, &test_pool, 30, &test_left, &test_right));
+    az_ulib_ustream test_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_clone, &test_left, 0));
+
+    ///act
+    (void)az_ulib_ustream_dispose(&test_rope);
+    (void)az_ulib_ustream_dispose(&test_left);
+    (void)az_ulib_ustream_dispose(&test_right);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+    check_buffer(&test_clone, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, 30);
+    (void)az_ulib_ustream_dispose(&test_clone);
+    ASSERT_ARE_EQUAL(int, TEST_POOL_SIZE, count_free_blocks(&test_pool));
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_read shall read the original and the clone of a rope in any order. */
+TEST_FUNCTION(az_ulib_ustream_rope_read_clone_and_original_in_parallel_succeed)
+{
+    ///arrange
+    az_ulib_ustream test_buffer;
+    USTREAM_COMPLIANCE_TARGET_FACTORY(&test_buffer);
+    az_ulib_ustream test_buffer_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&test_buffer_clone, &test_buffer, 0));
+    uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+    size_t size_result;
+
+    ///act
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer, buf_result, 15, &size_result));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, 15));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&test_buffer_clone, buf_result, 40, &size_result));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, 40));
+    (void)az_ulib_ustream_dispose(&test_buffer);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_read(&test_buffer_clone, buf_result, sizeof(buf_result), &size_result));
+    ASSERT_ARE_EQUAL(size_t, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 40, size_result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(&USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT[40], buf_result, size_result));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_buffer_clone);
+}
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_rope_ut)
@@ -0,0 +1,425 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#endif
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_sha256.h"
+#include "internal/az_ulib_sha256.h"
+
+#define TEST_LONG_CONTENT_LENGTH    3000
+
+typedef struct test_sha256_vector_tag
+{
+    const char* message;
+    size_t repeat;
+    const char* digest;
+} test_sha256_vector;
+
+/* Test vectors from FIPS 180-2. */
+static const test_sha256_vector test_vectors[] =
+{
+    { "", 1, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+    { "abc", 1, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    { "a", 1000000, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" }
+};
+#define TEST_VECTORS_COUNT  (sizeof(test_vectors) / sizeof(test_vectors[0]))
+
+/* Digest of the test_long_content. */
+static const char* const test_long_content_digest = "f49a000aeb937be459f9cf5769cfade4e352b54f4890d7d7b7cd12e348df68cf";
+static uint8_t test_long_content[TEST_LONG_CONTENT_LENGTH];
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+static void check_digest(const char* expected, const uint8_t* digest)
+{
+    char digest_string[(AZ_ULIB_SHA256_DIGEST_SIZE * 2) + 1];
+    for(size_t i = 0; i < AZ_ULIB_SHA256_DIGEST_SIZE; i++)
+    {
+        (void)sprintf(&digest_string[i * 2], "%02x", digest[i]);
+    }
+    ASSERT_ARE_EQUAL(char_ptr, expected, digest_string);
+}
+
+static void check_vectors(az_ulib_sha256_context* context, az_ulib_result (*init)(az_ulib_sha256_context*))
+{
+    for(size_t i = 0; i < TEST_VECTORS_COUNT; i++)
+    {
+        uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, init(context));
+        for(size_t j = 0; j < test_vectors[i].repeat; j++)
+        {
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+                az_ulib_sha256_update(context, (const uint8_t*)test_vectors[i].message, strlen(test_vectors[i].message)));
+        }
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(context, digest));
+        check_digest(test_vectors[i].digest, digest);
+    }
+}
+
+/* Create a ustream with the test_long_content split in parts with the provided sizes. */
+static void create_test_split_ustream(az_ulib_ustream* ustream, const size_t* part_sizes, size_t part_count)
+{
+    const uint8_t* content = test_long_content;
+    for(size_t i = 0; i < part_count; i++)
+    {
+        az_ulib_ustream part;
+        az_ulib_ustream_data_cb* control_block = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+        ASSERT_IS_NOT_NULL(control_block);
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_init((i == 0) ? ustream : &part, control_block, free,
+                            content, part_sizes[i], NULL));
+        content += part_sizes[i];
+        if(i != 0)
+        {
+            az_ulib_ustream_multi_data_cb* multi_data = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+            ASSERT_IS_NOT_NULL(multi_data);
+            ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_concat(ustream, &part, multi_data, free));
+            (void)az_ulib_ustream_dispose(&part);
+        }
+    }
+}
+
+/**
+ * Beginning of the UT for ustream_sha256.c on ownership model.
+ */
+BEGIN_TEST_SUITE(ustream_sha256_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    for(size_t i = 0; i < TEST_LONG_CONTENT_LENGTH; i++)
+    {
+        test_long_content[i] = (uint8_t)((i * 7) + (i >> 8));
+    }
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_sha256_init shall start a new digest. */
+TEST_FUNCTION(az_ulib_sha256_init_succeed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+    uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_update(&context, (const uint8_t*)"abc", 3));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(&context, digest));
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_init(&context);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(&context, digest));
+    check_digest(test_vectors[0].digest, digest);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided context is NULL. */
+TEST_FUNCTION(az_ulib_sha256_init_null_context_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_init(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* _az_ulib_sha256_init_portable shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided context is NULL. */
+TEST_FUNCTION(az_ulib_sha256_init_portable_null_context_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = _az_ulib_sha256_init_portable(NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* The SHA-256 shall return the expected digest for the test vectors. */
+TEST_FUNCTION(az_ulib_sha256_vectors_succeed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+
+    ///act
+    ///assert
+    check_vectors(&context, az_ulib_sha256_init);
+
+    ///cleanup
+}
+
+/* The portable SHA-256 shall return the expected digest for the test vectors. */
+TEST_FUNCTION(az_ulib_sha256_portable_vectors_succeed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+
+    ///act
+    ///assert
+    check_vectors(&context, _az_ulib_sha256_init_portable);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_update shall accept the content in pieces of any size. */
+TEST_FUNCTION(az_ulib_sha256_update_byte_by_byte_succeed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+    uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    for(size_t i = 0; i < TEST_LONG_CONTENT_LENGTH; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_update(&context, &test_long_content[i], 1));
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(&context, digest));
+    check_digest(test_long_content_digest, digest);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_update shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided context is NULL. */
+TEST_FUNCTION(az_ulib_sha256_update_null_context_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_update(NULL, (const uint8_t*)"abc", 3);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_update shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided buffer is NULL and the size is not zero. */
+TEST_FUNCTION(az_ulib_sha256_update_null_buffer_failed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_update(&context, NULL, 3);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_final shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided context is NULL. */
+TEST_FUNCTION(az_ulib_sha256_final_null_context_failed)
+{
+    ///arrange
+    uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_final(NULL, digest);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_sha256_final shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided digest is NULL. */
+TEST_FUNCTION(az_ulib_sha256_final_null_digest_failed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    az_ulib_result result = az_ulib_sha256_final(&context, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_sha256_update shall add the content from the current position, without changing it. */
+TEST_FUNCTION(az_ulib_ustream_sha256_update_succeed)
+{
+    ///arrange
+    static const uint8_t content[] = "xyzabc";
+    az_ulib_ustream_data_cb control_block;
+    az_ulib_ustream test_ustream;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_init(&test_ustream, &control_block, NULL, content, sizeof(content) - 1, NULL));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&test_ustream, 3));
+    az_ulib_sha256_context context;
+    uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+    offset_t position;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_sha256_update(&context, &test_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(&context, digest));
+    check_digest(test_vectors[1].digest, digest);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&test_ustream, &position));
+    ASSERT_ARE_EQUAL(int, 3, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_sha256_update shall add the content of all the ustreams in a concatenation. */
+TEST_FUNCTION(az_ulib_ustream_sha256_update_multibuffer_succeed)
+{
+    ///arrange
+    static const size_t part_sizes[] = { 1, 63, 64, 65, 1000, 1807 };
+    az_ulib_ustream test_ustream;
+    create_test_split_ustream(&test_ustream, part_sizes, sizeof(part_sizes) / sizeof(part_sizes[0]));
+    az_ulib_sha256_context context;
+    uint8_t digest[AZ_ULIB_SHA256_DIGEST_SIZE];
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_sha256_update(&context, &test_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_final(&context, digest));
+    check_digest(test_long_content_digest, digest);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&test_ustream);
+}
+
+/* az_ulib_ustream_sha256_update shall return the error if it cannot get the current position. */
+TEST_FUNCTION(az_ulib_ustream_sha256_update_get_position_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+    az_ulib_sha256_context context;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+    set_get_position_result(AZ_ULIB_SYSTEM_ERROR);
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_sha256_update(&context, test_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SYSTEM_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_sha256_update shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided context is NULL. */
+TEST_FUNCTION(az_ulib_ustream_sha256_update_null_context_failed)
+{
+    ///arrange
+    az_ulib_ustream* test_ustream = ustream_mock_create();
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_sha256_update(NULL, test_ustream);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_sha256_update shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided ustream is NULL. */
+TEST_FUNCTION(az_ulib_ustream_sha256_update_null_instance_failed)
+{
+    ///arrange
+    az_ulib_sha256_context context;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_sha256_init(&context));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_sha256_update(&context, NULL);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+END_TEST_SUITE(ustream_sha256_ut)
@@ -0,0 +1,719 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/* mkdtemp() is not part of the POSIX level used by the build. */
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
+/* The huge test file needs a 64 bits off_t. */
+#if !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#endif
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "umock_c/umock_c.h"
+#include "testrunnerswitcher.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_bool.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "azure_macro_utils/macro_utils.h"
+#include "az_ulib_ctest_aux.h"
+#include "az_ulib_ustream_mock_buffer.h"
+
+static TEST_MUTEX_HANDLE g_test_by_test;
+
+#include "az_ulib_ustream_base.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_uring.h"
+
+/* define constants for the compliance test */
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+#define USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH 62
+#define USTREAM_COMPLIANCE_PEEK_NOT_SUPPORTED
+
+#define TEST_FILE_NAME_LENGTH       128
+#define TEST_QUEUE_DEPTH            4
+#define TEST_READ_AHEAD             3
+
+/* Not a multiple of the chunk size, so the last chunk is partial. */
+#define TEST_BIG_FILE_SIZE          ((16 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE) + 123)
+#define TEST_BIG_FILE_BYTE(pos)     ((uint8_t)((pos) % 251))
+#define TEST_READ_BUFFER_SIZE       10000
+
+#if SIZE_MAX > UINT32_MAX
+/* Sparse file bigger than 4GB, only the marks are written. */
+#define TEST_HUGE_FILE_SIZE         (((offset_t)5 << 30) + 100)
+#define TEST_HUGE_MARK_SIZE         64
+static const offset_t test_huge_file_marks[] =
+{
+    0,
+    (offset_t)UINT32_MAX - (TEST_HUGE_MARK_SIZE / 2),
+    (offset_t)5 << 30,
+    TEST_HUGE_FILE_SIZE - TEST_HUGE_MARK_SIZE
+};
+#define TEST_HUGE_FILE_MARKS        (sizeof(test_huge_file_marks) / sizeof(test_huge_file_marks[0]))
+#endif /* SIZE_MAX > UINT32_MAX */
+
+static char test_directory[] = "/tmp/az_ulib_ustream_uring_ut_XXXXXX";
+static char test_content_file_name[TEST_FILE_NAME_LENGTH];
+static char test_empty_file_name[TEST_FILE_NAME_LENGTH];
+static char test_big_file_name[TEST_FILE_NAME_LENGTH];
+static char test_not_found_file_name[TEST_FILE_NAME_LENGTH];
+#if SIZE_MAX > UINT32_MAX
+static char test_huge_file_name[TEST_FILE_NAME_LENGTH];
+#endif
+
+static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
+static az_ulib_ustream test_ustream_instance;
+static az_ulib_ustream_uring_data_cb test_uring_data;
+static void ustream_factory(az_ulib_ustream* ustream)
+{
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_uring_init(ustream, uring_data, free, test_content_file_name, 2, 1));
+}
+#define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream)         ustream_factory(ustream)
+
+static void build_test_file_name(char* file_name, const char* name)
+{
+    int result = snprintf(file_name, TEST_FILE_NAME_LENGTH, "%s/%s", test_directory, name);
+    ASSERT_IS_TRUE((result > 0) && (result < TEST_FILE_NAME_LENGTH));
+}
+
+static void create_test_file(char* file_name, const char* name, size_t size, const uint8_t* const content)
+{
+    build_test_file_name(file_name, name);
+    FILE* file = fopen(file_name, "wb");
+    ASSERT_IS_NOT_NULL(file);
+    if(content != NULL)
+    {
+        ASSERT_ARE_EQUAL(int, size, fwrite(content, 1, size, file));
+    }
+    else
+    {
+        for(size_t i = 0; i < size; i++)
+        {
+            ASSERT_ARE_NOT_EQUAL(int, EOF, fputc(TEST_BIG_FILE_BYTE(i), file));
+        }
+    }
+    int result = fclose(file);
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+
+static void check_big_file_content(const uint8_t* const buffer, offset_t position, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_BYTE(position + i), buffer[i]);
+    }
+}
+
+#if SIZE_MAX > UINT32_MAX
+static void create_huge_test_file(char* file_name, const char* name)
+{
+    uint8_t mark[TEST_HUGE_MARK_SIZE];
+    build_test_file_name(file_name, name);
+    int file_descriptor = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_IS_TRUE(file_descriptor >= 0);
+    int result = ftruncate(file_descriptor, (off_t)TEST_HUGE_FILE_SIZE);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    for(size_t i = 0; i < TEST_HUGE_FILE_MARKS; i++)
+    {
+        for(size_t j = 0; j < TEST_HUGE_MARK_SIZE; j++)
+        {
+            mark[j] = TEST_BIG_FILE_BYTE(test_huge_file_marks[i] + j);
+        }
+        off_t file_offset = lseek(file_descriptor, (off_t)test_huge_file_marks[i], SEEK_SET);
+        ASSERT_IS_TRUE(file_offset == (off_t)test_huge_file_marks[i]);
+        ssize_t written = write(file_descriptor, mark, TEST_HUGE_MARK_SIZE);
+        ASSERT_ARE_EQUAL(int, TEST_HUGE_MARK_SIZE, written);
+    }
+    result = close(file_descriptor);
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+#endif /* SIZE_MAX > UINT32_MAX */
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    ASSERT_FAIL("umock_c reported error :%i", error_code);
+}
+
+/**
+ * Beginning of the UT for ustream_uring.c on ownership model.
+ */
+BEGIN_TEST_SUITE(ustream_uring_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    g_test_by_test = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_test_by_test);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_charptr_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(az_ulib_ustream, void*);
+
+    ASSERT_IS_NOT_NULL(mkdtemp(test_directory));
+    create_test_file(test_content_file_name, "content.bin", USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT);
+    create_test_file(test_empty_file_name, "empty.bin", 0, NULL);
+    create_test_file(test_big_file_name, "big.bin", TEST_BIG_FILE_SIZE, NULL);
+    build_test_file_name(test_not_found_file_name, "not_found.bin");
+#if SIZE_MAX > UINT32_MAX
+    create_huge_test_file(test_huge_file_name, "huge.bin");
+#endif
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    (void)remove(test_content_file_name);
+    (void)remove(test_empty_file_name);
+    (void)remove(test_big_file_name);
+#if SIZE_MAX > UINT32_MAX
+    (void)remove(test_huge_file_name);
+#endif
+    (void)rmdir(test_directory);
+
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_test_by_test);
+}
+
+TEST_FUNCTION_INITIALIZE(test_method_initialize)
+{
+    if (TEST_MUTEX_ACQUIRE(g_test_by_test))
+    {
+        ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+    }
+
+    memset(&test_ustream_instance, 0, sizeof(az_ulib_ustream));
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_method_cleanup)
+{
+    reset_mock_buffer();
+
+    TEST_MUTEX_RELEASE(g_test_by_test);
+}
+
+/* az_ulib_ustream_uring_init shall create an instance of the ustream and initialize the instance. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_content_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(int, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH, size);
+    check_buffer(&ustream_instance, 0, USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided instance is NULL. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_null_instance_failed)
+{
+    ///arrange
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(NULL, &test_uring_data, NULL, test_content_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided uring data is NULL. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_null_uring_data_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, NULL, NULL, test_content_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided file name is NULL. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_null_file_name_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, NULL,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided queue depth is zero. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_zero_queue_depth_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_content_file_name, 0, 0);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided queue depth is bigger than the configured max. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_queue_depth_too_big_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_content_file_name,
+                                                        AZ_ULIB_CONFIG_USTREAM_URING_MAX_QUEUE_DEPTH + 1, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the provided read ahead is not smaller than the queue depth. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_read_ahead_too_big_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_content_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_QUEUE_DEPTH);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_NO_SUCH_ELEMENT_ERROR if the file does not exist. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_file_not_found_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_not_found_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_NO_SUCH_ELEMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_uring_init shall return AZ_ULIB_ILLEGAL_ARGUMENT_ERROR if the file is empty. */
+TEST_FUNCTION(az_ulib_ustream_uring_init_empty_file_failed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_empty_file_name,
+                                                        TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_ILLEGAL_ARGUMENT_ERROR, result);
+
+    ///cleanup
+}
+
+/* az_ulib_ustream_read shall return the full content of a file with multiple chunks. */
+TEST_FUNCTION(az_ulib_ustream_uring_read_full_file_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, TEST_READ_AHEAD));
+    uint8_t* buf = (uint8_t*)malloc(TEST_READ_BUFFER_SIZE);
+    ASSERT_IS_NOT_NULL(buf);
+    offset_t position = 0;
+    size_t size;
+    az_ulib_result result;
+
+    ///act
+    while((result = az_ulib_ustream_read(&ustream_instance, buf, TEST_READ_BUFFER_SIZE, &size)) == AZ_ULIB_SUCCESS)
+    {
+        check_big_file_content(buf, position, size);
+        position += size;
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, result);
+    ASSERT_ARE_EQUAL(int, TEST_BIG_FILE_SIZE, position);
+
+    ///cleanup
+    free(buf);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_readv shall copy the content across multiple chunks. */
+TEST_FUNCTION(az_ulib_ustream_uring_readv_across_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, TEST_READ_AHEAD));
+    offset_t position = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE - 10;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    size_t buf_size = 3 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE;
+    uint8_t* buf = (uint8_t*)malloc(buf_size);
+    ASSERT_IS_NOT_NULL(buf);
+    az_ulib_ustream_iovec iov[2];
+    iov[0].buffer = buf;
+    iov[0].buffer_length = 20;
+    iov[1].buffer = buf + 20;
+    iov[1].buffer_length = buf_size - 20;
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_readv(&ustream_instance, iov, 2, &size);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, buf_size, size);
+    check_big_file_content(buf, position, size);
+
+    ///cleanup
+    free(buf);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* Clones reading different parts of the file shall share the chunk buffers and still return the right content. */
+TEST_FUNCTION(az_ulib_ustream_uring_read_with_clones_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, 2, 1));
+    az_ulib_ustream ustream_instance_clone;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_clone(&ustream_instance_clone, &ustream_instance, 0));
+    offset_t clone_position = TEST_BIG_FILE_SIZE / 2;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance_clone, clone_position));
+    uint8_t* buf = (uint8_t*)malloc(TEST_READ_BUFFER_SIZE);
+    ASSERT_IS_NOT_NULL(buf);
+    offset_t position = 0;
+    size_t size;
+
+    ///act
+    while(position < (TEST_BIG_FILE_SIZE / 2))
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, TEST_READ_BUFFER_SIZE, &size));
+        check_big_file_content(buf, position, size);
+        position += size;
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance_clone, buf, TEST_READ_BUFFER_SIZE, &size));
+        check_big_file_content(buf, clone_position, size);
+        clone_position += size;
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&ustream_instance_clone, buf, TEST_READ_BUFFER_SIZE, &size));
+
+    ///cleanup
+    free(buf);
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+    (void)az_ulib_ustream_dispose(&ustream_instance_clone);
+}
+
+/* az_ulib_ustream_release shall drop the chunks before the release watermark, and keep the rest of the content. */
+TEST_FUNCTION(az_ulib_ustream_uring_release_drops_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, 0));
+    offset_t position = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE + 10;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, 0));
+    uint8_t buf[16];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_release(&ustream_instance, position + 7);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    for(size_t i = 0; i < TEST_QUEUE_DEPTH; i++)
+    {
+        /* Only the second chunk is still in a buffer. */
+        ASSERT_IS_TRUE((uring_data->chunks[i].state == 0) ||
+                        (uring_data->chunks[i].position == AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE));
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_reset(&ustream_instance));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    check_big_file_content(buf, position + 8, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hints sequential and random shall change the read-ahead of all instances. */
+TEST_FUNCTION(az_ulib_ustream_uring_hint_sequential_and_random_change_read_ahead_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, 0));
+    uint8_t buf[16];
+    size_t size;
+
+    ///act
+    az_ulib_result result_sequential = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_SEQUENTIAL, 0, TEST_BIG_FILE_SIZE);
+    size_t read_ahead_sequential = uring_data->read_ahead;
+    az_ulib_result result_random = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_RANDOM, 0, TEST_BIG_FILE_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_sequential);
+    ASSERT_ARE_EQUAL(int, TEST_QUEUE_DEPTH - 1, read_ahead_sequential);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result_random);
+    ASSERT_ARE_EQUAL(int, 0, uring_data->read_ahead);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    check_big_file_content(buf, 0, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint will need shall request the chunks of the range, without changing the current position. */
+TEST_FUNCTION(az_ulib_ustream_uring_hint_will_need_requests_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, 0));
+    offset_t position = (4 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE) + 10;
+    uint8_t buf[16];
+    size_t size;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_WILL_NEED, position,
+                                AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    if(uring_data->ring.ring_fd >= 0)
+    {
+        /* The range covers the end of the fifth chunk and the beginning of the sixth one. */
+        size_t requested = 0;
+        for(size_t i = 0; i < TEST_QUEUE_DEPTH; i++)
+        {
+            if((uring_data->chunks[i].state != 0) &&
+                ((uring_data->chunks[i].position == (4 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE)) ||
+                 (uring_data->chunks[i].position == (5 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE))))
+            {
+                requested++;
+            }
+        }
+        ASSERT_ARE_EQUAL(int, 2, requested);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    check_big_file_content(buf, 0, size);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    check_big_file_content(buf, position, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The hint done shall drop the chunks fully inside the range. */
+TEST_FUNCTION(az_ulib_ustream_uring_hint_done_drops_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, 0));
+    offset_t position = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE + 10;
+    uint8_t buf[16];
+    size_t size;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, position));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_hint(&ustream_instance, AZ_ULIB_USTREAM_HINT_DONE, 0,
+                                (2 * AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE) - 1);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    for(size_t i = 0; i < TEST_QUEUE_DEPTH; i++)
+    {
+        /* Only the second chunk, which is not fully inside the range, is still in a buffer. */
+        ASSERT_IS_TRUE((uring_data->chunks[i].state == 0) ||
+                        (uring_data->chunks[i].position == AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE));
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, 0));
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+    ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+    check_big_file_content(buf, 0, size);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_find shall find a pattern across the chunks, copying the content when the ustream cannot peek. */
+TEST_FUNCTION(az_ulib_ustream_uring_find_across_chunks_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, TEST_READ_AHEAD));
+    /* The content repeats every 251 bytes, so the first match after the start position is the one in the chunk boundary. */
+    offset_t expected_position = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE - 10;
+    offset_t start_position = AZ_ULIB_CONFIG_USTREAM_URING_CHUNK_SIZE - 250;
+    uint8_t pattern[20];
+    for(size_t i = 0; i < sizeof(pattern); i++)
+    {
+        pattern[i] = TEST_BIG_FILE_BYTE(expected_position + i);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, start_position));
+    offset_t found_position;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_find(&ustream_instance, pattern, sizeof(pattern), &found_position);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(size_t, expected_position, found_position);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(size_t, start_position, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* az_ulib_ustream_crc32c shall read the content to the local buffer when the ustream cannot peek. */
+TEST_FUNCTION(az_ulib_ustream_uring_crc32c_succeed)
+{
+    ///arrange
+    az_ulib_ustream_uring_data_cb* uring_data = (az_ulib_ustream_uring_data_cb*)malloc(sizeof(az_ulib_ustream_uring_data_cb));
+    az_ulib_ustream ustream_instance;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS,
+        az_ulib_ustream_uring_init(&ustream_instance, uring_data, free, test_big_file_name, TEST_QUEUE_DEPTH, TEST_READ_AHEAD));
+    offset_t start_position = 10;
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, start_position));
+    uint32_t expected_crc = 0xFFFFFFFF;
+    for(offset_t i = start_position; i < TEST_BIG_FILE_SIZE; i++)
+    {
+        expected_crc ^= TEST_BIG_FILE_BYTE(i);
+        for(int bit = 0; bit < 8; bit++)
+        {
+            expected_crc = (expected_crc & 1) ? ((expected_crc >> 1) ^ 0x82F63B78) : (expected_crc >> 1);
+        }
+    }
+    expected_crc = ~expected_crc;
+    uint32_t crc = 0;
+    offset_t position;
+
+    ///act
+    az_ulib_result result = az_ulib_ustream_crc32c(&ustream_instance, &crc);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(uint32_t, expected_crc, crc);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_position(&ustream_instance, &position));
+    ASSERT_ARE_EQUAL(size_t, start_position, position);
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+#if SIZE_MAX > UINT32_MAX
+/* The uring ustream shall read files bigger than 4GB, with positions bigger than UINT32_MAX. */
+TEST_FUNCTION(az_ulib_ustream_uring_huge_file_succeed)
+{
+    ///arrange
+    az_ulib_ustream ustream_instance;
+    uint8_t buf[TEST_HUGE_MARK_SIZE];
+    size_t size;
+
+    ///act
+    az_ulib_result result =
+        az_ulib_ustream_uring_init(&ustream_instance, &test_uring_data, NULL, test_huge_file_name, TEST_QUEUE_DEPTH, TEST_READ_AHEAD);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, result);
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_get_remaining_size(&ustream_instance, &size));
+    ASSERT_ARE_EQUAL(size_t, TEST_HUGE_FILE_SIZE, size);
+    for(size_t i = 0; i < TEST_HUGE_FILE_MARKS; i++)
+    {
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_set_position(&ustream_instance, test_huge_file_marks[i]));
+        ASSERT_ARE_EQUAL(int, AZ_ULIB_SUCCESS, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+        ASSERT_ARE_EQUAL(int, sizeof(buf), size);
+        check_big_file_content(buf, test_huge_file_marks[i], size);
+    }
+    ASSERT_ARE_EQUAL(int, AZ_ULIB_EOF, az_ulib_ustream_read(&ustream_instance, buf, sizeof(buf), &size));
+
+    ///cleanup
+    (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+#endif /* SIZE_MAX > UINT32_MAX */
+
+#include "az_ulib_ustream_compliance_ut.h"
+
+END_TEST_SUITE(ustream_uring_ut)